@@ -0,0 +1,186 @@
+// benchmarks/BenchmarkHarness.cpp - Timing, reporting and baseline comparison for the benchmark suite
+#include "BenchmarkHarness.h"
+
+#include <QHash>
+#include <QJsonArray>
+#include <QSysInfo>
+#include <algorithm>
+#include <vector>
+
+#include "audio/MixKernel.h"
+
+namespace {
+
+QString resultKey(const QString& name, int size)
+{
+    return QString("%1@%2").arg(name).arg(size);
+}
+
+} // namespace
+
+BenchmarkHarness::BenchmarkHarness(QTextStream& out, const QString& filter, int repetitions)
+    : out_(out)
+    , filter_(filter)
+    , repetitions_(std::max(1, repetitions))
+    , results_()
+    , metrics_()
+{
+    out_ << QString("%1 %2 %3 %4 %5\n")
+        .arg("benchmark", -28).arg("size", 8).arg("median ms", 12).arg("ns/item", 12).arg("spread", 8);
+}
+
+bool BenchmarkHarness::isSelected(const QString& name) const
+{
+    return filter_.isEmpty() || name.contains(filter_);
+}
+
+void BenchmarkHarness::measure(const QString& name, int size, const std::function<qint64()>& run)
+{
+    if (!isSelected(name)) {
+        return;
+    }
+
+    std::vector<qint64> samples;
+    samples.reserve(static_cast<std::size_t>(repetitions_));
+    for (int i = 0; i < repetitions_; ++i) {
+        samples.push_back(run());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.name = name;
+    result.size = size;
+    result.repetitions = repetitions_;
+    result.medianNs = samples[samples.size() / 2];
+    result.minNs = samples.front();
+    result.maxNs = samples.back();
+    results_.append(result);
+
+    // Spread: how far the slowest run was from the fastest, a hint the machine was busy
+    const double spread = result.minNs > 0 ? static_cast<double>(result.maxNs) / result.minNs : 0.0;
+    out_ << QString("%1 %2 %3 %4 %5\n")
+        .arg(name, -28)
+        .arg(size, 8)
+        .arg(result.medianNs / 1.0e6, 12, 'f', 3)
+        .arg(result.perItemNs(), 12, 'f', 1)
+        .arg(spread, 8, 'f', 2);
+    out_.flush();
+}
+
+void BenchmarkHarness::addMetric(const Metric& metric)
+{
+    if (!isSelected(metric.name)) {
+        return;
+    }
+
+    metrics_.append(metric);
+    out_ << QString("%1 %2 %3\n").arg(metric.name, -28).arg(metric.value, 21, 'f', 1).arg(metric.unit);
+    out_.flush();
+}
+
+QJsonObject BenchmarkHarness::toJson() const
+{
+    QJsonArray results;
+    for (const Result& result : results_) {
+        QJsonObject json;
+        json["name"] = result.name;
+        json["size"] = result.size;
+        json["repetitions"] = result.repetitions;
+        json["medianNs"] = result.medianNs;
+        json["minNs"] = result.minNs;
+        json["maxNs"] = result.maxNs;
+        json["perItemNs"] = result.perItemNs();
+        results.append(json);
+    }
+
+    QJsonArray metrics;
+    for (const Metric& metric : metrics_) {
+        QJsonObject json;
+        json["name"] = metric.name;
+        json["value"] = metric.value;
+        json["unit"] = metric.unit;
+        json["higherIsBetter"] = metric.higherIsBetter;
+        metrics.append(json);
+    }
+
+    // Enough about the machine to tell when two reports aren't comparable
+    QJsonObject environment;
+    environment["cpu"] = QSysInfo::currentCpuArchitecture();
+    environment["os"] = QSysInfo::prettyProductName();
+    environment["qt"] = QString(qVersion());
+    environment["mixKernel"] = QString(MixKernel::implementationName());
+
+    QJsonObject json;
+    json["schema"] = SCHEMA_VERSION;
+    json["environment"] = environment;
+    json["results"] = results;
+    json["metrics"] = metrics;
+    return json;
+}
+
+int BenchmarkHarness::compare(const QJsonObject& baseline, const QJsonObject& current, double tolerance, QTextStream& out)
+{
+    if (baseline["schema"].toInt() != SCHEMA_VERSION) {
+        out << "Baseline has schema " << baseline["schema"].toInt() << ", expected " << SCHEMA_VERSION << "\n";
+        return 1;
+    }
+    if (baseline["environment"].toObject().value("mixKernel") != current["environment"].toObject().value("mixKernel")) {
+        out << "Warning: baseline used a different mix kernel, timings may not be comparable\n";
+    }
+
+    QHash<QString, qint64> baselineTimes;
+    for (const QJsonValue& value : baseline["results"].toArray()) {
+        const QJsonObject result = value.toObject();
+        baselineTimes.insert(resultKey(result["name"].toString(), result["size"].toInt()),
+                             result["medianNs"].toInteger());
+    }
+
+    int regressions = 0;
+    out << "\nAgainst baseline (tolerance " << tolerance * 100.0 << "%):\n";
+
+    for (const QJsonValue& value : current["results"].toArray()) {
+        const QJsonObject result = value.toObject();
+        const QString key = resultKey(result["name"].toString(), result["size"].toInt());
+        const qint64 before = baselineTimes.value(key, 0);
+        if (before <= 0) {
+            continue;
+        }
+
+        const double ratio = static_cast<double>(result["medianNs"].toInteger()) / before;
+        if (ratio > 1.0 + tolerance) {
+            out << QString("  REGRESSION %1 %2x slower\n").arg(key, -36).arg(ratio, 0, 'f', 2);
+            ++regressions;
+        }
+        else if (ratio < 1.0 - tolerance) {
+            out << QString("  improved   %1 %2x faster\n").arg(key, -36).arg(1.0 / ratio, 0, 'f', 2);
+        }
+    }
+
+    QHash<QString, QJsonObject> baselineMetrics;
+    for (const QJsonValue& value : baseline["metrics"].toArray()) {
+        const QJsonObject metric = value.toObject();
+        baselineMetrics.insert(metric["name"].toString(), metric);
+    }
+
+    for (const QJsonValue& value : current["metrics"].toArray()) {
+        const QJsonObject metric = value.toObject();
+        const auto it = baselineMetrics.constFind(metric["name"].toString());
+        if (it == baselineMetrics.constEnd() || it.value()["value"].toDouble() <= 0.0) {
+            continue;
+        }
+
+        const double ratio = metric["value"].toDouble() / it.value()["value"].toDouble();
+        const bool worse = metric["higherIsBetter"].toBool() ? ratio < 1.0 - tolerance : ratio > 1.0 + tolerance;
+        if (worse) {
+            out << QString("  REGRESSION %1 %2 -> %3 %4\n")
+                .arg(metric["name"].toString(), -36)
+                .arg(it.value()["value"].toDouble(), 0, 'f', 1)
+                .arg(metric["value"].toDouble(), 0, 'f', 1)
+                .arg(metric["unit"].toString());
+            ++regressions;
+        }
+    }
+
+    out << (regressions == 0 ? QString("  no regressions\n") : QString("  %1 regression(s)\n").arg(regressions));
+    return regressions;
+}
@@ -0,0 +1,83 @@
+// benchmarks/BenchmarkHarness.h - Timing, reporting and baseline comparison for the benchmark suite
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QTextStream>
+#include <functional>
+
+/**
+ * @brief Runs named benchmarks and collects their results
+ *
+ * Each benchmark is repeated and reported by its median, so one unlucky run
+ * (a page fault, a context switch) doesn't read as a regression. Results go
+ * to a table for people and to JSON for comparing two builds: compare()
+ * flags every benchmark that got slower, and every capacity metric that got
+ * smaller, by more than the tolerance.
+ */
+class BenchmarkHarness
+{
+public:
+    struct Result {
+        QString name;
+        int size = 0;               // Items per run (cues, frames, commands...)
+        int repetitions = 0;
+        qint64 medianNs = 0;
+        qint64 minNs = 0;
+        qint64 maxNs = 0;
+
+        double perItemNs() const { return size > 0 ? static_cast<double>(medianNs) / size : 0.0; }
+    };
+
+    /**
+     * @brief A figure that isn't a duration, e.g. voices before dropout
+     */
+    struct Metric {
+        QString name;
+        double value = 0.0;
+        QString unit;
+        bool higherIsBetter = true;
+    };
+
+    /**
+     * @param filter Only benchmarks whose name contains this run (empty: all)
+     */
+    BenchmarkHarness(QTextStream& out, const QString& filter, int repetitions);
+
+    bool isSelected(const QString& name) const;
+    int repetitions() const { return repetitions_; }
+
+    /**
+     * @brief Time a benchmark
+     * @param run One repetition: does any untimed setup itself and returns the nanoseconds of the timed part
+     */
+    void measure(const QString& name, int size, const std::function<qint64()>& run);
+    void addMetric(const Metric& metric);
+
+    const QList<Result>& results() const { return results_; }
+    const QList<Metric>& metrics() const { return metrics_; }
+
+    QJsonObject toJson() const;
+
+    /**
+     * @brief Report regressions of current against baseline (both toJson() output)
+     * @return Number of regressions
+     */
+    static int compare(const QJsonObject& baseline, const QJsonObject& current, double tolerance, QTextStream& out);
+
+private:
+    QTextStream& out_;
+    QString filter_;
+    int repetitions_;
+    QList<Result> results_;
+    QList<Metric> metrics_;
+
+    // Constants
+    static constexpr int SCHEMA_VERSION = 1;
+};
+
+// Suites (one translation unit each)
+void runCueManagerBenchmarks(BenchmarkHarness& harness, const QList<int>& sizes);
+void runEngineBenchmarks(BenchmarkHarness& harness);
+void runCapacityTest(BenchmarkHarness& harness, double sampleRate, int blockSize);
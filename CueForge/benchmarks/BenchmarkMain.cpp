@@ -0,0 +1,80 @@
+// benchmarks/BenchmarkMain.cpp - Benchmark suite entry point
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QTextStream>
+
+#include "BenchmarkHarness.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("CueForgeBenchmarks");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("CueForge microbenchmarks and voice capacity test");
+    parser.addHelpOption();
+
+    const QCommandLineOption jsonOption("json", "Write results as JSON to <file>.", "file");
+    const QCommandLineOption baselineOption("baseline", "Compare against an earlier --json report; exit 1 on regressions.", "file");
+    const QCommandLineOption toleranceOption("tolerance", "Allowed slowdown before a result counts as a regression (default 0.15).", "fraction", "0.15");
+    const QCommandLineOption filterOption("filter", "Only run benchmarks whose name contains <text>.", "text");
+    const QCommandLineOption repetitionsOption("repetitions", "Runs per benchmark; the median is reported (default 5).", "count", "5");
+    const QCommandLineOption quickOption("quick", "Only the 1k-cue sizes.");
+    const QCommandLineOption rateOption("rate", "Capacity test sample rate (default 48000).", "hz", "48000");
+    const QCommandLineOption blockOption("block", "Capacity test block size (default 256).", "frames", "256");
+    parser.addOptions({ jsonOption, baselineOption, toleranceOption, filterOption, repetitionsOption, quickOption,
+                        rateOption, blockOption });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    const double sampleRate = parser.value(rateOption).toDouble();
+    const int blockSize = parser.value(blockOption).toInt();
+    if (sampleRate <= 0.0 || blockSize <= 0) {
+        err << "--rate and --block must be positive\n";
+        return 2;
+    }
+
+    // Read the baseline first so a bad path fails before minutes of benchmarking
+    QJsonObject baseline;
+    if (parser.isSet(baselineOption)) {
+        QFile file(parser.value(baselineOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            err << "Cannot open baseline " << file.fileName() << ": " << file.errorString() << "\n";
+            return 2;
+        }
+        QJsonParseError parseError;
+        baseline = QJsonDocument::fromJson(file.readAll(), &parseError).object();
+        if (parseError.error != QJsonParseError::NoError) {
+            err << "Baseline " << file.fileName() << " is not valid JSON: " << parseError.errorString() << "\n";
+            return 2;
+        }
+    }
+
+    const QList<int> sizes = parser.isSet(quickOption) ? QList<int>{ 1000 } : QList<int>{ 1000, 10000 };
+
+    BenchmarkHarness harness(out, parser.value(filterOption), parser.value(repetitionsOption).toInt());
+    runCueManagerBenchmarks(harness, sizes);
+    runEngineBenchmarks(harness);
+    runCapacityTest(harness, sampleRate, blockSize);
+
+    const QJsonObject report = harness.toJson();
+    if (parser.isSet(jsonOption)) {
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            err << "Cannot write " << file.fileName() << ": " << file.errorString() << "\n";
+            return 2;
+        }
+        file.write(QJsonDocument(report).toJson());
+    }
+
+    if (parser.isSet(baselineOption)) {
+        return BenchmarkHarness::compare(baseline, report, parser.value(toleranceOption).toDouble(), out) > 0 ? 1 : 0;
+    }
+    return 0;
+}
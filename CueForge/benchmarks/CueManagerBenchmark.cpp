@@ -0,0 +1,186 @@
+// benchmarks/CueManagerBenchmark.cpp - CueManager bulk operation scaling
+#include "BenchmarkHarness.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <memory>
+
+#include "core/CueManager.h"
+
+namespace {
+
+const QStringList NAMES = { "Preshow music", "Thunder roll", "Door slam", "Rain loop", "Birdsong", "Car pass" };
+
+/**
+ * @brief Fill a manager with named audio cues and return their IDs in list order
+ */
+QStringList populate(CueManager& manager, int count)
+{
+    QStringList cueIds;
+    cueIds.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        cueIds.append(manager.addCue(CueType::Audio, { { "name", QString("%1 %2").arg(NAMES[i % NAMES.size()]).arg(i) } }));
+    }
+    return cueIds;
+}
+
+/**
+ * @brief Every other ID, so bulk operations touch cues spread across the list
+ */
+QStringList everyOther(const QStringList& cueIds)
+{
+    QStringList result;
+    result.reserve(cueIds.size() / 2 + 1);
+    for (int i = 0; i < cueIds.size(); i += 2) {
+        result.append(cueIds[i]);
+    }
+    return result;
+}
+
+void flushDeferredDeletes()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+/**
+ * @brief Fresh manager with size cues for each repetition; the fill isn't timed
+ */
+struct Fixture {
+    explicit Fixture(int size)
+        : manager(std::make_unique<CueManager>())
+        , cueIds(populate(*manager, size))
+        , half(everyOther(cueIds))
+    {
+    }
+
+    ~Fixture()
+    {
+        manager.reset();
+        flushDeferredDeletes();
+    }
+
+    std::unique_ptr<CueManager> manager;
+    QStringList cueIds;
+    QStringList half;
+};
+
+} // namespace
+
+void runCueManagerBenchmarks(BenchmarkHarness& harness, const QList<int>& sizes)
+{
+    // Linear scaling shows up as a flat ns/item column across sizes
+    for (int size : sizes) {
+        QElapsedTimer timer;
+
+        harness.measure("cues.add", size, [&]() {
+            CueManager manager;
+            timer.start();
+            populate(manager, size);
+            const qint64 elapsed = timer.nsecsElapsed();
+            return elapsed;
+        });
+
+        harness.measure("cues.select", size, [&]() {
+            Fixture fixture(size);
+            timer.start();
+            fixture.manager->selectCues(fixture.half);
+            fixture.manager->getSelectedCues();
+            for (const QString& cueId : std::as_const(fixture.cueIds)) {
+                fixture.manager->isCueSelected(cueId);
+            }
+            return timer.nsecsElapsed();
+        });
+
+        harness.measure("cues.move", size, [&]() {
+            Fixture fixture(size);
+            timer.start();
+            fixture.manager->moveCues(fixture.half, 0);
+            return timer.nsecsElapsed();
+        });
+
+        harness.measure("cues.group", size, [&]() {
+            Fixture fixture(size);
+            timer.start();
+            fixture.manager->createGroupFromCues(fixture.half.mid(0, fixture.half.size() / 2));
+            return timer.nsecsElapsed();
+        });
+
+        harness.measure("cues.remove", size, [&]() {
+            Fixture fixture(size);
+            timer.start();
+            fixture.manager->removeCues(fixture.half);
+            return timer.nsecsElapsed();
+        });
+
+        // Undo puts the removed half back in one splice
+        harness.measure("cues.restore", size, [&]() {
+            Fixture fixture(size);
+            fixture.manager->removeCues(fixture.half);
+            timer.start();
+            fixture.manager->undo();
+            return timer.nsecsElapsed();
+        });
+
+        // Search and the flattened view run many times against one list
+        Fixture fixture(size);
+        const QString groupId = fixture.manager->createGroupFromCues(fixture.half.mid(0, fixture.half.size() / 4));
+
+        BenchmarkHarness::Metric memory;
+        memory.name = QString("cues.memory@%1").arg(size);
+        memory.value = static_cast<double>(fixture.manager->getCueStatistics().bytesPerCue);
+        memory.unit = "bytes per cue";
+        memory.higherIsBetter = false;
+        harness.addMetric(memory);
+
+        harness.measure("cues.find", size, [&]() {
+            timer.start();
+            for (const QString& name : NAMES) {
+                fixture.manager->findCues(name.section(' ', 0, 0));
+            }
+            fixture.manager->findCues(QString::number(size / 2));
+            return timer.nsecsElapsed();
+        });
+
+        harness.measure("cues.flatten.cold", size, [&]() {
+            fixture.manager->toggleGroupExpansion(groupId);     // Invalidates the cached flattening
+            timer.start();
+            fixture.manager->getFlattenedCues();
+            return timer.nsecsElapsed();
+        });
+
+        harness.measure("cues.flatten.warm", size, [&]() {
+            fixture.manager->getFlattenedCues();
+            timer.start();
+            fixture.manager->getFlattenedCues();
+            return timer.nsecsElapsed();
+        });
+
+        // Workspace files, both formats
+        QTemporaryDir directory;
+        for (const QString& suffix : { QString("cueforge"), QString("json") }) {
+            const QString path = directory.filePath(QString("benchmark.%1").arg(suffix));
+
+            harness.measure(QString("workspace.save.%1").arg(suffix), size, [&]() {
+                timer.start();
+                fixture.manager->saveWorkspaceAs(path);
+                return timer.nsecsElapsed();
+            });
+
+            harness.measure(QString("workspace.load.%1").arg(suffix), size, [&]() {
+                if (!QFileInfo::exists(path)) {
+                    fixture.manager->saveWorkspaceAs(path);    // Save was filtered out
+                }
+                CueManager manager;
+                timer.start();
+                manager.openWorkspace(path);
+                const qint64 elapsed = timer.nsecsElapsed();
+                return elapsed;
+            });
+            flushDeferredDeletes();
+        }
+    }
+}
@@ -0,0 +1,264 @@
+// benchmarks/EngineBenchmark.cpp - Mix kernel, command round-trip and voice capacity
+#include "BenchmarkHarness.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "audio/AudioCommandQueue.h"
+#include "audio/CallbackProfiler.h"
+#include "audio/DecodedAudio.h"
+#include "audio/JuceAudioBridge.h"
+#include "audio/MixKernel.h"
+
+namespace {
+
+constexpr int KERNEL_FRAMES = 512;
+constexpr int KERNEL_PASSES = 2000;
+constexpr int ROUND_TRIPS = 1000;
+constexpr int CAPACITY_LIMIT = 256;             // Voices acquired up front; the engine may allow fewer
+constexpr int CAPACITY_WARMUP_BLOCKS = 4;
+constexpr int CAPACITY_MEASURE_BLOCKS = 64;
+constexpr double TWO_PI = 6.283185307179586;
+
+/**
+ * @brief Device output buffers for driving the callback by hand
+ */
+struct OutputBuffers {
+    OutputBuffers(int numChannels, int numFrames)
+        : storage(static_cast<std::size_t>(numChannels) * numFrames, 0.0f)
+        , channels(static_cast<std::size_t>(numChannels))
+    {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            channels[channel] = storage.data() + static_cast<std::size_t>(channel) * numFrames;
+        }
+    }
+
+    std::vector<float> storage;
+    std::vector<float*> channels;
+};
+
+/**
+ * @brief RAM-resident stereo tone, a stand-in for a decoded file
+ */
+std::unique_ptr<DecodedAudio> makeTone(double sampleRate, std::int64_t numFrames, double frequency)
+{
+    auto audio = std::make_unique<DecodedAudio>();
+    audio->numChannels = 2;
+    audio->sampleRate = sampleRate;
+    audio->sourceSampleRate = sampleRate;
+    audio->numFrames = numFrames;
+    audio->totalFrames = numFrames;
+    audio->samples.resize(static_cast<std::size_t>(numFrames) * 2);
+
+    for (std::int64_t frame = 0; frame < numFrames; ++frame) {
+        const float sample = 0.1f * static_cast<float>(std::sin(TWO_PI * frequency * frame / sampleRate));
+        audio->channel(0)[frame] = sample;
+        audio->channel(1)[frame] = sample;
+    }
+    return audio;
+}
+
+AudioCommand playCommand(int cueHandle)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Play;
+    command.cueHandle = cueHandle;
+    return command;
+}
+
+/**
+ * @brief Worst callback time over a run of blocks with the first numVoices playing
+ */
+qint64 worstBlockNs(JuceAudioBridge& bridge, OutputBuffers& buffers, const QList<int>& handles, int numVoices,
+                    int blockSize, int& activeVoices)
+{
+    AudioCommand stopAll;
+    stopAll.type = AudioCommandType::StopAll;
+    bridge.postCommand(stopAll);
+    bridge.processAudioBlock(buffers.channels.data(), static_cast<int>(buffers.channels.size()), blockSize);
+    bridge.dispatchAudioEvents();
+
+    for (int i = 0; i < numVoices; ++i) {
+        bridge.postCommand(playCommand(handles[i]));
+    }
+    for (int block = 0; block < CAPACITY_WARMUP_BLOCKS; ++block) {
+        bridge.processAudioBlock(buffers.channels.data(), static_cast<int>(buffers.channels.size()), blockSize);
+    }
+    bridge.dispatchAudioEvents();
+
+    qint64 worst = 0;
+    QElapsedTimer timer;
+    for (int block = 0; block < CAPACITY_MEASURE_BLOCKS; ++block) {
+        timer.start();
+        bridge.processAudioBlock(buffers.channels.data(), static_cast<int>(buffers.channels.size()), blockSize);
+        worst = std::max(worst, timer.nsecsElapsed());
+    }
+    activeVoices = bridge.getProfiler()->lastRecord().activeVoices;
+
+    // Keep the event queue from filling up between trials
+    bridge.dispatchAudioEvents();
+    return worst;
+}
+
+} // namespace
+
+void runEngineBenchmarks(BenchmarkHarness& harness)
+{
+    QElapsedTimer timer;
+
+    // Crosspoint mix kernel: routes x frames multiply-adds per pass
+    {
+        std::vector<float> destination(KERNEL_FRAMES, 0.0f);
+        for (int numRoutes : { 2, 8, 16 }) {
+            std::vector<std::vector<float>> sources(numRoutes, std::vector<float>(KERNEL_FRAMES));
+            std::vector<MixKernel::Route> routes(numRoutes);
+            for (int route = 0; route < numRoutes; ++route) {
+                for (int frame = 0; frame < KERNEL_FRAMES; ++frame) {
+                    sources[route][frame] = static_cast<float>(std::sin(0.01 * (frame + route)));
+                }
+                routes[route].source = sources[route].data();
+                routes[route].gain = 0.5f;
+                routes[route].gainStep = 1.0e-5f;
+            }
+
+            harness.measure(QString("mix.kernel.routes%1").arg(numRoutes), numRoutes * KERNEL_FRAMES * KERNEL_PASSES, [&]() {
+                timer.start();
+                for (int pass = 0; pass < KERNEL_PASSES; ++pass) {
+                    MixKernel::accumulateRamped(destination.data(), routes.data(), numRoutes, KERNEL_FRAMES);
+                }
+                return timer.nsecsElapsed();
+            });
+        }
+    }
+
+    // Command round-trip: post on the main thread, apply in the callback, signal back
+    if (harness.isSelected("engine.roundtrip")) {
+        JuceAudioBridge bridge;
+        bridge.setFreewheel(true);
+        bridge.prepareAudio(48000.0, 64);
+        OutputBuffers buffers(2, 64);
+
+        quint32 received = 0;
+        QObject::connect(&bridge, &JuceAudioBridge::scheduledDeadline, [&received](quint32 markerId) {
+            received = markerId;
+        });
+
+        quint32 nextMarker = 0;
+        harness.measure("engine.roundtrip", ROUND_TRIPS, [&]() {
+            timer.start();
+            for (int i = 0; i < ROUND_TRIPS; ++i) {
+                AudioCommand marker;
+                marker.type = AudioCommandType::Marker;
+                marker.markerId = ++nextMarker;
+                bridge.postCommand(marker);
+
+                bridge.processAudioBlock(buffers.channels.data(), 2, 64);
+                bridge.dispatchAudioEvents();
+                while (received != nextMarker) {
+                    bridge.processAudioBlock(buffers.channels.data(), 2, 64);
+                    bridge.dispatchAudioEvents();
+                }
+            }
+            return timer.nsecsElapsed();
+        });
+    }
+}
+
+void runCapacityTest(BenchmarkHarness& harness, double sampleRate, int blockSize)
+{
+    if (!harness.isSelected("capacity")) {
+        return;
+    }
+
+    JuceAudioBridge bridge;
+    bridge.setFreewheel(true);
+    bridge.prepareAudio(sampleRate, blockSize);
+    OutputBuffers buffers(2, blockSize);
+
+    // Long enough that no voice finishes inside a trial
+    const std::int64_t toneFrames = static_cast<std::int64_t>(CAPACITY_WARMUP_BLOCKS + CAPACITY_MEASURE_BLOCKS + 2) * blockSize;
+
+    QList<int> handles;
+    for (int i = 0; i < CAPACITY_LIMIT; ++i) {
+        const QString cueId = QString("capacity-%1").arg(i);
+        const int handle = bridge.acquireCueHandle(cueId);
+        if (handle < 0) {
+            break;      // Engine voice limit
+        }
+        if (!bridge.attachDecodedAudio(cueId, makeTone(sampleRate, toneFrames, 220.0 + i))) {
+            break;      // Command queue full
+        }
+        handles.append(handle);
+
+        // Apply attachments as we go so the command queue never backs up
+        if (handles.size() % 64 == 0) {
+            bridge.processAudioBlock(buffers.channels.data(), 2, blockSize);
+        }
+    }
+    bridge.processAudioBlock(buffers.channels.data(), 2, blockSize);
+    if (handles.isEmpty()) {
+        qWarning() << "Capacity test: no voices could be attached";
+        return;
+    }
+
+    // A block that takes longer than its own duration is a dropout on a real device
+    const qint64 budgetNs = static_cast<qint64>(1.0e9 * blockSize / sampleRate);
+    auto fits = [&](int numVoices, qint64& worst) {
+        int activeVoices = 0;
+        worst = worstBlockNs(bridge, buffers, handles, numVoices, blockSize, activeVoices);
+        return worst < budgetNs && activeVoices == numVoices;
+    };
+
+    // Double until a trial misses the budget, then bisect between the last pass and the miss
+    int passed = 0;
+    int failed = handles.size() + 1;
+    qint64 worstAtPassed = 0;
+    qint64 worst = 0;
+    for (int numVoices = 1; numVoices <= handles.size(); numVoices = std::min(numVoices * 2, static_cast<int>(handles.size()))) {
+        if (!fits(numVoices, worst)) {
+            failed = numVoices;
+            break;
+        }
+        passed = numVoices;
+        worstAtPassed = worst;
+        if (numVoices == handles.size()) {
+            break;
+        }
+    }
+    while (failed - passed > 1 && failed <= handles.size()) {
+        const int middle = (passed + failed) / 2;
+        if (fits(middle, worst)) {
+            passed = middle;
+            worstAtPassed = worst;
+        }
+        else {
+            failed = middle;
+        }
+    }
+
+    BenchmarkHarness::Metric voices;
+    voices.name = QString("capacity.voices@%1/%2").arg(blockSize).arg(sampleRate, 0, 'f', 0);
+    voices.value = passed;
+    voices.unit = passed == handles.size() ? QString("voices (engine limit, no dropout)") : QString("voices");
+    harness.addMetric(voices);
+
+    // Per-voice cost stays comparable when the limit, not the CPU, capped the count
+    BenchmarkHarness::Metric cost;
+    cost.name = QString("capacity.voiceCost@%1/%2").arg(blockSize).arg(sampleRate, 0, 'f', 0);
+    cost.value = passed > 0 ? static_cast<double>(worstAtPassed) / passed : 0.0;
+    cost.unit = "ns per voice per block";
+    cost.higherIsBetter = false;
+    harness.addMetric(cost);
+
+    AudioCommand stopAll;
+    stopAll.type = AudioCommandType::StopAll;
+    bridge.postCommand(stopAll);
+    bridge.processAudioBlock(buffers.channels.data(), 2, blockSize);
+    bridge.dispatchAudioEvents();
+}
@@ -5,12 +5,10 @@
 #include <QStandardPaths>
 #include <QFileInfo>
 #include <QMessageBox>
-#include <QSplashScreen>
-#include <QPixmap>
-#include <QTimer>
+#include <QElapsedTimer>
+#include <QSettings>
 
 #include "core/Application.h"
-#include "utils/Settings.h"
 
 // Function to load and apply stylesheet
 QString loadStyleSheet(const QString& filePath) {
@@ -50,6 +48,10 @@ bool checkSystemRequirements() {
 
 int main(int argc, char* argv[])
 {
+    // Startup stage timings are measured from here
+    QElapsedTimer launchTimer;
+    launchTimer.start();
+
     // Enable high DPI scaling
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
@@ -74,26 +76,12 @@ int main(int argc, char* argv[])
     // Setup application directories
     setupApplicationDirectories();
 
-    // Create splash screen
-    QPixmap splashPixmap(":/icons/cueforge_splash.png");
-    if (splashPixmap.isNull()) {
-        // Create a simple splash if image not found
-        splashPixmap = QPixmap(400, 300);
-        splashPixmap.fill(Qt::darkGray);
-    }
-
-    QSplashScreen splash(splashPixmap);
-    splash.show();
-
-    splash.showMessage("Loading CueForge...", Qt::AlignBottom | Qt::AlignCenter, Qt::white);
-    app.processEvents();
-
     // Set application style for professional look
     app.setStyle(QStyleFactory::create("Fusion"));
 
-    // Load and apply theme from settings
-    Settings settings;
-    QString theme = settings.value("ui/theme", "dark").toString();
+    // Theme straight from the settings file; the full Settings (defaults, validation) loads on a startup worker
+    const QSettings themeSettings(QSettings::IniFormat, QSettings::UserScope, app.organizationName(), app.applicationName());
+    QString theme = themeSettings.value("ui/theme", "dark").toString();
     QString styleSheetPath = QString(":/styles/cueforge-%1.qss").arg(theme);
     QString styleSheet = loadStyleSheet(styleSheetPath);
 
@@ -153,30 +141,15 @@ int main(int argc, char* argv[])
         )");
     }
 
-    splash.showMessage("Initializing audio engine...", Qt::AlignBottom | Qt::AlignCenter, Qt::white);
-    app.processEvents();
-
-    // Create and initialize CueForge application
+    // Create CueForge; the window appears on the first event-loop pass, the rest comes up in stages
     CueForgeApplication cueforge;
 
-    if (!cueforge.initialize()) {
-        splash.close();
+    if (!cueforge.initialize(launchTimer)) {
         QMessageBox::critical(nullptr, "Initialization Error",
-            "Failed to initialize CueForge. Please check your audio setup and try again.");
+            "Failed to initialize CueForge.");
         return 1;
     }
 
-    splash.showMessage("Starting CueForge...", Qt::AlignBottom | Qt::AlignCenter, Qt::white);
-    app.processEvents();
-
-    // Close splash screen after a brief delay
-    QTimer::singleShot(1000, &splash, &QSplashScreen::close);
-
     // Run the application
-    int result = cueforge.exec();
-
-    // Cleanup
-    splash.close();
-
-    return result;
+    return cueforge.exec();
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+// src/audio/AudioBackend.h - Handle-based engine interface with compile-time backend dispatch
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <cstdint>
+
+#include "FadeEngine.h"
+#include "GainMatrix.h"
+#include "Resampler.h"
+
+/**
+ * @brief Integer cue address, resolved once from the cue ID at registration
+ */
+using CueHandle = std::int32_t;
+constexpr CueHandle INVALID_CUE_HANDLE = -1;
+
+/**
+ * @brief One cue of a start set; every cue in the set starts on the same sample
+ */
+struct CueStart {
+    CueHandle handle = INVALID_CUE_HANDLE;
+    double startTime = 0.0;
+    double fadeInTime = 0.0;
+    FadeCurve curve = FadeCurve::Linear;
+};
+
+/**
+ * @brief Static (CRTP) interface every audio backend implements
+ *
+ * Cue IDs are turned into handles by registerCue() when a cue is armed and
+ * given back by releaseCue() once it is disarmed or has finished; everything
+ * on the transport path in between takes the handle, so a GO is no string
+ * conversion and no hash lookup. Calls resolve at compile time to the
+ * backend's *Handle hooks and inline away: there is no virtual dispatch.
+ *
+ * A backend derives from AudioBackend<Itself>, befriends it and provides:
+ *   CueHandle acquireHandle(const QString&), void releaseHandle(const QString&),
+ *   CueHandle findHandle(const QString&) const,
+ *   playHandle, stopHandle, pauseHandle, resumeHandle, fadeHandle,
+ *   setCrosspointHandle, setInputLevelHandle, setMatrixHandle, setSpeedHandle,
+ *   setOutputLevelAll, stopAllHandles and playSetHandles, with the signatures used below.
+ */
+template <typename Backend>
+class AudioBackend
+{
+public:
+    // Registration (main thread): the only place a cue ID is looked at
+    CueHandle registerCue(const QString& cueId) { return backend().acquireHandle(cueId); }
+    void releaseCue(const QString& cueId) { backend().releaseHandle(cueId); }
+    CueHandle handleFor(const QString& cueId) const { return backend().findHandle(cueId); }
+
+    // Transport
+    bool play(CueHandle handle, double startTime = 0.0, double fadeInTime = 0.0, FadeCurve curve = FadeCurve::Linear)
+    {
+        return isValid(handle) && backend().playHandle(handle, startTime, fadeInTime, curve);
+    }
+
+    bool stop(CueHandle handle, double fadeOutTime = 0.0, FadeCurve curve = FadeCurve::Linear)
+    {
+        return isValid(handle) && backend().stopHandle(handle, fadeOutTime, curve);
+    }
+
+    bool pause(CueHandle handle) { return isValid(handle) && backend().pauseHandle(handle); }
+    bool resume(CueHandle handle) { return isValid(handle) && backend().resumeHandle(handle); }
+
+    bool fade(CueHandle handle, float level, double duration, FadeCurve curve = FadeCurve::Linear)
+    {
+        return isValid(handle) && backend().fadeHandle(handle, level, duration, curve);
+    }
+
+    // All or nothing: the set is one engine command, so no cue can start a block late
+    bool playTogether(const QVector<CueStart>& starts) { return backend().playSetHandles(starts); }
+
+    void stopAll(double fadeOutTime = 0.0, FadeCurve curve = FadeCurve::Linear)
+    {
+        backend().stopAllHandles(fadeOutTime, curve);
+    }
+
+    // Routing and levels
+    bool setCrosspoint(CueHandle handle, int input, int output, float level)
+    {
+        return isValid(handle) && backend().setCrosspointHandle(handle, input, output, level);
+    }
+
+    bool setInputLevel(CueHandle handle, int input, float level)
+    {
+        return isValid(handle) && backend().setInputLevelHandle(handle, input, level);
+    }
+
+    bool setMatrix(CueHandle handle, const GainMatrix& matrix)
+    {
+        return isValid(handle) && backend().setMatrixHandle(handle, matrix);
+    }
+
+    bool setSpeed(CueHandle handle, double speed, ResamplerQuality quality = ResamplerQuality::Standard)
+    {
+        return isValid(handle) && backend().setSpeedHandle(handle, speed, quality);
+    }
+
+    bool setBusLevel(int output, float level) { return backend().setOutputLevelAll(output, level); }
+
+    static constexpr bool isValid(CueHandle handle) { return handle >= 0; }
+
+protected:
+    AudioBackend() = default;
+    ~AudioBackend() = default;      // Never deleted through the interface
+
+private:
+    Backend& backend() { return static_cast<Backend&>(*this); }
+    const Backend& backend() const { return static_cast<const Backend&>(*this); }
+};
+
+// Backend chosen at build time (CMake: CUEFORGE_USE_TRACKTION_ENGINE)
+#if CUEFORGE_USE_TRACKTION_ENGINE
+class TracktionAudioEngine;
+using ActiveAudioBackend = TracktionAudioEngine;
+#else
+class JuceAudioBridge;
+using ActiveAudioBackend = JuceAudioBridge;
+#endif
@@ -0,0 +1,338 @@
+// src/audio/AudioCommandQueue.h - Lock-free command and event queues for the audio thread
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct CompiledPatch;
+struct DecodedAudio;
+struct GainMatrix;
+class Resampler;
+struct StartSet;
+
+/**
+ * @brief Commands sent from the UI/control threads to the audio callback
+ */
+enum class AudioCommandType : std::uint8_t {
+    AttachVoice,    // Reset voice state for a newly acquired cue handle (generation = the handle's new generation)
+    ReleaseVoice,   // Cue handle released, voice goes idle
+    AttachAudio,    // Hand a decoded region to the voice (audio = buffer)
+    Play,           // Start playback (time = start offset, duration = fade-in)
+    Stop,           // Stop playback (duration = fade-out)
+    Pause,          // Pause at current position
+    Resume,         // Resume from paused position
+    StopAll,        // Stop every voice (duration = fade-out)
+    Fade,           // Ramp voice gain, or one crosspoint when input/output are set (level = target, duration = fade time)
+    SetMatrix,      // Replace the voice's gain matrix (matrix = snapshot)
+    SetCrosspoint,  // Matrix crosspoint (input, output, level)
+    SetInputLevel,  // Per-input trim (input, level)
+    SetOutputLevel, // Cue output level (output, level)
+    Marker,         // Post a Deadline event (markerId) when reached
+    CancelScheduled,// Drop scheduled commands (token, 0 = all)
+    SetSpeed,       // Varispeed (level = speed, resampler = replacement instance or null to keep the current one)
+    PlaySet,        // Start every voice in startSet on the same sample (returned via the start-set retire queue)
+    SetPatch        // Replace the output patch (patch = compiled routes, returned via the patch retire queue)
+};
+
+/**
+ * @brief Fixed-size, trivially copyable command payload
+ *
+ * Cues are addressed by integer handle so nothing in the payload owns heap
+ * memory; pushing and popping is a plain struct copy.
+ */
+struct AudioCommand {
+    AudioCommandType type = AudioCommandType::Stop;
+    std::int32_t cueHandle = -1;
+    std::int32_t input = -1;
+    std::int32_t output = -1;
+    float level = 0.0f;
+    double time = 0.0;          // Seconds (start offset)
+    double duration = 0.0;      // Seconds (fade length)
+    std::uint8_t curve = 0;     // FadeCurve of a Play/Stop/StopAll/Fade ramp
+    std::int64_t timestampNs = 0;           // steady_clock time the command was issued
+    const DecodedAudio* audio = nullptr;    // AttachAudio payload (ownership passes to the engine)
+    const GainMatrix* matrix = nullptr;     // SetMatrix payload (returned via the matrix retire queue)
+    Resampler* resampler = nullptr;         // SetSpeed payload (returned via the resampler retire queue)
+    StartSet* startSet = nullptr;           // PlaySet payload (returned via the start-set retire queue)
+    const CompiledPatch* patch = nullptr;   // SetPatch payload (returned via the patch retire queue)
+    std::int64_t atSample = -1;             // Audio-clock deadline, -1 = next block
+    std::uint32_t token = 0;                // Scheduling group, for cancellation
+    std::uint32_t markerId = 0;             // Marker payload
+    std::uint32_t generation = 0;           // AttachVoice: stamped on every event the voice posts
+};
+
+/**
+ * @brief Voices a single PlaySet command starts together
+ *
+ * Filled on the control thread before posting and only read by the
+ * callback, except that releasing a voice blanks its entry in sets still
+ * waiting on the timeline.
+ */
+struct StartSet {
+    struct Entry {
+        std::int32_t cueHandle = -1;
+        double time = 0.0;          // Start offset (seconds)
+        double duration = 0.0;      // Fade-in (seconds)
+        std::uint8_t curve = 0;     // FadeCurve of the fade-in
+    };
+
+    std::vector<Entry> entries;
+};
+
+/**
+ * @brief Events sent back from the audio callback to the UI thread
+ */
+enum class AudioEventType : std::uint8_t {
+    Started,
+    Finished,
+    Paused,
+    Resumed,
+    Stopped,
+    Position,       // value = playback position in seconds
+    Underrun,       // Streamed voice ran out of read-ahead (value = position)
+    Deadline,       // Scheduled marker reached (value = markerId)
+    Dropout,        // Callback overran or started late (value = load, cueHandle = -1)
+    Error
+};
+
+struct AudioEvent {
+    AudioEventType type = AudioEventType::Position;
+    std::int32_t cueHandle = -1;
+    std::uint32_t generation = 0;   // Handle generation when posted; stale ones belong to a previous owner
+    double value = 0.0;
+};
+
+static_assert(std::is_trivially_copyable<AudioCommand>::value, "AudioCommand must stay POD");
+static_assert(std::is_trivially_copyable<AudioEvent>::value, "AudioEvent must stay POD");
+
+/**
+ * @brief Bounded lock-free multi-producer queue of trivially copyable items
+ *
+ * Cell-sequence ring (Vyukov). Producers never block; a full ring rejects the
+ * push and bumps droppedCount(). The consumer side never allocates or waits,
+ * so it is safe to drain from the audio callback.
+ */
+template <typename T, std::size_t Capacity>
+class LockFreeQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+        "LockFreeQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+        "LockFreeQueue items must be trivially copyable");
+
+public:
+    LockFreeQueue()
+    {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    /**
+     * @brief Enqueue an item
+     * @return false if the ring is full (item dropped)
+     */
+    bool push(const T& item)
+    {
+        std::size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        for (;;) {
+            cell = &cells_[position & INDEX_MASK];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+            if (difference == 0) {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->item = item;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue an item
+     * @return false if the ring is empty
+     */
+    bool pop(T& item)
+    {
+        std::size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        for (;;) {
+            cell = &cells_[position & INDEX_MASK];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+            if (difference == 0) {
+                if (dequeuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = dequeuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = cell->item;
+        cell->sequence.store(position + INDEX_MASK + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop up to maxItems items, invoking handler for each
+     * @return Number of items handled
+     */
+    template <typename Handler>
+    std::size_t drain(Handler&& handler, std::size_t maxItems = Capacity)
+    {
+        std::size_t handled = 0;
+        T item;
+        while (handled < maxItems && pop(item)) {
+            handler(item);
+            ++handled;
+        }
+        return handled;
+    }
+
+    // Approximate while producers are active
+    bool isEmpty() const
+    {
+        return enqueuePosition_.load(std::memory_order_acquire) == dequeuePosition_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+    std::uint64_t droppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    static constexpr std::size_t INDEX_MASK = Capacity - 1;
+
+    std::array<Cell, Capacity> cells_;
+    alignas(64) std::atomic<std::size_t> enqueuePosition_{ 0 };
+    alignas(64) std::atomic<std::size_t> dequeuePosition_{ 0 };
+    alignas(64) std::atomic<std::uint64_t> droppedCount_{ 0 };
+};
+
+/**
+ * @brief Retirement channel from the audio callback back to the main thread
+ *
+ * Wraps a LockFreeQueue with a backlog only the audio thread touches. When the
+ * main thread falls behind and the ring fills, a retired pointer is parked in
+ * the backlog rather than lost, and flush() moves it across once the ring has
+ * room again. Only a backlog that is itself full (the main thread stalled for
+ * two ring's worth of retirements) gives an item up, and that bumps lostCount().
+ */
+template <typename T, std::size_t Capacity>
+class RetireQueue
+{
+public:
+    RetireQueue() = default;
+    RetireQueue(const RetireQueue&) = delete;
+    RetireQueue& operator=(const RetireQueue&) = delete;
+
+    /**
+     * @brief Hand an item back to the main thread (audio thread only)
+     * @return true if the item reached the ring now, false if it was parked
+     */
+    bool retire(const T& item)
+    {
+        flush();
+        if (backlogSize_ == 0 && ring_.push(item)) {
+            return true;
+        }
+        if (backlogSize_ < Capacity) {
+            backlog_[backlogSize_++] = item;
+        }
+        else {
+            lostCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Move parked items into the ring, oldest first (audio thread only)
+     * @return true if any item moved
+     */
+    bool flush()
+    {
+        std::size_t moved = 0;
+        while (moved < backlogSize_ && ring_.push(backlog_[moved])) {
+            ++moved;
+        }
+        if (moved > 0) {
+            for (std::size_t i = moved; i < backlogSize_; ++i) {
+                backlog_[i - moved] = backlog_[i];
+            }
+            backlogSize_ -= moved;
+        }
+        return moved > 0;
+    }
+
+    /**
+     * @brief Consume whatever has reached the ring (main thread)
+     */
+    template <typename Handler>
+    std::size_t drain(Handler&& handler)
+    {
+        return ring_.drain(std::forward<Handler>(handler));
+    }
+
+    /**
+     * @brief Consume the ring and the backlog; only once the audio thread has stopped
+     */
+    template <typename Handler>
+    std::size_t drainAll(Handler&& handler)
+    {
+        std::size_t handled = ring_.drain(handler);
+        for (std::size_t i = 0; i < backlogSize_; ++i) {
+            handler(backlog_[i]);
+        }
+        handled += backlogSize_;
+        backlogSize_ = 0;
+        return handled;
+    }
+
+    std::uint64_t lostCount() const { return lostCount_.load(std::memory_order_relaxed); }
+
+private:
+    LockFreeQueue<T, Capacity> ring_;
+    std::array<T, Capacity> backlog_{};
+    std::size_t backlogSize_ = 0;
+    std::atomic<std::uint64_t> lostCount_{ 0 };
+};
+
+// Queue sizes: commands are bursty (GO hammering), events include position updates
+using AudioCommandQueue = LockFreeQueue<AudioCommand, 1024>;
+using AudioEventQueue = LockFreeQueue<AudioEvent, 4096>;
+using AudioRetireQueue = RetireQueue<const DecodedAudio*, 1024>;      // Buffers the callback has let go of
+using MatrixRetireQueue = RetireQueue<const GainMatrix*, 1024>;        // Matrix snapshots already copied in
+using ResamplerRetireQueue = RetireQueue<Resampler*, 256>;             // Varispeed resamplers a voice dropped
+using StartSetRetireQueue = RetireQueue<StartSet*, 256>;               // Start sets the callback has applied or dropped
+using PatchRetireQueue = RetireQueue<const CompiledPatch*, 64>;        // Output patches the callback has replaced
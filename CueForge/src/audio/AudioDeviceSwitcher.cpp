@@ -0,0 +1,881 @@
+// src/audio/AudioDeviceSwitcher.cpp - Hot device switching and standby failover
+#include "AudioDeviceSwitcher.h"
+
+#include <QDebug>
+#include <QMetaObject>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <juce_audio_devices/juce_audio_devices.h>
+
+#include "JuceAudioBridge.h"
+
+namespace {
+
+constexpr double DEFAULT_SAMPLE_RATE = 48000.0;
+
+QString toQt(const juce::String& text)
+{
+    return QString::fromUtf8(text.toRawUTF8());
+}
+
+juce::String toJuce(const QString& text)
+{
+    return juce::String::fromUTF8(text.toUtf8().constData());
+}
+
+void clearOutputs(float* const* outputChannels, int firstChannel, int numChannels, int numSamples)
+{
+    for (int channel = firstChannel; channel < numChannels; ++channel) {
+        if (outputChannels[channel]) {
+            std::fill(outputChannels[channel], outputChannels[channel] + numSamples, 0.0f);
+        }
+    }
+}
+
+// Linear gain ramp across the whole block, in place
+void applyRamp(float* const* outputChannels, int numChannels, int numSamples, float from, float to)
+{
+    const float step = numSamples > 0 ? (to - from) / static_cast<float>(numSamples) : 0.0f;
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* samples = outputChannels[channel];
+        if (!samples) {
+            continue;
+        }
+        float gain = from;
+        for (int i = 0; i < numSamples; ++i) {
+            samples[i] *= gain;
+            gain += step;
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief One open device and the callback state the hand-off protocol reads
+ */
+class AudioDeviceSwitcher::DeviceSlot : public juce::AudioIODeviceCallback
+{
+public:
+    DeviceSlot(AudioDeviceSwitcher& switcher, int slotIndex)
+        : index(slotIndex)
+        , switcher_(switcher)
+    {
+    }
+
+    void audioDeviceIOCallbackWithContext(const float* const* inputChannelData,
+        int numInputChannels,
+        float* const* outputChannelData,
+        int numOutputChannels,
+        int numSamples,
+        const juce::AudioIODeviceCallbackContext& context) override
+    {
+        juce::ignoreUnused(inputChannelData, numInputChannels, context);
+        switcher_.renderSlot(*this, outputChannelData, numOutputChannels, numSamples);
+    }
+
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override
+    {
+        const double rate = device->getCurrentSampleRate();
+        const int frames = device->getCurrentBufferSizeSamples();
+        periodNs.store(rate > 0.0 ? static_cast<std::int64_t>(frames * 1.0e9 / rate) : 0, std::memory_order_relaxed);
+        lastCallbackNs.store(0, std::memory_order_relaxed);
+    }
+
+    void audioDeviceStopped() override
+    {
+        if (!closing.load(std::memory_order_acquire)) {
+            reportError("Device stopped unexpectedly");
+        }
+    }
+
+    void audioDeviceError(const juce::String& message) override
+    {
+        reportError(toQt(message));
+    }
+
+    const int index;
+
+    // Main thread
+    std::unique_ptr<juce::AudioIODevice> device;
+    QString name;
+    std::vector<float*> subBlockChannels;       // Sized to the active outputs when opened
+
+    // Shared with the callbacks
+    std::atomic<bool> inRender{ false };
+    std::atomic<bool> failed{ false };
+    std::atomic<bool> fadeIn{ false };          // Next rendered block ramps up from silence
+    std::atomic<bool> closing{ false };         // Stop requested by us, not a failure
+    std::atomic<std::int64_t> lastCallbackNs{ 0 };
+    std::atomic<std::int64_t> periodNs{ 0 };
+
+private:
+    void reportError(const QString& message)
+    {
+        // The standby watches this flag; the main thread learns about it from the queued call
+        failed.store(true, std::memory_order_release);
+        const int slot = index;
+        QMetaObject::invokeMethod(&switcher_, [this, slot, message]() {
+            switcher_.onSlotError(slot, message);
+        }, Qt::QueuedConnection);
+    }
+
+    AudioDeviceSwitcher& switcher_;
+};
+
+/**
+ * @brief Owns the platform device types and forwards their device-change notifications
+ */
+class AudioDeviceSwitcher::TypeListener : public juce::AudioIODeviceType::Listener
+{
+public:
+    explicit TypeListener(AudioDeviceSwitcher& switcher)
+        : switcher_(switcher)
+    {
+        juce::AudioDeviceManager factory;
+        factory.createAudioDeviceTypes(types_);
+        for (juce::AudioIODeviceType* type : types_) {
+            type->scanForDevices();
+            type->addListener(this);
+        }
+    }
+
+    ~TypeListener() override
+    {
+        for (juce::AudioIODeviceType* type : types_) {
+            type->removeListener(this);
+        }
+    }
+
+    void audioDeviceListChanged() override
+    {
+        QMetaObject::invokeMethod(&switcher_, "onDeviceListChanged", Qt::QueuedConnection);
+    }
+
+    void rescan()
+    {
+        for (juce::AudioIODeviceType* type : types_) {
+            type->scanForDevices();
+        }
+    }
+
+    QStringList deviceNames() const
+    {
+        QStringList names;
+        for (juce::AudioIODeviceType* type : types_) {
+            for (const juce::String& name : type->getDeviceNames(false)) {
+                names.append(toQt(name));
+            }
+        }
+        return names;
+    }
+
+    juce::AudioIODeviceType* typeFor(const QString& deviceName) const
+    {
+        const juce::String name = toJuce(deviceName);
+        for (juce::AudioIODeviceType* type : types_) {
+            if (type->getDeviceNames(false).contains(name)) {
+                return type;
+            }
+        }
+        return nullptr;
+    }
+
+    QString defaultDeviceName() const
+    {
+        for (juce::AudioIODeviceType* type : types_) {
+            const juce::StringArray names = type->getDeviceNames(false);
+            const int index = type->getDefaultDeviceIndex(false);
+            if (index >= 0 && index < names.size()) {
+                return toQt(names[index]);
+            }
+        }
+        const QStringList names = deviceNames();
+        return names.isEmpty() ? QString() : names.first();
+    }
+
+    bool isEmpty() const { return types_.isEmpty(); }
+
+private:
+    AudioDeviceSwitcher& switcher_;
+    juce::OwnedArray<juce::AudioIODeviceType> types_;
+};
+
+AudioDeviceSwitcher::AudioDeviceSwitcher(JuceAudioBridge& engine, QObject* parent)
+    : QObject(parent)
+    , engine_(engine)
+    , slots_{ { std::make_unique<DeviceSlot>(*this, 0), std::make_unique<DeviceSlot>(*this, 1) } }
+    , typeListener_()
+    , owner_(NO_OWNER)
+    , handOffTarget_(NO_HAND_OFF)
+    , failoverEnabled_(true)
+    , claimNotifyPending_(false)
+    , passNotifyPending_(false)
+    , handOffTimer_(new QTimer(this))
+    , pendingHandOff_(NO_HAND_OFF)
+    , handOffDone_()
+    , queuedChanges_()
+    , primarySlot_(0)
+    , standbyName_()
+    , engineSampleRate_(0.0)
+    , engineBlockSize_(DEFAULT_BUFFER_SIZE)
+{
+    handOffTimer_->setSingleShot(true);
+    handOffTimer_->setInterval(HAND_OFF_TIMEOUT_MS);
+    connect(handOffTimer_, &QTimer::timeout, this, &AudioDeviceSwitcher::onHandOffTimeout);
+}
+
+AudioDeviceSwitcher::~AudioDeviceSwitcher()
+{
+    shutdown();
+}
+
+bool AudioDeviceSwitcher::initialize()
+{
+    if (!typeListener_) {
+        typeListener_ = std::make_unique<TypeListener>(*this);
+    }
+    return !typeListener_->isEmpty();
+}
+
+void AudioDeviceSwitcher::shutdown()
+{
+    // Whatever was waiting on a hand-off is abandoned with the devices
+    handOffTimer_->stop();
+    pendingHandOff_ = NO_HAND_OFF;
+    handOffDone_ = HandOffDone();
+    queuedChanges_.clear();
+    handOffTarget_.store(NO_HAND_OFF, std::memory_order_release);
+
+    owner_.store(NO_OWNER, std::memory_order_release);
+    closeSlot(0);
+    closeSlot(1);
+    typeListener_.reset();
+}
+
+// Queries
+
+QStringList AudioDeviceSwitcher::availableDevices() const
+{
+    return typeListener_ ? typeListener_->deviceNames() : QStringList();
+}
+
+QString AudioDeviceSwitcher::defaultDevice() const
+{
+    return typeListener_ ? typeListener_->defaultDeviceName() : QString();
+}
+
+QString AudioDeviceSwitcher::currentDevice() const
+{
+    return slotDeviceName(primarySlot_);
+}
+
+QString AudioDeviceSwitcher::standbyDevice() const
+{
+    return slotDeviceName(otherSlot(primarySlot_));
+}
+
+double AudioDeviceSwitcher::sampleRate() const
+{
+    return engineSampleRate_;
+}
+
+int AudioDeviceSwitcher::bufferSize() const
+{
+    const DeviceSlot& slot = *slots_[primarySlot_];
+    return slot.device ? slot.device->getCurrentBufferSizeSamples() : 0;
+}
+
+QList<int> AudioDeviceSwitcher::availableSampleRates() const
+{
+    QList<int> rates;
+    if (juce::AudioIODevice* device = slots_[primarySlot_]->device.get()) {
+        for (double rate : device->getAvailableSampleRates()) {
+            rates.append(static_cast<int>(std::lround(rate)));
+        }
+    }
+    return rates;
+}
+
+QList<int> AudioDeviceSwitcher::availableBufferSizes() const
+{
+    QList<int> sizes;
+    if (juce::AudioIODevice* device = slots_[primarySlot_]->device.get()) {
+        for (int size : device->getAvailableBufferSizes()) {
+            sizes.append(size);
+        }
+    }
+    return sizes;
+}
+
+bool AudioDeviceSwitcher::isOpen(int slot) const
+{
+    return slots_[slot]->device != nullptr;
+}
+
+QString AudioDeviceSwitcher::slotDeviceName(int slot) const
+{
+    return isOpen(slot) ? slots_[slot]->name : QString();
+}
+
+// Switching
+
+bool AudioDeviceSwitcher::switchTo(const QString& deviceName)
+{
+    if (!initialize() || deviceName.isEmpty()) {
+        return false;
+    }
+    if (isHandingOff()) {
+        queueChange([this, deviceName]() { switchTo(deviceName); });
+        return true;
+    }
+    if (deviceName == currentDevice()) {
+        return true;
+    }
+
+    // Nothing running yet: open, prepare the engine for it and start
+    if (!isOpen(primarySlot_)) {
+        const int slot = primarySlot_;
+        if (!openSlot(slot, deviceName, engineSampleRate_, engineBlockSize_)) {
+            return false;
+        }
+        prepareEngine(slot);
+        slots_[slot]->fadeIn.store(true, std::memory_order_relaxed);
+        owner_.store(slot, std::memory_order_release);
+        startSlot(slot);
+        emit currentDeviceChanged(deviceName);
+
+        if (!standbyName_.isEmpty() && standbyName_ != deviceName) {
+            setStandbyDevice(standbyName_);
+        }
+        return true;
+    }
+
+    const QString previous = currentDevice();
+    const int standby = otherSlot(primarySlot_);
+    const bool toStandby = slotDeviceName(standby) == deviceName;
+
+    // A device that isn't the standby borrows the standby slot for the switch
+    if (!toStandby) {
+        if (!openSlot(standby, deviceName, engineSampleRate_, engineBlockSize_)) {
+            if (!standbyName_.isEmpty() && openSlot(standby, standbyName_, engineSampleRate_, engineBlockSize_)) {
+                startSlot(standby);
+            }
+            return false;
+        }
+        startSlot(standby);
+    }
+
+    handOff(standby, [this, standby, toStandby, previous, deviceName](bool) {
+        const int old = otherSlot(standby);
+        if (toStandby) {
+            standbyName_ = previous;    // The pair swaps roles; redundancy is kept
+        }
+        else {
+            closeSlot(old);
+            if (standbyName_ == deviceName) {
+                standbyName_.clear();
+            }
+            if (!standbyName_.isEmpty() && openSlot(old, standbyName_, engineSampleRate_, engineBlockSize_)) {
+                startSlot(old);
+            }
+        }
+
+        qDebug() << "Audio output moved from" << previous << "to" << deviceName;
+        emit currentDeviceChanged(deviceName);
+        emit standbyDeviceChanged(standbyDevice());
+    });
+    return true;
+}
+
+bool AudioDeviceSwitcher::setStandbyDevice(const QString& deviceName)
+{
+    // The standby slot may be the hand-off's target right now
+    if (isHandingOff()) {
+        queueChange([this, deviceName]() { setStandbyDevice(deviceName); });
+        return true;
+    }
+
+    const int standby = otherSlot(primarySlot_);
+
+    if (deviceName.isEmpty()) {
+        closeSlot(standby);
+        standbyName_.clear();
+        emit standbyDeviceChanged(QString());
+        return true;
+    }
+    if (deviceName == currentDevice()) {
+        qWarning() << "Standby device must differ from the current device:" << deviceName;
+        return false;
+    }
+
+    // Opened at the engine's rate once there is a current device
+    standbyName_ = deviceName;
+    if (!isOpen(primarySlot_) || slotDeviceName(standby) == deviceName) {
+        return true;
+    }
+    if (!initialize() || !openSlot(standby, deviceName, engineSampleRate_, engineBlockSize_)) {
+        return false;
+    }
+    startSlot(standby);
+    emit standbyDeviceChanged(deviceName);
+    return true;
+}
+
+bool AudioDeviceSwitcher::setBufferSize(int bufferSize)
+{
+    if (!isOpen(primarySlot_) || bufferSize <= 0) {
+        return false;
+    }
+    if (isHandingOff()) {
+        queueChange([this, bufferSize]() { setBufferSize(bufferSize); });
+        return true;
+    }
+
+    const int primary = primarySlot_;
+    const int standby = otherSlot(primary);
+    const int previousSize = this->bufferSize();
+    const QString deviceName = currentDevice();
+
+    // The standby covers the reopen; the engine stays prepared and sub-blocks larger buffers
+    if (isOpen(standby) && !slots_[standby]->failed.load(std::memory_order_acquire)) {
+        handOff(standby, [this, primary, bufferSize, previousSize, deviceName](bool) {
+            if (!reopenSlot(primary, engineSampleRate_, bufferSize, engineSampleRate_, previousSize)) {
+                qWarning() << "Audio device" << deviceName << "refused a buffer of" << bufferSize << "samples";
+            }
+            if (isOpen(primary)) {
+                handOff(primary);
+            }
+            else {
+                emit currentDeviceChanged(currentDevice());     // Left on the standby
+            }
+        });
+        return true;
+    }
+
+    // No standby: silent for as long as the device takes to reopen
+    handOff(NO_OWNER, [this, primary, bufferSize, deviceName](bool) {
+        if (!reopenSlot(primary, engineSampleRate_, bufferSize, engineSampleRate_, engineBlockSize_)) {
+            qWarning() << "Audio device" << deviceName << "refused a buffer of" << bufferSize << "samples";
+        }
+        if (!isOpen(primary)) {
+            return;
+        }
+        prepareEngine(primary);
+        handOff(primary);
+    });
+    return true;
+}
+
+bool AudioDeviceSwitcher::setSampleRate(double sampleRate)
+{
+    if (!isOpen(primarySlot_) || sampleRate <= 0.0) {
+        return false;
+    }
+    if (isHandingOff()) {
+        queueChange([this, sampleRate]() { setSampleRate(sampleRate); });
+        return true;
+    }
+    if (std::abs(sampleRate - engineSampleRate_) < 0.5) {
+        return true;
+    }
+
+    const int primary = primarySlot_;
+    const int standby = otherSlot(primary);
+    const double previousRate = engineSampleRate_;
+    const int frames = bufferSize();
+    const QString deviceName = currentDevice();
+
+    // The engine only changes rate while nothing renders: one fade-out, re-prepare, fade-in
+    const auto changeOver = [this, primary, standby, sampleRate, previousRate, deviceName](bool) {
+        closeSlot(standby);     // Reopened below at the new rate; also waits out a stalled block
+        prepareEngine(primary);
+        handOff(primary);
+        reopenStandby();
+
+        if (std::abs(engineSampleRate_ - previousRate) >= 0.5) {
+            emit sampleRateChanged(engineSampleRate_);
+        }
+        if (std::abs(engineSampleRate_ - sampleRate) >= 0.5) {
+            qWarning() << "Audio device" << deviceName << "refused" << sampleRate << "Hz";
+        }
+    };
+
+    // The standby plays at the old rate while the current device reopens at the new one
+    if (isOpen(standby) && !slots_[standby]->failed.load(std::memory_order_acquire)) {
+        handOff(standby, [this, primary, sampleRate, previousRate, frames, deviceName, changeOver](bool) {
+            if (!reopenSlot(primary, sampleRate, frames, previousRate, engineBlockSize_)) {
+                qWarning() << "Audio device" << deviceName << "refused" << sampleRate << "Hz";
+                if (isOpen(primary)) {
+                    handOff(primary);
+                }
+                else {
+                    emit currentDeviceChanged(currentDevice());     // Left on the standby
+                }
+                return;
+            }
+            handOff(NO_OWNER, changeOver);
+        });
+        return true;
+    }
+
+    // No standby: silent for as long as the device takes to reopen
+    handOff(NO_OWNER, [this, primary, sampleRate, previousRate, frames, changeOver](bool passed) {
+        reopenSlot(primary, sampleRate, frames, previousRate, engineBlockSize_);
+        if (isOpen(primary)) {
+            changeOver(passed);
+        }
+    });
+    return true;
+}
+
+// Main-Thread Helpers
+
+bool AudioDeviceSwitcher::openSlot(int slot, const QString& deviceName, double sampleRate, int bufferSize)
+{
+    closeSlot(slot);
+
+    juce::AudioIODeviceType* type = typeListener_ ? typeListener_->typeFor(deviceName) : nullptr;
+    std::unique_ptr<juce::AudioIODevice> device(type ? type->createDevice(toJuce(deviceName), juce::String()) : nullptr);
+    if (!device) {
+        qWarning() << "Audio device not found:" << deviceName;
+        emit deviceError(deviceName, QString("Device not found"));
+        return false;
+    }
+
+    // First device picks the engine rate; every later one has to match it
+    double rate = sampleRate;
+    if (rate <= 0.0) {
+        const juce::Array<double> rates = device->getAvailableSampleRates();
+        rate = rates.contains(DEFAULT_SAMPLE_RATE) || rates.isEmpty() ? DEFAULT_SAMPLE_RATE : rates.getFirst();
+    }
+
+    juce::BigInteger outputs;
+    outputs.setRange(0, device->getOutputChannelNames().size(), true);
+    const juce::String error = device->open(juce::BigInteger(), outputs, rate, bufferSize);
+    if (error.isNotEmpty()) {
+        qWarning() << "Could not open audio device" << deviceName << ":" << toQt(error);
+        emit deviceError(deviceName, toQt(error));
+        return false;
+    }
+
+    if (sampleRate > 0.0 && std::abs(device->getCurrentSampleRate() - sampleRate) > 0.5) {
+        const QString message = QString("Runs at %1 Hz, engine is at %2 Hz")
+            .arg(device->getCurrentSampleRate()).arg(sampleRate);
+        qWarning() << "Audio device" << deviceName << "rejected:" << message;
+        device->close();
+        emit deviceError(deviceName, message);
+        return false;
+    }
+
+    DeviceSlot& target = *slots_[slot];
+    target.subBlockChannels.assign(static_cast<std::size_t>(device->getActiveOutputChannels().countNumberOfSetBits()), nullptr);
+    target.failed.store(false, std::memory_order_relaxed);
+    target.fadeIn.store(false, std::memory_order_relaxed);
+    target.name = deviceName;
+    target.device = std::move(device);
+    return true;
+}
+
+void AudioDeviceSwitcher::startSlot(int slot)
+{
+    DeviceSlot& target = *slots_[slot];
+    if (target.device) {
+        target.device->start(&target);
+    }
+}
+
+void AudioDeviceSwitcher::closeSlot(int slot)
+{
+    DeviceSlot& target = *slots_[slot];
+    if (!target.device) {
+        return;
+    }
+
+    // stop() returns once the callback has finished its last block
+    target.closing.store(true, std::memory_order_release);
+    target.device->stop();
+    target.device->close();
+    target.device.reset();
+    target.name.clear();
+    target.inRender.store(false, std::memory_order_relaxed);
+    target.closing.store(false, std::memory_order_release);
+
+    int owner = slot;
+    owner_.compare_exchange_strong(owner, NO_OWNER);
+}
+
+bool AudioDeviceSwitcher::reopenSlot(int slot, double sampleRate, int bufferSize, double fallbackRate, int fallbackSize)
+{
+    // Taken before the first attempt: a refused open leaves the slot closed and nameless
+    const QString deviceName = slotDeviceName(slot);
+    if (deviceName.isEmpty()) {
+        return false;
+    }
+
+    const bool opened = openSlot(slot, deviceName, sampleRate, bufferSize);
+    if (opened || (fallbackSize > 0 && openSlot(slot, deviceName, fallbackRate, fallbackSize))) {
+        startSlot(slot);
+    }
+    return opened;
+}
+
+void AudioDeviceSwitcher::prepareEngine(int slot)
+{
+    // Only while nothing renders: prepareAudio reallocates the engine's scratch
+    juce::AudioIODevice* device = slots_[slot]->device.get();
+    engineSampleRate_ = device->getCurrentSampleRate();
+    engineBlockSize_ = std::max(1, device->getCurrentBufferSizeSamples());
+    engine_.prepareAudio(engineSampleRate_, engineBlockSize_);
+}
+
+void AudioDeviceSwitcher::reopenStandby()
+{
+    const int standby = otherSlot(primarySlot_);
+    if (!standbyName_.isEmpty() && isOpen(primarySlot_)
+        && openSlot(standby, standbyName_, engineSampleRate_, engineBlockSize_)) {
+        startSlot(standby);
+    }
+    emit standbyDeviceChanged(standbyDevice());
+}
+
+void AudioDeviceSwitcher::handOff(int target, HandOffDone done)
+{
+    const int owner = ownerSlot();
+
+    // Nobody renders (or the target already does): the target takes over on its next block
+    if (owner == target || owner == NO_OWNER) {
+        if (owner != target && target >= 0) {
+            slots_[target]->fadeIn.store(true, std::memory_order_relaxed);
+            owner_.store(target, std::memory_order_release);
+        }
+        if (target >= 0) {
+            primarySlot_ = target;
+        }
+        if (done) {
+            done(true);
+        }
+        return;
+    }
+
+    // The owner fades its next block out, passes the engine on and acknowledges (onHandOffPassed)
+    pendingHandOff_ = target;
+    handOffDone_ = std::move(done);
+    handOffTimer_->start();
+    handOffTarget_.store(target, std::memory_order_release);
+}
+
+void AudioDeviceSwitcher::finishHandOff(bool passed)
+{
+    handOffTimer_->stop();
+    const int target = std::exchange(pendingHandOff_, NO_HAND_OFF);
+    if (target >= 0) {
+        primarySlot_ = target;
+    }
+
+    // The continuation may start the next hand-off of a sequence; queued changes wait for the end of it
+    HandOffDone done = std::exchange(handOffDone_, HandOffDone());
+    if (done) {
+        done(passed);
+    }
+    while (!isHandingOff() && !queuedChanges_.isEmpty()) {
+        queuedChanges_.takeFirst()();
+    }
+}
+
+void AudioDeviceSwitcher::queueChange(std::function<void()> change)
+{
+    queuedChanges_.append(std::move(change));
+}
+
+// Audio Thread
+
+bool AudioDeviceSwitcher::canClaim(const DeviceSlot& slot, int owner, std::int64_t nowNs) const
+{
+    if (owner < 0 || owner == slot.index || slot.failed.load(std::memory_order_relaxed)
+        || !failoverEnabled_.load(std::memory_order_relaxed)
+        || handOffTarget_.load(std::memory_order_relaxed) != NO_HAND_OFF) {
+        return false;
+    }
+
+    const DeviceSlot& current = *slots_[owner];
+    if (current.failed.load(std::memory_order_acquire)) {
+        return true;
+    }
+
+    // Silent failures: the owner's callbacks just stop arriving
+    const std::int64_t last = current.lastCallbackNs.load(std::memory_order_relaxed);
+    const std::int64_t period = std::max(current.periodNs.load(std::memory_order_relaxed),
+                                         slot.periodNs.load(std::memory_order_relaxed));
+    return last > 0 && period > 0 && nowNs - last > STALL_PERIODS * period;
+}
+
+void AudioDeviceSwitcher::renderSlot(DeviceSlot& slot, float* const* outputChannels, int numOutputChannels, int numSamples)
+{
+    const std::int64_t nowNs = JuceAudioBridge::steadyClockNs();
+    slot.lastCallbackNs.store(nowNs, std::memory_order_relaxed);
+
+    // seq_cst on both sides: a claimer either sees this render in progress, or we see its claim
+    slot.inRender.store(true, std::memory_order_seq_cst);
+
+    int owner = owner_.load(std::memory_order_seq_cst);
+    if (canClaim(slot, owner, nowNs) && owner_.compare_exchange_strong(owner, slot.index)) {
+        owner = slot.index;
+        slot.fadeIn.store(true, std::memory_order_relaxed);
+        if (!claimNotifyPending_.exchange(true, std::memory_order_acq_rel)) {
+            QMetaObject::invokeMethod(this, "onOwnerClaimed", Qt::QueuedConnection);
+        }
+    }
+
+    const DeviceSlot& other = *slots_[otherSlot(slot.index)];
+    if (owner != slot.index || other.inRender.load(std::memory_order_seq_cst)) {
+        clearOutputs(outputChannels, 0, numOutputChannels, numSamples);
+        slot.inRender.store(false, std::memory_order_release);
+        return;
+    }
+
+    const bool fadingIn = slot.fadeIn.exchange(false, std::memory_order_relaxed);
+    if (fadingIn) {
+        engine_.getProfiler()->resumeAfterGap();    // The switch itself isn't a late callback
+    }
+
+    // Sub-blocks no larger than the engine was prepared for
+    const int channels = std::min(numOutputChannels, static_cast<int>(slot.subBlockChannels.size()));
+    for (int offset = 0; offset < numSamples; offset += engineBlockSize_) {
+        const int frames = std::min(engineBlockSize_, numSamples - offset);
+        for (int channel = 0; channel < channels; ++channel) {
+            slot.subBlockChannels[channel] = outputChannels[channel] ? outputChannels[channel] + offset : nullptr;
+        }
+        engine_.processAudioBlock(slot.subBlockChannels.data(), channels, frames);
+    }
+    clearOutputs(outputChannels, channels, numOutputChannels, numSamples);
+
+    if (fadingIn) {
+        applyRamp(outputChannels, channels, numSamples, 0.0f, 1.0f);
+    }
+
+    const int target = handOffTarget_.load(std::memory_order_acquire);
+    if (target == NO_HAND_OFF) {
+        slot.inRender.store(false, std::memory_order_release);
+        return;
+    }
+
+    // Last block on this device: fade out, then the target renders from its next callback
+    applyRamp(outputChannels, channels, numSamples, 1.0f, 0.0f);
+    handOffTarget_.store(NO_HAND_OFF, std::memory_order_relaxed);
+    if (target >= 0) {
+        slots_[target]->fadeIn.store(true, std::memory_order_relaxed);
+    }
+    slot.inRender.store(false, std::memory_order_seq_cst);
+    owner_.store(target, std::memory_order_seq_cst);
+    if (!passNotifyPending_.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, "onHandOffPassed", Qt::QueuedConnection);
+    }
+}
+
+// Main-Thread Notifications
+
+void AudioDeviceSwitcher::onHandOffPassed()
+{
+    passNotifyPending_.store(false, std::memory_order_release);
+    if (isHandingOff() && ownerSlot() == pendingHandOff_) {
+        finishHandOff(true);
+    }
+}
+
+void AudioDeviceSwitcher::onHandOffTimeout()
+{
+    if (!isHandingOff()) {
+        return;
+    }
+    if (ownerSlot() == pendingHandOff_) {
+        finishHandOff(true);    // Passed; the acknowledgement is still in the queue
+        return;
+    }
+
+    // The owner stopped calling back; reopening or closing it waits out any block it is stuck in
+    const int target = pendingHandOff_;
+    qWarning() << "Audio device" << slotDeviceName(ownerSlot()) << "stopped calling back; taking over without a fade";
+    handOffTarget_.store(NO_HAND_OFF, std::memory_order_release);
+    if (target >= 0) {
+        slots_[target]->fadeIn.store(true, std::memory_order_relaxed);
+    }
+    owner_.store(target, std::memory_order_seq_cst);
+    finishHandOff(false);
+}
+
+void AudioDeviceSwitcher::onOwnerClaimed()
+{
+    claimNotifyPending_.store(false, std::memory_order_release);
+
+    const int owner = ownerSlot();
+    if (owner < 0 || owner == primarySlot_ || owner == pendingHandOff_) {
+        return;     // A hand-off we asked for
+    }
+
+    const int failedSlot = primarySlot_;
+    const QString from = slotDeviceName(failedSlot);
+    const QString to = slotDeviceName(owner);
+    primarySlot_ = owner;
+
+    // The failed device becomes the standby again once it comes back
+    qWarning() << "Audio device" << from << "failed; standby" << to << "took over";
+    standbyName_ = from;
+    closeSlot(failedSlot);
+
+    emit failedOver(from, to);
+    emit currentDeviceChanged(to);
+    emit standbyDeviceChanged(QString());
+}
+
+void AudioDeviceSwitcher::onSlotError(int slot, const QString& error)
+{
+    const QString deviceName = slotDeviceName(slot);
+    if (deviceName.isEmpty()) {
+        return;     // Already closed
+    }
+
+    qWarning() << "Audio device error on" << deviceName << ":" << error;
+    emit deviceError(deviceName, error);
+
+    // A failed standby is closed; a failed owner (or hand-off target) is left to the failover
+    if (slot != ownerSlot() && slot != pendingHandOff_) {
+        closeSlot(slot);
+        emit standbyDeviceChanged(QString());
+    }
+}
+
+void AudioDeviceSwitcher::onDeviceListChanged()
+{
+    if (!typeListener_) {
+        return;
+    }
+    typeListener_->rescan();
+    const QStringList names = availableDevices();
+
+    // An unplugged device may not report an error; treat disappearance as failure
+    for (int slot = 0; slot < static_cast<int>(slots_.size()); ++slot) {
+        if (isOpen(slot) && !names.contains(slots_[slot]->name)) {
+            slots_[slot]->failed.store(true, std::memory_order_release);
+            if (slot != ownerSlot() && slot != pendingHandOff_) {
+                closeSlot(slot);
+                emit standbyDeviceChanged(QString());
+            }
+        }
+    }
+
+    // A configured standby that was unplugged comes back as soon as it reappears
+    const int standby = otherSlot(primarySlot_);
+    if (!isHandingOff() && !standbyName_.isEmpty() && isOpen(primarySlot_) && !isOpen(standby) && names.contains(standbyName_)
+        && openSlot(standby, standbyName_, engineSampleRate_, engineBlockSize_)) {
+        startSlot(standby);
+        qDebug() << "Standby audio device" << standbyName_ << "is back";
+        emit standbyDeviceChanged(standbyName_);
+    }
+
+    emit deviceListChanged();
+}
@@ -0,0 +1,172 @@
+// src/audio/AudioDeviceSwitcher.h - Hot device switching and standby failover
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+class JuceAudioBridge;
+class QTimer;
+
+/**
+ * @brief Runs the engine on one of two open devices and moves it between them live
+ *
+ * Both slots hold a started device: the one that owns the engine renders,
+ * the other (the hot standby) outputs silence but keeps its callback running.
+ * Switching is a hand-off of ownership between callbacks: the old device
+ * renders one last block fading out, the new device's next block renders
+ * fading in. Voices, positions, the timeline and armed buffers all live in
+ * the engine, so nothing is torn down, and the audio clock keeps counting.
+ *
+ * A standby that sees the owner report an error, or stop calling back for
+ * STALL_PERIODS buffer periods, claims the engine itself (failover) without
+ * waiting for the main thread. Exactly one callback renders at a time: a
+ * callback only renders while it owns the engine and the other slot is not
+ * inside a render.
+ *
+ * The main thread never waits for a hand-off: it posts the target and
+ * carries on once the outgoing callback acknowledges the pass (or, if that
+ * device has stopped calling back, once HAND_OFF_TIMEOUT_MS has gone by).
+ * Changes requested while a hand-off is under way are queued and run after it.
+ *
+ * Both devices run at the engine's rate. A device with larger buffers than
+ * the engine was prepared for is rendered in engine-sized sub-blocks.
+ * Device lists are refreshed from the OS' device-change notifications.
+ */
+class AudioDeviceSwitcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AudioDeviceSwitcher(JuceAudioBridge& engine, QObject* parent = nullptr);
+    ~AudioDeviceSwitcher();
+
+    AudioDeviceSwitcher(const AudioDeviceSwitcher&) = delete;
+    AudioDeviceSwitcher& operator=(const AudioDeviceSwitcher&) = delete;
+
+    bool initialize();      // Creates the platform device types and subscribes to their notifications
+    void shutdown();        // Stops and closes both devices
+
+    QStringList availableDevices() const;
+    QString defaultDevice() const;              // The system's default output, else the first found
+    QString currentDevice() const;
+    QString standbyDevice() const;
+    double sampleRate() const;
+    int bufferSize() const;
+    QList<int> availableSampleRates() const;    // Of the current device; empty while none is open
+    QList<int> availableBufferSizes() const;
+
+    /**
+     * @brief Move playback to deviceName (the standby, or a device opened for the purpose)
+     *
+     * The configured standby stays open afterwards; switching to the standby
+     * makes the previous device the new standby. Completes asynchronously:
+     * currentDeviceChanged() is emitted once the new device renders.
+     * @return false if the device could not be opened
+     */
+    bool switchTo(const QString& deviceName);
+
+    /**
+     * @brief Keep deviceName open and running silently, ready to take over; empty = none
+     */
+    bool setStandbyDevice(const QString& deviceName);
+
+    // Failover to the standby when the current device fails (on by default)
+    void setFailoverEnabled(bool enabled) { failoverEnabled_.store(enabled, std::memory_order_relaxed); }
+    bool isFailoverEnabled() const { return failoverEnabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Reopen the current device with a new buffer size (asynchronous)
+     *
+     * With a standby this is seamless: the standby plays while the device
+     * reopens. Without one it is not glitch-free: playback fades out, stays
+     * silent for as long as the device takes to reopen, and fades back in.
+     */
+    bool setBufferSize(int bufferSize);
+
+    /**
+     * @brief Move the engine and both devices to a new rate (asynchronous)
+     *
+     * With a standby, the standby plays at the old rate while the current
+     * device reopens at the new one; the engine then changes rate in one
+     * fade-out/fade-in between the two, and the standby is reopened last.
+     * Without a standby playback is silent for the reopen. Playing media
+     * keeps its frames and is resampled live; armed media is decoded again
+     * (sampleRateChanged()).
+     */
+    bool setSampleRate(double sampleRate);
+
+signals:
+    void currentDeviceChanged(const QString& deviceName);
+    void standbyDeviceChanged(const QString& deviceName);
+    void failedOver(const QString& fromDevice, const QString& toDevice);
+    void deviceError(const QString& deviceName, const QString& error);
+    void deviceListChanged();
+    void sampleRateChanged(double sampleRate);
+
+private slots:
+    void onOwnerClaimed();      // Queued from the callback that claimed the engine
+    void onHandOffPassed();     // Queued from the callback that passed the engine on
+    void onHandOffTimeout();
+    void onDeviceListChanged();
+    void onSlotError(int slot, const QString& error);
+
+private:
+    class DeviceSlot;
+    class TypeListener;
+
+    // Audio thread
+    void renderSlot(DeviceSlot& slot, float* const* outputChannels, int numOutputChannels, int numSamples);
+    bool canClaim(const DeviceSlot& slot, int owner, std::int64_t nowNs) const;
+
+    // Main thread
+    bool openSlot(int slot, const QString& deviceName, double sampleRate, int bufferSize);   // Opened, not started
+    void startSlot(int slot);
+    void closeSlot(int slot);
+    bool reopenSlot(int slot, double sampleRate, int bufferSize, double fallbackRate = 0.0, int fallbackSize = 0);
+    void prepareEngine(int slot);
+    using HandOffDone = std::function<void(bool passed)>;   // passed: false if taken over without the fade
+    void handOff(int target, HandOffDone done = HandOffDone());
+    void finishHandOff(bool passed);
+    bool isHandingOff() const { return pendingHandOff_ != NO_HAND_OFF; }
+    void queueChange(std::function<void()> change);
+    void reopenStandby();
+    int ownerSlot() const { return owner_.load(std::memory_order_acquire); }
+    int otherSlot(int slot) const { return slot == 0 ? 1 : 0; }
+    bool isOpen(int slot) const;
+    QString slotDeviceName(int slot) const;
+
+    JuceAudioBridge& engine_;
+    std::array<std::unique_ptr<DeviceSlot>, 2> slots_;
+    std::unique_ptr<TypeListener> typeListener_;
+
+    // Hand-off state shared with the callbacks
+    std::atomic<int> owner_;                // Slot rendering the engine, NO_OWNER while suspended
+    std::atomic<int> handOffTarget_;        // Where the owner passes the engine after its next block
+    std::atomic<bool> failoverEnabled_;
+    std::atomic<bool> claimNotifyPending_;
+    std::atomic<bool> passNotifyPending_;
+
+    // Main thread
+    QTimer* handOffTimer_;                  // Owner that never acknowledges is taken over
+    int pendingHandOff_;                    // Target of the hand-off under way, NO_HAND_OFF if none
+    HandOffDone handOffDone_;
+    QList<std::function<void()>> queuedChanges_;    // Requested while a hand-off was under way
+    int primarySlot_;                       // Last slot the main thread saw as the owner
+    QString standbyName_;                   // Configured standby, reopened when it reappears
+    double engineSampleRate_;
+    int engineBlockSize_;                   // What the engine was prepared for
+
+    // Constants
+    static constexpr int NO_OWNER = -1;
+    static constexpr int NO_HAND_OFF = -2;
+    static constexpr int STALL_PERIODS = 3;             // Missed periods before the standby takes over
+    static constexpr int HAND_OFF_TIMEOUT_MS = 500;     // Owner stopped calling back: force the hand-off
+    static constexpr int DEFAULT_BUFFER_SIZE = 256;
+};
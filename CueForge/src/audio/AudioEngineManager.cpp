@@ -0,0 +1,844 @@
+// src/audio/AudioEngineManager.cpp - Qt6 Audio Engine Manager
+#include "AudioEngineManager.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "JuceAudioBridge.h"
+#include "AudioDeviceSwitcher.h"
+#include "CuePrearmer.h"
+#include "CueScheduler.h"
+#include "MediaCache.h"
+#include "MediaPool.h"
+#include "CueManager.h"
+#include "AudioCue.h"
+#include "GainMatrix.h"
+#include "Settings.h"
+
+AudioEngineManager::AudioEngineManager(CueManager* cueManager, QObject* parent)
+    : QObject(parent)
+    , cueManager_(cueManager)
+    , juceBridge_(std::make_unique<JuceAudioBridge>())
+    , statusTimer_(new QTimer(this))
+    , lastCpuUsage_(0.0)
+    , lastDropoutCount_(0)
+    , performanceTimer_(new QTimer(this))
+    , diagnosticsDirectory_(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/diagnostics")
+    , lastDropoutDumpMs_(0)
+    , diagnosticsPool_()
+    , settingsGroup_("Audio")
+    , initialized_(false)
+    , shutdownRequested_(false)
+    , emergencyStopActive_(false)
+{
+    diagnosticsPool_.setMaxThreadCount(1);
+    diagnosticsPool_.setThreadPriority(QThread::LowPriority);
+
+    prearmer_ = std::make_unique<CuePrearmer>(cueManager_, juceBridge_.get());
+    scheduler_ = std::make_unique<CueScheduler>(cueManager_, juceBridge_.get(), prearmer_.get());
+    mediaCache_ = std::make_unique<MediaCache>();
+    levelMeters_ = std::make_unique<LevelMeters>(juceBridge_->getMeterBank());
+    connect(levelMeters_.get(), &LevelMeters::metersUpdated, this, &AudioEngineManager::metersUpdated);
+
+    // Bridge playback signals pass straight through
+    connect(juceBridge_.get(), &JuceAudioBridge::cueStarted, this, &AudioEngineManager::cueStarted);
+    connect(juceBridge_.get(), &JuceAudioBridge::cueFinished, this, &AudioEngineManager::cueFinished);
+    connect(juceBridge_.get(), &JuceAudioBridge::cuePaused, this, &AudioEngineManager::cuePaused);
+    connect(juceBridge_.get(), &JuceAudioBridge::cueResumed, this, &AudioEngineManager::cueResumed);
+    connect(juceBridge_.get(), &JuceAudioBridge::cueStopped, this, &AudioEngineManager::cueStopped);
+    connect(juceBridge_.get(), &JuceAudioBridge::cueError, this, &AudioEngineManager::cueError);
+    connect(juceBridge_.get(), &JuceAudioBridge::cuePositionChanged, this, &AudioEngineManager::cuePositionChanged);
+    connect(juceBridge_.get(), &JuceAudioBridge::cpuUsageChanged, this, &AudioEngineManager::cpuUsageChanged);
+    connect(juceBridge_.get(), &JuceAudioBridge::audioDropout, this, &AudioEngineManager::onAudioDropout);
+    connect(juceBridge_.get(), &JuceAudioBridge::juceError, this, &AudioEngineManager::handleJuceError);
+    connect(juceBridge_.get(), &JuceAudioBridge::bufferUnderrun, this, [this](const QString& cueId) {
+        qWarning() << "Disk read-ahead underrun on cue" << cueId;
+        emit bufferUnderrun();
+    });
+
+    connect(juceBridge_.get(), &JuceAudioBridge::cueVoiceAttached, this, &AudioEngineManager::onCueVoiceAttached);
+
+    connect(prearmer_.get(), &CuePrearmer::cueArmFailed, this, &AudioEngineManager::cueError);
+
+    // Device changes arrive as OS notifications; nothing polls
+    AudioDeviceSwitcher* devices = juceBridge_->getDeviceSwitcher();
+    connect(devices, &AudioDeviceSwitcher::deviceListChanged, this, &AudioEngineManager::handleDeviceChange);
+    connect(devices, &AudioDeviceSwitcher::currentDeviceChanged, this, [this](const QString& deviceName) {
+        currentDevice_ = deviceName;
+        emit audioDeviceChanged(deviceName);
+    });
+    connect(devices, &AudioDeviceSwitcher::failedOver, this, [this](const QString& from, const QString& to) {
+        emit warningMessage(QString("Audio device %1 failed, playback moved to %2").arg(from, to));
+        emit audioDeviceFailedOver(from, to);
+    });
+    connect(devices, &AudioDeviceSwitcher::deviceError, this, [this](const QString& deviceName, const QString& error) {
+        emit audioDeviceError(QString("%1: %2").arg(deviceName, error));
+    });
+    // Audio armed at the old rate is decoded again at the new one
+    connect(devices, &AudioDeviceSwitcher::sampleRateChanged, prearmer_.get(), &CuePrearmer::refresh);
+
+    if (cueManager_) {
+        connect(cueManager_, &CueManager::cueAdded, this, &AudioEngineManager::onCueAdded);
+        connect(cueManager_, &CueManager::cueRemoved, this, &AudioEngineManager::onCueRemoved);
+        connect(cueManager_, &CueManager::workspaceOpened, this, &AudioEngineManager::onWorkspaceOpened);
+        connect(cueManager_, &CueManager::standByCueChanged, prearmer_.get(), &CuePrearmer::onStandByCueChanged);
+        cueManager_->setScheduler(scheduler_.get());
+        cueManager_->setMediaPool(juceBridge_->getMediaPool());
+    }
+
+    // Started once a device is open (initialize()), stopped in shutdown()
+    statusTimer_->setInterval(STATUS_UPDATE_INTERVAL);
+    connect(statusTimer_, &QTimer::timeout, this, &AudioEngineManager::onStatusTimer);
+    performanceTimer_->setInterval(PERFORMANCE_UPDATE_INTERVAL);
+    connect(performanceTimer_, &QTimer::timeout, this, &AudioEngineManager::monitorPerformance);
+}
+
+AudioEngineManager::~AudioEngineManager()
+{
+    shutdown();
+    diagnosticsPool_.waitForDone();     // A dropout dump may still be on its way to disk
+
+    if (cueManager_) {
+        cueManager_->setScheduler(nullptr);
+        cueManager_->setMediaPool(nullptr);
+    }
+
+    // Pre-arm workers must stop before the bridge they attach to goes away
+    scheduler_.reset();
+    prearmer_.reset();
+}
+
+// Lifecycle
+
+bool AudioEngineManager::initialize(const QString& deviceName, int sampleRate, int bufferSize)
+{
+    if (initialized_) {
+        return true;
+    }
+
+    if (!juceBridge_->initialize()) {
+        qWarning() << "No audio device types available";
+        return false;
+    }
+    refreshAudioDevices();
+
+    // The saved device if it is still attached, otherwise whatever the system calls default
+    AudioDeviceSwitcher* devices = juceBridge_->getDeviceSwitcher();
+    QString device = deviceName;
+    if (device.isEmpty() || !availableDevices_.contains(device)) {
+        device = devices->defaultDevice();
+        if (!deviceName.isEmpty()) {
+            qWarning() << "Saved audio device" << deviceName << "not found, using" << device;
+        }
+    }
+
+    if (device.isEmpty() || !devices->switchTo(device)) {
+        qWarning() << "Could not open an audio output device" << device;
+        juceBridge_->shutdown();
+        return false;
+    }
+
+    // A rate or buffer the device refuses leaves it running at what it opened with
+    if (sampleRate > 0 && sampleRate != getCurrentSampleRate() && !setSampleRate(sampleRate)) {
+        qWarning() << "Audio device" << device << "refused" << sampleRate << "Hz";
+    }
+    if (bufferSize > 0 && bufferSize != getCurrentBufferSize() && !setBufferSize(bufferSize)) {
+        qWarning() << "Audio device" << device << "refused a buffer of" << bufferSize << "samples";
+    }
+
+    currentDevice_ = devices->currentDevice();
+    shutdownRequested_ = false;
+    initialized_ = true;
+
+    updateStatus();
+    statusTimer_->start();
+    performanceTimer_->start();
+
+    qDebug() << "Audio engine running on" << currentDevice_ << "at" << getCurrentSampleRate() << "Hz,"
+             << getCurrentBufferSize() << "samples";
+    emit initialized();
+    return true;
+}
+
+void AudioEngineManager::shutdown()
+{
+    if (!initialized_) {
+        return;
+    }
+    shutdownRequested_ = true;
+
+    statusTimer_->stop();
+    performanceTimer_->stop();
+
+    // Nothing may fire between here and the devices closing
+    scheduler_->cancelAll();
+    juceBridge_->stopAllCues(0.0);
+    juceBridge_->shutdown();
+
+    currentDevice_.clear();
+    initialized_ = false;
+    qDebug() << "Audio engine shut down";
+    emit shutdownComplete();
+}
+
+// Devices
+
+QStringList AudioEngineManager::getAvailableDevices() const
+{
+    return availableDevices_.isEmpty() ? juceBridge_->getAvailableDevices() : availableDevices_;
+}
+
+QString AudioEngineManager::getCurrentDevice() const
+{
+    return juceBridge_->getCurrentDevice();
+}
+
+bool AudioEngineManager::setAudioDevice(const QString& deviceName)
+{
+    return juceBridge_->setAudioDevice(deviceName);
+}
+
+bool AudioEngineManager::setBackupDevice(const QString& deviceName)
+{
+    return juceBridge_->getDeviceSwitcher()->setStandbyDevice(deviceName);
+}
+
+QString AudioEngineManager::getBackupDevice() const
+{
+    return juceBridge_->getDeviceSwitcher()->standbyDevice();
+}
+
+void AudioEngineManager::setDeviceFailoverEnabled(bool enabled)
+{
+    juceBridge_->getDeviceSwitcher()->setFailoverEnabled(enabled);
+}
+
+int AudioEngineManager::getCurrentSampleRate() const
+{
+    return qRound(juceBridge_->getDeviceSwitcher()->sampleRate());
+}
+
+int AudioEngineManager::getCurrentBufferSize() const
+{
+    return juceBridge_->getDeviceSwitcher()->bufferSize();
+}
+
+QList<int> AudioEngineManager::getAvailableSampleRates() const
+{
+    return juceBridge_->getDeviceSwitcher()->availableSampleRates();
+}
+
+QList<int> AudioEngineManager::getAvailableBufferSizes() const
+{
+    return juceBridge_->getDeviceSwitcher()->availableBufferSizes();
+}
+
+bool AudioEngineManager::setSampleRate(int sampleRate)
+{
+    return juceBridge_->getDeviceSwitcher()->setSampleRate(sampleRate);
+}
+
+bool AudioEngineManager::setBufferSize(int bufferSize)
+{
+    return juceBridge_->getDeviceSwitcher()->setBufferSize(bufferSize);
+}
+
+void AudioEngineManager::refreshAudioDevices()
+{
+    availableDevices_ = juceBridge_->getAvailableDevices();
+    emit availableDevicesChanged();
+}
+
+void AudioEngineManager::handleDeviceChange()
+{
+    // The switcher has already failed over if the current device went away
+    refreshAudioDevices();
+    currentDevice_ = juceBridge_->getCurrentDevice();
+}
+
+// Cue Registration
+
+bool AudioEngineManager::registerAudioCue(AudioCue* cue)
+{
+    if (!cue) {
+        return false;
+    }
+
+    QMutexLocker locker(&cueRegistryMutex_);
+
+    // No voice yet: the prearmer takes one when the cue is armed (onCueVoiceAttached)
+    const QString cueId = cue->id();
+    registeredCues_.insert(cueId, cue);
+
+    // Recompile the dense matrix whenever anything feeding it changes
+    const auto matrixChanged = [this, cueId]() { onAudioCueMatrixChanged(cueId); };
+    connect(cue, &AudioCue::matrixRoutingChanged, this, matrixChanged);
+    connect(cue, &AudioCue::levelsChanged, this, matrixChanged);
+    connect(cue, &AudioCue::mainLevelChanged, this, matrixChanged);
+    connect(cue, &AudioCue::mutedChanged, this, matrixChanged);
+    connect(cue, &Cue::detailsHydrated, this, matrixChanged);
+
+    // Peaks and metadata are built once per file version, long before anyone opens the inspector
+    const auto requestPeaks = [this, cue]() { mediaCache_->request(cue->filePath()); };
+    connect(cue, &AudioCue::filePathChanged, this, requestPeaks);
+    connect(cue, &Cue::detailsHydrated, this, requestPeaks);
+
+    // Only varispeed resamples in the callback; rate-mismatched files were converted when armed
+    const auto applySpeed = [this, cue]() { juceBridge_->setSpeed(juceBridge_->handleFor(cue->id()), cue->playbackSpeed()); };
+    connect(cue, &AudioCue::playbackSpeedChanged, this, applySpeed);
+    connect(cue, &Cue::detailsHydrated, this, applySpeed);
+
+    if (cue->isHydrated()) {
+        requestPeaks();
+    }
+    return true;
+}
+
+void AudioEngineManager::onCueVoiceAttached(const QString& cueId, CueHandle handle)
+{
+    levelMeters_->resetCue(handle);     // Don't inherit the previous owner's hold/clip
+
+    AudioCue* cue = nullptr;
+    {
+        QMutexLocker locker(&cueRegistryMutex_);
+        cue = registeredCues_.value(cueId);
+    }
+
+    // Lazily loaded cues compile their matrix once their details are parsed
+    if (!cue || !cue->isHydrated()) {
+        return;
+    }
+    updateCueInJuce(cue);
+    if (cue->playbackSpeed() != 1.0) {
+        juceBridge_->setSpeed(handle, cue->playbackSpeed());
+    }
+}
+
+bool AudioEngineManager::unregisterAudioCue(const QString& cueId)
+{
+    prearmer_->disarm(cueId);
+
+    QMutexLocker locker(&cueRegistryMutex_);
+
+    AudioCue* cue = registeredCues_.take(cueId);
+    if (!cue) {
+        return false;
+    }
+    disconnect(cue, nullptr, this, nullptr);
+
+    juceBridge_->releaseCue(cueId);
+    return true;
+}
+
+bool AudioEngineManager::loadAudioFile(const QString& cueId, const QString& filePath)
+{
+    double startTime = 0.0;
+    {
+        QMutexLocker locker(&cueRegistryMutex_);
+        if (AudioCue* cue = registeredCues_.value(cueId)) {
+            startTime = cue->startTime();
+        }
+    }
+
+    // Returns immediately when the prearmer already attached this file
+    return prearmer_->ensureArmed(cueId, filePath, startTime);
+}
+
+// Playback Control
+
+bool AudioEngineManager::playCue(const QString& cueId, double startTime, double fadeInTime, FadeCurve curve)
+{
+    AudioCue* cue = nullptr;
+    {
+        QMutexLocker locker(&cueRegistryMutex_);
+        cue = registeredCues_.value(cueId);
+    }
+
+    if (cue && !prearmer_->isArmed(cueId, cue->filePath(), cue->startTime())) {
+        prearmer_->ensureArmed(cueId, cue->filePath(), cue->startTime());
+    }
+
+    return playCue(getCueHandle(cueId), startTime, fadeInTime, curve);
+}
+
+bool AudioEngineManager::stopCue(const QString& cueId, double fadeOutTime, FadeCurve curve)
+{
+    return stopCue(getCueHandle(cueId), fadeOutTime, curve);
+}
+
+bool AudioEngineManager::pauseCue(const QString& cueId)
+{
+    return pauseCue(getCueHandle(cueId));
+}
+
+bool AudioEngineManager::resumeCue(const QString& cueId)
+{
+    return resumeCue(getCueHandle(cueId));
+}
+
+CueHandle AudioEngineManager::getCueHandle(const QString& cueId) const
+{
+    return juceBridge_->handleFor(cueId);
+}
+
+bool AudioEngineManager::playCue(CueHandle handle, double startTime, double fadeInTime, FadeCurve curve)
+{
+    emergencyStopActive_ = false;   // A new GO ends the emergency
+    return juceBridge_->play(handle, startTime, fadeInTime, curve);
+}
+
+bool AudioEngineManager::stopCue(CueHandle handle, double fadeOutTime, FadeCurve curve)
+{
+    return juceBridge_->stop(handle, fadeOutTime, curve);
+}
+
+bool AudioEngineManager::pauseCue(CueHandle handle)
+{
+    return juceBridge_->pause(handle);
+}
+
+bool AudioEngineManager::resumeCue(CueHandle handle)
+{
+    return juceBridge_->resume(handle);
+}
+
+void AudioEngineManager::stopAllCues(double fadeOutTime, FadeCurve curve)
+{
+    juceBridge_->stopAllCues(fadeOutTime, curve);
+}
+
+int AudioEngineManager::fadeCues(const QStringList& cueIds, float level, double duration, FadeCurve curve)
+{
+    QList<JuceAudioBridge::FadeTarget> targets;
+    targets.reserve(cueIds.size());
+    for (const QString& cueId : cueIds) {
+        JuceAudioBridge::FadeTarget target;
+        target.cueId = cueId;
+        target.level = level;
+        targets.append(target);
+    }
+    return juceBridge_->fadeTargets(targets, duration, curve);
+}
+
+bool AudioEngineManager::setCueSpeed(const QString& cueId, double speed, ResamplerQuality quality)
+{
+    return juceBridge_->setCueSpeed(cueId, speed, quality);
+}
+
+void AudioEngineManager::emergencyStop()
+{
+    // Pending GOs and waits first, so nothing starts behind the stop
+    emergencyStopActive_ = true;
+    scheduler_->cancelAll();
+    juceBridge_->stopAllCues(0.0);
+    qWarning() << "Audio emergency stop";
+}
+
+// Routing
+
+bool AudioEngineManager::setCrosspoint(const QString& cueId, int input, int output, float level)
+{
+    return juceBridge_->setCrosspoint(cueId, input, output, level);
+}
+
+float AudioEngineManager::getCrosspoint(const QString& cueId, int input, int output) const
+{
+    return juceBridge_->getCrosspoint(cueId, input, output);
+}
+
+bool AudioEngineManager::setInputLevel(const QString& cueId, int input, float level)
+{
+    return juceBridge_->setInputLevel(cueId, input, level);
+}
+
+bool AudioEngineManager::setOutputLevel(int output, float level)
+{
+    return juceBridge_->setOutputLevel(output, level);
+}
+
+bool AudioEngineManager::muteOutput(int output, bool mute)
+{
+    return juceBridge_->muteOutput(output, mute);
+}
+
+bool AudioEngineManager::soloOutput(int output, bool solo)
+{
+    return juceBridge_->soloOutput(output, solo);
+}
+
+bool AudioEngineManager::setPatchRouting(int cueOutput, int deviceOutput, float level)
+{
+    return juceBridge_->setPatchRouting(cueOutput, deviceOutput, level);
+}
+
+float AudioEngineManager::getPatchRouting(int cueOutput, int deviceOutput) const
+{
+    return juceBridge_->getPatchRouting(cueOutput, deviceOutput);
+}
+
+// Status
+
+AudioEngineManager::EngineStatus AudioEngineManager::getStatus() const
+{
+    QMutexLocker locker(&statusMutex_);
+
+    EngineStatus status = currentStatus_;
+    status.armedCues = prearmer_->armedCount();
+    status.lastGoLatencyMs = juceBridge_->getLastTriggerLatencyMs();
+    status.maxGoLatencyMs = juceBridge_->getMaxTriggerLatencyMs();
+    status.underrunCount = juceBridge_->getUnderrunCount();
+
+    const CallbackProfiler::Snapshot profile = juceBridge_->getProfiler()->snapshot(false);
+    status.cpuUsage = profile.recentLoad * 100.0;
+    status.dropoutCount = static_cast<int>(profile.dropouts);
+    status.averageCallbackMs = profile.averageNs / 1.0e6;
+    status.worstCallbackMs = profile.worstNs / 1.0e6;
+    status.peakCallbackLoad = profile.peakLoad * 100.0;
+    status.stageAverageMs.resize(CallbackProfiler::STAGE_COUNT);
+    for (int stage = 0; stage < CallbackProfiler::STAGE_COUNT; ++stage) {
+        status.stageAverageMs[stage] = profile.stageAverageNs[stage] / 1.0e6;
+    }
+    status.callbackLoadHistogram = QVector<quint64>(profile.loadHistogram.begin(), profile.loadHistogram.end());
+    return status;
+}
+
+void AudioEngineManager::updateStatus()
+{
+    updateEngineStatus();
+
+    bool changed = false;
+    {
+        QMutexLocker locker(&statusMutex_);
+        changed = currentStatus_.isRunning != lastStatus_.isRunning
+            || currentStatus_.currentDevice != lastStatus_.currentDevice
+            || currentStatus_.sampleRate != lastStatus_.sampleRate
+            || currentStatus_.bufferSize != lastStatus_.bufferSize
+            || currentStatus_.activeCues != lastStatus_.activeCues
+            || currentStatus_.lastError != lastStatus_.lastError;
+    }
+
+    if (changed) {
+        emit statusChanged();
+    }
+}
+
+void AudioEngineManager::onStatusTimer()
+{
+    updateStatus();
+}
+
+void AudioEngineManager::updateEngineStatus()
+{
+    // Live timing comes from the profiler in getStatus(); this is the slow-moving part
+    const AudioDeviceSwitcher* devices = juceBridge_->getDeviceSwitcher();
+
+    int activeCues = 0;
+    {
+        QMutexLocker locker(&cueRegistryMutex_);
+        for (auto it = registeredCues_.constBegin(); it != registeredCues_.constEnd(); ++it) {
+            activeCues += juceBridge_->isCuePlaying(it.key()) ? 1 : 0;
+        }
+    }
+
+    QMutexLocker locker(&statusMutex_);
+    lastStatus_ = currentStatus_;
+    currentStatus_.currentDevice = devices->currentDevice();
+    currentStatus_.isRunning = !currentStatus_.currentDevice.isEmpty();
+    currentStatus_.sampleRate = devices->sampleRate();
+    currentStatus_.bufferSize = devices->bufferSize();
+    currentStatus_.activeCues = activeCues;
+}
+
+void AudioEngineManager::monitorPerformance()
+{
+    // Warn once per crossing, not on every tick spent above the threshold
+    const double cpuUsage = juceBridge_->getCpuUsage();
+    if (cpuUsage >= CPU_CRITICAL_THRESHOLD && lastCpuUsage_ < CPU_CRITICAL_THRESHOLD) {
+        emit warningMessage(QString("Audio callback at %1% of the buffer period: dropouts are likely").arg(cpuUsage, 0, 'f', 0));
+    }
+    else if (cpuUsage >= CPU_WARNING_THRESHOLD && lastCpuUsage_ < CPU_WARNING_THRESHOLD) {
+        emit warningMessage(QString("Audio callback load is high (%1%)").arg(cpuUsage, 0, 'f', 0));
+    }
+    lastCpuUsage_ = cpuUsage;
+
+    // Each dropout is dumped by onAudioDropout(); this keeps a running tally in the log
+    const int dropouts = juceBridge_->getDropoutCount();
+    if (dropouts > lastDropoutCount_) {
+        qWarning() << dropouts - lastDropoutCount_ << "audio dropout(s), total" << dropouts;
+    }
+    lastDropoutCount_ = dropouts;
+}
+
+bool AudioEngineManager::isCuePlaying(const QString& cueId) const
+{
+    return juceBridge_->isCuePlaying(cueId);
+}
+
+double AudioEngineManager::getCuePosition(const QString& cueId) const
+{
+    return juceBridge_->getCuePosition(cueId);
+}
+
+double AudioEngineManager::getCueDuration(const QString& cueId) const
+{
+    return juceBridge_->getCueDuration(cueId);
+}
+
+double AudioEngineManager::getCpuUsage() const
+{
+    return juceBridge_->getCpuUsage();
+}
+
+int AudioEngineManager::getDropoutCount() const
+{
+    return juceBridge_->getDropoutCount();
+}
+
+void AudioEngineManager::resetDropoutCount()
+{
+    juceBridge_->resetDropoutCount();
+}
+
+MeterReading AudioEngineManager::getOutputMeter(int output) const
+{
+    return levelMeters_->output(output);
+}
+
+MeterReading AudioEngineManager::getCueMeter(const QString& cueId) const
+{
+    return levelMeters_->cue(juceBridge_->cueHandle(cueId));
+}
+
+quint64 AudioEngineManager::getUnderrunCount() const
+{
+    return juceBridge_->getUnderrunCount();
+}
+
+void AudioEngineManager::resetUnderrunCount()
+{
+    juceBridge_->resetUnderrunCount();
+}
+
+// Dropout Forensics
+
+void AudioEngineManager::setCallbackStageTiming(bool enabled)
+{
+    juceBridge_->getProfiler()->setStageTiming(enabled);
+}
+
+QByteArray AudioEngineManager::diagnosticsReport(const QString& reason) const
+{
+    const EngineStatus status = getStatus();
+
+    QJsonObject engine;
+    engine["device"] = status.currentDevice;
+    engine["sampleRate"] = juceBridge_->getClockSampleRate();
+    engine["bufferSize"] = status.bufferSize;
+    engine["activeCues"] = status.activeCues;
+    engine["armedCues"] = status.armedCues;
+    engine["underruns"] = static_cast<qint64>(status.underrunCount);
+    engine["lastGoLatencyMs"] = status.lastGoLatencyMs;
+    engine["maxGoLatencyMs"] = status.maxGoLatencyMs;
+
+    QJsonObject report;
+    report["reason"] = reason;
+    report["time"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+    report["engine"] = engine;
+    report["callbacks"] = CallbackProfiler::toJson(juceBridge_->getProfiler()->snapshot());
+    return QJsonDocument(report).toJson(QJsonDocument::Indented);
+}
+
+bool AudioEngineManager::exportDiagnostics(const QString& filePath) const
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write audio diagnostics" << filePath << "-" << file.errorString();
+        return false;
+    }
+
+    file.write(diagnosticsReport(QStringLiteral("export")));
+    if (!file.commit()) {
+        qWarning() << "Failed to write audio diagnostics" << filePath << "-" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void AudioEngineManager::onAudioDropout()
+{
+    emit audioDropout();
+
+    // The ring still holds the callbacks leading up to the dropout; dump it while it does
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now - lastDropoutDumpMs_ < DROPOUT_DUMP_INTERVAL) {
+        return;
+    }
+    lastDropoutDumpMs_ = now;
+
+    const QString fileName = QString("dropout-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz"));
+    const CallbackProfiler::Snapshot profile = juceBridge_->getProfiler()->snapshot(false);
+    qWarning() << "Audio dropout: worst callback" << profile.worstNs / 1.0e6 << "ms, load"
+               << profile.recentLoad * 100.0 << "% - dumping to" << fileName;
+
+    // The report is built from memory here; the disk work waits for the pool, away from
+    // the GUI thread while the system is already struggling
+    const QByteArray report = diagnosticsReport(QStringLiteral("dropout"));
+    const QString directoryPath = diagnosticsDirectory_;
+    diagnosticsPool_.start([directoryPath, fileName, report]() {
+        QDir directory(directoryPath);
+        if (!directory.mkpath(".")) {
+            qWarning() << "Cannot create diagnostics directory" << directoryPath;
+            return;
+        }
+
+        QSaveFile file(directory.filePath(fileName));
+        if (!file.open(QIODevice::WriteOnly) || file.write(report) != report.size() || !file.commit()) {
+            qWarning() << "Cannot write dropout dump" << fileName << file.errorString();
+        }
+
+        const QFileInfoList dumps = directory.entryInfoList({ "dropout-*.json" }, QDir::Files, QDir::Name);
+        for (int i = 0; i < dumps.size() - MAX_DROPOUT_DUMPS; ++i) {
+            QFile::remove(dumps[i].absoluteFilePath());
+        }
+    });
+}
+
+// Settings
+
+MediaPool* AudioEngineManager::getMediaPool() const
+{
+    return juceBridge_->getMediaPool();
+}
+
+void AudioEngineManager::applySettings(Settings* settings)
+{
+    if (!settings) {
+        return;
+    }
+
+    MediaPool* pool = juceBridge_->getMediaPool();
+    const auto applyBudget = [pool](const QVariant& megabytes) {
+        pool->setBudgetBytes(megabytes.toLongLong() * 1024 * 1024);
+    };
+
+    applyBudget(settings->value(Settings::Keys::Audio::MediaPoolBudget));
+    connect(settings, &Settings::settingChanged, this,
+            [applyBudget](const QString& key, const QVariant& oldValue, const QVariant& newValue) {
+        Q_UNUSED(oldValue)
+        if (key == Settings::Keys::Audio::MediaPoolBudget) {
+            applyBudget(newValue);
+        }
+    });
+
+    qDebug() << "Media pool budget:" << pool->budgetBytes() / (1024 * 1024) << "MB";
+}
+
+// CueManager Integration
+
+void AudioEngineManager::onCueAdded(Cue* cue)
+{
+    if (AudioCue* audioCue = qobject_cast<AudioCue*>(cue)) {
+        registerAudioCue(audioCue);
+    }
+}
+
+void AudioEngineManager::onCueRemoved(const QString& cueId)
+{
+    unregisterAudioCue(cueId);
+}
+
+void AudioEngineManager::onWorkspaceOpened()
+{
+    QStringList staleIds;
+    {
+        QMutexLocker locker(&cueRegistryMutex_);
+        staleIds = registeredCues_.keys();
+    }
+
+    // The previous workspace's cues were deleted in bulk; drop their voices by ID only
+    for (const QString& cueId : std::as_const(staleIds)) {
+        prearmer_->disarm(cueId);
+
+        QMutexLocker locker(&cueRegistryMutex_);
+        registeredCues_.remove(cueId);
+        juceBridge_->releaseCue(cueId);
+    }
+
+    for (Cue* cue : cueManager_->getCuesOfType(CueType::Audio)) {
+        registerAudioCue(qobject_cast<AudioCue*>(cue));
+    }
+    prearmer_->refresh();
+}
+
+void AudioEngineManager::onAudioCueFileChanged(const QString& cueId, const QString& newFilePath)
+{
+    Q_UNUSED(newFilePath)
+
+    // Drop the stale buffer; the window refresh re-arms if the cue is upcoming
+    prearmer_->disarm(cueId);
+    prearmer_->refresh();
+}
+
+void AudioEngineManager::onAudioCueMatrixChanged(const QString& cueId)
+{
+    AudioCue* cue = nullptr;
+    {
+        QMutexLocker locker(&cueRegistryMutex_);
+        cue = registeredCues_.value(cueId);
+    }
+
+    if (cue) {
+        updateCueInJuce(cue);
+    }
+}
+
+void AudioEngineManager::onAudioCueLevelsChanged(const QString& cueId)
+{
+    onAudioCueMatrixChanged(cueId);
+}
+
+void AudioEngineManager::updateCueInJuce(AudioCue* cue)
+{
+    // Flatten the string-keyed routing once per edit, never per buffer
+    GainMatrix matrix;
+    matrix.clear();
+
+    const float mainLevel = cue->isMuted() ? 0.0f : static_cast<float>(cue->mainLevel());
+    const int numInputs = cue->numChannels() > 0
+        ? qMin(cue->numChannels(), GainMatrix::MAX_INPUTS)
+        : GainMatrix::MAX_INPUTS;
+
+    for (int input = 0; input < numInputs; ++input) {
+        for (int output = 0; output < GainMatrix::MAX_OUTPUTS; ++output) {
+            const double level = cue->getChannelLevel(input, output);
+            if (level != 0.0) {
+                matrix.set(input, output, static_cast<float>(level) * mainLevel);
+            }
+        }
+    }
+
+    juceBridge_->setCueMatrix(cue->id(), matrix);
+}
+
+void AudioEngineManager::handleJuceError(const QString& error)
+{
+    qWarning() << "Audio engine error:" << error;
+    {
+        QMutexLocker locker(&statusMutex_);
+        currentStatus_.lastError = error;
+    }
+    emit warningMessage(error);
+}
+
+void AudioEngineManager::executeOnMainThread(std::function<void()> callback)
+{
+    QMetaObject::invokeMethod(this, std::move(callback), Qt::QueuedConnection);
+}
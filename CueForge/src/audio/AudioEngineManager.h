@@ -2,16 +2,27 @@
 #pragma once
 
 #include <QObject>
+#include <QThreadPool>
 #include <QTimer>
 #include <QMutex>
 #include <QHash>
 #include <QString>
 #include <QStringList>
+#include <QVector>
 #include <memory>
 
+#include "AudioBackend.h"
+#include "FadeEngine.h"
+#include "LevelMeters.h"
+
 // Forward declarations to avoid including JUCE headers in Qt code
 class AudioEngine;  // Your existing JUCE AudioEngine class
 class JuceAudioBridge;
+class CuePrearmer;
+class CueScheduler;
+class MediaCache;
+class MediaPool;
+class Settings;
 
 // Forward declarations for Qt6 classes
 class CueManager;
@@ -33,15 +44,26 @@ public:
     explicit AudioEngineManager(CueManager* cueManager, QObject* parent = nullptr);
     ~AudioEngineManager();
 
-    // Lifecycle management
-    bool initialize();
-    void shutdown();
+    /**
+     * @brief Open the saved output device and start status monitoring
+     *
+     * Falls back to the system default when deviceName is empty or no longer
+     * attached. sampleRate/bufferSize <= 0 keep what the device opens with.
+     * @return false if no audio device could be opened
+     */
+    bool initialize(const QString& deviceName = QString(), int sampleRate = 0, int bufferSize = 0);
+    void shutdown();    // Stops every cue and closes the devices
     bool isInitialized() const { return initialized_; }
 
     // Device management
     QStringList getAvailableDevices() const;
     QString getCurrentDevice() const;
-    bool setAudioDevice(const QString& deviceName);
+    bool setAudioDevice(const QString& deviceName);     // Hot switch: cues keep playing
+
+    // Redundant interface: kept running silently and takes over if the current device fails
+    bool setBackupDevice(const QString& deviceName);
+    QString getBackupDevice() const;
+    void setDeviceFailoverEnabled(bool enabled);
 
     // Audio settings
     QList<int> getAvailableSampleRates() const;
@@ -57,11 +79,25 @@ public:
     bool loadAudioFile(const QString& cueId, const QString& filePath);
 
     // Playback control (delegates to JUCE AudioEngine)
-    bool playCue(const QString& cueId, double startTime = 0.0, double fadeInTime = 0.0);
-    bool stopCue(const QString& cueId, double fadeOutTime = 0.0);
+    bool playCue(const QString& cueId, double startTime = 0.0, double fadeInTime = 0.0, FadeCurve curve = FadeCurve::Linear);
+    bool stopCue(const QString& cueId, double fadeOutTime = 0.0, FadeCurve curve = FadeCurve::Linear);
     bool pauseCue(const QString& cueId);
     bool resumeCue(const QString& cueId);
-    void stopAllCues();
+    void stopAllCues(double fadeOutTime = 0.0, FadeCurve curve = FadeCurve::Linear);
+
+    // Handle-based playback: resolve once with getCueHandle(), then no lookups per GO.
+    // Unlike playCue(QString) this does not arm on demand; the prearmer must have armed the cue.
+    CueHandle getCueHandle(const QString& cueId) const;     // INVALID_CUE_HANDLE unless armed or playing
+    bool playCue(CueHandle handle, double startTime = 0.0, double fadeInTime = 0.0, FadeCurve curve = FadeCurve::Linear);
+    bool stopCue(CueHandle handle, double fadeOutTime = 0.0, FadeCurve curve = FadeCurve::Linear);
+    bool pauseCue(CueHandle handle);
+    bool resumeCue(CueHandle handle);
+
+    // Fade several cues to a level, all starting on the same sample; returns how many were queued
+    int fadeCues(const QStringList& cueIds, float level, double duration, FadeCurve curve = FadeCurve::Linear);
+
+    // Varispeed (AudioCue::playbackSpeed applies it automatically); Linear is meant for scrubbing
+    bool setCueSpeed(const QString& cueId, double speed, ResamplerQuality quality = ResamplerQuality::Standard);
     void emergencyStop();
 
     // Matrix routing (interfaces with your JUCE MatrixMixer)
@@ -72,7 +108,7 @@ public:
     bool muteOutput(int output, bool mute);
     bool soloOutput(int output, bool solo);
 
-    // Output patch routing (interfaces with your JUCE OutputPatch)
+    // Output patch routing: cue outputs to device outputs (CueOutputPatch)
     bool setPatchRouting(int cueOutput, int deviceOutput, float level);
     float getPatchRouting(int cueOutput, int deviceOutput) const;
 
@@ -86,15 +122,50 @@ public:
         QString currentDevice;
         int activeCues = 0;
         QString lastError;
+        int armedCues = 0;              // Cues with decoded audio attached
+        double lastGoLatencyMs = 0.0;   // playCue() -> first rendered sample
+        double maxGoLatencyMs = 0.0;
+        quint64 underrunCount = 0;      // Streamed-cue read-ahead starvation
+        double averageCallbackMs = 0.0; // Audio callback profiler
+        double worstCallbackMs = 0.0;
+        double peakCallbackLoad = 0.0;  // % of the buffer period
+        QVector<double> stageAverageMs;             // CallbackProfiler::Stage order
+        QVector<quint64> callbackLoadHistogram;     // CallbackProfiler::HISTOGRAM_BUCKET_PERCENT buckets
     };
 
     EngineStatus getStatus() const;
     void updateStatus();
 
+    // Engine internals (offline rendering drives the bridge's callback directly)
+    JuceAudioBridge* getJuceBridge() const { return juceBridge_.get(); }
+
+    // Pre-arming of upcoming cues
+    CuePrearmer* getPrearmer() const { return prearmer_.get(); }
+    CueScheduler* getScheduler() const { return scheduler_.get(); }
+
+    // Metadata and waveform peaks (read by the inspector; generated in the background)
+    MediaCache* getMediaCache() const { return mediaCache_.get(); }
+
+    // Decoded buffers shared by every cue on the same file, cached up to Keys::Audio::MediaPoolBudget
+    MediaPool* getMediaPool() const;
+    void applySettings(Settings* settings);     // Reads the budget now and follows later changes
+
+    // Level meters (display-rate readings; the audio thread never locks for them)
+    LevelMeters* getLevelMeters() const { return levelMeters_.get(); }
+    MeterReading getOutputMeter(int output) const;
+    MeterReading getCueMeter(const QString& cueId) const;
+
     // Performance monitoring
     double getCpuUsage() const;
     int getDropoutCount() const;
     void resetDropoutCount();
+    quint64 getUnderrunCount() const;
+    void resetUnderrunCount();
+
+    // Dropout forensics: profiler state plus the last callbacks, as JSON for bug reports
+    bool exportDiagnostics(const QString& filePath) const;
+    QString diagnosticsDirectory() const { return diagnosticsDirectory_; }     // Automatic dropout dumps
+    void setCallbackStageTiming(bool enabled);
 
     // Cue state tracking
     bool isCuePlaying(const QString& cueId) const;
@@ -105,12 +176,13 @@ public slots:
     // CueManager integration slots
     void onCueAdded(class Cue* cue);
     void onCueRemoved(const QString& cueId);
-    void onCueUpdated(class Cue* cue);
+    void onWorkspaceOpened();     // Bulk loads don't emit cueAdded/cueRemoved per cue
 
     // Audio cue specific slots
     void onAudioCueFileChanged(const QString& cueId, const QString& newFilePath);
     void onAudioCueMatrixChanged(const QString& cueId);
     void onAudioCueLevelsChanged(const QString& cueId);
+    void onCueVoiceAttached(const QString& cueId, CueHandle handle);
 
     // Device management slots
     void refreshAudioDevices();
@@ -128,6 +200,7 @@ signals:
     void audioDeviceChanged(const QString& deviceName);
     void audioDeviceError(const QString& error);
     void availableDevicesChanged();
+    void audioDeviceFailedOver(const QString& fromDevice, const QString& toDevice);
 
     // Playback signals
     void cueStarted(const QString& cueId);
@@ -145,41 +218,33 @@ signals:
     void cpuUsageChanged(double usage);
     void audioDropout();
     void bufferUnderrun();
+    void metersUpdated();           // Once per meter refresh
 
 private slots:
     void onStatusTimer();
-    void onAudioEngineCallback();
+    void onAudioDropout();
     void handleJuceError(const QString& error);
 
 private:
-    // Initialization helpers
-    bool initializeJuceEngine();
-    bool setupAudioDevice();
-    void setupCallbacks();
-    void loadAudioSettings();
-    void saveAudioSettings();
-
     // Cue registration helpers
-    void registerCueWithJuce(AudioCue* cue);
-    void unregisterCueFromJuce(const QString& cueId);
     void updateCueInJuce(AudioCue* cue);
 
     // Status monitoring helpers
     void updateEngineStatus();
-    void checkForErrors();
     void monitorPerformance();
 
-    // Thread safety helpers
-    void executeOnAudioThread(std::function<void()> callback);
-    void executeOnMainThread(std::function<void()> callback);
+    QByteArray diagnosticsReport(const QString& reason) const;
 
-    // Error handling
-    void handleEngineError(const QString& error);
-    void reportCriticalError(const QString& error);
+    // Thread safety helpers (audio-thread work goes through JuceAudioBridge::postCommand)
+    void executeOnMainThread(std::function<void()> callback);
 
     // Core components
     CueManager* cueManager_;
     std::unique_ptr<JuceAudioBridge> juceBridge_;
+    std::unique_ptr<CuePrearmer> prearmer_;     // Declared after the bridge it feeds
+    std::unique_ptr<CueScheduler> scheduler_;   // Sample-accurate GO, pre-waits and chains
+    std::unique_ptr<MediaCache> mediaCache_;
+    std::unique_ptr<LevelMeters> levelMeters_;  // Reads the bridge's meter bank
 
     // Status monitoring
     QTimer* statusTimer_;
@@ -189,18 +254,19 @@ private:
 
     // Cue tracking
     QHash<QString, AudioCue*> registeredCues_;
-    QHash<QString, QString> cueIdToJuceId_;  // Qt cue ID -> JUCE engine ID mapping
     mutable QMutex cueRegistryMutex_;
 
     // Device management
     QStringList availableDevices_;
     QString currentDevice_;
-    QTimer* deviceRefreshTimer_;
 
     // Performance monitoring
     double lastCpuUsage_;
     int lastDropoutCount_;
     QTimer* performanceTimer_;
+    QString diagnosticsDirectory_;
+    qint64 lastDropoutDumpMs_;
+    QThreadPool diagnosticsPool_;       // One thread: dumps are written and pruned in order, off the GUI thread
 
     // Settings
     QString settingsGroup_;
@@ -213,7 +279,8 @@ private:
     // Constants
     static constexpr int STATUS_UPDATE_INTERVAL = 100;      // 100ms status updates
     static constexpr int PERFORMANCE_UPDATE_INTERVAL = 250; // 250ms performance updates
-    static constexpr int DEVICE_REFRESH_INTERVAL = 5000;    // 5s device refresh
+    static constexpr qint64 DROPOUT_DUMP_INTERVAL = 2000;   // At most one automatic dump per 2s
+    static constexpr int MAX_DROPOUT_DUMPS = 50;            // Oldest dumps are pruned beyond this
     static constexpr double CPU_WARNING_THRESHOLD = 80.0;   // 80% CPU warning
     static constexpr double CPU_CRITICAL_THRESHOLD = 95.0;  // 95% CPU critical
 };
\ No newline at end of file
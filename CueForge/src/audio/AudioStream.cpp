@@ -0,0 +1,234 @@
+// src/audio/AudioStream.cpp - Read-ahead ring buffer for one streamed media file
+#include "AudioStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "Resampler.h"
+
+AudioStream::AudioStream(std::unique_ptr<juce::AudioFormatReader> reader, std::int64_t firstFrame, int capacityFrames,
+                         double sourceStep)
+    : reader_(std::move(reader))
+    , numChannels_(reader_ ? static_cast<int>(reader_->numChannels) : 0)
+    , totalFrames_(0)
+    , capacityFrames_(std::max(capacityFrames, CHUNK_FRAMES))
+    , ringStartFrame_(firstFrame)
+    , nextFileFrame_(firstFrame)
+    , sourceStep_(sourceStep > 0.0 ? sourceStep : 1.0)
+    , sourceFrames_(reader_ ? reader_->lengthInSamples : 0)
+    , nextSourceFrame_(0)
+    , resampler_()
+    , sourceScratch_()
+    , seekFrame_(firstFrame)
+{
+    ring_.assign(static_cast<std::size_t>(numChannels_) * capacityFrames_, 0.0f);
+
+    if (sourceStep_ == 1.0 || numChannels_ == 0) {
+        totalFrames_ = sourceFrames_;
+        return;
+    }
+
+    // Same tier as the decoded head, so the join is inaudible
+    totalFrames_ = static_cast<std::int64_t>(std::ceil(sourceFrames_ / sourceStep_));
+    const int maxSourceFrames = static_cast<int>(std::ceil(CHUNK_FRAMES * sourceStep_)) + Resampler::MAX_TAPS;
+    resampler_ = std::make_unique<Resampler>(ResamplerQuality::High, numChannels_, maxSourceFrames, sourceStep_);
+    sourceScratch_.resize(static_cast<std::size_t>(numChannels_) * maxSourceFrames);
+    seekSource(firstFrame);
+}
+
+AudioStream::~AudioStream() = default;
+
+// Audio Thread
+
+int AudioStream::read(std::int64_t frame, float* const* destination, int numDestChannels, int numFrames)
+{
+    if (isSeekPending()) {
+        return 0;
+    }
+
+    std::int64_t readCount = readCount_.load(std::memory_order_relaxed);
+    const std::int64_t writeCount = writeCount_.load(std::memory_order_acquire);
+    std::int64_t head = ringStartFrame_ + readCount;
+
+    if (frame < head) {
+        requestSeek(frame);
+        return 0;
+    }
+
+    // Playback ran ahead during an underrun: drop what it skipped over
+    if (frame > head) {
+        const std::int64_t skip = std::min(frame - head, writeCount - readCount);
+        readCount += skip;
+        head += skip;
+        readCount_.store(readCount, std::memory_order_release);
+
+        if (frame > head) {
+            requestSeek(frame);
+            return 0;
+        }
+    }
+
+    const int available = static_cast<int>(std::min<std::int64_t>(numFrames, writeCount - readCount));
+    const int ringIndex = static_cast<int>(readCount % capacityFrames_);
+    const int firstPart = std::min(available, capacityFrames_ - ringIndex);
+    const int channels = std::min(numChannels_, numDestChannels);
+
+    for (int channel = 0; channel < channels; ++channel) {
+        const float* source = ring_.data() + static_cast<std::size_t>(channel) * capacityFrames_;
+        std::memcpy(destination[channel], source + ringIndex, sizeof(float) * firstPart);
+        std::memcpy(destination[channel] + firstPart, source, sizeof(float) * (available - firstPart));
+    }
+
+    readCount_.store(readCount + available, std::memory_order_release);
+    return available;
+}
+
+void AudioStream::prime(std::int64_t frame)
+{
+    if (isSeekPending()) {
+        if (seekFrame_.load(std::memory_order_relaxed) != frame) {
+            requestSeek(frame);
+        }
+        return;
+    }
+
+    if (readHeadFrame() != frame) {
+        requestSeek(frame);
+    }
+}
+
+bool AudioStream::isSeekPending() const
+{
+    return seekAck_.load(std::memory_order_acquire) != seekRequest_.load(std::memory_order_relaxed);
+}
+
+void AudioStream::requestSeek(std::int64_t frame)
+{
+    seekFrame_.store(frame, std::memory_order_relaxed);
+    seekRequest_.fetch_add(1, std::memory_order_release);
+}
+
+std::int64_t AudioStream::readHeadFrame() const
+{
+    return ringStartFrame_ + readCount_.load(std::memory_order_relaxed);
+}
+
+// Disk Thread
+
+bool AudioStream::service(std::vector<float>& scratch)
+{
+    if (!reader_) {
+        return false;
+    }
+
+    bool worked = false;
+
+    // The consumer stays off the ring until the ack, so it is safe to reset here
+    const std::uint32_t request = seekRequest_.load(std::memory_order_acquire);
+    if (request != seekAck_.load(std::memory_order_relaxed)) {
+        const std::int64_t frame = std::clamp<std::int64_t>(seekFrame_.load(std::memory_order_relaxed), 0, totalFrames_);
+        readCount_.store(0, std::memory_order_relaxed);
+        writeCount_.store(0, std::memory_order_relaxed);
+        ringStartFrame_ = frame;
+        nextFileFrame_ = frame;
+        if (resampler_) {
+            seekSource(frame);
+        }
+        seekAck_.store(request, std::memory_order_release);
+        worked = true;
+    }
+
+    if (nextFileFrame_ >= totalFrames_) {
+        return worked;
+    }
+
+    const std::int64_t writeCount = writeCount_.load(std::memory_order_relaxed);
+    const std::int64_t readCount = readCount_.load(std::memory_order_acquire);
+    const int freeFrames = capacityFrames_ - static_cast<int>(writeCount - readCount);
+    const int chunk = static_cast<int>(std::min<std::int64_t>({ freeFrames, CHUNK_FRAMES, totalFrames_ - nextFileFrame_ }));
+
+    // Wait for a reasonable gap rather than trickling tiny reads
+    if (chunk <= 0 || (chunk < CHUNK_FRAMES && nextFileFrame_ + chunk < totalFrames_)) {
+        return worked;
+    }
+
+    scratch.resize(static_cast<std::size_t>(numChannels_) * chunk);
+    float* destinations[64] = {};
+    const int channels = std::min(numChannels_, 64);
+    for (int channel = 0; channel < channels; ++channel) {
+        destinations[channel] = scratch.data() + static_cast<std::size_t>(channel) * chunk;
+    }
+
+    const bool ok = resampler_ ? readConverted(destinations, channels, chunk)
+                               : reader_->read(destinations, channels, nextFileFrame_, chunk);
+    if (!ok) {
+        std::fill(scratch.begin(), scratch.end(), 0.0f);
+    }
+
+    // A seek that arrived mid-read makes this chunk stale
+    if (seekRequest_.load(std::memory_order_acquire) != seekAck_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    const int ringIndex = static_cast<int>(writeCount % capacityFrames_);
+    const int firstPart = std::min(chunk, capacityFrames_ - ringIndex);
+    for (int channel = 0; channel < channels; ++channel) {
+        float* target = ring_.data() + static_cast<std::size_t>(channel) * capacityFrames_;
+        std::memcpy(target + ringIndex, destinations[channel], sizeof(float) * firstPart);
+        std::memcpy(target, destinations[channel] + firstPart, sizeof(float) * (chunk - firstPart));
+    }
+
+    writeCount_.store(writeCount + chunk, std::memory_order_release);
+    nextFileFrame_ += chunk;
+    return true;
+}
+
+int AudioStream::bufferedFrames() const
+{
+    return static_cast<int>(writeCount_.load(std::memory_order_acquire) - readCount_.load(std::memory_order_acquire));
+}
+
+// Rate Conversion (disk thread)
+
+void AudioStream::seekSource(std::int64_t frame)
+{
+    // Start a few file frames early so the filter has real history at the seek point
+    const double sourcePosition = frame * sourceStep_;
+    const std::int64_t start = std::max<std::int64_t>(0, static_cast<std::int64_t>(sourcePosition) - resampler_->taps() / 2);
+    resampler_->reset(sourcePosition - start);
+    nextSourceFrame_ = start;
+}
+
+bool AudioStream::readConverted(float* const* destinations, int channels, int numFrames)
+{
+    const int maxSourceFrames = static_cast<int>(sourceScratch_.size() / numChannels_);
+    const int wanted = std::min(resampler_->inputFramesFor(numFrames, sourceStep_), maxSourceFrames);
+
+    // Past the end of the file the filter is flushed with silence
+    const int fromFile = static_cast<int>(std::clamp<std::int64_t>(sourceFrames_ - nextSourceFrame_, 0, wanted));
+    float* sources[64] = {};
+    for (int channel = 0; channel < numChannels_ && channel < 64; ++channel) {
+        sources[channel] = sourceScratch_.data() + static_cast<std::size_t>(channel) * maxSourceFrames;
+        std::fill(sources[channel] + fromFile, sources[channel] + wanted, 0.0f);
+    }
+
+    bool ok = true;
+    if (fromFile > 0) {
+        ok = reader_->read(sources, std::min(numChannels_, 64), nextSourceFrame_, fromFile);
+    }
+    nextSourceFrame_ += wanted;
+
+    // The resampler writes every channel; any the caller doesn't take land in the spent source scratch
+    float* outputs[64] = {};
+    for (int channel = 0; channel < numChannels_ && channel < 64; ++channel) {
+        outputs[channel] = channel < channels ? destinations[channel] : sources[channel];
+    }
+    const int made = resampler_->process(sources, numChannels_, wanted, outputs, numFrames, sourceStep_);
+    for (int channel = 0; channel < channels; ++channel) {
+        std::fill(destinations[channel] + made, destinations[channel] + numFrames, 0.0f);
+    }
+    return ok;
+}
@@ -0,0 +1,101 @@
+// src/audio/AudioStream.h - Read-ahead ring buffer for one streamed media file
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace juce { class AudioFormatReader; }
+class Resampler;
+
+/**
+ * @brief Single-producer/single-consumer read-ahead buffer for a streamed cue
+ *
+ * The disk thread (DiskStreamer) is the only producer and the audio callback
+ * the only consumer. The ring holds consecutive file frames starting at
+ * ringStartFrame_; when playback wants a frame outside what is buffered the
+ * audio thread requests a seek, and the disk thread resets and refills the
+ * ring before acknowledging it. Nothing on the consumer side locks or
+ * allocates.
+ *
+ * When the file's rate differs from the device's, the disk thread converts
+ * as it reads (sourceStep = file frames per stream frame), so frames in the
+ * ring, seeks and totalFrames() are all at the device rate.
+ */
+class AudioStream
+{
+public:
+    AudioStream(std::unique_ptr<juce::AudioFormatReader> reader, std::int64_t firstFrame, int capacityFrames,
+                double sourceStep = 1.0);
+    ~AudioStream();
+
+    AudioStream(const AudioStream&) = delete;
+    AudioStream& operator=(const AudioStream&) = delete;
+
+    int numChannels() const { return numChannels_; }
+    std::int64_t totalFrames() const { return totalFrames_; }
+    int capacityFrames() const { return capacityFrames_; }
+
+    // Audio thread
+
+    /**
+     * @brief Copy buffered frames starting at file frame into destination
+     * @return Frames copied; fewer than numFrames means the ring ran dry
+     */
+    int read(std::int64_t frame, float* const* destination, int numDestChannels, int numFrames);
+
+    /**
+     * @brief Make sure buffering starts at frame (e.g. on Play), seeking if needed
+     */
+    void prime(std::int64_t frame);
+
+    bool isSeekPending() const;
+
+    // Disk thread
+
+    /**
+     * @brief Handle a pending seek and top the ring up by at most one chunk
+     * @return true if any work was done
+     */
+    bool service(std::vector<float>& scratch);
+    bool isConverting() const { return resampler_ != nullptr; }
+
+    /**
+     * @brief Frames buffered ahead of the read head (approximate off the audio thread)
+     */
+    int bufferedFrames() const;
+
+private:
+    void requestSeek(std::int64_t frame);
+    std::int64_t readHeadFrame() const;
+    void seekSource(std::int64_t frame);                        // Disk thread
+    bool readConverted(float* const* destinations, int channels, int numFrames);
+
+    std::unique_ptr<juce::AudioFormatReader> reader_;
+    int numChannels_;
+    std::int64_t totalFrames_;
+    int capacityFrames_;
+    std::vector<float> ring_;                   // Channel-major: numChannels x capacityFrames
+
+    // Ring indices are monotonic frame counts since the last seek
+    alignas(64) std::atomic<std::int64_t> readCount_{ 0 };
+    alignas(64) std::atomic<std::int64_t> writeCount_{ 0 };
+
+    // Written by the disk thread before seekAck_ is released
+    std::int64_t ringStartFrame_;
+    std::int64_t nextFileFrame_;                // Stream (device-rate) frame
+
+    // Rate conversion (disk thread only; null resampler when the rates match)
+    double sourceStep_;
+    std::int64_t sourceFrames_;
+    std::int64_t nextSourceFrame_;
+    std::unique_ptr<Resampler> resampler_;
+    std::vector<float> sourceScratch_;
+
+    std::atomic<std::int64_t> seekFrame_;
+    std::atomic<std::uint32_t> seekRequest_{ 0 };
+    std::atomic<std::uint32_t> seekAck_{ 0 };
+
+    static constexpr int CHUNK_FRAMES = 8192;   // Frames per disk read
+};
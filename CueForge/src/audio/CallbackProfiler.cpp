@@ -0,0 +1,256 @@
+// src/audio/CallbackProfiler.cpp - Audio callback timing and dropout forensics
+#include "CallbackProfiler.h"
+
+#include <QJsonArray>
+#include <algorithm>
+
+namespace {
+
+constexpr const char* STAGE_NAMES[CallbackProfiler::STAGE_COUNT] = { "commands", "disk", "resample", "fade", "mix", "patch", "meter" };
+
+constexpr double NS_PER_MS = 1.0e6;
+
+// Single writer: plain load/store is enough and cheaper than a locked RMW
+template <typename T>
+void bumpCounter(std::atomic<T>& counter, T amount)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+template <typename T>
+void raiseMaximum(std::atomic<T>& maximum, T value)
+{
+    if (value > maximum.load(std::memory_order_relaxed)) {
+        maximum.store(value, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+CallbackProfiler::CallbackProfiler()
+    : current_()
+    , previousStartNs_(0)
+    , ring_()
+    , published_(0)
+    , callbacks_(0)
+    , dropouts_(0)
+    , underruns_(0)
+    , totalNs_(0)
+    , worstNs_(0)
+    , recentLoad_(0.0)
+    , peakLoad_(0.0)
+    , stageSamples_(0)
+    , stageTiming_(true)
+    , resetRequested_(false)
+{
+    for (auto& bucket : histogram_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        stageTotalNs_[stage].store(0, std::memory_order_relaxed);
+        stageWorstNs_[stage].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Audio Thread
+
+void CallbackProfiler::beginCallback(std::int64_t startNs, int numSamples, double sampleRate)
+{
+    if (resetRequested_.exchange(false, std::memory_order_acq_rel)) {
+        applyReset();
+    }
+
+    current_ = CallbackRecord();
+    current_.startNs = startNs;
+    current_.numSamples = numSamples;
+    current_.periodNs = sampleRate > 0.0 ? static_cast<std::int64_t>(numSamples * 1.0e9 / sampleRate) : 0;
+    current_.gapNs = previousStartNs_ > 0 ? startNs - previousStartNs_ : 0;
+    previousStartNs_ = startNs;
+}
+
+bool CallbackProfiler::endCallback(std::int64_t endNs, int activeVoices)
+{
+    CallbackRecord& record = current_;
+    record.durationNs = std::max<std::int64_t>(0, endNs - record.startNs);
+    record.activeVoices = activeVoices;
+
+    if (record.periodNs > 0) {
+        if (record.durationNs > record.periodNs) {
+            record.flags |= Overrun;
+        }
+        if (record.gapNs > static_cast<std::int64_t>(record.periodNs * LATE_FACTOR)) {
+            record.flags |= Late;
+        }
+    }
+    const bool dropout = (record.flags & (Overrun | Late)) != 0;
+
+    // Aggregates
+    const double load = record.load();
+    bumpCounter<std::uint64_t>(callbacks_, 1);
+    bumpCounter<std::int64_t>(totalNs_, record.durationNs);
+    raiseMaximum<std::int64_t>(worstNs_, record.durationNs);
+    raiseMaximum(peakLoad_, load);
+    recentLoad_.store(recentLoad_.load(std::memory_order_relaxed) * (1.0 - LOAD_SMOOTHING) + load * LOAD_SMOOTHING,
+                      std::memory_order_relaxed);
+    if (dropout) {
+        bumpCounter<std::uint64_t>(dropouts_, 1);
+    }
+    if (record.flags & Underrun) {
+        bumpCounter<std::uint64_t>(underruns_, 1);
+    }
+
+    const int bucket = std::min(HISTOGRAM_BUCKETS - 1, static_cast<int>(load * 100.0 / HISTOGRAM_BUCKET_PERCENT));
+    bumpCounter<std::uint64_t>(histogram_[bucket], 1);
+
+    if (stageTimingEnabled()) {
+        bumpCounter<std::uint64_t>(stageSamples_, 1);
+        for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+            bumpCounter(stageTotalNs_[stage], record.stageNs[stage]);
+            raiseMaximum(stageWorstNs_[stage], record.stageNs[stage]);
+        }
+    }
+
+    // Ring slot, seqlock-style: readers retry or skip a slot caught mid-write
+    const std::uint64_t index = published_.load(std::memory_order_relaxed);
+    Slot& slot = ring_[index % RING_SIZE];
+    const std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.record = record;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    published_.store(index + 1, std::memory_order_release);
+
+    return dropout;
+}
+
+void CallbackProfiler::applyReset()
+{
+    callbacks_.store(0, std::memory_order_relaxed);
+    dropouts_.store(0, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    totalNs_.store(0, std::memory_order_relaxed);
+    worstNs_.store(0, std::memory_order_relaxed);
+    peakLoad_.store(0.0, std::memory_order_relaxed);
+    stageSamples_.store(0, std::memory_order_relaxed);
+    for (auto& bucket : histogram_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        stageTotalNs_[stage].store(0, std::memory_order_relaxed);
+        stageWorstNs_[stage].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Snapshots
+
+CallbackProfiler::Snapshot CallbackProfiler::snapshot(bool includeRecent) const
+{
+    Snapshot result;
+    result.callbacks = callbacks_.load(std::memory_order_relaxed);
+    result.dropouts = dropouts_.load(std::memory_order_relaxed);
+    result.underruns = underruns_.load(std::memory_order_relaxed);
+    result.worstNs = worstNs_.load(std::memory_order_relaxed);
+    result.averageNs = result.callbacks > 0 ? static_cast<double>(totalNs_.load(std::memory_order_relaxed)) / result.callbacks : 0.0;
+    result.recentLoad = recentLoad_.load(std::memory_order_relaxed);
+    result.peakLoad = peakLoad_.load(std::memory_order_relaxed);
+    result.stageTiming = stageTimingEnabled();
+
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+        result.loadHistogram[bucket] = histogram_[bucket].load(std::memory_order_relaxed);
+    }
+
+    const std::uint64_t stageSamples = stageSamples_.load(std::memory_order_relaxed);
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        const auto total = static_cast<double>(stageTotalNs_[stage].load(std::memory_order_relaxed));
+        result.stageAverageNs[stage] = stageSamples > 0 ? total / stageSamples : 0.0;
+        result.stageWorstNs[stage] = stageWorstNs_[stage].load(std::memory_order_relaxed);
+    }
+
+    if (!includeRecent) {
+        return result;
+    }
+
+    const std::uint64_t end = published_.load(std::memory_order_acquire);
+    const std::uint64_t begin = end > static_cast<std::uint64_t>(RING_SIZE) ? end - RING_SIZE : 0;
+    result.recent.reserve(static_cast<std::size_t>(end - begin));
+
+    for (std::uint64_t index = begin; index < end; ++index) {
+        const Slot& slot = ring_[index % RING_SIZE];
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            const std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            const CallbackRecord record = slot.record;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                result.recent.push_back(record);
+                break;
+            }
+        }
+    }
+
+    // The writer may have lapped the oldest slots while we copied
+    std::sort(result.recent.begin(), result.recent.end(), [](const CallbackRecord& a, const CallbackRecord& b) {
+        return a.startNs < b.startNs;
+    });
+    return result;
+}
+
+const char* CallbackProfiler::stageName(Stage stage)
+{
+    const int index = static_cast<int>(stage);
+    return index >= 0 && index < STAGE_COUNT ? STAGE_NAMES[index] : "unknown";
+}
+
+QJsonObject CallbackProfiler::toJson(const Snapshot& snapshot)
+{
+    QJsonObject json;
+    json["callbacks"] = static_cast<qint64>(snapshot.callbacks);
+    json["dropouts"] = static_cast<qint64>(snapshot.dropouts);
+    json["underruns"] = static_cast<qint64>(snapshot.underruns);
+    json["averageMs"] = snapshot.averageNs / NS_PER_MS;
+    json["worstMs"] = snapshot.worstNs / NS_PER_MS;
+    json["recentLoad"] = snapshot.recentLoad;
+    json["peakLoad"] = snapshot.peakLoad;
+
+    QJsonArray histogram;
+    for (std::uint64_t count : snapshot.loadHistogram) {
+        histogram.append(static_cast<qint64>(count));
+    }
+    json["loadHistogram"] = histogram;
+    json["loadHistogramBucketPercent"] = HISTOGRAM_BUCKET_PERCENT;
+
+    QJsonObject stages;
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        QJsonObject timing;
+        timing["averageMs"] = snapshot.stageAverageNs[stage] / NS_PER_MS;
+        timing["worstMs"] = snapshot.stageWorstNs[stage] / NS_PER_MS;
+        stages[STAGE_NAMES[stage]] = timing;
+    }
+    json["stages"] = stages;
+    json["stageTiming"] = snapshot.stageTiming;
+
+    QJsonArray recent;
+    for (const CallbackRecord& record : snapshot.recent) {
+        QJsonObject entry;
+        entry["startNs"] = static_cast<qint64>(record.startNs);
+        entry["durationMs"] = record.durationNs / NS_PER_MS;
+        entry["periodMs"] = record.periodNs / NS_PER_MS;
+        entry["gapMs"] = record.gapNs / NS_PER_MS;
+        entry["samples"] = record.numSamples;
+        entry["voices"] = record.activeVoices;
+        entry["overrun"] = (record.flags & Overrun) != 0;
+        entry["late"] = (record.flags & Late) != 0;
+        entry["underrun"] = (record.flags & Underrun) != 0;
+
+        QJsonArray stageMs;
+        for (std::int64_t ns : record.stageNs) {
+            stageMs.append(ns / NS_PER_MS);
+        }
+        entry["stageMs"] = stageMs;
+        recent.append(entry);
+    }
+    json["recent"] = recent;
+    return json;
+}
@@ -0,0 +1,133 @@
+// src/audio/CallbackProfiler.h - Audio callback timing and dropout forensics
+#pragma once
+
+#include <QJsonObject>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Wait-free timing instrumentation for the audio callback
+ *
+ * The callback reports its start/end times and, when stage timing is on,
+ * how long each stage took. The profiler keeps a load histogram, running
+ * and worst-case figures, and a ring of the last RING_SIZE callbacks that
+ * can be snapshotted from any thread, e.g. to dump the moments around a
+ * dropout. The audio thread only ever stores into preallocated slots.
+ *
+ * A dropout is a callback that took longer than its buffer lasts (Overrun),
+ * or one that started more than LATE_FACTOR periods after the previous one
+ * (Late: something outside the callback held the device thread).
+ */
+class CallbackProfiler
+{
+public:
+    enum class Stage : std::uint8_t {
+        Commands,   // Draining the command queue and timeline
+        Disk,       // Gathering voice sources: RAM head copy and stream reads
+        Resample,   // Varispeed filtering
+        Fade,       // Crosspoint fade advance
+        Mix,        // Matrix mix kernels
+        Patch,      // Output patch: cue-output buses to device outputs
+        Meter,      // Level measurement
+        Count
+    };
+    static constexpr int STAGE_COUNT = static_cast<int>(Stage::Count);
+    static constexpr int HISTOGRAM_BUCKETS = 32;
+
+    enum RecordFlag : std::uint8_t {
+        Overrun = 1 << 0,
+        Late = 1 << 1,
+        Underrun = 1 << 2       // A streamed voice ran out of read-ahead
+    };
+
+    struct CallbackRecord {
+        std::int64_t startNs = 0;       // steady_clock
+        std::int64_t durationNs = 0;
+        std::int64_t periodNs = 0;      // Buffer length at the current rate
+        std::int64_t gapNs = 0;         // Since the previous callback started
+        std::int32_t numSamples = 0;
+        std::int32_t activeVoices = 0;
+        std::uint8_t flags = 0;
+        std::array<std::int64_t, STAGE_COUNT> stageNs{};
+
+        double load() const { return periodNs > 0 ? static_cast<double>(durationNs) / periodNs : 0.0; }
+    };
+
+    struct Snapshot {
+        std::uint64_t callbacks = 0;
+        std::uint64_t dropouts = 0;
+        std::uint64_t underruns = 0;
+        double averageNs = 0.0;
+        std::int64_t worstNs = 0;
+        double recentLoad = 0.0;        // Smoothed, 0..1 (exceeds 1 when overrunning)
+        double peakLoad = 0.0;
+        std::array<std::uint64_t, HISTOGRAM_BUCKETS> loadHistogram{};    // HISTOGRAM_BUCKET_PERCENT wide
+        std::array<double, STAGE_COUNT> stageAverageNs{};
+        std::array<std::int64_t, STAGE_COUNT> stageWorstNs{};
+        bool stageTiming = false;
+        std::vector<CallbackRecord> recent;     // Oldest first
+    };
+
+    CallbackProfiler();
+
+    CallbackProfiler(const CallbackProfiler&) = delete;
+    CallbackProfiler& operator=(const CallbackProfiler&) = delete;
+
+    // Audio thread
+    void beginCallback(std::int64_t startNs, int numSamples, double sampleRate);
+    void addStageTime(Stage stage, std::int64_t ns) { current_.stageNs[static_cast<int>(stage)] += ns; }
+    void markUnderrun() { current_.flags |= Underrun; }
+    void resumeAfterGap() { previousStartNs_ = 0; }     // Next callback isn't judged Late (e.g. after a device switch)
+    bool endCallback(std::int64_t endNs, int activeVoices);    // true if this callback dropped out
+    bool stageTimingEnabled() const { return stageTiming_.load(std::memory_order_relaxed); }
+    const CallbackRecord& lastRecord() const { return current_; }    // Audio thread, after endCallback()
+
+    // Any thread
+    void setStageTiming(bool enabled) { stageTiming_.store(enabled, std::memory_order_relaxed); }
+    void reset() { resetRequested_.store(true, std::memory_order_release); }    // Applied by the next callback
+    Snapshot snapshot(bool includeRecent = true) const;
+    std::uint64_t dropoutCount() const { return dropouts_.load(std::memory_order_relaxed); }
+    double recentLoad() const { return recentLoad_.load(std::memory_order_relaxed); }
+
+    static const char* stageName(Stage stage);
+    static QJsonObject toJson(const Snapshot& snapshot);
+
+    // Constants
+    static constexpr int RING_SIZE = 512;                 // ~2.7 s of 256-frame callbacks at 48k
+    static constexpr int HISTOGRAM_BUCKET_PERCENT = 5;    // Last bucket collects everything >= 155%
+    static constexpr double LATE_FACTOR = 1.5;
+    static constexpr double LOAD_SMOOTHING = 0.05;        // Per callback
+
+private:
+    struct Slot {
+        std::atomic<std::uint32_t> sequence{ 0 };   // Odd while the audio thread is writing
+        CallbackRecord record;
+    };
+
+    void applyReset();
+
+    // Audio thread only
+    CallbackRecord current_;
+    std::int64_t previousStartNs_;
+
+    std::array<Slot, RING_SIZE> ring_;
+    std::atomic<std::uint64_t> published_;      // Records written so far (next slot = published_ % RING_SIZE)
+
+    // Aggregates (single writer, relaxed readers)
+    std::atomic<std::uint64_t> callbacks_;
+    std::atomic<std::uint64_t> dropouts_;
+    std::atomic<std::uint64_t> underruns_;
+    std::atomic<std::int64_t> totalNs_;
+    std::atomic<std::int64_t> worstNs_;
+    std::atomic<double> recentLoad_;
+    std::atomic<double> peakLoad_;
+    std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> histogram_;
+    std::array<std::atomic<std::int64_t>, STAGE_COUNT> stageTotalNs_;
+    std::array<std::atomic<std::int64_t>, STAGE_COUNT> stageWorstNs_;
+    std::atomic<std::uint64_t> stageSamples_;   // Callbacks timed with stage timing on
+
+    std::atomic<bool> stageTiming_;
+    std::atomic<bool> resetRequested_;
+};
@@ -0,0 +1,287 @@
+// src/audio/CuePrearmer.cpp - Background pre-arming of upcoming audio cues
+#include "CuePrearmer.h"
+
+#include <QDebug>
+#include <QMetaObject>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QThread>
+#include <utility>
+
+#include "JuceAudioBridge.h"
+#include "DecodedAudio.h"
+#include "MediaPool.h"
+#include "CueManager.h"
+#include "AudioCue.h"
+#include "GroupCue.h"
+
+CuePrearmer::CuePrearmer(CueManager* cueManager, JuceAudioBridge* bridge, QObject* parent)
+    : QObject(parent)
+    , cueManager_(cueManager)
+    , bridge_(bridge)
+    , nextGeneration_(1)
+    , prearmDepth_(DEFAULT_PREARM_DEPTH)
+    , preloadSeconds_(DEFAULT_PRELOAD_SECONDS)
+{
+    ioPool_.setMaxThreadCount(MAX_IO_THREADS);
+    burstPool_.setMaxThreadCount(QThread::idealThreadCount());
+
+    // A finished cue outside the window gives its voice back. Queued, so the cue has left
+    // its executing state by the time refresh() looks at it
+    if (bridge_) {
+        const auto onVoiceEnded = [this](const QString& cueId) {
+            releaseHold(cueId);
+            refresh();
+        };
+        connect(bridge_, &JuceAudioBridge::cueFinished, this, onVoiceEnded, Qt::QueuedConnection);
+        connect(bridge_, &JuceAudioBridge::cueStopped, this, onVoiceEnded, Qt::QueuedConnection);
+    }
+}
+
+CuePrearmer::~CuePrearmer()
+{
+    // Workers post back to this object, so they must be gone first
+    ioPool_.clear();
+    burstPool_.clear();
+    ioPool_.waitForDone();
+    burstPool_.waitForDone();
+}
+
+void CuePrearmer::setPrearmDepth(int depth)
+{
+    prearmDepth_ = qMax(0, depth);
+    refresh();
+}
+
+void CuePrearmer::setPreloadSeconds(double seconds)
+{
+    preloadSeconds_ = qMax(0.0, seconds);
+}
+
+bool CuePrearmer::isArmed(const QString& cueId, const QString& filePath, double startTime) const
+{
+    auto it = armStates_.constFind(cueId);
+    return it != armStates_.constEnd() && it->ready && matches(it.value(), filePath, startTime);
+}
+
+int CuePrearmer::armedCount() const
+{
+    int count = 0;
+    for (const ArmState& state : armStates_) {
+        if (state.ready) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool CuePrearmer::ensureArmed(const QString& cueId, const QString& filePath, double startTime)
+{
+    if (isArmed(cueId, filePath, startTime)) {
+        return true;
+    }
+
+    if (!bridge_ || bridge_->acquireCueHandle(cueId) < 0) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const double sampleRate = bridge_->getClockSampleRate();
+    const DecodedAudio* audio = bridge_->getMediaPool()->acquire(filePath, startTime, preloadSeconds_,
+                                                                 bridge_->getResidentThresholdBytes(), sampleRate);
+    if (!audio) {
+        armStates_.remove(cueId);
+        bridge_->releaseCueHandle(cueId);
+        emit cueArmFailed(cueId, QString("Could not decode %1").arg(filePath));
+        return false;
+    }
+
+    // New generation so an in-flight background preload for this cue is ignored
+    ArmState& state = armStates_[cueId];
+    state.filePath = filePath;
+    state.startTime = startTime;
+    state.sampleRate = sampleRate;
+    state.generation = nextGeneration_++;
+    state.ready = bridge_->attachDecodedAudio(cueId, audio);
+
+    qWarning() << "Cue" << cueId << "was not pre-armed; synchronous load took" << timer.elapsed() << "ms";
+
+    if (state.ready) {
+        emit cueArmed(cueId);
+    }
+    return state.ready;
+}
+
+bool CuePrearmer::requestArm(const QString& cueId, const QString& filePath, double startTime)
+{
+    if (!bridge_) {
+        return false;
+    }
+
+    // A matching preload already in flight is simply awaited
+    auto it = armStates_.find(cueId);
+    if (it == armStates_.end() || !matches(it.value(), filePath, startTime)) {
+        if (!startPreload(cueId, filePath, startTime, burstPool_)) {
+            return false;
+        }
+        it = armStates_.find(cueId);
+        qDebug() << "Cue" << cueId << "was not pre-armed; arming it in the background";
+    }
+
+    it->held = true;
+    return true;
+}
+
+void CuePrearmer::releaseHold(const QString& cueId)
+{
+    auto it = armStates_.find(cueId);
+    if (it != armStates_.end()) {
+        it->held = false;
+    }
+}
+
+void CuePrearmer::disarm(const QString& cueId)
+{
+    if (armStates_.remove(cueId) == 0) {
+        return;
+    }
+    if (bridge_) {
+        bridge_->releaseCueHandle(cueId);   // The voice retires its audio on release
+    }
+    emit cueDisarmed(cueId);
+}
+
+void CuePrearmer::disarmAll()
+{
+    const QStringList cueIds = armStates_.keys();
+    for (const QString& cueId : cueIds) {
+        disarm(cueId);
+    }
+}
+
+// Window Management
+
+void CuePrearmer::onStandByCueChanged(const QString& cueId)
+{
+    Q_UNUSED(cueId)
+    refresh();
+}
+
+void CuePrearmer::refresh()
+{
+    if (!cueManager_ || !bridge_) {
+        return;
+    }
+
+    const QList<Cue*> upcoming = cueManager_->getUpcomingExecutableCues(prearmDepth_);
+
+    // A fire-all group starts all of its children on GO, so they are all in the window
+    QList<Cue*> candidates;
+    for (Cue* cue : upcoming) {
+        candidates.append(cue);
+        if (GroupCue* group = qobject_cast<GroupCue*>(cue)) {
+            candidates.append(group->children());
+        }
+    }
+
+    QSet<QString> window;
+    for (Cue* cue : std::as_const(candidates)) {
+        AudioCue* audioCue = qobject_cast<AudioCue*>(cue);
+        if (!audioCue || audioCue->filePath().isEmpty()) {
+            continue;
+        }
+
+        const QString cueId = audioCue->id();
+        window.insert(cueId);
+
+        auto it = armStates_.constFind(cueId);
+        if (it != armStates_.constEnd() && matches(it.value(), audioCue->filePath(), audioCue->startTime())) {
+            continue; // Armed or already in flight
+        }
+
+        startPreload(cueId, audioCue->filePath(), audioCue->startTime(), ioPool_);
+    }
+
+    // Release cues that left the window, unless they are triggered or sounding
+    const QStringList armedIds = armStates_.keys();
+    for (const QString& cueId : armedIds) {
+        if (window.contains(cueId) || armStates_.value(cueId).held) {
+            continue;
+        }
+
+        Cue* cue = cueManager_->getCue(cueId);
+        if (cue && cue->isExecuting()) {
+            continue;
+        }
+
+        disarm(cueId);
+    }
+}
+
+bool CuePrearmer::startPreload(const QString& cueId, const QString& filePath, double startTime, QThreadPool& pool)
+{
+    if (bridge_->acquireCueHandle(cueId) < 0) {
+        return false;
+    }
+
+    ArmState& state = armStates_[cueId];
+    state.filePath = filePath;
+    state.startTime = startTime;
+    state.sampleRate = bridge_->getClockSampleRate();
+    state.generation = nextGeneration_++;
+    state.ready = false;
+
+    const quint64 generation = state.generation;
+    const double seconds = preloadSeconds_;
+    const std::int64_t residentThreshold = bridge_->getResidentThresholdBytes();
+    const double sampleRate = state.sampleRate;
+
+    MediaPool* media = bridge_->getMediaPool();
+
+    pool.start([this, media, cueId, filePath, startTime, seconds, residentThreshold, sampleRate, generation]() {
+        // Shared holder gives the reference back if the result is never delivered
+        const std::shared_ptr<const DecodedAudio*> holder(
+            new const DecodedAudio*(media->acquire(filePath, startTime, seconds, residentThreshold, sampleRate)),
+            [media](const DecodedAudio** audio) {
+                media->release(*audio);
+                delete audio;
+            });
+
+        QMetaObject::invokeMethod(this, [this, cueId, generation, holder]() {
+            onPreloadFinished(cueId, generation, std::exchange(*holder, nullptr));
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void CuePrearmer::onPreloadFinished(const QString& cueId, quint64 generation, const DecodedAudio* audio)
+{
+    auto it = armStates_.find(cueId);
+    if (it == armStates_.end() || it->generation != generation) {
+        bridge_->getMediaPool()->release(audio);
+        return; // Superseded or disarmed while decoding
+    }
+
+    if (!audio) {
+        const QString filePath = it->filePath;
+        armStates_.erase(it);
+        bridge_->releaseCueHandle(cueId);
+        emit cueArmFailed(cueId, QString("Could not decode %1").arg(filePath));
+        return;
+    }
+
+    it->ready = bridge_->attachDecodedAudio(cueId, audio);
+    if (it->ready) {
+        qDebug() << "Pre-armed cue" << cueId;
+        emit cueArmed(cueId);
+    }
+}
+
+bool CuePrearmer::matches(const ArmState& state, const QString& filePath, double startTime) const
+{
+    // Audio converted for another device rate has to be decoded again
+    return state.filePath == filePath && qAbs(state.startTime - startTime) < 0.0005
+        && state.sampleRate == bridge_->getClockSampleRate();
+}
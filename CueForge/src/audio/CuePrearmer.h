@@ -0,0 +1,107 @@
+// src/audio/CuePrearmer.h - Background pre-arming of upcoming audio cues
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QThreadPool>
+#include <memory>
+
+// Forward declarations
+class CueManager;
+class JuceAudioBridge;
+struct DecodedAudio;
+
+/**
+ * @brief Keeps the next few executable audio cues decoded and attached
+ *
+ * Whenever the standby cue changes, the next prearmDepth() executable audio
+ * cues get their opening seconds decoded on a small I/O pool and attached to
+ * their voices. GO then only posts a Play command. Cues that drop out of the
+ * window (and aren't playing) are released again, voice handle included, to
+ * bound memory and keep the voice table free for cues that are about to sound.
+ */
+class CuePrearmer : public QObject
+{
+    Q_OBJECT
+
+public:
+    CuePrearmer(CueManager* cueManager, JuceAudioBridge* bridge, QObject* parent = nullptr);
+    ~CuePrearmer();
+
+    // Window configuration
+    int prearmDepth() const { return prearmDepth_; }
+    void setPrearmDepth(int depth);
+    double preloadSeconds() const { return preloadSeconds_; }
+    void setPreloadSeconds(double seconds);
+
+    /**
+     * @brief Whether the cue's voice holds decoded audio for this file and start time
+     */
+    bool isArmed(const QString& cueId, const QString& filePath, double startTime) const;
+    int armedCount() const;
+
+    /**
+     * @brief Decode and attach synchronously unless already armed
+     *
+     * Fallback for direct playback outside the scheduler (playCue() on a cue
+     * that was never armed, explicit loads). GO uses requestArm() instead.
+     */
+    bool ensureArmed(const QString& cueId, const QString& filePath, double startTime);
+
+    /**
+     * @brief Hold a triggered cue armed, decoding it in the background if it isn't yet
+     *
+     * GO never waits on a decode: the scheduler starts what is armed and
+     * hands the rest here. Requested preloads run one per core, so a fire-all
+     * group is ready after its slowest file; cueArmed() or cueArmFailed()
+     * reports the outcome. The cue is kept through window changes until its
+     * voice finishes or stops, or releaseHold().
+     * @return False if no preload could be started (no free voice)
+     */
+    bool requestArm(const QString& cueId, const QString& filePath, double startTime);
+    void releaseHold(const QString& cueId);
+
+    void disarm(const QString& cueId);
+    void disarmAll();
+
+public slots:
+    void refresh();
+    void onStandByCueChanged(const QString& cueId);
+
+signals:
+    void cueArmed(const QString& cueId);
+    void cueArmFailed(const QString& cueId, const QString& error);
+    void cueDisarmed(const QString& cueId);
+
+private:
+    struct ArmState {
+        QString filePath;
+        double startTime = 0.0;
+        double sampleRate = 0.0;    // Device rate the audio was converted to
+        quint64 generation = 0;     // Matches the preload that may attach
+        bool ready = false;         // Audio attached to the voice
+        bool held = false;          // Triggered: not released with the window
+    };
+
+    bool startPreload(const QString& cueId, const QString& filePath, double startTime, QThreadPool& pool);
+    void onPreloadFinished(const QString& cueId, quint64 generation, const DecodedAudio* audio);
+    bool matches(const ArmState& state, const QString& filePath, double startTime) const;
+
+    CueManager* cueManager_;
+    JuceAudioBridge* bridge_;
+
+    QThreadPool ioPool_;                 // Bounded decode parallelism
+    QThreadPool burstPool_;              // requestArm(): a cue was triggered, so use every core
+    QHash<QString, ArmState> armStates_;
+    quint64 nextGeneration_;
+
+    int prearmDepth_;
+    double preloadSeconds_;
+
+    // Constants
+    static constexpr int DEFAULT_PREARM_DEPTH = 3;          // Cues kept ready past standby
+    static constexpr double DEFAULT_PRELOAD_SECONDS = 10.0; // Decoded head of streamed cues
+    static constexpr int MAX_IO_THREADS = 2;                // Concurrent decodes
+};
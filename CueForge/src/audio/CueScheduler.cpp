@@ -0,0 +1,513 @@
+// src/audio/CueScheduler.cpp - Audio-clock scheduling of cue starts, stops and fades
+#include "CueScheduler.h"
+
+#include <QDebug>
+
+#include "JuceAudioBridge.h"
+#include "CuePrearmer.h"
+#include "CueManager.h"
+#include "AudioCue.h"
+#include "GroupCue.h"
+
+CueScheduler::CueScheduler(CueManager* cueManager, JuceAudioBridge* bridge, CuePrearmer* prearmer, QObject* parent)
+    : QObject(parent)
+    , cueManager_(cueManager)
+    , bridge_(bridge)
+    , prearmer_(prearmer)
+    , nextMarkerId_(1)
+    , nextToken_(1)
+{
+    connect(bridge_, &JuceAudioBridge::scheduledDeadline, this, &CueScheduler::onDeadline);
+    connect(bridge_, &JuceAudioBridge::cueStarted, this, &CueScheduler::onCueStarted);
+    if (prearmer_) {
+        connect(prearmer_, &CuePrearmer::cueArmed, this, &CueScheduler::onCueArmed);
+        connect(prearmer_, &CuePrearmer::cueArmFailed, this, &CueScheduler::onCueArmFailed);
+    }
+}
+
+CueScheduler::~CueScheduler() = default;
+
+// Scheduling
+
+QList<Cue*> CueScheduler::scheduleGo(Cue* cue)
+{
+    QList<Cue*> scheduled;
+    if (!cue || !cueManager_) {
+        return scheduled;
+    }
+
+    // Every deadline in the chain derives from this one sample, so links can't drift
+    const std::int64_t now = nowSample();
+    const std::uint32_t token = nextToken_++;
+
+    std::int64_t base = now;
+    Cue* current = cue;
+    while (current && scheduled.size() < MAX_CHAIN_LENGTH) {
+        const std::int64_t start = base + toSamples(current->preWait());
+        if (!scheduleCueStart(current, start > now ? start : -1, token)) {
+            break;
+        }
+        scheduled.append(current);
+
+        if (!current->continueMode()) {
+            break;
+        }
+
+        base = start + toSamples(current->postWait());
+        current = cueManager_->getNextExecutableCue(current->id());
+    }
+
+    if (scheduled.size() > 1) {
+        qDebug() << "Scheduled auto-continue chain of" << scheduled.size() << "cues";
+    }
+    return scheduled;
+}
+
+QList<Cue*> CueScheduler::scheduleTogether(const QList<Cue*>& cues)
+{
+    QList<Cue*> scheduled;
+    if (cues.isEmpty() || !cueManager_) {
+        return scheduled;
+    }
+
+    Batch batch;
+    collectBatch(cues, batch);
+    if (!scheduleBatch(batch, -1, nextToken_++)) {
+        return scheduled;
+    }
+
+    for (Cue* cue : cues) {
+        if (cue && cue->canExecute()) {
+            scheduled.append(cue);
+        }
+    }
+    return scheduled;
+}
+
+bool CueScheduler::scheduleStop(const QString& cueId, double delaySeconds, double fadeOutTime)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Stop;
+    command.cueHandle = bridge_->cueHandle(cueId);
+    command.duration = fadeOutTime;
+    command.atSample = delaySeconds > 0.0 ? nowSample() + toSamples(delaySeconds) : -1;
+    return command.cueHandle >= 0 && bridge_->postCommand(command);
+}
+
+bool CueScheduler::scheduleFade(const QString& cueId, double delaySeconds, float level, double duration)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Fade;
+    command.cueHandle = bridge_->cueHandle(cueId);
+    command.level = level;
+    command.duration = duration;
+    command.atSample = delaySeconds > 0.0 ? nowSample() + toSamples(delaySeconds) : -1;
+    return command.cueHandle >= 0 && bridge_->postCommand(command);
+}
+
+void CueScheduler::adoptStart(AudioCue* cue)
+{
+    if (!cue) {
+        return;
+    }
+
+    // Nested cues aren't reachable through getCue(), so keep a pointer like a batch does
+    pendingAudioCues_.insert(cue->id());
+    nestedCues_.insert(cue->id(), cue);
+}
+
+void CueScheduler::cancelAll()
+{
+    AudioCommand command;
+    command.type = AudioCommandType::CancelScheduled;
+    command.token = 0;
+    bridge_->postCommand(command);
+
+    // Cues parked in their pre-wait, or still arming, go back to ready
+    QSet<QString> waiting = pendingAudioCues_;
+    for (const QString& cueId : std::as_const(markerCues_)) {
+        waiting.insert(cueId);
+    }
+
+    QSet<Cue*> toReset;
+    for (const QString& cueId : std::as_const(waiting)) {
+        Cue* cue = findScheduledCue(cueId);
+        if (cue && cue->status() == CueStatus::Loading) {
+            toReset.insert(cue);
+        }
+    }
+    for (const ArmWait& wait : std::as_const(armWaits_)) {
+        if (wait.cue && wait.cue->status() == CueStatus::Loading) {
+            toReset.insert(wait.cue);
+        }
+    }
+    for (const QList<QPointer<Cue>>& groups : std::as_const(pendingGroups_)) {
+        for (const QPointer<Cue>& group : groups) {
+            if (group && group->status() == CueStatus::Loading) {
+                toReset.insert(group);
+            }
+        }
+    }
+
+    // Cancelled starts never finish, so the prearmer has to be told to let them go
+    if (prearmer_) {
+        for (const QString& cueId : std::as_const(pendingAudioCues_)) {
+            prearmer_->releaseHold(cueId);
+        }
+        for (auto it = armWaits_.cbegin(); it != armWaits_.cend(); ++it) {
+            prearmer_->releaseHold(it.key());
+        }
+    }
+
+    pendingAudioCues_.clear();
+    markerCues_.clear();
+    pendingGroups_.clear();
+    nestedCues_.clear();
+    armWaits_.clear();
+
+    for (Cue* cue : std::as_const(toReset)) {
+        cue->reset();
+    }
+    if (prearmer_) {
+        prearmer_->refresh();
+    }
+}
+
+bool CueScheduler::isPending(const QString& cueId) const
+{
+    if (pendingAudioCues_.contains(cueId) || pendingGroups_.contains(cueId) || armWaits_.contains(cueId)) {
+        return true;
+    }
+    for (const QString& markerCueId : markerCues_) {
+        if (markerCueId == cueId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CueScheduler::scheduleCueStart(Cue* cue, std::int64_t atSample, std::uint32_t token)
+{
+    if (GroupCue* group = qobject_cast<GroupCue*>(cue)) {
+        Batch batch;
+        batch.groups.append(group);
+        collectBatch(group->children(), batch);
+        return scheduleBatch(batch, atSample, token);
+    }
+
+    const QString cueId = cue->id();
+    AudioCue* audioCue = qobject_cast<AudioCue*>(cue);
+    if (audioCue) {
+        const Readiness readiness = checkArmed(audioCue, atSample, token);
+        if (readiness != Readiness::Armed) {
+            return readiness == Readiness::Awaiting;
+        }
+    }
+    const int handle = audioCue ? bridge_->cueHandle(cueId) : -1;
+
+    if (handle >= 0) {
+        // Audio goes straight onto the callback's timeline
+        if (!postPlay(audioCue, atSample, token)) {
+            return false;
+        }
+    }
+    else if (atSample < 0) {
+        // Nothing to wait for: run it now rather than round-trip through the callback
+        cue->execute();
+        emit cueFired(cueId);
+        return true;
+    }
+    else {
+        const quint32 markerId = nextMarkerId_++;
+
+        AudioCommand command;
+        command.type = AudioCommandType::Marker;
+        command.atSample = atSample;
+        command.token = token;
+        command.markerId = markerId;
+
+        if (!bridge_->postCommand(command)) {
+            return false;
+        }
+        markerCues_.insert(markerId, cueId);
+    }
+
+    if (atSample >= 0) {
+        cue->setStatus(CueStatus::Loading); // Pre-wait in progress
+    }
+    return true;
+}
+
+void CueScheduler::collectBatch(const QList<Cue*>& cues, Batch& batch) const
+{
+    for (Cue* cue : cues) {
+        if (!cue || !cue->canExecute()) {
+            continue;
+        }
+        if (cue->preWait() > 0.0) {
+            batch.deferred.append(cue);
+            continue;
+        }
+
+        // A nested group without a pre-wait fires with its parent, so its children join the set
+        if (GroupCue* group = qobject_cast<GroupCue*>(cue)) {
+            batch.groups.append(group);
+            collectBatch(group->children(), batch);
+            continue;
+        }
+
+        // Unarmed audio joins the set too; scheduleBatch() leaves it to start once armed
+        AudioCue* audioCue = qobject_cast<AudioCue*>(cue);
+        if (audioCue && (bridge_->cueHandle(cue->id()) >= 0 || (prearmer_ && !audioCue->filePath().isEmpty()))) {
+            batch.together.append(audioCue);
+        }
+        else {
+            batch.deferred.append(cue);
+        }
+    }
+}
+
+bool CueScheduler::scheduleBatch(const Batch& batch, std::int64_t atSample, std::uint32_t token)
+{
+    // The set is whatever is armed now, in one command; the rest arm in parallel and follow
+    QVector<CueStart> starts;
+    QList<AudioCue*> inSet;
+    starts.reserve(batch.together.size());
+    for (AudioCue* audioCue : batch.together) {
+        const Readiness readiness = checkArmed(audioCue, atSample, token);
+        if (readiness == Readiness::Failed) {
+            qWarning() << "Could not arm cue" << audioCue->number() << "with its group";
+        }
+        const int handle = bridge_->cueHandle(audioCue->id());
+        if (readiness != Readiness::Armed || handle < 0) {
+            continue;
+        }
+
+        CueStart start;
+        start.handle = handle;
+        start.startTime = audioCue->startTime();
+        start.fadeInTime = audioCue->fadeInTime();
+        starts.append(start);
+        inSet.append(audioCue);
+    }
+
+    if (!starts.isEmpty() && !bridge_->postStartSet(starts, atSample, token)) {
+        return false;
+    }
+
+    for (AudioCue* audioCue : std::as_const(inSet)) {
+        pendingAudioCues_.insert(audioCue->id());
+        nestedCues_.insert(audioCue->id(), audioCue);
+        if (atSample >= 0) {
+            audioCue->setStatus(CueStatus::Loading);
+        }
+    }
+
+    // Pre-waits count from the sample the set starts on
+    const std::int64_t now = nowSample();
+    const std::int64_t base = atSample >= 0 ? atSample : now;
+    for (Cue* cue : batch.deferred) {
+        const std::int64_t start = base + toSamples(cue->preWait());
+        if (start > now) {
+            nestedCues_.insert(cue->id(), cue);
+        }
+        if (!scheduleCueStart(cue, start > now ? start : -1, token)) {
+            qWarning() << "Could not schedule cue" << cue->number() << "with its group";
+        }
+    }
+
+    if (batch.groups.isEmpty()) {
+        return true;
+    }
+
+    QList<QPointer<Cue>> groups;
+    for (GroupCue* group : batch.groups) {
+        groups.append(group);
+    }
+    for (GroupCue* group : batch.groups) {
+        pendingGroups_.insert(group->id(), groups);
+        if (atSample >= 0) {
+            group->setStatus(CueStatus::Loading);
+        }
+    }
+
+    // Without a start set to report back, the groups go live on their own deadline
+    const QString groupId = batch.groups.first()->id();
+    if (!starts.isEmpty()) {
+        return true;
+    }
+    if (atSample < 0) {
+        fireGroups(groupId);
+        return true;
+    }
+
+    const quint32 markerId = nextMarkerId_++;
+
+    AudioCommand command;
+    command.type = AudioCommandType::Marker;
+    command.atSample = atSample;
+    command.token = token;
+    command.markerId = markerId;
+
+    if (!bridge_->postCommand(command)) {
+        fireGroups(groupId);
+        return true;
+    }
+    markerCues_.insert(markerId, groupId);
+    return true;
+}
+
+void CueScheduler::fireGroups(const QString& groupId)
+{
+    const QList<QPointer<Cue>> groups = pendingGroups_.value(groupId);
+    for (const QPointer<Cue>& group : groups) {
+        if (!group) {
+            continue;
+        }
+        pendingGroups_.remove(group->id());
+        group->setStatus(CueStatus::Playing);
+        emit cueFired(group->id());
+    }
+}
+
+bool CueScheduler::postPlay(AudioCue* cue, std::int64_t atSample, std::uint32_t token)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Play;
+    command.cueHandle = bridge_->cueHandle(cue->id());
+    command.time = cue->startTime();
+    command.duration = cue->fadeInTime();
+    command.atSample = atSample;
+    command.token = token;
+    command.timestampNs = atSample < 0 ? JuceAudioBridge::steadyClockNs() : 0;
+
+    if (command.cueHandle < 0 || !bridge_->postCommand(command)) {
+        return false;
+    }
+    pendingAudioCues_.insert(cue->id());
+    return true;
+}
+
+CueScheduler::Readiness CueScheduler::checkArmed(AudioCue* cue, std::int64_t atSample, std::uint32_t token)
+{
+    if (!prearmer_ || cue->filePath().isEmpty()) {
+        return Readiness::Armed;    // Nothing to decode; the caller goes by the voice handle
+    }
+
+    // Held either way, so the window moving on at GO can't release it before it sounds
+    const bool armed = prearmer_->isArmed(cue->id(), cue->filePath(), cue->startTime());
+    if (!prearmer_->requestArm(cue->id(), cue->filePath(), cue->startTime())) {
+        return Readiness::Failed;
+    }
+    if (armed) {
+        return Readiness::Armed;
+    }
+
+    ArmWait wait;
+    wait.cue = cue;
+    wait.atSample = atSample;
+    wait.token = token;
+    armWaits_.insert(cue->id(), wait);
+    cue->setStatus(CueStatus::Loading);     // Arming, then whatever is left of the pre-wait
+    return Readiness::Awaiting;
+}
+
+Cue* CueScheduler::findScheduledCue(const QString& cueId) const
+{
+    if (Cue* nested = nestedCues_.value(cueId)) {
+        return nested;
+    }
+    return cueManager_->getCue(cueId);
+}
+
+// Audio Thread Reports
+
+void CueScheduler::onDeadline(quint32 markerId)
+{
+    const QString cueId = markerCues_.take(markerId);
+    if (cueId.isEmpty()) {
+        return; // Cancelled
+    }
+
+    if (pendingGroups_.contains(cueId)) {
+        fireGroups(cueId);
+        return;
+    }
+
+    Cue* cue = findScheduledCue(cueId);
+    nestedCues_.remove(cueId);
+    if (!cue) {
+        return;
+    }
+
+    cue->execute();
+    emit cueFired(cueId);
+}
+
+void CueScheduler::onCueStarted(const QString& cueId)
+{
+    if (!pendingAudioCues_.remove(cueId)) {
+        return;
+    }
+
+    if (Cue* cue = findScheduledCue(cueId)) {
+        cue->setStatus(CueStatus::Playing);
+    }
+    nestedCues_.remove(cueId);
+    emit cueFired(cueId);
+
+    // The first voice of a start set takes its groups live
+    for (GroupCue* group = cueManager_->getParentGroup(cueId); group; group = cueManager_->getParentGroup(group->id())) {
+        if (pendingGroups_.contains(group->id())) {
+            fireGroups(group->id());
+            break;
+        }
+    }
+}
+
+void CueScheduler::onCueArmed(const QString& cueId)
+{
+    const ArmWait wait = armWaits_.take(cueId);
+    AudioCue* cue = wait.cue;
+    if (!cue) {
+        return; // Armed by the window, not waited on (or cancelled)
+    }
+
+    // The deadline still counts if the decode beat it
+    const std::int64_t now = nowSample();
+    const std::int64_t atSample = wait.atSample > now ? wait.atSample : -1;
+    if (wait.atSample >= 0 && atSample < 0) {
+        qWarning() << "Cue" << cue->number() << "was armed after its start time and starts late";
+    }
+
+    if (!postPlay(cue, atSample, wait.token)) {
+        qWarning() << "Could not start cue" << cue->number() << "after arming it";
+        if (prearmer_) {
+            prearmer_->releaseHold(cueId);
+        }
+        cue->reset();
+        return;
+    }
+    nestedCues_.insert(cueId, cue);
+}
+
+void CueScheduler::onCueArmFailed(const QString& cueId)
+{
+    // The prearmer already reported the error and dropped the voice
+    const ArmWait wait = armWaits_.take(cueId);
+    if (wait.cue) {
+        wait.cue->reset();
+    }
+}
+
+// Helpers
+
+std::int64_t CueScheduler::nowSample() const
+{
+    return bridge_->estimateSampleTime(JuceAudioBridge::steadyClockNs());
+}
+
+std::int64_t CueScheduler::toSamples(double seconds) const
+{
+    return static_cast<std::int64_t>(seconds * bridge_->getClockSampleRate() + 0.5);
+}
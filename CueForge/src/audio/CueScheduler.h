@@ -0,0 +1,125 @@
+// src/audio/CueScheduler.h - Audio-clock scheduling of cue starts, stops and fades
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <cstdint>
+
+// Forward declarations
+class Cue;
+class AudioCue;
+class GroupCue;
+class CueManager;
+class CuePrearmer;
+class JuceAudioBridge;
+
+/**
+ * @brief Turns pre-waits and auto-continue chains into audio-clock deadlines
+ *
+ * On GO the whole chain is laid out at once against a single base sample:
+ * each cue fires preWait after its base, and while continueMode is set the
+ * next cue's base is the previous start plus its postWait. Audio cues get a
+ * Play command stamped with that sample, so the callback starts them exactly
+ * on it; other cues get a marker whose Deadline event runs them on the Qt
+ * side. Since nothing waits on a QTimer, links don't accumulate drift and a
+ * busy event loop delays only the UI, not the chain.
+ *
+ * A group cue fires all of its children: every armed audio child without a
+ * pre-wait (nested groups included) goes out in one PlaySet command, so they
+ * all start on the same sample. Children with a pre-wait, and non-audio
+ * children, are scheduled from that same sample.
+ *
+ * GO never waits on a decode. An audio cue that isn't armed yet is handed to
+ * the prearmer and starts once its audio is attached: on its deadline if
+ * that is still ahead, otherwise immediately (and late).
+ */
+class CueScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    CueScheduler(CueManager* cueManager, JuceAudioBridge* bridge, CuePrearmer* prearmer, QObject* parent = nullptr);
+    ~CueScheduler();
+
+    /**
+     * @brief Schedule a GO on the audio clock
+     * @return Cues placed on the timeline in firing order; empty if nothing was scheduled
+     */
+    QList<Cue*> scheduleGo(Cue* cue);
+
+    /**
+     * @brief Multi-cue GO: fire cues together, as a group fires its children
+     * @return Cues that were fired or scheduled
+     */
+    QList<Cue*> scheduleTogether(const QList<Cue*>& cues);
+
+    // Timed transport on audio cues (delays relative to now)
+    bool scheduleStop(const QString& cueId, double delaySeconds, double fadeOutTime = 0.0);
+    bool scheduleFade(const QString& cueId, double delaySeconds, float level, double duration);
+
+    /**
+     * @brief Track a Play another thread already posted (network control) as if it were ours
+     *
+     * The cue goes live when its Started event arrives, like a scheduled one.
+     * Must run before that event is dispatched.
+     */
+    void adoptStart(AudioCue* cue);
+
+    void cancelAll();
+    bool isPending(const QString& cueId) const;
+    int pendingCount() const { return pendingAudioCues_.size() + markerCues_.size() + pendingGroups_.size() + armWaits_.size(); }
+
+signals:
+    void cueFired(const QString& cueId);    // A scheduled cue has started executing
+
+private slots:
+    void onDeadline(quint32 markerId);
+    void onCueStarted(const QString& cueId);
+    void onCueArmed(const QString& cueId);
+    void onCueArmFailed(const QString& cueId);
+
+private:
+    bool scheduleCueStart(Cue* cue, std::int64_t atSample, std::uint32_t token);
+    bool postPlay(AudioCue* cue, std::int64_t atSample, std::uint32_t token);
+
+    // Audio cues GO reached before their audio was decoded
+    struct ArmWait {
+        QPointer<AudioCue> cue;
+        std::int64_t atSample = -1;     // Intended start; -1 = as soon as armed
+        std::uint32_t token = 0;
+    };
+    enum class Readiness { Armed, Awaiting, Failed };
+    Readiness checkArmed(AudioCue* cue, std::int64_t atSample, std::uint32_t token);
+
+    // Fire-all batches (a group's children, or a multi-cue GO)
+    struct Batch {
+        QList<AudioCue*> together;      // One start set
+        QList<Cue*> deferred;           // Pre-waits and non-audio cues, timed from the set's sample
+        QList<GroupCue*> groups;        // Shown as playing once the set starts
+    };
+    void collectBatch(const QList<Cue*>& cues, Batch& batch) const;
+    bool scheduleBatch(const Batch& batch, std::int64_t atSample, std::uint32_t token);
+    void fireGroups(const QString& groupId);
+    Cue* findScheduledCue(const QString& cueId) const;
+    std::int64_t nowSample() const;
+    std::int64_t toSamples(double seconds) const;
+
+    CueManager* cueManager_;
+    JuceAudioBridge* bridge_;
+    CuePrearmer* prearmer_;
+
+    QHash<quint32, QString> markerCues_;    // Marker ID -> non-audio cue waiting for its deadline
+    QSet<QString> pendingAudioCues_;        // Audio cues whose Play is on the timeline
+    QHash<QString, QList<QPointer<Cue>>> pendingGroups_;   // Group ID -> every group of its batch
+    QHash<QString, QPointer<Cue>> nestedCues_;  // Scheduled group children (not top-level, so getCue() can't find them)
+    QHash<QString, ArmWait> armWaits_;      // Cue ID -> start waiting for the prearmer
+    quint32 nextMarkerId_;
+    std::uint32_t nextToken_;
+
+    // Constants
+    static constexpr int MAX_CHAIN_LENGTH = 512;    // Guard against runaway auto-continue chains
+};
@@ -0,0 +1,41 @@
+// src/audio/DecodedAudio.h - RAM-resident decoded audio region
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AudioStream.h"
+
+/**
+ * @brief Block of decoded float samples for one cue's media file
+ *
+ * Produced off the audio thread (pre-arm, media loading) and handed to the
+ * audio callback by pointer. The audio thread only reads it; the owner frees
+ * it on the main thread once the callback has let go of it.
+ *
+ * Files above the RAM-resident threshold only keep a head here; the rest is
+ * read ahead by the disk thread into stream.
+ *
+ * Files recorded at another rate are converted while decoding (and by the
+ * disk thread for the streamed tail), so the callback only ever resamples
+ * for varispeed.
+ */
+struct DecodedAudio {
+    int numChannels = 0;
+    double sampleRate = 0.0;            // Playback (device) rate: every frame count below is at this rate
+    double sourceSampleRate = 0.0;      // The file's own rate; differs when the decode converted it
+    std::int64_t startFrame = 0;        // First decoded frame within the file
+    std::int64_t numFrames = 0;         // Frames held in samples
+    std::int64_t totalFrames = 0;       // Length of the whole file
+    std::vector<float> samples;         // Channel-major: numChannels x numFrames
+    std::shared_ptr<AudioStream> stream;    // Tail of a streamed file, null when RAM-resident; shared with the disk thread
+
+    const float* channel(int index) const { return samples.data() + static_cast<std::size_t>(index) * numFrames; }
+    float* channel(int index) { return samples.data() + static_cast<std::size_t>(index) * numFrames; }
+
+    // True when the decoded region covers the file from startFrame to the end
+    bool coversToEnd() const { return startFrame + numFrames >= totalFrames; }
+    bool isStreamed() const { return stream != nullptr; }
+    bool isConverted() const { return sourceSampleRate != sampleRate; }
+};
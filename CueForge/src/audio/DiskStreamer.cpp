@@ -0,0 +1,110 @@
+// src/audio/DiskStreamer.cpp - Disk-I/O thread feeding streamed cues
+#include "DiskStreamer.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "AudioStream.h"
+
+DiskStreamer::DiskStreamer()
+    : streamsRevision_(0)
+    , stopRequested_(false)
+{
+}
+
+DiskStreamer::~DiskStreamer()
+{
+    stop();
+}
+
+void DiskStreamer::start()
+{
+    if (thread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = false;
+    }
+    thread_ = std::thread(&DiskStreamer::run, this);
+}
+
+void DiskStreamer::stop()
+{
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    wakeCondition_.notify_all();
+    thread_.join();
+}
+
+void DiskStreamer::addStream(const std::shared_ptr<AudioStream>& stream)
+{
+    if (!stream) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::find(streams_.begin(), streams_.end(), stream) == streams_.end()) {
+            streams_.push_back(stream);
+            ++streamsRevision_;
+        }
+    }
+    wake();
+}
+
+void DiskStreamer::removeStream(const AudioStream* stream)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto removed = std::remove_if(streams_.begin(), streams_.end(),
+        [stream](const std::shared_ptr<AudioStream>& entry) { return entry.get() == stream; });
+    if (removed != streams_.end()) {
+        streams_.erase(removed, streams_.end());
+        ++streamsRevision_;
+    }
+}
+
+int DiskStreamer::streamCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(streams_.size());
+}
+
+void DiskStreamer::wake()
+{
+    wakeCondition_.notify_one();
+}
+
+void DiskStreamer::run()
+{
+    std::vector<float> scratch;
+    std::vector<std::shared_ptr<AudioStream>> pass;
+    std::uint64_t passRevision = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopRequested_) {
+        if (passRevision != streamsRevision_) {
+            pass = streams_;
+            passRevision = streamsRevision_;
+        }
+
+        // Disk reads happen unlocked: a slow file stalls neither registration nor the list
+        lock.unlock();
+        bool worked = false;
+        for (const std::shared_ptr<AudioStream>& stream : pass) {
+            worked |= stream->service(scratch);
+        }
+        lock.lock();
+
+        if (!worked && !stopRequested_ && passRevision == streamsRevision_) {
+            wakeCondition_.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL_MS));
+        }
+    }
+}
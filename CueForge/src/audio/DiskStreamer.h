@@ -0,0 +1,57 @@
+// src/audio/DiskStreamer.h - Disk-I/O thread feeding streamed cues
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class AudioStream;
+
+/**
+ * @brief Dedicated thread that keeps every registered AudioStream topped up
+ *
+ * Streams are serviced round-robin, one chunk each per pass, so a single long
+ * file can't starve the others. The thread sleeps for POLL_INTERVAL_MS when
+ * no stream needs data; seeks requested by the audio thread are picked up on
+ * the next pass.
+ *
+ * Each pass works on a copy of the stream list taken under the mutex, and
+ * reads from disk with it released, so registration on the main thread
+ * never waits behind a slow read. A stream removed mid-pass is kept alive by
+ * that copy until the pass moves on.
+ */
+class DiskStreamer
+{
+public:
+    DiskStreamer();
+    ~DiskStreamer();
+
+    DiskStreamer(const DiskStreamer&) = delete;
+    DiskStreamer& operator=(const DiskStreamer&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return thread_.joinable(); }
+
+    // Main thread
+    void addStream(const std::shared_ptr<AudioStream>& stream);
+    void removeStream(const AudioStream* stream);
+    int streamCount() const;
+
+    void wake();
+
+private:
+    void run();
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable wakeCondition_;
+    std::vector<std::shared_ptr<AudioStream>> streams_;
+    std::uint64_t streamsRevision_;     // Bumped on add/remove; the disk thread recopies when it changes
+    bool stopRequested_;
+
+    static constexpr int POLL_INTERVAL_MS = 5;
+};
@@ -0,0 +1,86 @@
+// src/audio/FadeEngine.cpp - Curve-shaped gain fades for the audio thread
+#include "FadeEngine.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace FadeEngine {
+
+namespace {
+
+constexpr int CURVE_COUNT = 4;
+constexpr float HALF_PI = 1.57079632679489661923f;
+
+using CurveTable = std::array<float, CURVE_TABLE_SIZE + 1>;    // Inclusive of progress 1.0
+
+float evaluateExact(FadeCurve curve, float p)
+{
+    switch (curve) {
+    case FadeCurve::Linear:
+        return p;
+    case FadeCurve::EqualPower:
+        return std::sin(p * HALF_PI);
+    case FadeCurve::SCurve:
+        return p * p * (3.0f - 2.0f * p);
+    case FadeCurve::Log: {
+        // -LOG_RANGE_DB at p = 0 rising linearly in dB, rescaled so the ends are exactly 0 and 1
+        const float floor = std::pow(10.0f, -LOG_RANGE_DB / 20.0f);
+        const float amplitude = std::pow(10.0f, (p - 1.0f) * LOG_RANGE_DB / 20.0f);
+        return (amplitude - floor) / (1.0f - floor);
+    }
+    }
+    return p;
+}
+
+std::array<CurveTable, CURVE_COUNT> buildTables()
+{
+    std::array<CurveTable, CURVE_COUNT> tables{};
+    for (int c = 0; c < CURVE_COUNT; ++c) {
+        for (int i = 0; i <= CURVE_TABLE_SIZE; ++i) {
+            const float p = static_cast<float>(i) / CURVE_TABLE_SIZE;
+            tables[c][i] = evaluateExact(static_cast<FadeCurve>(c), p);
+        }
+    }
+    return tables;
+}
+
+// Built during static initialization, long before the first audio callback
+const std::array<CurveTable, CURVE_COUNT> curveTables = buildTables();
+
+constexpr const char* CURVE_NAMES[CURVE_COUNT] = { "linear", "equalPower", "sCurve", "log" };
+
+} // namespace
+
+float shape(FadeCurve curve, float progress)
+{
+    const int index = static_cast<int>(curve);
+    if (index < 0 || index >= CURVE_COUNT) {
+        return progress;
+    }
+
+    const float position = std::clamp(progress, 0.0f, 1.0f) * CURVE_TABLE_SIZE;
+    const int lower = std::min(static_cast<int>(position), CURVE_TABLE_SIZE - 1);
+    const float fraction = position - static_cast<float>(lower);
+
+    const CurveTable& table = curveTables[index];
+    return table[lower] + (table[lower + 1] - table[lower]) * fraction;
+}
+
+const char* curveName(FadeCurve curve)
+{
+    const int index = static_cast<int>(curve);
+    return index >= 0 && index < CURVE_COUNT ? CURVE_NAMES[index] : CURVE_NAMES[0];
+}
+
+FadeCurve curveFromName(const char* name)
+{
+    for (int c = 0; name && c < CURVE_COUNT; ++c) {
+        if (std::strcmp(name, CURVE_NAMES[c]) == 0) {
+            return static_cast<FadeCurve>(c);
+        }
+    }
+    return FadeCurve::Linear;
+}
+
+} // namespace FadeEngine
@@ -0,0 +1,85 @@
+// src/audio/FadeEngine.h - Curve-shaped gain fades for the audio thread
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Fade shapes, defined as fade-in curves
+ *
+ * Fade-outs use the mirrored curve, so an equal-power fade-out is the cosine
+ * half of the equal-power fade-in and a log fade-out falls linearly in dB.
+ */
+enum class FadeCurve : std::uint8_t {
+    Linear,
+    EqualPower,     // sin(p * pi/2): constant power across a crossfade
+    SCurve,         // Smoothstep: gentle at both ends
+    Log             // Linear in dB over FadeEngine::LOG_RANGE_DB
+};
+
+/**
+ * @brief Curve lookup and per-fade state
+ *
+ * Curves are tabulated once at startup (CURVE_TABLE_SIZE segments each), so
+ * the audio thread evaluates a fade with one table lookup and a lerp per
+ * block edge. The mixer ramps linearly between block edges, which keeps the
+ * per-sample work identical to an unfaded voice: no per-sample branching or
+ * transcendental math, however many cues are fading.
+ */
+namespace FadeEngine {
+
+constexpr int CURVE_TABLE_SIZE = 1024;
+constexpr float LOG_RANGE_DB = 60.0f;
+
+/**
+ * @brief Fade-in shape at progress in [0, 1], from the lookup table
+ */
+float shape(FadeCurve curve, float progress);
+
+// Curve name for settings/serialization ("linear", "equalPower", "sCurve", "log")
+const char* curveName(FadeCurve curve);
+FadeCurve curveFromName(const char* name);     // Unknown names give Linear
+
+/**
+ * @brief One running gain fade (trivially copyable, audio-thread owned)
+ */
+struct Fade {
+    float from = 1.0f;
+    float to = 1.0f;
+    std::int64_t length = 0;        // Samples
+    std::int64_t elapsed = 0;
+    FadeCurve curve = FadeCurve::Linear;
+
+    bool isActive() const { return elapsed < length; }
+    std::int64_t remaining() const { return length - elapsed; }
+
+    void start(float fromGain, float toGain, std::int64_t lengthSamples, FadeCurve fadeCurve)
+    {
+        from = fromGain;
+        to = toGain;
+        length = std::max<std::int64_t>(0, lengthSamples);
+        elapsed = 0;
+        curve = fadeCurve;
+    }
+
+    // Gain after position samples of the fade
+    float gainAt(std::int64_t position) const
+    {
+        if (position >= length) {
+            return to;
+        }
+        const float progress = static_cast<float>(position) / static_cast<float>(length);
+        return to >= from
+            ? from + (to - from) * shape(curve, progress)
+            : to + (from - to) * shape(curve, 1.0f - progress);
+    }
+
+    // Move the fade on by frames; returns the gain at the new position
+    float advance(std::int64_t frames)
+    {
+        elapsed = std::min(length, elapsed + frames);
+        return gainAt(elapsed);
+    }
+};
+
+} // namespace FadeEngine
@@ -0,0 +1,37 @@
+// src/audio/GainMatrix.h - Dense per-cue crosspoint gain matrix
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+/**
+ * @brief Fixed-size input x output gain table for one cue voice
+ *
+ * Compiled on the main thread from AudioCue's routing maps and copied into
+ * the voice by the audio thread, so the mixer never touches QVariantMap.
+ * Rows are padded to whole SIMD registers and the table is 32-byte aligned.
+ */
+struct alignas(32) GainMatrix {
+    static constexpr int MAX_INPUTS = 16;
+    static constexpr int MAX_OUTPUTS = 64;
+
+    float gains[MAX_INPUTS * MAX_OUTPUTS];
+
+    float at(int input, int output) const { return gains[input * MAX_OUTPUTS + output]; }
+    void set(int input, int output, float gain) { gains[input * MAX_OUTPUTS + output] = gain; }
+
+    void clear() { std::fill(std::begin(gains), std::end(gains), 0.0f); }
+
+    // One-to-one routing, the default until a cue sends its matrix
+    void setIdentity()
+    {
+        clear();
+        for (int channel = 0; channel < MAX_INPUTS; ++channel) {
+            set(channel, channel, 1.0f);
+        }
+    }
+};
+
+static_assert(std::is_trivially_copyable<GainMatrix>::value, "GainMatrix must stay POD");
+static_assert(GainMatrix::MAX_OUTPUTS % 8 == 0, "GainMatrix rows must fill whole AVX registers");
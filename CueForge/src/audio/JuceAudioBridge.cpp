@@ -1,211 +1,1995 @@
-// src/audio/TracktionAudioEngine.h - Tracktion Engine Integration
-#pragma once
-
-#include <QObject>
-#include <QString>
-#include <QStringList>
-#include <QTimer>
-#include <QMutex>
-#include <QMap>
-#include <memory>
-
-// Conditional include for Tracktion Engine
-#if CUEFORGE_USE_TRACKTION_ENGINE
-#include <tracktion_engine/tracktion_engine.h>
-namespace te = tracktion_engine;
-#endif
-
-/**
- * @brief Qt6 wrapper for Tracktion Engine providing professional audio capabilities
- *
- * This class integrates the powerful Tracktion Engine with our Qt6 application,
- * providing professional DAW-quality audio processing, matrix mixing, and
- * multi-format audio file support.
- */
-class TracktionAudioEngine : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit TracktionAudioEngine(QObject* parent = nullptr);
-    ~TracktionAudioEngine() override;
-
-    // Engine lifecycle
-    bool initialize();
-    void shutdown();
-    bool isInitialized() const { return initialized_; }
-
-    // Device management
-    QStringList getAvailableDevices() const;
-    QString getCurrentDevice() const;
-    bool setAudioDevice(const QString& deviceName);
-
-    // Audio device properties
-    QList<int> getAvailableSampleRates() const;
-    QList<int> getAvailableBufferSizes() const;
-    int getCurrentSampleRate() const;
-    int getCurrentBufferSize() const;
-    bool setSampleRate(int sampleRate);
-    bool setBufferSize(int bufferSize);
-
-    // Cue management
-    bool createAudioCue(const QString& cueId, const QString& filePath);
-    bool loadAudioFile(const QString& cueId, const QString& filePath);
-    bool removeAudioCue(const QString& cueId);
-
-    // Playback control
-    bool playCue(const QString& cueId, double startTime = 0.0, double fadeInTime = 0.0);
-    bool stopCue(const QString& cueId, double fadeOutTime = 0.0);
-    bool pauseCue(const QString& cueId);
-    bool resumeCue(const QString& cueId);
-    void stopAllCues();
-    void emergencyStop();
-
-    // Matrix mixer integration
-    struct MatrixRoute {
-        int inputChannel = -1;
-        int outputChannel = -1;
-        double level = 1.0;
-        bool muted = false;
-        bool soloed = false;
-    };
+// src/audio/JuceAudioBridge.cpp - JUCE Integration Bridge Implementation
+#include "JuceAudioBridge.h"
+
+#include <QDebug>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "AudioDeviceSwitcher.h"
+#include "AudioEngine.h"    // Existing JUCE engine (native/include)
+#include "MixKernel.h"
+
+namespace {
+
+std::int64_t steadyNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Heap order for the timeline: earliest deadline at the front
+bool laterDeadline(const AudioCommand& a, const AudioCommand& b)
+{
+    return a.atSample > b.atSample;
+}
+
+// Source frames one block can pull: a full block at top speed plus the filter's look-ahead
+int varispeedInputFrames(int maximumBlockSize)
+{
+    return static_cast<int>(std::ceil(maximumBlockSize * Resampler::MAX_STEP)) + Resampler::MAX_TAPS + 2;
+}
+
+// Patch routes into deviceOutput from buses with signal; gains ramp from fromScale to toScale of the patched level
+int gatherPatchRoutes(const CompiledPatch& patch, int deviceOutput, std::uint64_t activeBuses, const float* buses,
+                      int busStride, float fromScale, float toScale, float inverseFrames, MixKernel::Route* routes)
+{
+    if (deviceOutput >= patch.numDeviceOutputs) {
+        return 0;
+    }
+
+    int numRoutes = 0;
+    for (int i = patch.firstRoute[deviceOutput]; i < patch.firstRoute[deviceOutput + 1]; ++i) {
+        const CompiledPatch::Route& patchRoute = patch.routes[i];
+        if (((activeBuses >> patchRoute.cueOutput) & 1u) == 0) {
+            continue;
+        }
+
+        MixKernel::Route& route = routes[numRoutes++];
+        route.source = buses + static_cast<std::size_t>(patchRoute.cueOutput) * busStride;
+        route.gain = patchRoute.gain * fromScale;
+        route.gainStep = patchRoute.gain * (toScale - fromScale) * inverseFrames;
+    }
+    return numRoutes;
+}
+
+} // namespace
+
+JuceAudioBridge::JuceAudioBridge(QObject* parent)
+    : QObject(parent)
+    , juceEngine_()
+    , statusTimer_(new QTimer(this))
+    , currentStatus_()
+    , lastError_()
+    , errorTimer_(new QTimer(this))
+    , eventDispatchPending_(false)
+    , eventsPostedThisBlock_(false)
+    , eventTimer_(new QTimer(this))
+    , voices_(MAX_VOICES)
+    , outputLevels_(MAX_VOICE_OUTPUTS, 1.0f)
+    , outputPatch_()
+    , patch_(outputPatch_.compile().release())
+    , previousPatch_(nullptr)
+    , busBuffers_(static_cast<std::size_t>(MAX_VOICE_OUTPUTS) * 512, 0.0f)
+    , activeBuses_(0)
+    , sampleRate_(48000.0)
+    , maximumBlockSize_(512)
+    , blockStartNs_(0)
+    , streamScratchFrames_(varispeedInputFrames(512))
+    , streamScratch_(static_cast<std::size_t>(MAX_VOICE_INPUTS) * streamScratchFrames_, 0.0f)
+    , varispeedScratch_(static_cast<std::size_t>(MAX_VOICE_INPUTS) * 512, 0.0f)
+    , timeline_()
+    , sampleClock_(0)
+    , clockSequence_(0)
+    , publishedClockSample_(0)
+    , publishedClockNs_(0)
+    , publishedSampleRate_(48000.0)
+    , diskStreamer_()
+    , residentThresholdBytes_(DEFAULT_RESIDENT_THRESHOLD_BYTES)
+    , mediaPool_()
+    , underrunCount_(0)
+    , lastTriggerLatencyNs_(0)
+    , maxTriggerLatencyNs_(0)
+    , triggerLatency_()
+    , meterBank_(MAX_DEVICE_OUTPUTS, MAX_VOICES)
+    , profiler_()
+    , profileStages_(false)
+    , freewheel_(false)
+    , initialized_(false)
+    , shutdownInProgress_(false)
+    , lastCpuUsage_(0.0)
+    , lastDropoutCount_(0)
+    , deviceSwitcher_(std::make_unique<AudioDeviceSwitcher>(*this))
+{
+    // Preallocate per-voice routing so the audio thread never resizes
+    for (Voice& voice : voices_) {
+        voice.crosspoints.setIdentity();
+        voice.appliedGains.clear();
+        voice.inputLevels.assign(MAX_VOICE_INPUTS, 1.0f);
+    }
+    timeline_.reserve(TIMELINE_CAPACITY);
+
+    statusTimer_->setInterval(STATUS_UPDATE_INTERVAL);
+    connect(statusTimer_, &QTimer::timeout, this, &JuceAudioBridge::onStatusTimer);
+
+    // Polled rather than signalled: posting a Qt event from the callback would allocate and lock
+    eventTimer_->setInterval(EVENT_DISPATCH_INTERVAL);
+    connect(eventTimer_, &QTimer::timeout, this, &JuceAudioBridge::onEventTimer);
+    eventTimer_->start();
+
+    diskStreamer_.start();
+}
+
+JuceAudioBridge::~JuceAudioBridge()
+{
+    // Stop the device callbacks, then reclaim everything the engine owns
+    deviceSwitcher_->shutdown();
+    diskStreamer_.stop();
+
+    commandQueue_.drain([this](const AudioCommand& command) {
+        if (command.type == AudioCommandType::AttachAudio) {
+            freeDecodedAudio(command.audio);
+        }
+        else if (command.type == AudioCommandType::SetMatrix) {
+            delete command.matrix;
+        }
+        else if (command.type == AudioCommandType::SetSpeed) {
+            delete command.resampler;
+        }
+        else if (command.type == AudioCommandType::PlaySet) {
+            delete command.startSet;
+        }
+        else if (command.type == AudioCommandType::SetPatch) {
+            delete command.patch;
+        }
+    });
+
+    for (const AudioCommand& command : timeline_) {
+        delete command.startSet;
+        delete command.patch;
+    }
+    timeline_.clear();
+
+    for (Voice& voice : voices_) {
+        freeDecodedAudio(voice.audio);
+        voice.audio = nullptr;
+        delete voice.varispeed;
+        voice.varispeed = nullptr;
+    }
+
+    delete patch_;
+    patch_ = nullptr;
+    delete previousPatch_;
+    previousPatch_ = nullptr;
+
+    retireQueue_.drainAll([this](const DecodedAudio* audio) {
+        freeDecodedAudio(audio);
+    });
+
+    matrixRetireQueue_.drainAll([](const GainMatrix* matrix) {
+        delete matrix;
+    });
+
+    resamplerRetireQueue_.drainAll([](Resampler* resampler) {
+        delete resampler;
+    });
+
+    startSetRetireQueue_.drainAll([](StartSet* startSet) {
+        delete startSet;
+    });
+
+    patchRetireQueue_.drainAll([](const CompiledPatch* patch) {
+        delete patch;
+    });
+
+    const std::uint64_t lost = retireQueue_.lostCount() + matrixRetireQueue_.lostCount()
+        + resamplerRetireQueue_.lostCount() + startSetRetireQueue_.lostCount() + patchRetireQueue_.lostCount();
+    if (lost > 0) {
+        qWarning() << "JuceAudioBridge: leaked" << lost << "retirements the main thread never collected";
+    }
+}
+
+// Lifecycle
+
+bool JuceAudioBridge::initialize()
+{
+    if (initialized_) {
+        return true;
+    }
+
+    if (!deviceSwitcher_->initialize()) {
+        reportError("initialize", "No audio device types available on this system");
+        return false;
+    }
+
+    shutdownInProgress_ = false;
+    statusTimer_->start();
+    initialized_ = true;
+    return true;
+}
+
+void JuceAudioBridge::shutdown()
+{
+    if (!initialized_) {
+        return;
+    }
+    shutdownInProgress_ = true;
+
+    statusTimer_->stop();
+    deviceSwitcher_->shutdown();
+
+    // The callback has stopped: deliver the last events and take back what it retired
+    dispatchAudioEvents();
+
+    initialized_ = false;
+    shutdownInProgress_ = false;
+}
+
+// Cue Handle Registry
+
+int JuceAudioBridge::acquireCueHandle(const QString& cueId)
+{
+    auto existing = cueHandles_.constFind(cueId);
+    if (existing != cueHandles_.constEnd()) {
+        return existing.value();
+    }
+
+    int handle = -1;
+    if (!freeHandles_.isEmpty()) {
+        handle = freeHandles_.takeLast();
+        handleCueIds_[handle] = cueId;
+        handleStates_[handle] = CueState();
+        ++handleGenerations_[handle];
+    }
+    else if (handleCueIds_.size() < MAX_VOICES) {
+        handle = handleCueIds_.size();
+        handleCueIds_.append(cueId);
+        handleStates_.append(CueState());
+        handleGenerations_.append(1);
+    }
+    else {
+        reportError("acquireCueHandle", QString("Voice limit of %1 reached").arg(MAX_VOICES));
+        return -1;
+    }
+
+    // Events the previous owner left in the ring carry the old generation and are dropped
+    AudioCommand command;
+    command.type = AudioCommandType::AttachVoice;
+    command.cueHandle = handle;
+    command.generation = handleGenerations_[handle];
+    if (!postCommand(command)) {
+        // The voice was never reset, so nothing may be sent to it under this handle
+        handleCueIds_[handle].clear();
+        freeHandles_.append(handle);
+        reportError("acquireCueHandle", QString("Could not attach a voice for cue %1").arg(cueId));
+        return -1;
+    }
+
+    cueHandles_.insert(cueId, handle);
+
+    // AttachVoice resets the voice to one-to-one routing
+    GainMatrix identity;
+    identity.setIdentity();
+    handleMatrices_.insert(handle, identity);
+
+    emit cueVoiceAttached(cueId, handle);
+    return handle;
+}
+
+void JuceAudioBridge::releaseCueHandle(const QString& cueId)
+{
+    // take() on a missing ID would hand back 0, another cue's voice
+    const int handle = cueHandles_.contains(cueId) ? cueHandles_.take(cueId) : -1;
+    if (handle < 0 || handle >= handleCueIds_.size()) {
+        return;
+    }
+
+    // Commands are FIFO, so a later AttachVoice for this slot lands after the release
+    AudioCommand command;
+    command.type = AudioCommandType::ReleaseVoice;
+    command.cueHandle = handle;
+    postCommand(command);
+
+    handleCueIds_[handle].clear();
+    handleStates_[handle] = CueState();
+    freeHandles_.append(handle);
+    varispeedQualities_.remove(handle);     // The voice retires its resampler on release
+    handleMatrices_.remove(handle);
+}
+
+// Real-Time Command Path
+
+bool JuceAudioBridge::postCommand(const AudioCommand& command)
+{
+    if (!commandQueue_.push(command)) {
+        qWarning() << "Audio command queue full, dropped command" << static_cast<int>(command.type);
+        return false;
+    }
+    return true;
+}
+
+bool JuceAudioBridge::postStartSet(const QVector<CueStart>& starts, std::int64_t atSample, std::uint32_t token)
+{
+    auto startSet = std::make_unique<StartSet>();
+    startSet->entries.reserve(static_cast<std::size_t>(starts.size()));
+    for (const CueStart& start : starts) {
+        if (!isValid(start.handle)) {
+            continue;
+        }
+
+        StartSet::Entry entry;
+        entry.cueHandle = start.handle;
+        entry.time = start.startTime;
+        entry.duration = start.fadeInTime;
+        entry.curve = static_cast<std::uint8_t>(start.curve);
+        startSet->entries.push_back(entry);
+    }
+
+    if (startSet->entries.empty()) {
+        return false;
+    }
+
+    AudioCommand command;
+    command.type = AudioCommandType::PlaySet;
+    command.startSet = startSet.get();
+    command.atSample = atSample;
+    command.token = token;
+    command.timestampNs = steadyNowNs();
+
+    if (!postCommand(command)) {
+        return false;
+    }
+
+    startSet.release();
+    return true;
+}
+
+// Devices
+
+QStringList JuceAudioBridge::getAvailableDevices() const
+{
+    deviceSwitcher_->initialize();
+    return deviceSwitcher_->availableDevices();
+}
+
+QString JuceAudioBridge::getCurrentDevice() const
+{
+    return deviceSwitcher_->currentDevice();
+}
+
+bool JuceAudioBridge::setAudioDevice(const QString& deviceName)
+{
+    return deviceSwitcher_->switchTo(deviceName);
+}
+
+bool JuceAudioBridge::playCue(const QString& cueId, double startTime, double fadeInTime, FadeCurve curve)
+{
+    return play(cueHandle(cueId), startTime, fadeInTime, curve);
+}
+
+bool JuceAudioBridge::stopCue(const QString& cueId, double fadeOutTime, FadeCurve curve)
+{
+    return stop(cueHandle(cueId), fadeOutTime, curve);
+}
+
+bool JuceAudioBridge::pauseCue(const QString& cueId)
+{
+    return pause(cueHandle(cueId));
+}
+
+bool JuceAudioBridge::resumeCue(const QString& cueId)
+{
+    return resume(cueHandle(cueId));
+}
+
+void JuceAudioBridge::stopAllCues(double fadeOutTime, FadeCurve curve)
+{
+    stopAll(fadeOutTime, curve);
+}
+
+bool JuceAudioBridge::setCueSpeed(const QString& cueId, double speed, ResamplerQuality quality)
+{
+    return setSpeed(cueHandle(cueId), speed, quality);
+}
+
+int JuceAudioBridge::fadeTargets(const QList<FadeTarget>& targets, double duration, FadeCurve curve)
+{
+    // A shared deadline one block out puts every fade on the same sample, even if the
+    // callback drains the queue while we are still pushing
+    const std::int64_t startSample = getSampleClock() + maximumBlockSize_;
+
+    int queued = 0;
+    for (const FadeTarget& target : targets) {
+        AudioCommand command;
+        command.type = AudioCommandType::Fade;
+        command.cueHandle = cueHandle(target.cueId);
+        command.input = target.input;
+        command.output = target.output;
+        command.level = target.level;
+        command.duration = duration;
+        command.curve = static_cast<std::uint8_t>(curve);
+        command.atSample = startSample;
+
+        if (command.cueHandle < 0 || !postCommand(command)) {
+            continue;
+        }
+        ++queued;
+
+        // A crosspoint fade ends at its target; that is what getCrosspoint() reports
+        auto matrix = handleMatrices_.find(command.cueHandle);
+        if (matrix != handleMatrices_.end() && target.input >= 0 && target.input < MAX_VOICE_INPUTS
+            && target.output >= 0 && target.output < MAX_VOICE_OUTPUTS) {
+            matrix->set(target.input, target.output, target.level);
+        }
+    }
+    return queued;
+}
+
+bool JuceAudioBridge::setCueMatrix(const QString& cueId, const GainMatrix& matrix)
+{
+    return setMatrix(cueHandle(cueId), matrix);
+}
+
+bool JuceAudioBridge::setCrosspoint(const QString& cueId, int input, int output, float level)
+{
+    return setCrosspoint(cueHandle(cueId), input, output, level);
+}
+
+float JuceAudioBridge::getCrosspoint(const QString& cueId, int input, int output) const
+{
+    if (input < 0 || input >= MAX_VOICE_INPUTS || output < 0 || output >= MAX_VOICE_OUTPUTS) {
+        return 0.0f;
+    }
+
+    // What was last sent, not where a crosspoint fade currently is
+    const auto it = handleMatrices_.constFind(cueHandle(cueId));
+    return it != handleMatrices_.constEnd() ? it->at(input, output) : 0.0f;
+}
+
+bool JuceAudioBridge::setInputLevel(const QString& cueId, int input, float level)
+{
+    return setInputLevel(cueHandle(cueId), input, level);
+}
 
-    bool setMatrixRouting(const QString& cueId, const QList<MatrixRoute>& routes);
-    QList<MatrixRoute> getMatrixRouting(const QString& cueId) const;
-    bool setCrosspoint(const QString& cueId, int input, int output, double level);
-    double getCrosspoint(const QString& cueId, int input, int output) const;
-
-    // Level control
-    bool setInputLevel(const QString& cueId, int input, double level);
-    bool setOutputLevel(int output, double level);
-    bool muteOutput(int output, bool mute);
-    bool soloOutput(int output, bool solo);
-
-signals:
-    // Engine status
-    void initialized();
-    void shutdownComplete();
-    void statusChanged();
-    void errorOccurred(const QString& error);
-    void warningOccurred(const QString& warning);
-
-    // Device signals
-    void audioDeviceChanged(const QString& deviceName);
-    void audioDeviceError(const QString& error);
-    void availableDevicesChanged();
-
-    // Playback signals
-    void cueStarted(const QString& cueId);
-    void cueFinished(const QString& cueId);
-    void cuePaused(const QString& cueId);
-    void cueResumed(const QString& cueId);
-    void cueStopped(const QString& cueId);
-    void cueError(const QString& cueId, const QString& error);
-
-    // Position tracking
-    void cuePositionChanged(const QString& cueId, double position);
-    void cueTimeRemaining(const QString& cueId, double timeRemaining);
-
-    // Performance monitoring
-    void cpuUsageChanged(double usage);
-    void audioDropout();
-    void bufferUnderrun();
-
-private slots:
-    void onStatusTimer();
-    void onPositionTimer();
-    void processTracktionCallbacks();
-
-private:
-    // Initialization helpers
-    bool initializeTracktionEngine();
-    bool setupAudioDevice();
-    void setupCallbacks();
-    void cleanupTracktionEngine();
-
-    // Cue management helpers
-    void registerCueWithTracktion(const QString& cueId);
-    void unregisterCueFromTracktion(const QString& cueId);
-
-    // String conversion helpers
-    QString tracktionToQt(const std::string& str) const;
-    std::string qtToTracktion(const QString& str) const;
-
-    // Error handling
-    void handleTracktionError(const QString& error);
-    void reportError(const QString& context, const QString& error);
-
-#if CUEFORGE_USE_TRACKTION_ENGINE
-    // Tracktion Engine components
-    std::unique_ptr<te::Engine> tracktionEngine_;
-    std::unique_ptr<te::Project> currentProject_;
-    std::unique_ptr<te::Edit> currentEdit_;
-
-    // Audio device management
-    te::DeviceManager* deviceManager_;
-    te::WaveAudioDevice* audioDevice_;
-
-    // Cue tracking
-    struct TracktionCue {
-        QString cueId;
-        std::unique_ptr<te::AudioTrack> track;
-        std::unique_ptr<te::WaveAudioClip> clip;
-        te::TransportControl* transport = nullptr;
-        bool isPlaying = false;
-        bool isPaused = false;
-        double startTime = 0.0;
-        double duration = 0.0;
+bool JuceAudioBridge::setOutputLevel(int output, float level)
+{
+    return setBusLevel(output, level);
+}
+
+bool JuceAudioBridge::muteOutput(int output, bool mute)
+{
+    if (output < 0 || output >= MAX_VOICE_OUTPUTS) {
+        return false;
+    }
+    if (outputPatch_.isMuted(output) == mute) {
+        return true;
+    }
+    outputPatch_.setMuted(output, mute);
+    return commitPatch();
+}
+
+bool JuceAudioBridge::soloOutput(int output, bool solo)
+{
+    if (output < 0 || output >= MAX_VOICE_OUTPUTS) {
+        return false;
+    }
+    if (outputPatch_.isSoloed(output) == solo) {
+        return true;
+    }
+    outputPatch_.setSoloed(output, solo);
+    return commitPatch();
+}
+
+// Output Patch
+
+bool JuceAudioBridge::setPatchRouting(int cueOutput, int deviceOutput, float level)
+{
+    if (!CueOutputPatch::isValid(cueOutput, deviceOutput)) {
+        return false;
+    }
+    if (outputPatch_.level(cueOutput, deviceOutput) == level) {
+        return true;
+    }
+    outputPatch_.setLevel(cueOutput, deviceOutput, level);
+    return commitPatch();
+}
+
+float JuceAudioBridge::getPatchRouting(int cueOutput, int deviceOutput) const
+{
+    return CueOutputPatch::isValid(cueOutput, deviceOutput) ? outputPatch_.level(cueOutput, deviceOutput) : 0.0f;
+}
+
+bool JuceAudioBridge::setOutputPatch(const CueOutputPatch& patch)
+{
+    outputPatch_ = patch;
+    return commitPatch();
+}
+
+bool JuceAudioBridge::commitPatch()
+{
+    // Compiled here, swapped in by the callback; the one it replaces comes back via patchRetireQueue_
+    std::unique_ptr<CompiledPatch> compiled = outputPatch_.compile();
+
+    AudioCommand command;
+    command.type = AudioCommandType::SetPatch;
+    command.patch = compiled.get();
+
+    if (!postCommand(command)) {
+        return false;
+    }
+
+    compiled.release();
+    return true;
+}
+
+// Backend Hooks (AudioBackend). Handles are already validated (>= 0).
+
+bool JuceAudioBridge::playHandle(CueHandle handle, double startTime, double fadeInTime, FadeCurve curve)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Play;
+    command.cueHandle = handle;
+    command.time = startTime;
+    command.duration = fadeInTime;
+    command.curve = static_cast<std::uint8_t>(curve);
+    command.timestampNs = steadyNowNs();
+    return postCommand(command);
+}
+
+bool JuceAudioBridge::stopHandle(CueHandle handle, double fadeOutTime, FadeCurve curve)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Stop;
+    command.cueHandle = handle;
+    command.duration = fadeOutTime;
+    command.curve = static_cast<std::uint8_t>(curve);
+    return postCommand(command);
+}
+
+bool JuceAudioBridge::pauseHandle(CueHandle handle)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Pause;
+    command.cueHandle = handle;
+    return postCommand(command);
+}
+
+bool JuceAudioBridge::resumeHandle(CueHandle handle)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Resume;
+    command.cueHandle = handle;
+    return postCommand(command);
+}
+
+bool JuceAudioBridge::fadeHandle(CueHandle handle, float level, double duration, FadeCurve curve)
+{
+    AudioCommand command;
+    command.type = AudioCommandType::Fade;
+    command.cueHandle = handle;
+    command.level = level;
+    command.duration = duration;
+    command.curve = static_cast<std::uint8_t>(curve);
+    return postCommand(command);
+}
+
+void JuceAudioBridge::stopAllHandles(double fadeOutTime, FadeCurve curve)
+{
+    // One command however many voices are playing; the fades run on the audio thread
+    AudioCommand command;
+    command.type = AudioCommandType::StopAll;
+    command.duration = fadeOutTime;
+    command.curve = static_cast<std::uint8_t>(curve);
+    postCommand(command);
+}
+
+bool JuceAudioBridge::setSpeedHandle(CueHandle handle, double speed, ResamplerQuality quality)
+{
+    if (!(speed > 0.0)) {
+        return false;
+    }
+
+    speed = std::clamp(speed, MIN_VARISPEED, Resampler::MAX_STEP);
+    const bool unity = std::abs(speed - 1.0) < 1e-6;
+
+    AudioCommand command;
+    command.type = AudioCommandType::SetSpeed;
+    command.cueHandle = handle;
+    command.level = unity ? 1.0f : static_cast<float>(speed);
+
+    // A speed change alone reuses the voice's resampler; a new one only when the voice has none or the tier changes
+    std::unique_ptr<Resampler> resampler;
+    auto current = varispeedQualities_.constFind(handle);
+    if (!unity && (current == varispeedQualities_.constEnd() || current.value() != quality)) {
+        resampler = std::make_unique<Resampler>(quality, MAX_VOICE_INPUTS, varispeedInputFrames(maximumBlockSize_));
+        command.resampler = resampler.get();
+    }
+
+    if (!postCommand(command)) {
+        return false;
+    }
+
+    resampler.release();
+    if (unity) {
+        varispeedQualities_.remove(handle);
+    }
+    else if (command.resampler) {
+        varispeedQualities_.insert(handle, quality);
+    }
+    return true;
+}
+
+bool JuceAudioBridge::setMatrixHandle(CueHandle handle, const GainMatrix& matrix)
+{
+    // Snapshot travels by pointer; the callback copies it and hands it back
+    auto snapshot = std::make_unique<GainMatrix>(matrix);
+
+    AudioCommand command;
+    command.type = AudioCommandType::SetMatrix;
+    command.cueHandle = handle;
+    command.matrix = snapshot.get();
+
+    if (!postCommand(command)) {
+        return false;
+    }
+
+    snapshot.release();
+    handleMatrices_[handle] = matrix;
+    return true;
+}
+
+bool JuceAudioBridge::setCrosspointHandle(CueHandle handle, int input, int output, float level)
+{
+    if (input < 0 || input >= MAX_VOICE_INPUTS || output < 0 || output >= MAX_VOICE_OUTPUTS) {
+        return false;
+    }
+
+    AudioCommand command;
+    command.type = AudioCommandType::SetCrosspoint;
+    command.cueHandle = handle;
+    command.input = input;
+    command.output = output;
+    command.level = level;
+    if (!postCommand(command)) {
+        return false;
+    }
+
+    auto matrix = handleMatrices_.find(handle);
+    if (matrix != handleMatrices_.end()) {
+        matrix->set(input, output, level);
+    }
+    return true;
+}
+
+bool JuceAudioBridge::setInputLevelHandle(CueHandle handle, int input, float level)
+{
+    if (input < 0 || input >= MAX_VOICE_INPUTS) {
+        return false;
+    }
+
+    AudioCommand command;
+    command.type = AudioCommandType::SetInputLevel;
+    command.cueHandle = handle;
+    command.input = input;
+    command.level = level;
+    return postCommand(command);
+}
+
+bool JuceAudioBridge::setOutputLevelAll(int output, float level)
+{
+    if (output < 0 || output >= MAX_VOICE_OUTPUTS) {
+        return false;
+    }
+
+    AudioCommand command;
+    command.type = AudioCommandType::SetOutputLevel;
+    command.output = output;
+    command.level = level;
+    return postCommand(command);
+}
+
+// Audio Thread
+
+void JuceAudioBridge::prepareAudio(double sampleRate, int maximumBlockSize)
+{
+    const double previousRate = sampleRate_;
+    sampleRate_ = sampleRate > 0.0 ? sampleRate : 48000.0;
+    maximumBlockSize_ = qMax(1, maximumBlockSize);
+
+    // Called while no device is rendering (see AudioDeviceSwitcher): safe to allocate here
+    streamScratchFrames_ = varispeedInputFrames(maximumBlockSize_);
+    streamScratch_.assign(static_cast<std::size_t>(MAX_VOICE_INPUTS) * streamScratchFrames_, 0.0f);
+    varispeedScratch_.assign(static_cast<std::size_t>(MAX_VOICE_INPUTS) * maximumBlockSize_, 0.0f);
+    busBuffers_.assign(static_cast<std::size_t>(MAX_VOICE_OUTPUTS) * maximumBlockSize_, 0.0f);
+    activeBuses_ = 0;
+
+    if (previousRate > 0.0 && previousRate != sampleRate_) {
+        rescaleForRate(sampleRate_ / previousRate);
+    }
+
+    for (Voice& voice : voices_) {
+        if (voice.varispeed) {
+            voice.varispeed->prepare(streamScratchFrames_);
+        }
+    }
+    publishedSampleRate_.store(sampleRate_, std::memory_order_relaxed);
+}
+
+void JuceAudioBridge::rescaleForRate(double ratio)
+{
+    const auto rescale = [ratio](std::int64_t frames) {
+        return static_cast<std::int64_t>(std::llround(static_cast<double>(frames) * ratio));
     };
 
-    QMap<QString, std::unique_ptr<TracktionCue>> tracktionCues_;
-    QMutex cuesMutex_;
+    // Deadlines keep their distance in time from now, not in frames
+    for (AudioCommand& command : timeline_) {
+        if (command.atSample > sampleClock_) {
+            command.atSample = sampleClock_ + rescale(command.atSample - sampleClock_);
+        }
+    }
+    std::make_heap(timeline_.begin(), timeline_.end(), laterDeadline);
+
+    for (int handle = 0; handle < MAX_VOICES; ++handle) {
+        Voice& voice = voices_[handle];
+        if (!voice.attached) {
+            continue;
+        }
+
+        // Fades and the position-event interval count output frames
+        voice.fade.length = rescale(voice.fade.length);
+        voice.fade.elapsed = std::min(rescale(voice.fade.elapsed), voice.fade.length);
+        for (int i = 0; i < voice.numCrosspointFades; ++i) {
+            FadeEngine::Fade& fade = voice.crosspointFades[i].fade;
+            fade.length = rescale(fade.length);
+            fade.elapsed = std::min(rescale(fade.elapsed), fade.length);
+        }
+        voice.samplesSincePositionEvent = rescale(voice.samplesSincePositionEvent);
+
+        // Positions index the media, which keeps its rate: it is resampled live until re-armed
+        if (voice.varispeed || sourceStep(handle) == 1.0) {
+            continue;
+        }
+        const ResamplerQuality quality = ResamplerQuality::Standard;
+        voice.varispeed = new Resampler(quality, MAX_VOICE_INPUTS, streamScratchFrames_);
+        varispeedQualities_.insert(handle, quality);
+    }
+}
+
+double JuceAudioBridge::mediaRate(int cueHandle) const
+{
+    const Voice& voice = voices_[cueHandle];
+    return voice.audio && voice.audio->sampleRate > 0.0 ? voice.audio->sampleRate : sampleRate_;
+}
+
+double JuceAudioBridge::sourceStep(int cueHandle) const
+{
+    return voices_[cueHandle].speed * mediaRate(cueHandle) / sampleRate_;
+}
+
+void JuceAudioBridge::processAudioBlock(float* const* outputChannels, int numOutputChannels, int numSamples)
+{
+    blockStartNs_ = steadyNowNs();
+    eventsPostedThisBlock_ = false;
+    profiler_.beginCallback(blockStartNs_, numSamples, sampleRate_);
+    profileStages_ = profiler_.stageTimingEnabled();
+    publishClock();
+
+    // Retirements parked while the main thread was behind go across first
+    const bool retiredParked = retireQueue_.flush() | matrixRetireQueue_.flush() | resamplerRetireQueue_.flush()
+        | startSetRetireQueue_.flush() | patchRetireQueue_.flush();
+    if (retiredParked) {
+        eventsPostedThisBlock_ = true;
+    }
+
+    // Future deadlines go onto the timeline; late or immediate ones apply now
+    commandQueue_.drain([this](const AudioCommand& command) {
+        if (command.atSample > sampleClock_) {
+            scheduleCommand(command);
+        }
+        else {
+            applyCommand(command);
+        }
+    });
+    chargeStage(CallbackProfiler::Stage::Commands, blockStartNs_);
+
+    for (int channel = 0; channel < numOutputChannels; ++channel) {
+        if (outputChannels[channel]) {
+            std::fill(outputChannels[channel], outputChannels[channel] + numSamples, 0.0f);
+        }
+    }
+
+    // Voices mix into the cue-output buses; only buses the patch reads are rendered
+    const int numBuses = std::max(patch_->numCueOutputs, previousPatch_ ? previousPatch_->numCueOutputs : 0);
+    float* segmentOutputs[MAX_VOICE_OUTPUTS] = {};
+
+    // Split the block at each deadline so scheduled commands land on their exact sample
+    // A voice counts once per block, whichever segment it started in
+    int done = 0;
+    std::bitset<MAX_VOICES> renderedVoices;
+    while (done < numSamples) {
+        const std::int64_t segmentStart = sampleClock_ + done;
+        while (!timeline_.empty() && timeline_.front().atSample <= segmentStart) {
+            std::pop_heap(timeline_.begin(), timeline_.end(), laterDeadline);
+            const AudioCommand command = timeline_.back();
+            timeline_.pop_back();
+            applyCommand(command);
+        }
+
+        int segmentLength = numSamples - done;
+        if (!timeline_.empty()) {
+            segmentLength = static_cast<int>(std::min<std::int64_t>(segmentLength, timeline_.front().atSample - segmentStart));
+        }
+
+        for (int bus = 0; bus < numBuses; ++bus) {
+            segmentOutputs[bus] = busBuffers_.data() + static_cast<std::size_t>(bus) * maximumBlockSize_ + done;
+        }
+
+        for (int handle = 0; handle < MAX_VOICES; ++handle) {
+            const Voice& voice = voices_[handle];
+            if (voice.attached && voice.playing && !voice.paused) {
+                renderVoice(handle, segmentOutputs, numBuses, segmentLength);
+                renderedVoices.set(static_cast<std::size_t>(handle));
+            }
+        }
+
+        done += segmentLength;
+    }
+
+    const std::int64_t patchStart = stageMark();
+    applyPatch(outputChannels, numOutputChannels, numSamples);
+    chargeStage(CallbackProfiler::Stage::Patch, patchStart);
+
+    // Output meters are taken post-patch; the reader applies ballistics at display rate
+    const std::int64_t meterStart = stageMark();
+    const int numOutputs = std::min(numOutputChannels, MAX_DEVICE_OUTPUTS);
+    for (int channel = 0; channel < numOutputs; ++channel) {
+        if (outputChannels[channel]) {
+            float peak = 0.0f;
+            float sumSquares = 0.0f;
+            MixKernel::measure(outputChannels[channel], numSamples, peak, sumSquares);
+            meterBank_.addOutput(channel, peak, sumSquares, numSamples);
+        }
+    }
+    meterBank_.publish();
+    chargeStage(CallbackProfiler::Stage::Meter, meterStart);
+
+    sampleClock_ += numSamples;
+
+    // Freewheeling, the wall clock means nothing: gaps are the caller's and the next block starts here
+    const bool freewheel = freewheel_.load(std::memory_order_relaxed);
+    const int activeVoices = static_cast<int>(renderedVoices.count());
+    if (profiler_.endCallback(steadyNowNs(), activeVoices) && !freewheel) {
+        postEvent(AudioEventType::Dropout, -1, profiler_.lastRecord().load());
+    }
+    if (freewheel) {
+        publishClock();
+    }
+
+    // A plain flag store; the main thread's event timer picks it up
+    if (eventsPostedThisBlock_) {
+        eventDispatchPending_.store(true, std::memory_order_release);
+    }
+}
+
+void JuceAudioBridge::applyPatch(float* const* outputChannels, int numOutputChannels, int numSamples)
+{
+    static_assert(MAX_VOICE_OUTPUTS <= 64, "activeBuses_ has one bit per cue output");
+
+    // Sparse: the cost is one pass per route whose bus had signal, not per bus x device pair
+    if (activeBuses_ != 0 && numSamples > 0) {
+        const int numDevices = std::min(numOutputChannels, MAX_DEVICE_OUTPUTS);
+        const float inverseFrames = 1.0f / static_cast<float>(numSamples);
+        MixKernel::Route routes[2 * MAX_VOICE_OUTPUTS];
+
+        for (int device = 0; device < numDevices; ++device) {
+            if (!outputChannels[device]) {
+                continue;
+            }
+
+            // The block after a swap crossfades: old routes ramp out while the new ones ramp in
+            int numRoutes = 0;
+            if (previousPatch_) {
+                numRoutes = gatherPatchRoutes(*previousPatch_, device, activeBuses_, busBuffers_.data(),
+                                              maximumBlockSize_, 1.0f, 0.0f, inverseFrames, routes);
+                numRoutes += gatherPatchRoutes(*patch_, device, activeBuses_, busBuffers_.data(),
+                                               maximumBlockSize_, 0.0f, 1.0f, inverseFrames, routes + numRoutes);
+            }
+            else {
+                numRoutes = gatherPatchRoutes(*patch_, device, activeBuses_, busBuffers_.data(),
+                                              maximumBlockSize_, 1.0f, 1.0f, inverseFrames, routes);
+            }
+
+            if (numRoutes > 0) {
+                MixKernel::accumulateRamped(outputChannels[device], routes, numRoutes, numSamples);
+            }
+        }
+
+        // Buses are silent between blocks, so only the ones written need clearing
+        for (int bus = 0; bus < MAX_VOICE_OUTPUTS; ++bus) {
+            if ((activeBuses_ >> bus) & 1u) {
+                float* samples = busBuffers_.data() + static_cast<std::size_t>(bus) * maximumBlockSize_;
+                std::fill(samples, samples + numSamples, 0.0f);
+            }
+        }
+        activeBuses_ = 0;
+    }
+
+    if (previousPatch_) {
+        retirePatch(previousPatch_);
+        previousPatch_ = nullptr;
+    }
+}
+
+std::int64_t JuceAudioBridge::stageMark() const
+{
+    return profileStages_ ? steadyNowNs() : 0;
+}
+
+std::int64_t JuceAudioBridge::chargeStage(CallbackProfiler::Stage stage, std::int64_t since)
+{
+    // Charges the time since the last mark to stage and returns the new mark
+    if (!profileStages_) {
+        return 0;
+    }
+    const std::int64_t now = steadyNowNs();
+    profiler_.addStageTime(stage, now - since);
+    return now;
+}
+
+void JuceAudioBridge::scheduleCommand(const AudioCommand& command)
+{
+    // Capacity is reserved up front, so this never allocates
+    if (timeline_.size() >= static_cast<std::size_t>(TIMELINE_CAPACITY)) {
+        postEvent(AudioEventType::Error, command.cueHandle);
+        retireStartSet(command.startSet);
+        retirePatch(command.patch);
+        return;
+    }
 
-    // Matrix mixer (using Tracktion's sends/returns)
-    struct MatrixConnection {
-        te::Send* send = nullptr;
-        double level = 1.0;
-        bool muted = false;
-        bool soloed = false;
+    timeline_.push_back(command);
+    std::push_heap(timeline_.begin(), timeline_.end(), laterDeadline);
+}
+
+void JuceAudioBridge::cancelScheduled(std::uint32_t token)
+{
+    // Partition rather than remove_if: the dropped commands' payloads still have to be retired
+    const auto dropped = std::partition(timeline_.begin(), timeline_.end(), [token](const AudioCommand& command) {
+        return token != 0 && command.token != token;
+    });
+    for (auto it = dropped; it != timeline_.end(); ++it) {
+        retireStartSet(it->startSet);
+        retirePatch(it->patch);
+    }
+    timeline_.erase(dropped, timeline_.end());
+
+    std::make_heap(timeline_.begin(), timeline_.end(), laterDeadline);
+}
+
+void JuceAudioBridge::publishClock()
+{
+    clockSequence_.fetch_add(1, std::memory_order_acq_rel);
+    publishedClockSample_.store(sampleClock_, std::memory_order_relaxed);
+    publishedClockNs_.store(blockStartNs_, std::memory_order_relaxed);
+    clockSequence_.fetch_add(1, std::memory_order_release);
+}
+
+void JuceAudioBridge::applyCommand(const AudioCommand& command)
+{
+    if (command.type == AudioCommandType::SetOutputLevel) {
+        outputLevels_[command.output] = command.level;
+        return;
+    }
+
+    if (command.type == AudioCommandType::SetPatch) {
+        // The patch heard so far fades out this block; one that never got a block is dropped
+        if (previousPatch_) {
+            retirePatch(patch_);
+        }
+        else {
+            previousPatch_ = patch_;
+        }
+        patch_ = command.patch;
+        return;
+    }
+
+    const auto toSamples = [this](double seconds) {
+        return static_cast<std::int64_t>(seconds * sampleRate_);
     };
 
-    QMap<QString, QMap<int, QMap<int, MatrixConnection>>> matrixConnections_;
-    QMutex matrixMutex_;
-
-#else
-    // Placeholder structures when Tracktion Engine is not available
-    struct DummyCue {
-        QString cueId;
-        QString filePath;
-        bool isPlaying = false;
-        bool isPaused = false;
-        double position = 0.0;
-        double duration = 0.0;
+    if (command.type == AudioCommandType::Marker) {
+        postEvent(AudioEventType::Deadline, -1, static_cast<double>(command.markerId));
+        return;
+    }
+
+    if (command.type == AudioCommandType::CancelScheduled) {
+        cancelScheduled(command.token);
+        return;
+    }
+
+    if (command.type == AudioCommandType::PlaySet) {
+        // Same block, same segment: every voice in the set starts on this sample
+        for (const StartSet::Entry& entry : command.startSet->entries) {
+            AudioCommand play;
+            play.type = AudioCommandType::Play;
+            play.cueHandle = entry.cueHandle;
+            play.time = entry.time;
+            play.duration = entry.duration;
+            play.curve = entry.curve;
+            play.timestampNs = command.timestampNs;
+            applyCommand(play);
+        }
+        retireStartSet(command.startSet);
+        return;
+    }
+
+    const FadeCurve curve = static_cast<FadeCurve>(command.curve);
+
+    if (command.type == AudioCommandType::StopAll) {
+        for (int handle = 0; handle < MAX_VOICES; ++handle) {
+            stopVoice(handle, toSamples(command.duration), curve);
+        }
+        return;
+    }
+
+    if (command.cueHandle < 0 || command.cueHandle >= MAX_VOICES) {
+        return;
+    }
+
+    Voice& voice = voices_[command.cueHandle];
+
+    switch (command.type) {
+    case AudioCommandType::AttachVoice:
+        retireAudio(voice.audio);
+        voice.audio = nullptr;
+        voice.triggerTimestampNs = 0;
+        voice.underrun = false;
+        voice.attached = true;
+        voice.playing = false;
+        voice.paused = false;
+        voice.stopAfterFade = false;
+        voice.positionSamples = 0;
+        voice.lengthSamples = 0;
+        voice.samplesSincePositionEvent = 0;
+        voice.gain = 1.0f;
+        voice.fade = FadeEngine::Fade();
+        voice.numCrosspointFades = 0;
+        std::fill(voice.inputLevels.begin(), voice.inputLevels.end(), 1.0f);
+        retireResampler(voice.varispeed);
+        voice.varispeed = nullptr;
+        voice.speed = 1.0;
+        voice.generation = command.generation;
+
+        // One-to-one routing until the cue sends its matrix
+        voice.crosspoints.setIdentity();
+        voice.snapGains = true;
+        break;
+
+    case AudioCommandType::ReleaseVoice: {
+        // Anything still scheduled for this handle must not reach its next owner
+        const std::int32_t handle = command.cueHandle;
+        timeline_.erase(std::remove_if(timeline_.begin(), timeline_.end(), [handle](const AudioCommand& pending) {
+            return pending.cueHandle == handle;
+        }), timeline_.end());
+        std::make_heap(timeline_.begin(), timeline_.end(), laterDeadline);
+
+        // Start sets waiting on the timeline keep their other voices
+        for (const AudioCommand& pending : timeline_) {
+            if (!pending.startSet) {
+                continue;
+            }
+            for (StartSet::Entry& entry : pending.startSet->entries) {
+                if (entry.cueHandle == handle) {
+                    entry.cueHandle = -1;
+                }
+            }
+        }
+
+        retireAudio(voice.audio);
+        voice.audio = nullptr;
+        retireResampler(voice.varispeed);
+        voice.varispeed = nullptr;
+        voice.speed = 1.0;
+        voice.attached = false;
+        voice.playing = false;
+        break;
+    }
+
+    case AudioCommandType::AttachAudio:
+        if (!voice.attached) {
+            retireAudio(command.audio);
+            break;
+        }
+        retireAudio(voice.audio);
+        voice.audio = command.audio;
+        voice.lengthSamples = command.audio ? command.audio->totalFrames : 0;
+        break;
+
+    case AudioCommandType::Play: {
+        if (!voice.attached) {
+            break;
+        }
+        voice.playing = true;
+        voice.paused = false;
+        voice.stopAfterFade = false;
+        voice.positionSamples = static_cast<std::int64_t>(command.time * mediaRate(command.cueHandle));
+        voice.samplesSincePositionEvent = 0;
+        voice.triggerTimestampNs = command.timestampNs;
+        voice.underrun = false;
+        voice.snapGains = true;
+        if (voice.varispeed) {
+            voice.varispeed->reset();
+        }
+
+        // Point the read-ahead at where playback will leave the head
+        if (voice.audio && voice.audio->stream) {
+            const std::int64_t headEnd = voice.audio->startFrame + voice.audio->numFrames;
+            const bool inHead = voice.positionSamples >= voice.audio->startFrame && voice.positionSamples < headEnd;
+            voice.audio->stream->prime(inHead ? headEnd : voice.positionSamples);
+        }
+
+        const std::int64_t fadeSamples = toSamples(command.duration);
+        voice.gain = fadeSamples > 0 ? 0.0f : 1.0f;
+        voice.fade.start(voice.gain, 1.0f, fadeSamples, curve);
+        postEvent(AudioEventType::Started, command.cueHandle, voice.positionSamples / mediaRate(command.cueHandle));
+        break;
+    }
+
+    case AudioCommandType::Stop:
+        stopVoice(command.cueHandle, toSamples(command.duration), curve);
+        break;
+
+    case AudioCommandType::Pause:
+        if (voice.playing && !voice.paused) {
+            voice.paused = true;
+            postEvent(AudioEventType::Paused, command.cueHandle);
+        }
+        break;
+
+    case AudioCommandType::Resume:
+        if (voice.playing && voice.paused) {
+            voice.paused = false;
+            postEvent(AudioEventType::Resumed, command.cueHandle);
+        }
+        break;
+
+    case AudioCommandType::Fade: {
+        const std::int64_t fadeSamples = toSamples(command.duration);
+        if (command.input >= 0 && command.output >= 0) {
+            startCrosspointFade(command.cueHandle, command.input, command.output, command.level, fadeSamples, curve);
+            break;
+        }
+
+        // Retargeting mid-fade starts the new curve from wherever the gain is now
+        voice.fade.start(voice.gain, command.level, fadeSamples, curve);
+        if (fadeSamples <= 0) {
+            voice.gain = command.level;
+        }
+        break;
+    }
+
+    case AudioCommandType::SetMatrix:
+        if (command.matrix) {
+            voice.crosspoints = *command.matrix;
+            if (matrixRetireQueue_.retire(command.matrix)) {
+                eventsPostedThisBlock_ = true;
+            }
+        }
+        break;
+
+    case AudioCommandType::SetCrosspoint:
+        voice.crosspoints.set(command.input, command.output, command.level);
+        break;
+
+    case AudioCommandType::SetInputLevel:
+        voice.inputLevels[command.input] = command.level;
+        break;
+
+    case AudioCommandType::SetSpeed:
+        if (!voice.attached) {
+            retireResampler(command.resampler);
+            break;
+        }
+        if (command.resampler) {
+            retireResampler(voice.varispeed);
+            voice.varispeed = command.resampler;
+        }
+        voice.speed = command.level;
+
+        // Back at unity the voice mixes straight from its source again, unless its media is at an older rate
+        if (sourceStep(command.cueHandle) == 1.0 && voice.varispeed) {
+            retireResampler(voice.varispeed);
+            voice.varispeed = nullptr;
+        }
+        break;
+
+    case AudioCommandType::StopAll:
+    case AudioCommandType::SetOutputLevel:
+    case AudioCommandType::PlaySet:
+    case AudioCommandType::SetPatch:
+        break;
+    }
+}
+
+void JuceAudioBridge::stopVoice(int cueHandle, std::int64_t fadeSamples, FadeCurve curve)
+{
+    Voice& voice = voices_[cueHandle];
+    if (!voice.playing) {
+        return;
+    }
+
+    if (fadeSamples > 0 && !voice.paused) {
+        voice.fade.start(voice.gain, 0.0f, fadeSamples, curve);
+        voice.stopAfterFade = true;
+    }
+    else {
+        voice.playing = false;
+        voice.paused = false;
+        voice.stopAfterFade = false;
+        postEvent(AudioEventType::Stopped, cueHandle);
+    }
+}
+
+void JuceAudioBridge::startCrosspointFade(int cueHandle, int input, int output, float level, std::int64_t fadeSamples, FadeCurve curve)
+{
+    if (input >= MAX_VOICE_INPUTS || output >= MAX_VOICE_OUTPUTS) {
+        return;
+    }
+
+    Voice& voice = voices_[cueHandle];
+    if (fadeSamples <= 0) {
+        voice.crosspoints.set(input, output, level);
+        return;
+    }
+
+    // A crosspoint already fading is retargeted in place
+    CrosspointFade* slot = nullptr;
+    for (int i = 0; i < voice.numCrosspointFades; ++i) {
+        CrosspointFade& candidate = voice.crosspointFades[i];
+        if (candidate.input == input && candidate.output == output) {
+            slot = &candidate;
+            break;
+        }
+    }
+    if (!slot) {
+        if (voice.numCrosspointFades >= MAX_CROSSPOINT_FADES) {
+            voice.crosspoints.set(input, output, level);     // Out of slots: jump rather than drop
+            return;
+        }
+        slot = &voice.crosspointFades[voice.numCrosspointFades++];
+        slot->input = input;
+        slot->output = output;
+    }
+
+    slot->fade.start(voice.crosspoints.at(input, output), level, fadeSamples, curve);
+}
+
+void JuceAudioBridge::advanceCrosspointFades(int cueHandle, std::int64_t frames)
+{
+    Voice& voice = voices_[cueHandle];
+
+    // The new crosspoint value is this block's target; the mixer glides to it from appliedGains
+    for (int i = 0; i < voice.numCrosspointFades;) {
+        CrosspointFade& entry = voice.crosspointFades[i];
+        voice.crosspoints.set(entry.input, entry.output, entry.fade.advance(frames));
+
+        if (entry.fade.isActive()) {
+            ++i;
+        }
+        else {
+            entry = voice.crosspointFades[--voice.numCrosspointFades];
+        }
+    }
+}
+
+void JuceAudioBridge::renderVoice(int cueHandle, float* const* outputChannels, int numOutputChannels, int numSamples)
+{
+    Voice& voice = voices_[cueHandle];
+
+    // First block after a Play command: record how long the trigger took to reach audio
+    if (voice.triggerTimestampNs > 0) {
+        const std::int64_t latency = std::max<std::int64_t>(0, blockStartNs_ - voice.triggerTimestampNs);
+        lastTriggerLatencyNs_.store(latency, std::memory_order_relaxed);
+        if (latency > maxTriggerLatencyNs_.load(std::memory_order_relaxed)) {
+            maxTriggerLatencyNs_.store(latency, std::memory_order_relaxed);
+        }
+        triggerLatency_.record(latency);
+        voice.triggerTimestampNs = 0;
+    }
+
+    // Output frames this block; a varispeed voice consumes sourceFrames of media to make them
+    const double step = sourceStep(cueHandle);
+    Resampler* varispeed = step != 1.0 ? voice.varispeed : nullptr;
+    const std::int64_t remaining = voice.lengthSamples > 0 ? voice.lengthSamples - voice.positionSamples : 0;
+    std::int64_t framesToRender = numSamples;
+    std::int64_t sourceFrames = numSamples;
+    if (varispeed) {
+        if (voice.lengthSamples > 0) {
+            const auto outputLeft = static_cast<std::int64_t>(std::ceil(remaining / step));
+            framesToRender = std::min<std::int64_t>(numSamples, outputLeft);
+        }
+        sourceFrames = std::min(varispeed->inputFramesFor(static_cast<int>(framesToRender), step), streamScratchFrames_);
+        if (voice.lengthSamples > 0) {
+            sourceFrames = std::min(sourceFrames, remaining);
+        }
+    }
+    else if (voice.lengthSamples > 0) {
+        framesToRender = std::min<std::int64_t>(numSamples, remaining);
+        sourceFrames = framesToRender;
+    }
+
+    // Fade gain from the curve table at the block edges; the mixer ramps linearly in between
+    const float startGain = voice.gain;
+    const std::int64_t rampFrames = std::min(framesToRender, voice.fade.remaining());
+    const float endGain = rampFrames > 0 ? voice.fade.gainAt(voice.fade.elapsed + rampFrames) : startGain;
+
+    std::int64_t mark = stageMark();
+    if (voice.numCrosspointFades > 0) {
+        advanceCrosspointFades(cueHandle, framesToRender);
+        mark = chargeStage(CallbackProfiler::Stage::Fade, mark);
+    }
+
+    const float* sources[MAX_VOICE_INPUTS] = {};
+    int available = sourceFrames > 0 ? gatherVoiceSource(cueHandle, sourceFrames, sources) : 0;
+    mark = chargeStage(CallbackProfiler::Stage::Disk, mark);
+
+    if (varispeed && voice.audio) {
+        // Resample into scratch, then mix from it as if it were the source. It may need no new
+        // input this block at slow speeds, so it runs even when nothing was gathered
+        const int numInputs = std::min(voice.audio->numChannels, MAX_VOICE_INPUTS);
+        float* stretched[MAX_VOICE_INPUTS] = {};
+        for (int input = 0; input < numInputs; ++input) {
+            stretched[input] = varispeedScratch_.data() + static_cast<std::size_t>(input) * maximumBlockSize_;
+        }
+        available = varispeed->process(sources, numInputs, available, stretched, static_cast<int>(framesToRender), step);
+        for (int input = 0; input < numInputs; ++input) {
+            sources[input] = stretched[input];
+        }
+        mark = chargeStage(CallbackProfiler::Stage::Resample, mark);
+    }
+
+    if (available > 0) {
+        const int numInputs = std::min(voice.audio->numChannels, MAX_VOICE_INPUTS);
+        const int numOutputs = std::min(numOutputChannels, MAX_VOICE_OUTPUTS);
+
+        // Matrix changes glide across the whole block. The cue fade ramps for rampFrames and
+        // then holds its end gain, so a fade ending mid-block isn't stretched to the block edge
+        const int split = rampFrames > 0 && rampFrames < available ? static_cast<int>(rampFrames) : available;
+        const float splitPoint = static_cast<float>(split) / static_cast<float>(available);
+        const MixSegment segments[] = {
+            { 0, split, startGain, endGain, 0.0f, splitPoint },
+            { split, available - split, endGain, endGain, splitPoint, 1.0f },
+        };
+
+        MixKernel::Route routes[MAX_VOICE_INPUTS];
+        float previousGains[MAX_VOICE_INPUTS];
+        float targetGains[MAX_VOICE_INPUTS];
+        for (int output = 0; output < numOutputs; ++output) {
+            for (int input = 0; input < numInputs; ++input) {
+                const float target = voice.crosspoints.at(input, output) * voice.inputLevels[input] * outputLevels_[output];
+                previousGains[input] = voice.snapGains ? target : voice.appliedGains.at(input, output);
+                targetGains[input] = target;
+                voice.appliedGains.set(input, output, target);
+            }
+            if (!outputChannels[output]) {
+                continue;
+            }
+
+            for (const MixSegment& segment : segments) {
+                if (segment.numFrames <= 0) {
+                    continue;
+                }
+
+                const float inverseFrames = 1.0f / static_cast<float>(segment.numFrames);
+                int numRoutes = 0;
+                for (int input = 0; input < numInputs; ++input) {
+                    const float glide = targetGains[input] - previousGains[input];
+                    const float segmentStart = (previousGains[input] + glide * segment.matrixFrom) * segment.fadeFrom;
+                    const float segmentEnd = (previousGains[input] + glide * segment.matrixTo) * segment.fadeTo;
+                    if (segmentStart == 0.0f && segmentEnd == 0.0f) {
+                        continue;
+                    }
+
+                    MixKernel::Route& route = routes[numRoutes++];
+                    route.source = sources[input] + segment.firstFrame;
+                    route.gain = segmentStart;
+                    route.gainStep = (segmentEnd - segmentStart) * inverseFrames;
+                }
+
+                if (numRoutes > 0) {
+                    MixKernel::accumulateRamped(outputChannels[output] + segment.firstFrame, routes, numRoutes,
+                                                segment.numFrames);
+                    activeBuses_ |= std::uint64_t(1) << output;
+                }
+            }
+        }
+        voice.snapGains = false;
+        mark = chargeStage(CallbackProfiler::Stage::Mix, mark);
+
+        // Cue meter: source level after input trims and the cue fade, before routing
+        float cuePeak = 0.0f;
+        float cueSumSquares = 0.0f;
+        for (int input = 0; input < numInputs; ++input) {
+            float peak = 0.0f;
+            float sumSquares = 0.0f;
+            MixKernel::measure(sources[input], available, peak, sumSquares);
+
+            const float trim = voice.inputLevels[input];
+            cuePeak = std::max(cuePeak, peak * trim);
+            cueSumSquares += sumSquares * trim * trim;
+        }
+
+        const float meanGain = 0.5f * (startGain + endGain);
+        meterBank_.addCue(cueHandle, cuePeak * std::max(startGain, endGain),
+                          cueSumSquares * meanGain * meanGain / static_cast<float>(std::max(1, numInputs)), available);
+        chargeStage(CallbackProfiler::Stage::Meter, mark);
+    }
+
+    if (rampFrames > 0) {
+        voice.gain = voice.fade.advance(rampFrames);
+        if (!voice.fade.isActive() && voice.stopAfterFade) {
+            voice.playing = false;
+            voice.stopAfterFade = false;
+            postEvent(AudioEventType::Stopped, cueHandle);
+            return;
+        }
+    }
+
+    voice.positionSamples += sourceFrames;
+
+    if (voice.lengthSamples > 0 && voice.positionSamples >= voice.lengthSamples) {
+        voice.playing = false;
+        postEvent(AudioEventType::Position, cueHandle, voice.positionSamples / mediaRate(cueHandle));
+        postEvent(AudioEventType::Finished, cueHandle);
+        return;
+    }
+
+    voice.samplesSincePositionEvent += framesToRender;
+    if (voice.samplesSincePositionEvent >= static_cast<std::int64_t>(POSITION_EVENT_INTERVAL * sampleRate_)) {
+        voice.samplesSincePositionEvent = 0;
+        postEvent(AudioEventType::Position, cueHandle, voice.positionSamples / mediaRate(cueHandle));
+    }
+}
+
+int JuceAudioBridge::gatherVoiceSource(int cueHandle, std::int64_t numFrames, const float** sources)
+{
+    Voice& voice = voices_[cueHandle];
+    const DecodedAudio* audio = voice.audio;
+    if (!audio) {
+        return 0;
+    }
+
+    const int numInputs = std::min(audio->numChannels, MAX_VOICE_INPUTS);
+    const std::int64_t offset = voice.positionSamples - audio->startFrame;
+    const int headFrames = static_cast<int>(offset >= 0 ? std::clamp<std::int64_t>(audio->numFrames - offset, 0, numFrames) : 0);
+
+    // Entirely inside the RAM-resident region: mix straight from it
+    if (headFrames == numFrames || !audio->stream) {
+        for (int input = 0; input < numInputs; ++input) {
+            sources[input] = audio->channel(input) + offset;
+        }
+        return headFrames;
+    }
+
+    // Straddles the head or lies past it: assemble the block in scratch
+    const int frames = static_cast<int>(std::min<std::int64_t>(numFrames, streamScratchFrames_));
+    float* scratch[MAX_VOICE_INPUTS] = {};
+    for (int input = 0; input < numInputs; ++input) {
+        scratch[input] = streamScratch_.data() + static_cast<std::size_t>(input) * streamScratchFrames_;
+        sources[input] = scratch[input];
+        if (headFrames > 0) {
+            std::copy_n(audio->channel(input) + offset, headFrames, scratch[input]);
+        }
+    }
+
+    const std::int64_t streamFrame = voice.positionSamples + headFrames;
+    const int wanted = frames - headFrames;
+
+    float* streamDestinations[MAX_VOICE_INPUTS] = {};
+    for (int input = 0; input < numInputs; ++input) {
+        streamDestinations[input] = scratch[input] + headFrames;
+    }
+
+    const int streamed = audio->stream->read(streamFrame, streamDestinations, numInputs, wanted);
+
+    if (streamed < wanted) {
+        for (int input = 0; input < numInputs; ++input) {
+            std::fill(streamDestinations[input] + streamed, streamDestinations[input] + wanted, 0.0f);
+        }
+
+        // Running off the end of the file is not an underrun
+        if (streamFrame + streamed < audio->totalFrames) {
+            underrunCount_.fetch_add(1, std::memory_order_relaxed);
+            profiler_.markUnderrun();
+            if (!voice.underrun) {
+                postEvent(AudioEventType::Underrun, cueHandle, voice.positionSamples / mediaRate(cueHandle));
+            }
+            voice.underrun = true;
+            return frames;
+        }
+    }
+
+    voice.underrun = false;
+    return frames;
+}
+
+void JuceAudioBridge::retireAudio(const DecodedAudio* audio)
+{
+    if (!audio) {
+        return;
+    }
+
+    // Freed on the main thread by dispatchAudioEvents()
+    if (retireQueue_.retire(audio)) {
+        eventsPostedThisBlock_ = true;
+    }
+}
+
+void JuceAudioBridge::retireResampler(Resampler* resampler)
+{
+    if (!resampler) {
+        return;
+    }
+
+    // Deleted on the main thread by dispatchAudioEvents()
+    if (resamplerRetireQueue_.retire(resampler)) {
+        eventsPostedThisBlock_ = true;
+    }
+}
+
+void JuceAudioBridge::retireStartSet(StartSet* startSet)
+{
+    if (!startSet) {
+        return;
+    }
+
+    // Deleted on the main thread by dispatchAudioEvents()
+    if (startSetRetireQueue_.retire(startSet)) {
+        eventsPostedThisBlock_ = true;
+    }
+}
+
+void JuceAudioBridge::retirePatch(const CompiledPatch* patch)
+{
+    if (!patch) {
+        return;
+    }
+
+    // Deleted on the main thread by dispatchAudioEvents()
+    if (patchRetireQueue_.retire(patch)) {
+        eventsPostedThisBlock_ = true;
+    }
+}
+
+void JuceAudioBridge::postEvent(AudioEventType type, int cueHandle, double value)
+{
+    AudioEvent event;
+    event.type = type;
+    event.cueHandle = cueHandle;
+    event.generation = cueHandle >= 0 && cueHandle < MAX_VOICES ? voices_[cueHandle].generation : 0;
+    event.value = value;
+
+    // A full ring drops the event; the UI catches up on the next position update
+    if (eventQueue_.push(event)) {
+        eventsPostedThisBlock_ = true;
+    }
+}
+
+// Main Thread
+
+void JuceAudioBridge::onEventTimer()
+{
+    if (eventDispatchPending_.load(std::memory_order_acquire)) {
+        dispatchAudioEvents();
+    }
+}
+
+void JuceAudioBridge::dispatchAudioEvents()
+{
+    // Clear first so events pushed during the drain trigger a fresh dispatch
+    eventDispatchPending_.store(false, std::memory_order_release);
+
+    retireQueue_.drain([this](const DecodedAudio* audio) {
+        freeDecodedAudio(audio);
+    });
+
+    matrixRetireQueue_.drain([](const GainMatrix* matrix) {
+        delete matrix;
+    });
+
+    resamplerRetireQueue_.drain([](Resampler* resampler) {
+        delete resampler;
+    });
+
+    startSetRetireQueue_.drain([](StartSet* startSet) {
+        delete startSet;
+    });
+
+    patchRetireQueue_.drain([](const CompiledPatch* patch) {
+        delete patch;
+    });
+
+    eventQueue_.drain([this](const AudioEvent& event) {
+        if (event.type == AudioEventType::Deadline) {
+            emit scheduledDeadline(static_cast<quint32>(event.value));
+            return;
+        }
+        if (event.type == AudioEventType::Dropout) {
+            emit audioDropout();
+            return;
+        }
+
+        if (event.cueHandle < 0 || event.cueHandle >= handleCueIds_.size()) {
+            return;
+        }
+
+        // Released since the event was queued, or released and handed to another cue
+        const QString& cueId = handleCueIds_[event.cueHandle];
+        if (cueId.isEmpty() || event.generation != handleGenerations_[event.cueHandle]) {
+            return;
+        }
+
+        CueState& state = handleStates_[event.cueHandle];
+        switch (event.type) {
+        case AudioEventType::Started:   state.playing = true; state.position = event.value; break;
+        case AudioEventType::Finished:
+        case AudioEventType::Stopped:   state.playing = false; break;
+        case AudioEventType::Position:  state.position = event.value; break;
+        default:                        break;
+        }
+
+        switch (event.type) {
+        case AudioEventType::Started:   emit cueStarted(cueId); break;
+        case AudioEventType::Finished:  emit cueFinished(cueId); break;
+        case AudioEventType::Paused:    emit cuePaused(cueId); break;
+        case AudioEventType::Resumed:   emit cueResumed(cueId); break;
+        case AudioEventType::Stopped:   emit cueStopped(cueId); break;
+        case AudioEventType::Position:  emit cuePositionChanged(cueId, event.value); break;
+        case AudioEventType::Underrun:  emit bufferUnderrun(cueId); break;
+        case AudioEventType::Deadline:  break;
+        case AudioEventType::Dropout:   break;
+        case AudioEventType::Error:     emit cueError(cueId, QString("Audio engine error")); break;
+        }
+    });
+}
+
+// Media Decoding
+
+std::unique_ptr<DecodedAudio> JuceAudioBridge::decodeAudioFile(const QString& filePath, double startSeconds, double maxSeconds,
+                                                               std::int64_t residentThresholdBytes, double targetSampleRate)
+{
+    // Own format manager per call so decoding can run on any worker thread
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    juce::File file(juce::String::fromUTF8(filePath.toUtf8().constData()));
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (!reader || reader->numChannels == 0 || reader->sampleRate <= 0.0) {
+        return nullptr;
+    }
+
+    // Frames below are at the playback rate; a mismatched file is converted here, never in the callback
+    const double playbackRate = targetSampleRate > 0.0 ? targetSampleRate : reader->sampleRate;
+    const double sourceStep = reader->sampleRate / playbackRate;
+    const bool convert = std::abs(sourceStep - 1.0) > 1e-9;
+
+    auto audio = std::make_unique<DecodedAudio>();
+    audio->numChannels = static_cast<int>(reader->numChannels);
+    audio->sampleRate = playbackRate;
+    audio->sourceSampleRate = reader->sampleRate;
+    audio->totalFrames = convert ? static_cast<std::int64_t>(std::ceil(reader->lengthInSamples / sourceStep))
+                                 : reader->lengthInSamples;
+    audio->startFrame = juce::jlimit<juce::int64>(0, audio->totalFrames,
+        static_cast<juce::int64>(startSeconds * playbackRate));
+
+    std::int64_t frames = audio->totalFrames - audio->startFrame;
+    const std::int64_t residentBytes = frames * audio->numChannels * static_cast<std::int64_t>(sizeof(float));
+    const bool streamed = residentThresholdBytes > 0 && residentBytes > residentThresholdBytes;
+
+    // Under the threshold a short file is decoded whole, so it never touches the disk thread
+    if (maxSeconds > 0.0 && (residentThresholdBytes <= 0 || streamed)) {
+        frames = std::min<std::int64_t>(frames, static_cast<std::int64_t>(maxSeconds * playbackRate));
+    }
+    audio->numFrames = frames;
+    audio->samples.resize(static_cast<std::size_t>(audio->numChannels) * frames);
+
+    // JUCE reads take an int length, so go in chunks
+    const auto readFrames = [&reader](const std::vector<float*>& destinations, std::int64_t first, std::int64_t count) {
+        constexpr std::int64_t chunkFrames = 1 << 20;
+        std::vector<float*> chunk(destinations.size());
+        for (std::int64_t done = 0; done < count; done += chunkFrames) {
+            for (std::size_t channel = 0; channel < destinations.size(); ++channel) {
+                chunk[channel] = destinations[channel] + done;
+            }
+            if (!reader->read(chunk.data(), static_cast<int>(chunk.size()), first + done,
+                              static_cast<int>(std::min(chunkFrames, count - done)))) {
+                return false;
+            }
+        }
+        return true;
     };
 
-    QMap<QString, DummyCue> dummyCues_;
-#endif
-
-    // Status monitoring
-    QTimer* statusTimer_;
-    QTimer* positionTimer_;
-    mutable QMutex statusMutex_;
-    EngineStatus currentStatus_;
-
-    // Performance tracking
-    double lastCpuUsage_;
-    int lastDropoutCount_;
-    QStringList availableDevices_;
-    QString currentDeviceName_;
-
-    // State flags
-    bool initialized_;
-    bool shutdownInProgress_;
-    QString lastError_;
-
-    // Constants
-    static constexpr int STATUS_UPDATE_INTERVAL = 100;    // 100ms
-    static constexpr int POSITION_UPDATE_INTERVAL = 50;   // 50ms for smooth position updates
-    static constexpr double FADE_STEP_SIZE = 0.001;       // Fade resolution
-    static constexpr int MAX_MATRIX_INPUTS = 64;          // Maximum matrix inputs
-    static constexpr int MAX_MATRIX_OUTPUTS = 64;         // Maximum matrix outputs
-};
\ No newline at end of file
+    std::vector<float*> destinations(audio->numChannels);
+    for (int channel = 0; channel < audio->numChannels; ++channel) {
+        destinations[channel] = audio->channel(channel);
+    }
+
+    if (!convert) {
+        if (!readFrames(destinations, audio->startFrame, frames)) {
+            return nullptr;
+        }
+    }
+    else {
+        // Decode the covering source region plus filter margins, then convert it in one pass
+        const int margin = Resampler::MAX_TAPS;
+        const double sourceStart = audio->startFrame * sourceStep;
+        const std::int64_t first = std::max<std::int64_t>(0, static_cast<std::int64_t>(sourceStart) - margin);
+        const std::int64_t last = std::min<std::int64_t>(reader->lengthInSamples,
+            static_cast<std::int64_t>(std::ceil((audio->startFrame + frames) * sourceStep)) + margin);
+
+        const std::int64_t sourceFrames = std::max<std::int64_t>(0, last - first);
+        std::vector<float> source(static_cast<std::size_t>(audio->numChannels) * sourceFrames);
+        std::vector<float*> sourceChannels(audio->numChannels);
+        for (int channel = 0; channel < audio->numChannels; ++channel) {
+            sourceChannels[channel] = source.data() + static_cast<std::size_t>(channel) * sourceFrames;
+        }
+        if (!readFrames(sourceChannels, first, sourceFrames)) {
+            return nullptr;
+        }
+
+        std::vector<const float*> inputs(sourceChannels.begin(), sourceChannels.end());
+        Resampler::convert(inputs.data(), audio->numChannels, sourceFrames, destinations.data(), frames,
+                           sourceStep, sourceStart - first, ResamplerQuality::High);
+    }
+
+    // The head plays from RAM while the disk thread reads ahead from its end
+    if (streamed && !audio->coversToEnd()) {
+        const int bufferFrames = static_cast<int>(STREAM_BUFFER_SECONDS * playbackRate);
+        audio->stream = std::make_shared<AudioStream>(std::move(reader), audio->startFrame + audio->numFrames, bufferFrames,
+                                                      sourceStep);
+    }
+
+    return audio;
+}
+
+bool JuceAudioBridge::attachDecodedAudio(const QString& cueId, const DecodedAudio* audio)
+{
+    const int handle = cueHandle(cueId);
+    if (handle < 0 || !audio) {
+        freeDecodedAudio(audio);
+        return false;
+    }
+
+    // Decoded for the device rate before a rate change; the prearmer decodes it again
+    if (audio->sampleRate != sampleRate_) {
+        qDebug() << "Cue" << cueId << "was decoded at" << audio->sampleRate << "Hz, engine runs at" << sampleRate_;
+        freeDecodedAudio(audio);
+        return false;
+    }
+
+    AudioCommand command;
+    command.type = AudioCommandType::AttachAudio;
+    command.cueHandle = handle;
+    command.audio = audio;
+
+    // Start filling the read-ahead now so it is primed well before GO
+    diskStreamer_.addStream(audio->stream);
+
+    if (!postCommand(command)) {
+        freeDecodedAudio(audio);
+        return false;
+    }
+
+    handleStates_[handle].duration = audio->sampleRate > 0.0 ? audio->totalFrames / audio->sampleRate : 0.0;
+    return true;
+}
+
+void JuceAudioBridge::detachDecodedAudio(const QString& cueId)
+{
+    const int handle = cueHandle(cueId);
+    if (handle < 0) {
+        return;
+    }
+
+    // A null payload makes the callback retire whatever the voice holds
+    AudioCommand command;
+    command.type = AudioCommandType::AttachAudio;
+    command.cueHandle = handle;
+    if (postCommand(command)) {
+        handleStates_[handle].duration = 0.0;
+    }
+}
+
+double JuceAudioBridge::getLastTriggerLatencyMs() const
+{
+    return lastTriggerLatencyNs_.load(std::memory_order_relaxed) / 1.0e6;
+}
+
+double JuceAudioBridge::getMaxTriggerLatencyMs() const
+{
+    return maxTriggerLatencyNs_.load(std::memory_order_relaxed) / 1.0e6;
+}
+
+void JuceAudioBridge::resetTriggerLatency()
+{
+    lastTriggerLatencyNs_.store(0, std::memory_order_relaxed);
+    maxTriggerLatencyNs_.store(0, std::memory_order_relaxed);
+    triggerLatency_.reset();
+}
+
+std::int64_t JuceAudioBridge::getSampleClock() const
+{
+    return publishedClockSample_.load(std::memory_order_relaxed);
+}
+
+double JuceAudioBridge::getClockSampleRate() const
+{
+    return publishedSampleRate_.load(std::memory_order_relaxed);
+}
+
+std::int64_t JuceAudioBridge::estimateSampleTime(std::int64_t steadyNs) const
+{
+    std::int64_t clockSample = 0;
+    std::int64_t clockNs = 0;
+    std::uint32_t sequence = 0;
+
+    // Retry while the audio thread is mid-publish
+    do {
+        sequence = clockSequence_.load(std::memory_order_acquire);
+        clockSample = publishedClockSample_.load(std::memory_order_relaxed);
+        clockNs = publishedClockNs_.load(std::memory_order_relaxed);
+    } while ((sequence & 1u) != 0 || sequence != clockSequence_.load(std::memory_order_acquire));
+
+    if (clockNs == 0 || isFreewheeling()) {
+        return clockSample; // No callback yet, or offline: the next block starts on clockSample
+    }
+
+    const double elapsedSeconds = std::max<std::int64_t>(0, steadyNs - clockNs) / 1.0e9;
+    return clockSample + static_cast<std::int64_t>(elapsedSeconds * getClockSampleRate());
+}
+
+std::int64_t JuceAudioBridge::steadyClockNs()
+{
+    return steadyNowNs();
+}
+
+void JuceAudioBridge::setResidentThresholdBytes(std::int64_t bytes)
+{
+    residentThresholdBytes_ = qMax<std::int64_t>(0, bytes);
+}
+
+// Status
+
+JuceAudioBridge::JuceStatus JuceAudioBridge::getStatus() const
+{
+    JuceStatus status;
+    {
+        QMutexLocker locker(&statusMutex_);
+        status = currentStatus_;
+    }
+
+    status.currentDevice = deviceSwitcher_->currentDevice();
+    status.isRunning = !status.currentDevice.isEmpty();
+    status.sampleRate = deviceSwitcher_->sampleRate();
+    status.bufferSize = deviceSwitcher_->bufferSize();
+    status.cpuUsage = getCpuUsage();
+    status.dropoutCount = getDropoutCount();
+    status.lastTriggerLatencyMs = getLastTriggerLatencyMs();
+    status.maxTriggerLatencyMs = getMaxTriggerLatencyMs();
+    return status;
+}
+
+void JuceAudioBridge::updateStatus()
+{
+    const JuceStatus status = getStatus();
+
+    // Whole percent steps: the meter doesn't need every flicker
+    if (std::abs(status.cpuUsage - lastCpuUsage_) >= 1.0) {
+        lastCpuUsage_ = status.cpuUsage;
+        emit cpuUsageChanged(status.cpuUsage);
+    }
+    lastDropoutCount_ = status.dropoutCount;
+
+    emit statusUpdated();
+}
+
+void JuceAudioBridge::onStatusTimer()
+{
+    updateStatus();
+}
+
+bool JuceAudioBridge::isCuePlaying(const QString& cueId) const
+{
+    const int handle = cueHandle(cueId);
+    return handle >= 0 && handleStates_[handle].playing;
+}
+
+double JuceAudioBridge::getCuePosition(const QString& cueId) const
+{
+    const int handle = cueHandle(cueId);
+    return handle >= 0 ? handleStates_[handle].position : 0.0;
+}
+
+double JuceAudioBridge::getCueDuration(const QString& cueId) const
+{
+    const int handle = cueHandle(cueId);
+    return handle >= 0 ? handleStates_[handle].duration : 0.0;
+}
+
+double JuceAudioBridge::getCpuUsage() const
+{
+    return profiler_.recentLoad() * 100.0;
+}
+
+int JuceAudioBridge::getDropoutCount() const
+{
+    return static_cast<int>(profiler_.dropoutCount());
+}
+
+void JuceAudioBridge::resetDropoutCount()
+{
+    profiler_.reset();
+}
+
+quint64 JuceAudioBridge::getUnderrunCount() const
+{
+    return underrunCount_.load(std::memory_order_relaxed);
+}
+
+void JuceAudioBridge::resetUnderrunCount()
+{
+    underrunCount_.store(0, std::memory_order_relaxed);
+}
+
+void JuceAudioBridge::freeDecodedAudio(const DecodedAudio* audio)
+{
+    if (!audio) {
+        return;
+    }
+
+    // The disk thread stops servicing it; a pass already under way holds its own reference
+    if (audio->stream) {
+        diskStreamer_.removeStream(audio->stream.get());
+    }
+
+    // Shared buffers stay cached for the next cue on the same file; unpooled ones are deleted
+    mediaPool_.release(audio);
+}
+
+void JuceAudioBridge::executeOnMainThread(std::function<void()> callback)
+{
+    QMetaObject::invokeMethod(this, std::move(callback), Qt::QueuedConnection);
+}
+
+// Error Handling
+
+void JuceAudioBridge::reportError(const QString& context, const QString& error)
+{
+    const QString message = QString("%1: %2").arg(context, error);
+    qWarning() << "Audio engine" << message;
+
+    lastError_ = message;
+    {
+        QMutexLocker locker(&statusMutex_);
+        currentStatus_.lastError = message;
+    }
+    emit juceError(message);
+}
+
+// String Conversion Helpers
+
+QString JuceAudioBridge::juceToQt(const juce::String& juceString) const
+{
+    return QString::fromUtf8(juceString.toRawUTF8());
+}
+
+juce::String JuceAudioBridge::qtToJuce(const QString& qtString) const
+{
+    return juce::String::fromUTF8(qtString.toUtf8().constData());
+}
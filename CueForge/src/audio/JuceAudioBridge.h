@@ -6,13 +6,34 @@
 #include <QStringList>
 #include <QTimer>
 #include <QMutex>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <array>
 #include <memory>
 #include <functional>
+#include <atomic>
+#include <vector>
+
+#include "AudioBackend.h"
+#include "AudioCommandQueue.h"
+#include "CallbackProfiler.h"
+#include "DecodedAudio.h"
+#include "DiskStreamer.h"
+#include "FadeEngine.h"
+#include "GainMatrix.h"
+#include "LatencyHistogram.h"
+#include "MediaPool.h"
+#include "MeterBank.h"
+#include "OutputPatch.h"
+#include "Resampler.h"
 
 // Forward declare your existing JUCE classes to avoid header dependencies
 class AudioEngine;      // Your existing JUCE AudioEngine from native/include/AudioEngine.h
 class MatrixMixer;      // Your existing JUCE MatrixMixer
-class OutputPatch;      // Your existing JUCE OutputPatch
+class AudioDeviceSwitcher;
+
+namespace juce { class String; }
 
 /**
  * @brief Low-level bridge between Qt6 and your existing JUCE audio engine
@@ -21,15 +42,16 @@ class OutputPatch;      // Your existing JUCE OutputPatch
  * providing string conversion, thread safety, and lifecycle management.
  * It isolates JUCE dependencies from the rest of the Qt6 application.
  */
-class JuceAudioBridge : public QObject
+class JuceAudioBridge : public QObject, public AudioBackend<JuceAudioBridge>
 {
     Q_OBJECT
+    friend class AudioBackend<JuceAudioBridge>;
 
 public:
     explicit JuceAudioBridge(QObject* parent = nullptr);
     ~JuceAudioBridge();
 
-    // Lifecycle management
+    // Lifecycle management: device types and status polling; devices are opened through setAudioDevice()
     bool initialize();
     void shutdown();
     bool isInitialized() const { return initialized_; }
@@ -40,28 +62,69 @@ public:
     // Device management (wrapping your JUCE AudioEngine methods)
     QStringList getAvailableDevices() const;
     QString getCurrentDevice() const;
-    bool setAudioDevice(const QString& deviceName);
+    bool setAudioDevice(const QString& deviceName);     // Hot switch: playback carries on
+    AudioDeviceSwitcher* getDeviceSwitcher() const { return deviceSwitcher_.get(); }    // Standby, failover, rate/buffer
+
+    // Handle-based transport (AudioBackend): play, stop, pause, resume, fade, setSpeed, ...
+    using AudioBackend<JuceAudioBridge>::setCrosspoint;
+    using AudioBackend<JuceAudioBridge>::setInputLevel;
 
-    // Audio cue operations (converting Qt strings to JUCE strings)
-    bool createAudioCue(const QString& cueId, const QString& filePath);
-    bool loadAudioFile(const QString& cueId, const QString& filePath);
-    bool playCue(const QString& cueId, double startTime = 0.0, double fadeInTime = 0.0);
-    bool stopCue(const QString& cueId, double fadeOutTime = 0.0);
+    // Cue-ID convenience wrappers; each resolves the handle and forwards
+    bool playCue(const QString& cueId, double startTime = 0.0, double fadeInTime = 0.0, FadeCurve curve = FadeCurve::Linear);
+    bool stopCue(const QString& cueId, double fadeOutTime = 0.0, FadeCurve curve = FadeCurve::Linear);
     bool pauseCue(const QString& cueId);
     bool resumeCue(const QString& cueId);
-    void stopAllCues();
+    void stopAllCues(double fadeOutTime = 0.0, FadeCurve curve = FadeCurve::Linear);
+
+    /**
+     * @brief Varispeed: play the cue's media speed times faster (pitch follows)
+     *
+     * The resampler is allocated here and handed to the voice; the callback
+     * only filters. 1.0 returns the voice to the direct path.
+     */
+    bool setCueSpeed(const QString& cueId, double speed, ResamplerQuality quality = ResamplerQuality::Standard);
+
+    /**
+     * @brief One destination of a multi-target fade
+     *
+     * input/output select a single crosspoint; leave them at -1 to fade the
+     * cue's overall gain.
+     */
+    struct FadeTarget {
+        QString cueId;
+        float level = 0.0f;
+        int input = -1;
+        int output = -1;
+    };
+
+    /**
+     * @brief Start fades on many cues/crosspoints on the same audio sample
+     * @return Number of targets queued
+     */
+    int fadeTargets(const QList<FadeTarget>& targets, double duration, FadeCurve curve = FadeCurve::Linear);
 
     // Matrix routing (wrapping your JUCE MatrixMixer)
+    bool setCueMatrix(const QString& cueId, const GainMatrix& matrix);
     bool setCrosspoint(const QString& cueId, int input, int output, float level);
     float getCrosspoint(const QString& cueId, int input, int output) const;
     bool setInputLevel(const QString& cueId, int input, float level);
     bool setOutputLevel(int output, float level);
-    bool muteOutput(int output, bool mute);
+    bool muteOutput(int output, bool mute);     // Cue outputs; resolved into the compiled patch
     bool soloOutput(int output, bool solo);
 
-    // Output patch routing (wrapping your JUCE OutputPatch)
+    /**
+     * @brief Output patch: cue outputs to device outputs
+     *
+     * Every change compiles the patch to a sparse route list and swaps it in
+     * through the command ring; the callback crossfades old to new over one
+     * block. Use setOutputPatch() to change many crosspoints in one swap.
+     * @return false if out of range or the command ring is full (the change
+     *         is kept and goes out with the next one)
+     */
     bool setPatchRouting(int cueOutput, int deviceOutput, float level);
     float getPatchRouting(int cueOutput, int deviceOutput) const;
+    bool setOutputPatch(const CueOutputPatch& patch);
+    const CueOutputPatch& getOutputPatch() const { return outputPatch_; }
 
     // Status information from your JUCE engine
     struct JuceStatus {
@@ -72,10 +135,12 @@ public:
         int dropoutCount = 0;
         QString currentDevice;
         QString lastError;
+        double lastTriggerLatencyMs = 0.0;  // Play command issued -> first rendered sample
+        double maxTriggerLatencyMs = 0.0;
     };
     JuceStatus getStatus() const;
 
-    // Cue state queries
+    // Cue state as last reported by the callback (main thread)
     bool isCuePlaying(const QString& cueId) const;
     double getCuePosition(const QString& cueId) const;
     double getCueDuration(const QString& cueId) const;
@@ -85,13 +150,141 @@ public:
     int getDropoutCount() const;
     void resetDropoutCount();
 
+    // Cue handle registry (main thread). Handles index the audio-thread voice table and are
+    // only held while a cue is armed or playing; acquire returns -1 if no voice could be attached.
+    int acquireCueHandle(const QString& cueId);
+    void releaseCueHandle(const QString& cueId);
+    int cueHandle(const QString& cueId) const { return cueHandles_.value(cueId, -1); }
+
+    /**
+     * @brief Queue a command for the audio callback (lock-free, any thread)
+     *
+     * Commands with atSample in the future wait on the audio-thread timeline
+     * and are applied at exactly that sample.
+     * @return false if the command ring is full
+     */
+    bool postCommand(const AudioCommand& command);
+
+    /**
+     * @brief Start several voices on exactly the same sample, as one command
+     *
+     * atSample/token work as for postCommand(); -1 starts them at the next
+     * block. Invalid handles are skipped.
+     * @return false if nothing was valid or the command ring is full (none start)
+     */
+    bool postStartSet(const QVector<CueStart>& starts, std::int64_t atSample, std::uint32_t token);
+
+    // Audio clock: frames rendered since the engine started
+    std::int64_t getSampleClock() const;
+    double getClockSampleRate() const;
+
+    /**
+     * @brief Map a steady_clock time onto the audio clock
+     *
+     * Extrapolated from the last callback, so deadlines derived from a GO
+     * press line up with what the listener hears.
+     */
+    std::int64_t estimateSampleTime(std::int64_t steadyNs) const;
+    static std::int64_t steadyClockNs();
+
+    /**
+     * @brief Offline rendering: blocks are pulled as fast as the caller likes, not by a device
+     *
+     * The clock is published at the end of each block and never extrapolated,
+     * so a GO issued between blocks lands on the next one's first sample
+     * whatever the wall clock did, and timing gaps aren't reported as dropouts.
+     */
+    void setFreewheel(bool enabled) { freewheel_.store(enabled, std::memory_order_relaxed); }
+    bool isFreewheeling() const { return freewheel_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Audio callback body; called by whichever device owns the engine
+     *
+     * Drains pending commands, advances voices and queues events for the UI.
+     * Never locks or allocates.
+     */
+    void processAudioBlock(float* const* outputChannels, int numOutputChannels, int numSamples);
+
+    /**
+     * @brief Size the engine for a device; only while no device renders
+     *
+     * On a rate change, deadlines and fades keep their length in time and
+     * voices whose media was decoded for the old rate resample it live until
+     * the prearmer has decoded it again.
+     */
+    void prepareAudio(double sampleRate, int maximumBlockSize);
+
+    /**
+     * @brief Decode part of a media file into RAM (thread-safe, blocking)
+     * @param startSeconds Offset into the file
+     * @param maxSeconds Upper bound on the decoded region; <= 0 decodes to the end
+     * @param residentThresholdBytes When > 0, files whose remaining decoded size
+     *        fits are decoded whole; larger ones keep a maxSeconds head and stream the rest
+     * @param targetSampleRate Playback rate; a file at another rate is converted
+     *        offline (ResamplerQuality::High). <= 0 keeps the file's rate
+     * @return Decoded region, or nullptr if the file can't be read
+     */
+    static std::unique_ptr<DecodedAudio> decodeAudioFile(const QString& filePath, double startSeconds, double maxSeconds,
+                                                         std::int64_t residentThresholdBytes = 0,
+                                                         double targetSampleRate = 0.0);
+
+    // RAM-resident vs streamed playback cut-off, in decoded float bytes
+    std::int64_t getResidentThresholdBytes() const { return residentThresholdBytes_; }
+    void setResidentThresholdBytes(std::int64_t bytes);
+
+    /**
+     * @brief Hand a decoded region to the cue's voice; the engine takes ownership
+     *
+     * For a buffer from getMediaPool()->acquire(), the engine takes over that
+     * reference and gives it back to the pool once the voice lets go.
+     */
+    bool attachDecodedAudio(const QString& cueId, const DecodedAudio* audio);
+    bool attachDecodedAudio(const QString& cueId, std::unique_ptr<DecodedAudio> audio)
+    {
+        return attachDecodedAudio(cueId, static_cast<const DecodedAudio*>(audio.release()));
+    }
+    void detachDecodedAudio(const QString& cueId);
+
+    // Decoded buffers shared between cues that play the same media (thread-safe)
+    MediaPool* getMediaPool() { return &mediaPool_; }
+    const MediaPool* getMediaPool() const { return &mediaPool_; }
+
+    // GO -> first-sample latency, measured on the audio thread from the Play command's timestampNs
+    double getLastTriggerLatencyMs() const;
+    double getMaxTriggerLatencyMs() const;
+    const LatencyHistogram& getTriggerLatencyHistogram() const { return triggerLatency_; }
+    void resetTriggerLatency();
+
+    // Streamed cues whose read-ahead ran dry (blocks with missing samples)
+    quint64 getUnderrunCount() const;
+    void resetUnderrunCount();
+
+    /**
+     * @brief Raw per-output and per-cue levels written by the callback
+     *
+     * Indexed by output channel and cue handle. Read it from one thread only
+     * (LevelMeters does, at the display rate).
+     */
+    MeterBank* getMeterBank() { return &meterBank_; }
+
+    // Callback timing, stage breakdown and the recent-callback ring (dumped on dropouts)
+    CallbackProfiler* getProfiler() { return &profiler_; }
+    const CallbackProfiler* getProfiler() const { return &profiler_; }
+
+    /**
+     * @brief Main thread: turn what the callback queued into signals and free what it retired
+     *
+     * A display-rate timer calls this whenever the callback has flagged new
+     * work; the audio thread itself never posts to Qt. Offline drivers with no
+     * event loop running call it between blocks.
+     */
+    void dispatchAudioEvents();
+
     // Thread-safe execution helpers
-    void executeOnAudioThread(std::function<void()> callback);
     void executeOnMainThread(std::function<void()> callback);
 
 public slots:
     void updateStatus();
-    void handleJuceMessage();
 
 signals:
     // Error and status signals
@@ -107,39 +300,72 @@ signals:
     void cueStopped(const QString& cueId);
     void cueError(const QString& cueId, const QString& error);
 
+    // A voice was attached to the cue; per-cue routing and speed have to be sent to it again
+    void cueVoiceAttached(const QString& cueId, int handle);
+
     // Position tracking
     void cuePositionChanged(const QString& cueId, double position);
 
     // Performance signals
     void cpuUsageChanged(double usage);
     void audioDropout();
+    void bufferUnderrun(const QString& cueId);
+
+    // Scheduling
+    void scheduledDeadline(quint32 markerId);
 
 private slots:
     void onStatusTimer();
-    void processJuceCallbacks();
+    void onEventTimer();            // Dispatches if the callback raised eventDispatchPending_
 
 private:
-    // JUCE initialization helpers
-    bool initializeJuceFramework();
-    bool createAudioEngine();
-    bool setupAudioDevice();
-    void shutdownJuceFramework();
-
     // String conversion helpers
-    QString juceToQt(const class juce::String& juceString) const;
-    class juce::String qtToJuce(const QString& qtString) const;
+    QString juceToQt(const juce::String& juceString) const;
+    juce::String qtToJuce(const QString& qtString) const;
 
     // Error handling
-    void handleJuceError(const QString& error);
     void reportError(const QString& context, const QString& error);
 
-    // Callback setup for your JUCE engine
-    void setupJuceCallbacks();
-    void cleanupJuceCallbacks();
-
-    // Thread synchronization
-    void ensureAudioThread();
-    void ensureMainThread();
+    // AudioBackend hooks (main/control threads; handles already validated)
+    CueHandle acquireHandle(const QString& cueId) { return acquireCueHandle(cueId); }
+    void releaseHandle(const QString& cueId) { releaseCueHandle(cueId); }
+    CueHandle findHandle(const QString& cueId) const { return cueHandle(cueId); }
+    bool playHandle(CueHandle handle, double startTime, double fadeInTime, FadeCurve curve);
+    bool stopHandle(CueHandle handle, double fadeOutTime, FadeCurve curve);
+    bool pauseHandle(CueHandle handle);
+    bool resumeHandle(CueHandle handle);
+    bool fadeHandle(CueHandle handle, float level, double duration, FadeCurve curve);
+    void stopAllHandles(double fadeOutTime, FadeCurve curve);
+    bool playSetHandles(const QVector<CueStart>& starts) { return postStartSet(starts, -1, 0); }
+    bool setSpeedHandle(CueHandle handle, double speed, ResamplerQuality quality);
+    bool setMatrixHandle(CueHandle handle, const GainMatrix& matrix);
+    bool setCrosspointHandle(CueHandle handle, int input, int output, float level);
+    bool setInputLevelHandle(CueHandle handle, int input, float level);
+    bool setOutputLevelAll(int output, float level);
+
+    // Audio-thread helpers
+    void applyCommand(const AudioCommand& command);
+    void scheduleCommand(const AudioCommand& command);
+    void cancelScheduled(std::uint32_t token);
+    void publishClock();
+    void stopVoice(int cueHandle, std::int64_t fadeSamples, FadeCurve curve);
+    void startCrosspointFade(int cueHandle, int input, int output, float level, std::int64_t fadeSamples, FadeCurve curve);
+    void advanceCrosspointFades(int cueHandle, std::int64_t frames);
+    void renderVoice(int cueHandle, float* const* outputChannels, int numOutputChannels, int numSamples);
+    double mediaRate(int cueHandle) const;      // Frames per second of the voice's media
+    double sourceStep(int cueHandle) const;     // Media frames per output frame: varispeed and any rate change
+    void rescaleForRate(double ratio);          // prepareAudio(), while nothing renders
+    std::int64_t stageMark() const;
+    std::int64_t chargeStage(CallbackProfiler::Stage stage, std::int64_t since);
+    int gatherVoiceSource(int cueHandle, std::int64_t numFrames, const float** sources);
+    void retireAudio(const DecodedAudio* audio);
+    void retireResampler(Resampler* resampler);
+    void retireStartSet(StartSet* startSet);
+    void retirePatch(const CompiledPatch* patch);
+    bool commitPatch();     // Main thread: compile outputPatch_ and post it
+    void applyPatch(float* const* outputChannels, int numOutputChannels, int numSamples);
+    void freeDecodedAudio(const DecodedAudio* audio);   // Main thread; returns pooled buffers
+    void postEvent(AudioEventType type, int cueHandle, double value = 0.0);
 
     // Your existing JUCE components
     std::unique_ptr<AudioEngine> juceEngine_;    // Your main AudioEngine class
@@ -153,11 +379,122 @@ private:
     QString lastError_;
     QTimer* errorTimer_;
 
-    // Thread management
-    QMutex audioThreadMutex_;
-    std::queue<std::function<void()>> audioThreadQueue_;
-    std::queue<std::function<void()>> mainThreadQueue_;
-    QTimer* callbackTimer_;
+    // Lock-free queues between the UI and audio threads
+    AudioCommandQueue commandQueue_;             // UI/control threads -> audio callback
+    AudioEventQueue eventQueue_;                 // Audio callback -> UI thread
+    AudioRetireQueue retireQueue_;               // Decoded buffers released by the callback
+    MatrixRetireQueue matrixRetireQueue_;        // Matrix snapshots the callback has copied
+    ResamplerRetireQueue resamplerRetireQueue_;  // Varispeed resamplers voices have dropped
+    StartSetRetireQueue startSetRetireQueue_;    // Start sets applied, cancelled or dropped
+    PatchRetireQueue patchRetireQueue_;          // Output patches replaced by a newer one
+    std::atomic<bool> eventDispatchPending_;     // Set by the callback, cleared by dispatchAudioEvents()
+    bool eventsPostedThisBlock_;                 // Audio thread only
+    QTimer* eventTimer_;                         // Main thread: polls eventDispatchPending_
+
+    // Cue handle registry (main thread only)
+    QHash<QString, int> cueHandles_;
+    QVector<QString> handleCueIds_;              // Handle -> cue ID
+    QVector<quint32> handleGenerations_;         // Handle -> bumped on every acquire, matched against events
+    QVector<int> freeHandles_;
+    QHash<int, ResamplerQuality> varispeedQualities_;   // Handles whose voice holds a resampler
+    QHash<int, GainMatrix> handleMatrices_;      // Routing last sent to each handle's voice
+
+    struct CueState {
+        bool playing = false;
+        double position = 0.0;                   // Seconds, from Started/Position events
+        double duration = 0.0;                   // Seconds of attached media, 0 = none
+    };
+    QVector<CueState> handleStates_;             // Handle -> state, fed by dispatchAudioEvents()
+
+    // Audio-thread voice state, preallocated to MAX_VOICES
+    struct CrosspointFade {
+        int input = 0;
+        int output = 0;
+        FadeEngine::Fade fade;
+    };
+
+    /**
+     * @brief Stretch of a block mixed with one linear gain ramp (renderVoice)
+     *
+     * The fade and the matrix glide are given as their own ramps; matrixFrom/To
+     * are the fraction of the block's matrix change reached at either end.
+     */
+    struct MixSegment {
+        int firstFrame;
+        int numFrames;
+        float fadeFrom;
+        float fadeTo;
+        float matrixFrom;
+        float matrixTo;
+    };
+
+    static constexpr int MAX_CROSSPOINT_FADES = 32;     // Per voice (declared here: sizes Voice below)
+
+    struct Voice {
+        bool attached = false;
+        bool playing = false;
+        bool paused = false;
+        bool stopAfterFade = false;
+        std::int64_t positionSamples = 0;
+        std::int64_t lengthSamples = 0;          // 0 = unknown/unbounded
+        std::int64_t samplesSincePositionEvent = 0;
+        float gain = 1.0f;                       // Cue gain at the start of the next block
+        FadeEngine::Fade fade;                   // Cue gain fade (inactive when elapsed == length)
+        std::array<CrosspointFade, MAX_CROSSPOINT_FADES> crosspointFades;
+        int numCrosspointFades = 0;
+        const DecodedAudio* audio = nullptr;     // RAM-resident region (owned by the engine)
+        std::int64_t triggerTimestampNs = 0;     // Pending latency measurement, 0 = none
+        bool underrun = false;                   // Stream ran dry in the previous block
+        bool snapGains = true;                   // Next block starts at target gains, no ramp
+        GainMatrix crosspoints;                  // Target routing from the cue
+        GainMatrix appliedGains;                 // Effective gains at the end of the last block
+        std::vector<float> inputLevels;          // MAX_VOICE_INPUTS
+        double speed = 1.0;                      // Source frames per output frame
+        Resampler* varispeed = nullptr;          // Set while speed != 1 (owned by the engine)
+        std::uint32_t generation = 0;            // From AttachVoice; copied into every event
+    };
+    std::vector<Voice> voices_;
+    std::vector<float> outputLevels_;            // MAX_VOICE_OUTPUTS
+    CueOutputPatch outputPatch_;                 // Main thread: the patch as edited
+    const CompiledPatch* patch_;                 // Audio thread: patch in effect (owned by the engine)
+    const CompiledPatch* previousPatch_;         // Audio thread: faded out this block, then retired
+    std::vector<float> busBuffers_;              // MAX_VOICE_OUTPUTS x maximumBlockSize_, zero between blocks
+    std::uint64_t activeBuses_;                  // Buses a voice mixed into this block
+    double sampleRate_;
+    int maximumBlockSize_;
+    std::int64_t blockStartNs_;                  // steady_clock time at callback entry
+    int streamScratchFrames_;                    // Source frames one block can consume at MAX_STEP
+    std::vector<float> streamScratch_;           // MAX_VOICE_INPUTS x streamScratchFrames_
+    std::vector<float> varispeedScratch_;        // MAX_VOICE_INPUTS x maximumBlockSize_
+
+    // Audio-clock timeline (audio thread only, min-heap on atSample, never grows)
+    std::vector<AudioCommand> timeline_;
+    std::int64_t sampleClock_;
+
+    // Clock snapshot for other threads (seqlock)
+    std::atomic<std::uint32_t> clockSequence_;
+    std::atomic<std::int64_t> publishedClockSample_;
+    std::atomic<std::int64_t> publishedClockNs_;
+    std::atomic<double> publishedSampleRate_;
+
+    // Streaming
+    DiskStreamer diskStreamer_;
+    std::int64_t residentThresholdBytes_;
+    MediaPool mediaPool_;                        // Every voice's buffer goes back here
+    std::atomic<quint64> underrunCount_;
+
+    // Trigger latency statistics (written by the audio thread)
+    std::atomic<std::int64_t> lastTriggerLatencyNs_;
+    std::atomic<std::int64_t> maxTriggerLatencyNs_;
+    LatencyHistogram triggerLatency_;
+
+    // Metering (written by the audio thread, handed off lock-free)
+    MeterBank meterBank_;
+
+    // Callback profiling
+    CallbackProfiler profiler_;
+    bool profileStages_;                         // Audio thread: stage timing for this callback
+    std::atomic<bool> freewheel_;                // No device: offline render (see setFreewheel())
 
     // State tracking
     bool initialized_;
@@ -169,9 +506,17 @@ private:
 
     // Constants
     static constexpr int STATUS_UPDATE_INTERVAL = 50;   // 50ms for responsive UI updates
-    static constexpr int CALLBACK_PROCESS_INTERVAL = 16; // ~60 FPS for smooth updates
-
-    // JUCE-specific helpers (implementation will include JUCE headers)
-    class JuceCallbackHandler;
-    std::unique_ptr<JuceCallbackHandler> callbackHandler_;
+    static constexpr int EVENT_DISPATCH_INTERVAL = 16;  // Display rate; events wait in the ring until then
+    static constexpr int MAX_VOICES = 256;              // Concurrent cue voices
+    static constexpr int MAX_VOICE_INPUTS = GainMatrix::MAX_INPUTS;     // File channels per voice
+    static constexpr int MAX_VOICE_OUTPUTS = GainMatrix::MAX_OUTPUTS;   // Cue outputs (pre-patch)
+    static constexpr int MAX_DEVICE_OUTPUTS = CueOutputPatch::MAX_DEVICE_OUTPUTS;
+    static constexpr double POSITION_EVENT_INTERVAL = 0.016; // ~60 position events per second
+    static constexpr std::int64_t DEFAULT_RESIDENT_THRESHOLD_BYTES = 64ll * 1024 * 1024; // ~3 min stereo @ 48k
+    static constexpr double STREAM_BUFFER_SECONDS = 4.0;     // Read-ahead per streamed cue
+    static constexpr int TIMELINE_CAPACITY = 1024;           // Pending scheduled commands
+    static constexpr double MIN_VARISPEED = 0.1;             // AudioCue's lowest playback speed
+
+    // Device I/O: current device plus hot standby (implementation includes JUCE headers)
+    std::unique_ptr<AudioDeviceSwitcher> deviceSwitcher_;
 };
\ No newline at end of file
@@ -0,0 +1,123 @@
+// src/audio/LatencyHistogram.h - Lock-free log2 latency histogram
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Counts latencies in power-of-two microsecond buckets
+ *
+ * Bucket i holds samples in [2^i, 2^(i+1)) us, bucket 0 everything below
+ * 2 us and the last bucket everything from ~4 s up. Recording is a couple
+ * of relaxed atomic adds, so the audio and I/O threads can record from
+ * inside their loops; any thread can snapshot.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int BUCKETS = 23;
+
+    struct Snapshot {
+        std::array<std::uint64_t, BUCKETS> counts{};
+        std::uint64_t samples = 0;
+        std::int64_t totalNs = 0;
+        std::int64_t worstNs = 0;
+
+        double averageNs() const { return samples > 0 ? static_cast<double>(totalNs) / samples : 0.0; }
+
+        // Upper edge of the bucket holding the given fraction of samples (0.99 = p99)
+        std::int64_t percentileNs(double fraction) const
+        {
+            const double target = fraction * static_cast<double>(samples);
+            std::uint64_t seen = 0;
+            for (int i = 0; i < BUCKETS; ++i) {
+                seen += counts[i];
+                if (samples > 0 && static_cast<double>(seen) >= target) {
+                    return bucketUpperNs(i);
+                }
+            }
+            return worstNs;
+        }
+    };
+
+    LatencyHistogram() { reset(); }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(std::int64_t ns)
+    {
+        if (ns < 0) {
+            ns = 0;
+        }
+        counts_[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+        samples_.fetch_add(1, std::memory_order_relaxed);
+        totalNs_.fetch_add(ns, std::memory_order_relaxed);
+
+        std::int64_t worst = worstNs_.load(std::memory_order_relaxed);
+        while (ns > worst && !worstNs_.compare_exchange_weak(worst, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    Snapshot snapshot() const
+    {
+        Snapshot result;
+        for (int i = 0; i < BUCKETS; ++i) {
+            result.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        }
+        result.samples = samples_.load(std::memory_order_relaxed);
+        result.totalNs = totalNs_.load(std::memory_order_relaxed);
+        result.worstNs = worstNs_.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    // Not atomic as a whole: samples recorded during a reset may land on either side
+    void reset()
+    {
+        for (auto& count : counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        samples_.store(0, std::memory_order_relaxed);
+        totalNs_.store(0, std::memory_order_relaxed);
+        worstNs_.store(0, std::memory_order_relaxed);
+    }
+
+    static std::int64_t bucketUpperNs(int bucket) { return (std::int64_t(2) << bucket) * 1000; }
+
+    static QJsonObject toJson(const Snapshot& snapshot)
+    {
+        QJsonArray counts;
+        for (std::uint64_t count : snapshot.counts) {
+            counts.append(static_cast<qint64>(count));
+        }
+
+        QJsonObject json;
+        json["samples"] = static_cast<qint64>(snapshot.samples);
+        json["averageUs"] = snapshot.averageNs() / 1.0e3;
+        json["p50Us"] = snapshot.percentileNs(0.50) / 1.0e3;
+        json["p99Us"] = snapshot.percentileNs(0.99) / 1.0e3;
+        json["worstUs"] = snapshot.worstNs / 1.0e3;
+        json["log2UsBuckets"] = counts;
+        return json;
+    }
+
+private:
+    static int bucketFor(std::int64_t ns)
+    {
+        std::uint64_t us = static_cast<std::uint64_t>(ns / 1000) >> 1;
+        int bucket = 0;
+        while (us > 0 && bucket < BUCKETS - 1) {
+            us >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    std::array<std::atomic<std::uint64_t>, BUCKETS> counts_;
+    std::atomic<std::uint64_t> samples_;
+    std::atomic<std::int64_t> totalNs_;
+    std::atomic<std::int64_t> worstNs_;
+};
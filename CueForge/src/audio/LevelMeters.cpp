@@ -0,0 +1,116 @@
+// src/audio/LevelMeters.cpp - Display-rate meter ballistics for outputs and cues
+#include "LevelMeters.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "MeterBank.h"
+
+LevelMeters::LevelMeters(MeterBank* bank, QObject* parent)
+    : QObject(parent)
+    , bank_(bank)
+    , refreshTimer_(new QTimer(this))
+    , clock_()
+    , lastRefreshMs_(0)
+    , outputs_(static_cast<std::size_t>(bank->outputCount()))
+    , cues_(static_cast<std::size_t>(bank->cueCount()))
+    , holdSeconds_(DEFAULT_HOLD_SECONDS)
+    , decayDbPerSecond_(DEFAULT_DECAY_DB_PER_SECOND)
+{
+    clock_.start();
+
+    refreshTimer_->setInterval(REFRESH_INTERVAL);
+    refreshTimer_->setTimerType(Qt::PreciseTimer);
+    connect(refreshTimer_, &QTimer::timeout, this, &LevelMeters::refresh);
+    refreshTimer_->start();
+}
+
+// Readings
+
+MeterReading LevelMeters::output(int output) const
+{
+    return output >= 0 && output < outputCount() ? outputs_[static_cast<std::size_t>(output)].reading : MeterReading();
+}
+
+MeterReading LevelMeters::cue(int cueHandle) const
+{
+    return cueHandle >= 0 && cueHandle < static_cast<int>(cues_.size())
+        ? cues_[static_cast<std::size_t>(cueHandle)].reading : MeterReading();
+}
+
+void LevelMeters::resetCue(int cueHandle)
+{
+    if (cueHandle >= 0 && cueHandle < static_cast<int>(cues_.size())) {
+        cues_[static_cast<std::size_t>(cueHandle)] = Ballistics();
+    }
+}
+
+void LevelMeters::clearClips()
+{
+    for (Ballistics& meter : outputs_) {
+        meter.reading.clipped = false;
+    }
+    for (Ballistics& meter : cues_) {
+        meter.reading.clipped = false;
+    }
+}
+
+// Ballistics
+
+void LevelMeters::refresh()
+{
+    const qint64 nowMs = clock_.elapsed();
+    const double elapsed = std::max<qint64>(1, nowMs - lastRefreshMs_) / 1000.0;
+    lastRefreshMs_ = nowMs;
+
+    // Per-refresh factors, so a late timer tick still decays at the set rate
+    const float decay = static_cast<float>(std::pow(10.0, -decayDbPerSecond_ * elapsed / 20.0));
+    const float rmsBlend = static_cast<float>(1.0 - std::exp(-elapsed / RMS_INTEGRATION_SECONDS));
+
+    const bool received = bank_->consume([&](const MeterBank::Block& block) {
+        for (std::size_t i = 0; i < outputs_.size(); ++i) {
+            const MeterValue& value = block.outputs[i];
+            const float meanSquare = value.frames > 0 ? value.sumSquares / static_cast<float>(value.frames) : 0.0f;
+            advance(outputs_[i], value.peak, meanSquare, decay, rmsBlend, nowMs);
+        }
+        for (std::size_t i = 0; i < cues_.size(); ++i) {
+            const MeterValue& value = block.cues[i];
+            const float meanSquare = value.frames > 0 ? value.sumSquares / static_cast<float>(value.frames) : 0.0f;
+            advance(cues_[i], value.peak, meanSquare, decay, rmsBlend, nowMs);
+        }
+    });
+
+    // No block means the callback isn't running (device stopped): let everything fall back
+    if (!received) {
+        for (Ballistics& meter : outputs_) {
+            advance(meter, 0.0f, 0.0f, decay, rmsBlend, nowMs);
+        }
+        for (Ballistics& meter : cues_) {
+            advance(meter, 0.0f, 0.0f, decay, rmsBlend, nowMs);
+        }
+    }
+
+    emit metersUpdated();
+}
+
+void LevelMeters::advance(Ballistics& meter, float peak, float meanSquare, float decay, float rmsBlend, qint64 nowMs) const
+{
+    MeterReading& reading = meter.reading;
+
+    reading.peak = std::max(peak, reading.peak * decay);
+
+    meter.meanSquare += (meanSquare - meter.meanSquare) * rmsBlend;
+    reading.rms = std::sqrt(meter.meanSquare);
+
+    if (peak >= reading.peakHold) {
+        reading.peakHold = peak;
+        meter.holdUntilMs = nowMs + static_cast<qint64>(holdSeconds_ * 1000.0);
+    }
+    else if (nowMs >= meter.holdUntilMs) {
+        reading.peakHold = std::max(reading.peak, reading.peakHold * decay);
+    }
+
+    if (peak >= CLIP_LEVEL) {
+        reading.clipped = true;
+    }
+}
@@ -0,0 +1,77 @@
+// src/audio/LevelMeters.h - Display-rate meter ballistics for outputs and cues
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <vector>
+
+class MeterBank;
+
+/**
+ * @brief What a meter widget draws, all linear gain
+ */
+struct MeterReading {
+    float peak = 0.0f;          // Instant peak with decay applied
+    float rms = 0.0f;           // Integrated over RMS_INTEGRATION_SECONDS
+    float peakHold = 0.0f;      // Held for the hold time, then decays
+    bool clipped = false;       // Latched until clearClips()
+};
+
+/**
+ * @brief Turns the audio callback's raw meter blocks into stable readings
+ *
+ * Polls the MeterBank at the display rate on the UI thread and applies peak
+ * decay, peak hold, RMS integration and clip latching there, so the audio
+ * callback only ever measures. Readings are indexed like the bank: output
+ * channel and cue handle.
+ */
+class LevelMeters : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LevelMeters(MeterBank* bank, QObject* parent = nullptr);
+
+    MeterReading output(int output) const;
+    MeterReading cue(int cueHandle) const;
+    int outputCount() const { return static_cast<int>(outputs_.size()); }
+
+    void resetCue(int cueHandle);       // Handle reused by another cue
+    void clearClips();
+
+    void setHoldTime(double seconds) { holdSeconds_ = seconds; }
+    void setDecayRate(double decibelsPerSecond) { decayDbPerSecond_ = decibelsPerSecond; }
+    void setRefreshInterval(int milliseconds) { refreshTimer_->setInterval(milliseconds); }
+
+signals:
+    void metersUpdated();
+
+private slots:
+    void refresh();
+
+private:
+    struct Ballistics {
+        MeterReading reading;
+        float meanSquare = 0.0f;
+        qint64 holdUntilMs = 0;
+    };
+
+    void advance(Ballistics& meter, float peak, float meanSquare, float decay, float rmsBlend, qint64 nowMs) const;
+
+    MeterBank* bank_;
+    QTimer* refreshTimer_;
+    QElapsedTimer clock_;
+    qint64 lastRefreshMs_;
+    std::vector<Ballistics> outputs_;
+    std::vector<Ballistics> cues_;
+    double holdSeconds_;
+    double decayDbPerSecond_;
+
+    // Constants
+    static constexpr int REFRESH_INTERVAL = 33;                 // ~30 Hz display rate
+    static constexpr double DEFAULT_HOLD_SECONDS = 1.5;
+    static constexpr double DEFAULT_DECAY_DB_PER_SECOND = 20.0;
+    static constexpr double RMS_INTEGRATION_SECONDS = 0.3;      // VU-like
+    static constexpr float CLIP_LEVEL = 1.0f;
+};
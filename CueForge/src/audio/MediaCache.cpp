@@ -0,0 +1,519 @@
+// src/audio/MediaCache.cpp - Persistent audio metadata and waveform-peak cache
+#include "MediaCache.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+namespace {
+
+constexpr char PEAK_MAGIC[4] = { 'C', 'F', 'P', 'K' };
+constexpr quint16 PEAK_VERSION = 1;
+constexpr int HEADER_SIZE = 40;
+constexpr int LEVEL_ENTRY_SIZE = 24;
+constexpr int FORMAT_NAME_SIZE = 12;
+
+// Peak data is written in host order and mapped as-is; every supported platform is little-endian
+static_assert(Q_BYTE_ORDER == Q_LITTLE_ENDIAN, "Peak files assume a little-endian host");
+
+qint16 quantize(float sample)
+{
+    return static_cast<qint16>(std::clamp(sample, -1.0f, 1.0f) * 32767.0f);
+}
+
+qint64 align8(qint64 offset)
+{
+    return (offset + 7) & ~qint64(7);
+}
+
+} // namespace
+
+// MediaPeaks
+
+MediaPeaks::~MediaPeaks()
+{
+    if (mapped_) {
+        file_.unmap(const_cast<uchar*>(mapped_));
+    }
+}
+
+std::unique_ptr<MediaPeaks> MediaPeaks::open(const QString& cachePath)
+{
+    std::unique_ptr<MediaPeaks> peaks(new MediaPeaks());
+    peaks->file_.setFileName(cachePath);
+    if (!peaks->file_.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    const qint64 fileSize = peaks->file_.size();
+    if (fileSize < HEADER_SIZE) {
+        return nullptr;
+    }
+
+    peaks->mapped_ = peaks->file_.map(0, fileSize);
+    if (!peaks->mapped_) {
+        return nullptr;
+    }
+    peaks->mappedBytes_ = fileSize;
+
+    const uchar* header = peaks->mapped_;
+    if (std::memcmp(header, PEAK_MAGIC, sizeof(PEAK_MAGIC)) != 0
+        || qFromLittleEndian<quint16>(header + 4) != PEAK_VERSION) {
+        return nullptr;
+    }
+
+    Metadata& metadata = peaks->metadata_;
+    metadata.channels = qFromLittleEndian<quint16>(header + 6);
+    metadata.sampleRate = qFromLittleEndian<double>(header + 8);
+    metadata.totalFrames = qFromLittleEndian<qint64>(header + 16);
+    const quint32 levelCount = qFromLittleEndian<quint32>(header + 24);
+    metadata.format = QString::fromUtf8(reinterpret_cast<const char*>(header + 28),
+        static_cast<int>(qstrnlen(reinterpret_cast<const char*>(header + 28), FORMAT_NAME_SIZE)));
+
+    if (metadata.channels <= 0 || HEADER_SIZE + qint64(levelCount) * LEVEL_ENTRY_SIZE > fileSize) {
+        return nullptr;
+    }
+
+    peaks->levels_.reserve(levelCount);
+    for (quint32 i = 0; i < levelCount; ++i) {
+        const uchar* entry = header + HEADER_SIZE + i * LEVEL_ENTRY_SIZE;
+
+        Level level;
+        level.samplesPerBlock = static_cast<int>(qFromLittleEndian<quint32>(entry));
+        level.blockCount = static_cast<std::int64_t>(qFromLittleEndian<quint64>(entry + 8));
+        const quint64 offset = qFromLittleEndian<quint64>(entry + 16);
+
+        const qint64 bytes = level.blockCount * metadata.channels * 2 * static_cast<qint64>(sizeof(qint16));
+        if (level.samplesPerBlock <= 0 || offset % alignof(qint16) != 0 || qint64(offset) + bytes > fileSize) {
+            return nullptr;     // Truncated or foreign file; the caller regenerates
+        }
+        level.data = reinterpret_cast<const qint16*>(header + offset);
+        peaks->levels_.push_back(level);
+    }
+
+    return peaks;
+}
+
+int MediaPeaks::levelForZoom(double framesPerPixel) const
+{
+    int best = 0;
+    for (int i = 0; i < levelCount(); ++i) {
+        if (levels_[static_cast<std::size_t>(i)].samplesPerBlock <= framesPerPixel) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void MediaPeaks::peakRange(int channel, std::int64_t startFrame, std::int64_t endFrame, float& minimum, float& maximum) const
+{
+    minimum = 0.0f;
+    maximum = 0.0f;
+    if (levels_.empty() || channel < 0 || channel >= metadata_.channels || endFrame <= startFrame) {
+        return;
+    }
+
+    const Level& level = levels_[static_cast<std::size_t>(levelForZoom(static_cast<double>(endFrame - startFrame)))];
+    if (level.blockCount == 0) {
+        return;
+    }
+    const std::int64_t firstBlock = std::clamp<std::int64_t>(startFrame / level.samplesPerBlock, 0, level.blockCount - 1);
+    const std::int64_t lastBlock = std::clamp<std::int64_t>((endFrame - 1) / level.samplesPerBlock, firstBlock, level.blockCount - 1);
+
+    qint16 low = 32767;
+    qint16 high = -32767;
+    for (std::int64_t block = firstBlock; block <= lastBlock; ++block) {
+        const qint16* pair = level.data + (block * metadata_.channels + channel) * 2;
+        low = std::min(low, pair[0]);
+        high = std::max(high, pair[1]);
+    }
+
+    minimum = low / 32767.0f;
+    maximum = high / 32767.0f;
+}
+
+// MediaCache
+
+MediaCache::MediaCache(QObject* parent)
+    : QObject(parent)
+    , cacheDirectory_(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/media")
+    , indexSaveTimer_(new QTimer(this))
+    , mappedBytes_(0)
+{
+    generatorPool_.setMaxThreadCount(GENERATOR_THREADS);
+    generatorPool_.setThreadPriority(QThread::LowPriority);
+    QDir().mkpath(cacheDirectory_);
+
+    indexSaveTimer_->setSingleShot(true);
+    indexSaveTimer_->setInterval(INDEX_SAVE_DELAY_MS);
+    connect(indexSaveTimer_, &QTimer::timeout, this, &MediaCache::saveIndex);
+
+    loadIndex();
+}
+
+MediaCache::~MediaCache()
+{
+    // Workers post back to this object, so they must be gone first
+    generatorPool_.clear();
+    generatorPool_.waitForDone();
+
+    if (indexSaveTimer_->isActive()) {
+        saveIndex();
+    }
+}
+
+// Lookup
+
+std::shared_ptr<const MediaPeaks> MediaCache::peaks(const QString& filePath)
+{
+    const QString key = keyFor(filePath);
+    if (key.isEmpty()) {
+        request(filePath);
+        return nullptr;
+    }
+
+    const auto mapped = mapped_.find(key);
+    if (mapped != mapped_.end()) {
+        touchMapped(mapped.value());
+        return mapped->peaks;
+    }
+
+    std::shared_ptr<const MediaPeaks> opened = MediaPeaks::open(cachePathFor(cacheDirectory_, key));
+    if (!opened) {
+        keysByPath_.remove(filePath);   // Deleted or damaged on disk; start over
+        indexChanged();
+        request(filePath);
+        return nullptr;
+    }
+
+    MappedEntry entry;
+    entry.peaks = opened;
+    entry.usePosition = mappedUse_.insert(mappedUse_.end(), key);
+    mapped_.insert(key, entry);
+    mappedBytes_ += opened->mappedBytes();
+    evictMapped();
+    return opened;
+}
+
+bool MediaCache::metadata(const QString& filePath, MediaPeaks::Metadata& result)
+{
+    const std::shared_ptr<const MediaPeaks> entry = peaks(filePath);
+    if (!entry) {
+        return false;
+    }
+    result = entry->metadata();
+    return true;
+}
+
+void MediaCache::clearMemory()
+{
+    mapped_.clear();
+    mappedUse_.clear();
+    mappedBytes_ = 0;
+}
+
+void MediaCache::touchMapped(MappedEntry& entry)
+{
+    // Most recently used goes to the back; eviction takes from the front
+    mappedUse_.splice(mappedUse_.end(), mappedUse_, entry.usePosition);
+}
+
+void MediaCache::evictMapped()
+{
+    // The newest mapping always stays, however large
+    while (mappedUse_.size() > 1
+           && (static_cast<int>(mappedUse_.size()) > MAX_MAPPED_FILES || mappedBytes_ > MAX_MAPPED_BYTES)) {
+        const auto it = mapped_.constFind(mappedUse_.front());
+        mappedUse_.pop_front();
+        if (it != mapped_.constEnd()) {
+            mappedBytes_ -= it->peaks->mappedBytes();
+            mapped_.erase(it);
+        }
+    }
+}
+
+QString MediaCache::keyFor(const QString& filePath) const
+{
+    const auto known = keysByPath_.constFind(filePath);
+    if (known == keysByPath_.constEnd()) {
+        return QString();
+    }
+
+    // A stat is cheap next to re-hashing; it catches files replaced under the same name
+    const QFileInfo info(filePath);
+    if (info.size() != known->size || info.lastModified() != known->modified) {
+        return QString();
+    }
+    return known->key;
+}
+
+QString MediaCache::cachePathFor(const QString& directory, const QString& key)
+{
+    return QString("%1/%2.cfpk").arg(directory, key);
+}
+
+QString MediaCache::computeKey(const QString& filePath, qint64 size, const QDateTime& modified)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+
+    // Head and tail sample, not the whole file: a moved folder with preserved mtimes still matches
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(size));
+    hash.addData(file.read(HASH_SAMPLE_BYTES));
+    if (size > 2 * HASH_SAMPLE_BYTES && file.seek(size - HASH_SAMPLE_BYTES)) {
+        hash.addData(file.read(HASH_SAMPLE_BYTES));
+    }
+    hash.addData(QByteArray::number(modified.toMSecsSinceEpoch()));
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+// Generation
+
+void MediaCache::request(const QString& filePath)
+{
+    if (filePath.isEmpty() || pending_.contains(filePath) || !keyFor(filePath).isEmpty()) {
+        return;
+    }
+    pending_.insert(filePath);
+
+    const QString directory = cacheDirectory_;
+    generatorPool_.start([this, filePath, directory]() {
+        // Hashing reads from the media volume too, so it stays off the GUI thread
+        const QFileInfo info(filePath);
+        KeyEntry entry;
+        entry.size = info.size();
+        entry.modified = info.lastModified();
+        entry.key = info.exists() ? computeKey(filePath, entry.size, entry.modified) : QString();
+
+        bool success = false;
+        QString error;
+        if (entry.key.isEmpty()) {
+            error = QStringLiteral("File not readable");
+        }
+        else {
+            const QString cachePath = cachePathFor(directory, entry.key);
+            success = QFile::exists(cachePath) || generate(filePath, cachePath, error);
+        }
+
+        QMetaObject::invokeMethod(this, [this, filePath, entry, success, error]() {
+            onGenerated(filePath, entry, success, error);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MediaCache::onGenerated(const QString& filePath, const KeyEntry& entry, bool success, const QString& error)
+{
+    pending_.remove(filePath);
+
+    if (!success) {
+        qWarning() << "Could not build peaks for" << filePath << ":" << error;
+        emit peaksFailed(filePath, error);
+        return;
+    }
+
+    keysByPath_.insert(filePath, entry);
+    indexChanged();
+    emit peaksReady(filePath);
+}
+
+// Key Index
+
+QString MediaCache::indexPath() const
+{
+    return QString("%1/index.cbor").arg(cacheDirectory_);
+}
+
+void MediaCache::loadIndex()
+{
+    QFile file(indexPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return; // First run
+    }
+
+    // [ version, [ [ path, size, mtime ms, key ] ... ] ]
+    const QCborArray index = QCborValue::fromCbor(file.readAll()).toArray();
+    if (index.size() != 2 || index.at(0).toInteger() != INDEX_VERSION) {
+        qWarning() << "Ignoring media cache index" << file.fileName() << "of another version";
+        return;
+    }
+
+    const QCborArray entries = index.at(1).toArray();
+    keysByPath_.reserve(static_cast<int>(entries.size()));
+    for (const QCborValue& value : entries) {
+        const QCborArray fields = value.toArray();
+        if (fields.size() != 4) {
+            continue;
+        }
+
+        KeyEntry entry;
+        entry.size = fields.at(1).toInteger();
+        entry.modified = QDateTime::fromMSecsSinceEpoch(fields.at(2).toInteger());
+        entry.key = fields.at(3).toString();
+        if (!entry.key.isEmpty()) {
+            keysByPath_.insert(fields.at(0).toString(), entry);
+        }
+    }
+    qDebug() << "Loaded" << keysByPath_.size() << "media cache keys";
+}
+
+void MediaCache::saveIndex()
+{
+    indexSaveTimer_->stop();
+
+    QCborArray entries;
+    for (auto it = keysByPath_.cbegin(); it != keysByPath_.cend(); ++it) {
+        entries.append(QCborArray{ it.key(), it->size, it->modified.toMSecsSinceEpoch(), it->key });
+    }
+
+    QSaveFile file(indexPath());
+    const QByteArray data = QCborArray{ INDEX_VERSION, entries }.toCborValue().toCbor();
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "Could not save media cache index:" << file.errorString();
+    }
+}
+
+void MediaCache::indexChanged()
+{
+    if (!indexSaveTimer_->isActive()) {
+        indexSaveTimer_->start();
+    }
+}
+
+bool MediaCache::generate(const QString& filePath, const QString& cachePath, QString& error)
+{
+    // Own format manager per call so generation can run on any worker thread
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    juce::File file(juce::String::fromUTF8(filePath.toUtf8().constData()));
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+    if (!reader || reader->numChannels == 0 || reader->sampleRate <= 0.0) {
+        error = QStringLiteral("Unsupported or unreadable audio");
+        return false;
+    }
+
+    const int channels = static_cast<int>(reader->numChannels);
+    const std::int64_t totalFrames = reader->lengthInSamples;
+
+    // Finest level straight from the decoder
+    std::vector<std::vector<qint16>> levels(1);
+    std::vector<int> blockSizes(1, BASE_BLOCK_FRAMES);
+    const std::int64_t baseBlocks = (totalFrames + BASE_BLOCK_FRAMES - 1) / BASE_BLOCK_FRAMES;
+    levels[0].resize(static_cast<std::size_t>(baseBlocks * channels * 2));
+
+    std::vector<float> scratch(static_cast<std::size_t>(channels) * DECODE_CHUNK_FRAMES);
+    std::vector<float*> destinations(channels);
+    for (int channel = 0; channel < channels; ++channel) {
+        destinations[channel] = scratch.data() + static_cast<std::size_t>(channel) * DECODE_CHUNK_FRAMES;
+    }
+
+    for (std::int64_t position = 0; position < totalFrames; position += DECODE_CHUNK_FRAMES) {
+        const int count = static_cast<int>(std::min<std::int64_t>(DECODE_CHUNK_FRAMES, totalFrames - position));
+        if (!reader->read(destinations.data(), channels, position, count)) {
+            error = QStringLiteral("Decode failed");
+            return false;
+        }
+
+        // DECODE_CHUNK_FRAMES is a multiple of the block size, so blocks never straddle chunks
+        const std::int64_t firstBlock = position / BASE_BLOCK_FRAMES;
+        for (int offset = 0; offset < count; offset += BASE_BLOCK_FRAMES) {
+            const int length = std::min(BASE_BLOCK_FRAMES, count - offset);
+            qint16* out = levels[0].data() + (firstBlock + offset / BASE_BLOCK_FRAMES) * channels * 2;
+
+            for (int channel = 0; channel < channels; ++channel) {
+                const auto range = std::minmax_element(destinations[channel] + offset, destinations[channel] + offset + length);
+                out[channel * 2] = quantize(*range.first);
+                out[channel * 2 + 1] = quantize(*range.second);
+            }
+        }
+    }
+
+    // Coarser levels fold LEVEL_FACTOR blocks of the level below
+    while (static_cast<int>(levels.size()) < MAX_LEVELS) {
+        const std::vector<qint16>& finer = levels.back();
+        const std::int64_t finerBlocks = static_cast<std::int64_t>(finer.size()) / (channels * 2);
+        if (finerBlocks <= 1) {
+            break;
+        }
+
+        const std::int64_t blocks = (finerBlocks + LEVEL_FACTOR - 1) / LEVEL_FACTOR;
+        std::vector<qint16> coarser(static_cast<std::size_t>(blocks * channels * 2));
+        for (std::int64_t block = 0; block < blocks; ++block) {
+            const std::int64_t first = block * LEVEL_FACTOR;
+            const std::int64_t last = std::min(first + LEVEL_FACTOR, finerBlocks);
+            for (int channel = 0; channel < channels; ++channel) {
+                qint16 low = 32767;
+                qint16 high = -32767;
+                for (std::int64_t source = first; source < last; ++source) {
+                    low = std::min(low, finer[(source * channels + channel) * 2]);
+                    high = std::max(high, finer[(source * channels + channel) * 2 + 1]);
+                }
+                coarser[(block * channels + channel) * 2] = low;
+                coarser[(block * channels + channel) * 2 + 1] = high;
+            }
+        }
+
+        blockSizes.push_back(blockSizes.back() * LEVEL_FACTOR);
+        levels.push_back(std::move(coarser));
+    }
+
+    // Header and level table
+    const int levelCount = static_cast<int>(levels.size());
+    QByteArray header(HEADER_SIZE + levelCount * LEVEL_ENTRY_SIZE, '\0');
+    uchar* out = reinterpret_cast<uchar*>(header.data());
+    std::memcpy(out, PEAK_MAGIC, sizeof(PEAK_MAGIC));
+    qToLittleEndian<quint16>(PEAK_VERSION, out + 4);
+    qToLittleEndian<quint16>(static_cast<quint16>(channels), out + 6);
+    qToLittleEndian<double>(reader->sampleRate, out + 8);
+    qToLittleEndian<qint64>(totalFrames, out + 16);
+    qToLittleEndian<quint32>(static_cast<quint32>(levelCount), out + 24);
+    const QByteArray formatName = QByteArray(reader->getFormatName().toRawUTF8()).left(FORMAT_NAME_SIZE);
+    std::memcpy(out + 28, formatName.constData(), static_cast<std::size_t>(formatName.size()));
+
+    qint64 offset = align8(header.size());
+    for (int i = 0; i < levelCount; ++i) {
+        uchar* entry = out + HEADER_SIZE + i * LEVEL_ENTRY_SIZE;
+        qToLittleEndian<quint32>(static_cast<quint32>(blockSizes[i]), entry);
+        qToLittleEndian<quint64>(static_cast<quint64>(levels[i].size() / (channels * 2)), entry + 8);
+        qToLittleEndian<quint64>(static_cast<quint64>(offset), entry + 16);
+        offset = align8(offset + static_cast<qint64>(levels[i].size() * sizeof(qint16)));
+    }
+
+    QSaveFile output(cachePath);
+    if (!output.open(QIODevice::WriteOnly)) {
+        error = output.errorString();
+        return false;
+    }
+
+    output.write(header);
+    for (const std::vector<qint16>& level : levels) {
+        output.write(QByteArray(static_cast<int>(align8(output.pos()) - output.pos()), '\0'));
+        output.write(reinterpret_cast<const char*>(level.data()), static_cast<qint64>(level.size() * sizeof(qint16)));
+    }
+
+    if (!output.commit()) {
+        error = output.errorString();
+        return false;
+    }
+
+    qDebug() << "Built" << levelCount << "peak levels for" << filePath;
+    return true;
+}
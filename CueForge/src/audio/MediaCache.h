@@ -0,0 +1,178 @@
+// src/audio/MediaCache.h - Persistent audio metadata and waveform-peak cache
+#pragma once
+
+#include <QObject>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+// Forward declarations
+class QTimer;
+
+/**
+ * @brief Memory-mapped peak file for one media file
+ *
+ * Holds the file's metadata plus min/max peaks at several zoom levels. Each
+ * level stores, per block of samplesPerBlock frames, one int16 min/max pair
+ * per channel. Everything is read straight out of the mapping; nothing is
+ * parsed or copied when an inspector asks for a waveform.
+ *
+ * File layout (little-endian):
+ *   0   char[4]  magic "CFPK"
+ *   4   uint16   version
+ *   6   uint16   channels
+ *   8   float64  sample rate
+ *   16  int64    total frames
+ *   24  uint32   level count
+ *   28  char[12] format name (UTF-8, zero padded)
+ *   40  level table: { uint32 samplesPerBlock, uint32 reserved, uint64 blockCount, uint64 offset } x levels
+ *   ... peak data: int16 { min, max } x channels x blocks, per level
+ */
+class MediaPeaks
+{
+public:
+    struct Metadata {
+        int channels = 0;
+        double sampleRate = 0.0;
+        std::int64_t totalFrames = 0;
+        QString format;
+
+        double duration() const { return sampleRate > 0.0 ? totalFrames / sampleRate : 0.0; }
+    };
+
+    struct Level {
+        int samplesPerBlock = 0;
+        std::int64_t blockCount = 0;
+        const qint16* data = nullptr;   // blockCount x channels x { min, max }
+    };
+
+    ~MediaPeaks();
+
+    /**
+     * @brief Map a cache file; null if it is missing or not a valid peak file
+     */
+    static std::unique_ptr<MediaPeaks> open(const QString& cachePath);
+
+    const Metadata& metadata() const { return metadata_; }
+    qint64 mappedBytes() const { return mappedBytes_; }
+    int levelCount() const { return static_cast<int>(levels_.size()); }
+    Level level(int index) const { return levels_[static_cast<std::size_t>(index)]; }
+
+    /**
+     * @brief Coarsest level that still resolves framesPerPixel (what a waveform view should draw from)
+     */
+    int levelForZoom(double framesPerPixel) const;
+
+    /**
+     * @brief Peak range of a channel over a frame range, read from the best level
+     */
+    void peakRange(int channel, std::int64_t startFrame, std::int64_t endFrame, float& minimum, float& maximum) const;
+
+private:
+    MediaPeaks() = default;
+
+    QFile file_;
+    const uchar* mapped_ = nullptr;
+    qint64 mappedBytes_ = 0;
+    Metadata metadata_;
+    std::vector<Level> levels_;
+};
+
+/**
+ * @brief Persistent cache of media metadata and waveform peaks
+ *
+ * Entries are keyed by a sampled content hash (size plus the first and last
+ * HASH_SAMPLE_BYTES) and the file's mtime, so a show folder moved with its
+ * mtimes intact still hits the cache while an edited file never does. Missing entries are
+ * generated on a low-priority pool (one full decode per file, ever) and
+ * announced with peaksReady(); lookups only touch the mapping.
+ *
+ * The path + size + mtime -> key index is saved next to the peak files, so
+ * a restart doesn't re-hash the whole show. Open mappings are bounded by
+ * MAX_MAPPED_FILES and MAX_MAPPED_BYTES and unmapped least recently used
+ * first; a caller still holding the peaks keeps its mapping until it lets go.
+ */
+class MediaCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MediaCache(QObject* parent = nullptr);
+    ~MediaCache();
+
+    /**
+     * @brief Mapped peaks for a media file, or null while they are being generated
+     *
+     * A miss queues generation; peaksReady(filePath) follows.
+     */
+    std::shared_ptr<const MediaPeaks> peaks(const QString& filePath);
+
+    /**
+     * @brief Cached metadata without decoding (false on a miss; generation is queued)
+     */
+    bool metadata(const QString& filePath, MediaPeaks::Metadata& result);
+
+    void request(const QString& filePath);      // Generate in the background if not cached
+    bool isPending(const QString& filePath) const { return pending_.contains(filePath); }
+
+    QString cacheDirectory() const { return cacheDirectory_; }
+    void clearMemory();                          // Unmap all entries (files stay on disk)
+    void saveIndex();                            // Write the key index now rather than after INDEX_SAVE_DELAY_MS
+
+    // Sampled content hash of a file (thread-safe; empty if it can't be read)
+    static QString computeKey(const QString& filePath, qint64 size, const QDateTime& modified);
+
+signals:
+    void peaksReady(const QString& filePath);
+    void peaksFailed(const QString& filePath, const QString& error);
+
+private:
+    struct KeyEntry {
+        qint64 size = 0;
+        QDateTime modified;
+        QString key;
+    };
+
+    struct MappedEntry {
+        std::shared_ptr<const MediaPeaks> peaks;
+        std::list<QString>::iterator usePosition;
+    };
+
+    QString keyFor(const QString& filePath) const;            // Empty if unknown or the file changed
+    static QString cachePathFor(const QString& directory, const QString& key);
+    QString indexPath() const;
+    void loadIndex();
+    void indexChanged();                                        // Schedules saveIndex()
+    void touchMapped(MappedEntry& entry);
+    void evictMapped();
+    static bool generate(const QString& filePath, const QString& cachePath, QString& error);
+    void onGenerated(const QString& filePath, const KeyEntry& entry, bool success, const QString& error);
+
+    QString cacheDirectory_;
+    QThreadPool generatorPool_;
+    QHash<QString, KeyEntry> keysByPath_;                       // Avoids re-hashing unchanged files; persisted
+    QTimer* indexSaveTimer_;
+    QHash<QString, MappedEntry> mapped_;                        // Cache key -> open mapping
+    std::list<QString> mappedUse_;                              // Mapped keys, least recently used first
+    qint64 mappedBytes_;
+    QSet<QString> pending_;                                     // File paths being generated
+
+    // Constants
+    static constexpr int GENERATOR_THREADS = 1;                 // Full decodes; keep them off the prearm pool's disks
+    static constexpr int BASE_BLOCK_FRAMES = 256;               // Finest level
+    static constexpr int LEVEL_FACTOR = 4;                      // Each level is LEVEL_FACTOR x coarser
+    static constexpr int MAX_LEVELS = 6;                        // 256 .. 262144 frames per block
+    static constexpr int DECODE_CHUNK_FRAMES = 65536;
+    static constexpr qint64 HASH_SAMPLE_BYTES = 64 * 1024;
+    static constexpr int MAX_MAPPED_FILES = 128;                // Each mapping holds a file handle
+    static constexpr qint64 MAX_MAPPED_BYTES = 256LL * 1024 * 1024;
+    static constexpr int INDEX_SAVE_DELAY_MS = 2000;            // Coalesces a burst of new entries into one write
+    static constexpr int INDEX_VERSION = 1;
+};
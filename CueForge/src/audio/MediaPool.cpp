@@ -0,0 +1,226 @@
+// src/audio/MediaPool.cpp - Shared, refcounted decoded-audio buffers under an LRU memory budget
+#include "MediaPool.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <memory>
+
+#include "DecodedAudio.h"
+#include "JuceAudioBridge.h"
+#include "MediaCache.h"
+
+MediaPool::MediaPool(std::int64_t budgetBytes)
+    : mutex_()
+    , decodeFinished_()
+    , entries_()
+    , keysByBuffer_()
+    , unused_()
+    , decoding_()
+    , fileKeys_()
+    , budgetBytes_(qMax<std::int64_t>(0, budgetBytes))
+    , residentBytes_(0)
+    , counters_()
+{
+}
+
+MediaPool::~MediaPool()
+{
+    // The engine gives every buffer back before it shuts down; anything left was leaked by a holder
+    int inUse = 0;
+    for (const Entry& entry : std::as_const(entries_)) {
+        if (entry.references > 0) {
+            ++inUse;
+        }
+        delete entry.audio;
+    }
+
+    if (inUse > 0) {
+        qWarning() << "MediaPool destroyed with" << inUse << "buffers still referenced";
+    }
+}
+
+// Buffers
+
+const DecodedAudio* MediaPool::acquire(const QString& filePath, double startSeconds, double maxSeconds,
+                                       std::int64_t residentThresholdBytes, double targetSampleRate)
+{
+    const QString hash = contentKey(filePath);
+    if (hash.isEmpty()) {
+        return nullptr;
+    }
+
+    // Start offsets match to the millisecond, like the prearmer's own comparison
+    const QString key = QString("%1:%2:%3:%4:%5")
+        .arg(hash)
+        .arg(qRound64(startSeconds * 1000.0))
+        .arg(qRound64(maxSeconds * 1000.0))
+        .arg(residentThresholdBytes)
+        .arg(targetSampleRate, 0, 'f', 0);
+
+    QMutexLocker locker(&mutex_);
+
+    // Another thread is decoding this buffer: share its result instead of decoding twice
+    while (decoding_.contains(key)) {
+        decodeFinished_.wait(&mutex_);
+    }
+
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        if (it->references++ == 0) {
+            unused_.erase(it->unusedPosition);
+        }
+        ++counters_.hits;
+        return it->audio;
+    }
+
+    decoding_.insert(key);
+    locker.unlock();
+
+    std::unique_ptr<DecodedAudio> audio = JuceAudioBridge::decodeAudioFile(filePath, startSeconds, maxSeconds,
+                                                                            residentThresholdBytes, targetSampleRate);
+
+    locker.relock();
+    decoding_.remove(key);
+    decodeFinished_.wakeAll();
+
+    if (!audio) {
+        return nullptr;
+    }
+
+    if (audio->isStreamed()) {
+        ++counters_.unpooled;
+        return audio.release();
+    }
+
+    Entry entry;
+    entry.audio = audio.release();
+    entry.bytes = static_cast<std::int64_t>(entry.audio->samples.size() * sizeof(float));
+    entry.references = 1;
+    entries_.insert(key, entry);
+    keysByBuffer_.insert(entry.audio, key);
+    residentBytes_ += entry.bytes;
+    ++counters_.misses;
+
+    evictLocked(budgetBytes_);
+    return entry.audio;
+}
+
+void MediaPool::release(const DecodedAudio* audio)
+{
+    if (!audio) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex_);
+
+    const auto keyIt = keysByBuffer_.constFind(audio);
+    if (keyIt == keysByBuffer_.constEnd()) {
+        locker.unlock();
+        delete audio;   // Unpooled (streamed) buffer: this was its only holder
+        return;
+    }
+
+    Entry& entry = entries_[keyIt.value()];
+    if (--entry.references > 0) {
+        return;
+    }
+
+    // Most recently used goes to the back; eviction takes from the front
+    entry.unusedPosition = unused_.insert(unused_.end(), keyIt.value());
+    evictLocked(budgetBytes_);
+}
+
+// Budget
+
+std::int64_t MediaPool::budgetBytes() const
+{
+    QMutexLocker locker(&mutex_);
+    return budgetBytes_;
+}
+
+void MediaPool::setBudgetBytes(std::int64_t bytes)
+{
+    QMutexLocker locker(&mutex_);
+    budgetBytes_ = qMax<std::int64_t>(0, bytes);
+    evictLocked(budgetBytes_);
+}
+
+void MediaPool::trim()
+{
+    QMutexLocker locker(&mutex_);
+    evictLocked(0);
+}
+
+MediaPool::Stats MediaPool::stats() const
+{
+    QMutexLocker locker(&mutex_);
+
+    Stats result = counters_;
+    result.entries = entries_.size();
+    result.entriesInUse = entries_.size() - static_cast<int>(unused_.size());
+    result.residentBytes = residentBytes_;
+    result.budgetBytes = budgetBytes_;
+    return result;
+}
+
+void MediaPool::resetStats()
+{
+    QMutexLocker locker(&mutex_);
+    counters_ = Stats();
+}
+
+// Private Implementation
+
+QString MediaPool::contentKey(const QString& filePath)
+{
+    const QFileInfo info(filePath);
+    if (!info.exists()) {
+        return QString();
+    }
+
+    {
+        // A stat is cheap next to re-hashing; it catches files replaced under the same name
+        QMutexLocker locker(&mutex_);
+        const auto known = fileKeys_.constFind(filePath);
+        if (known != fileKeys_.constEnd() && known->size == info.size() && known->modified == info.lastModified()) {
+            return known->hash;
+        }
+    }
+
+    // Hashing reads from the media volume, so it happens outside the lock
+    FileKey fileKey;
+    fileKey.size = info.size();
+    fileKey.modified = info.lastModified();
+    fileKey.hash = MediaCache::computeKey(filePath, fileKey.size, fileKey.modified);
+    if (fileKey.hash.isEmpty()) {
+        return QString();
+    }
+
+    QMutexLocker locker(&mutex_);
+    fileKeys_.insert(filePath, fileKey);
+    return fileKey.hash;
+}
+
+void MediaPool::evictLocked(std::int64_t budget)
+{
+    while (residentBytes_ > budget && !unused_.empty()) {
+        const QString key = unused_.front();
+        unused_.pop_front();
+        eraseLocked(key);
+        ++counters_.evictions;
+    }
+}
+
+void MediaPool::eraseLocked(const QString& key)
+{
+    const auto it = entries_.constFind(key);
+    if (it == entries_.constEnd()) {
+        return;
+    }
+
+    residentBytes_ -= it->bytes;
+    keysByBuffer_.remove(it->audio);
+    delete it->audio;
+    entries_.erase(it);
+}
@@ -0,0 +1,114 @@
+// src/audio/MediaPool.h - Shared, refcounted decoded-audio buffers under an LRU memory budget
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QWaitCondition>
+#include <cstdint>
+#include <list>
+
+struct DecodedAudio;
+
+/**
+ * @brief One decode per media file, shared by every cue that plays it
+ *
+ * Buffers are keyed by the file's sampled content hash (the same key the
+ * peak cache uses) plus the decode parameters (start offset, head length,
+ * resident threshold and device rate), so twenty cues on one doorbell
+ * effect hold a single copy, even if they reach it through different paths.
+ *
+ * Every holder (normally an engine voice) owns one reference. Buffers nobody
+ * holds stay cached and are evicted least recently used first whenever the
+ * pool is over its budget; buffers in use are never evicted, so the budget is
+ * exceeded rather than a cue losing its audio.
+ *
+ * Streamed decodes aren't pooled: their read-ahead tail carries per-voice
+ * state. They are handed out unshared and deleted on release().
+ *
+ * Thread-safe, and never used from the audio callback: the engine gives
+ * buffers back on the main thread, once the callback has retired them.
+ */
+class MediaPool
+{
+public:
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;                 // Pooled decodes
+        quint64 unpooled = 0;               // Streamed decodes handed out unshared
+        quint64 evictions = 0;
+        int entries = 0;
+        int entriesInUse = 0;
+        std::int64_t residentBytes = 0;     // Every pooled buffer, in use or not
+        std::int64_t budgetBytes = 0;
+
+        double hitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+    };
+
+    explicit MediaPool(std::int64_t budgetBytes = DEFAULT_BUDGET_BYTES);
+    ~MediaPool();
+
+    MediaPool(const MediaPool&) = delete;
+    MediaPool& operator=(const MediaPool&) = delete;
+
+    /**
+     * @brief Shared decode of part of a media file, decoding it on a miss (blocking)
+     *
+     * Parameters as for JuceAudioBridge::decodeAudioFile(). Concurrent misses
+     * on the same buffer decode once; the other callers wait for that decode.
+     * @return One reference to the buffer, to be given back with release(); null if the file can't be read
+     */
+    const DecodedAudio* acquire(const QString& filePath, double startSeconds, double maxSeconds,
+                                std::int64_t residentThresholdBytes, double targetSampleRate);
+
+    /**
+     * @brief Give back a reference from acquire()
+     *
+     * The last reference makes the buffer evictable; buffers the pool doesn't
+     * track (streamed decodes) are deleted. A stream must already be off the
+     * disk thread.
+     */
+    void release(const DecodedAudio* audio);
+
+    // Memory budget for cached buffers (0 keeps nothing that isn't in use)
+    std::int64_t budgetBytes() const;
+    void setBudgetBytes(std::int64_t bytes);    // Evicts right away if now over
+
+    void trim();                                // Evict every buffer not in use
+    Stats stats() const;
+    void resetStats();                          // Counters only; the cache stays
+
+    // Constants
+    static constexpr std::int64_t DEFAULT_BUDGET_BYTES = std::int64_t(1024) * 1024 * 1024;
+
+private:
+    struct Entry {
+        DecodedAudio* audio = nullptr;          // Owned
+        std::int64_t bytes = 0;
+        int references = 0;
+        std::list<QString>::iterator unusedPosition;    // Valid while references == 0
+    };
+
+    struct FileKey {
+        qint64 size = 0;
+        QDateTime modified;
+        QString hash;
+    };
+
+    QString contentKey(const QString& filePath);        // Empty if the file can't be read
+    void evictLocked(std::int64_t budget);              // Caller holds mutex_
+    void eraseLocked(const QString& key);
+
+    mutable QMutex mutex_;
+    QWaitCondition decodeFinished_;
+    QHash<QString, Entry> entries_;                     // Buffer key -> entry
+    QHash<const DecodedAudio*, QString> keysByBuffer_;
+    std::list<QString> unused_;                         // Unreferenced entries, least recently used first
+    QSet<QString> decoding_;                            // Buffer keys being decoded right now
+    QHash<QString, FileKey> fileKeys_;                  // Avoids re-hashing unchanged files
+    std::int64_t budgetBytes_;
+    std::int64_t residentBytes_;
+    Stats counters_;                                    // hits/misses/unpooled/evictions only
+};
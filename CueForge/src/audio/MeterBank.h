@@ -0,0 +1,118 @@
+// src/audio/MeterBank.h - Lock-free level meter hand-off from the audio callback
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Raw level accumulated since the last hand-off (no ballistics)
+ */
+struct MeterValue {
+    float peak = 0.0f;              // Linear magnitude
+    float sumSquares = 0.0f;
+    std::int64_t frames = 0;
+
+    void add(float blockPeak, float blockSumSquares, std::int64_t numFrames)
+    {
+        peak = std::max(peak, blockPeak);
+        sumSquares += blockSumSquares;
+        frames += numFrames;
+    }
+
+    float rms() const { return frames > 0 ? std::sqrt(sumSquares / static_cast<float>(frames)) : 0.0f; }
+};
+
+/**
+ * @brief Double-buffered meter blocks shared by the audio callback and one reader
+ *
+ * The callback accumulates into the back block for as long as the reader
+ * hasn't taken the front one, so no peak is lost however slowly the UI
+ * polls. Once the reader has consumed the front block, the next publish()
+ * swaps the two and clears the new back block. A single atomic flag hands
+ * ownership back and forth: neither side waits, locks or allocates, and the
+ * block contents need no atomics because only one side owns each block at
+ * a time.
+ *
+ * Outputs and cues are indexed by output channel and cue handle. Both
+ * counts are fixed at construction.
+ */
+class MeterBank
+{
+public:
+    struct Block {
+        std::vector<MeterValue> outputs;
+        std::vector<MeterValue> cues;
+        std::uint64_t sequence = 0;     // Publish count, for spotting a stalled callback
+    };
+
+    MeterBank(int numOutputs, int numCues)
+    {
+        for (Block& block : blocks_) {
+            block.outputs.resize(static_cast<std::size_t>(numOutputs));
+            block.cues.resize(static_cast<std::size_t>(numCues));
+        }
+    }
+
+    MeterBank(const MeterBank&) = delete;
+    MeterBank& operator=(const MeterBank&) = delete;
+
+    int outputCount() const { return static_cast<int>(blocks_[0].outputs.size()); }
+    int cueCount() const { return static_cast<int>(blocks_[0].cues.size()); }
+
+    // Audio thread: accumulate into the back block
+    void addOutput(int output, float peak, float sumSquares, std::int64_t frames)
+    {
+        blocks_[back_].outputs[static_cast<std::size_t>(output)].add(peak, sumSquares, frames);
+    }
+
+    void addCue(int cueHandle, float peak, float sumSquares, std::int64_t frames)
+    {
+        blocks_[back_].cues[static_cast<std::size_t>(cueHandle)].add(peak, sumSquares, frames);
+    }
+
+    /**
+     * @brief Audio thread, end of callback: hand the back block over if the reader is ready
+     */
+    void publish()
+    {
+        if (fresh_.load(std::memory_order_acquire)) {
+            return;     // Reader hasn't taken the last one; keep accumulating
+        }
+
+        blocks_[back_].sequence = ++sequence_;
+        front_ = back_;
+        back_ = 1 - back_;
+
+        Block& next = blocks_[back_];
+        std::fill(next.outputs.begin(), next.outputs.end(), MeterValue());
+        std::fill(next.cues.begin(), next.cues.end(), MeterValue());
+
+        fresh_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Reader thread: pass the latest block to reader, if one was published since the last call
+     * @return false if nothing new arrived
+     */
+    template <typename Reader>
+    bool consume(Reader&& reader)
+    {
+        if (!fresh_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        reader(static_cast<const Block&>(blocks_[front_]));
+        fresh_.store(false, std::memory_order_release);
+        return true;
+    }
+
+private:
+    Block blocks_[2];
+    int back_ = 0;                          // Audio thread
+    int front_ = 1;                         // Written before fresh_ is released, read after it is acquired
+    std::uint64_t sequence_ = 0;            // Audio thread
+    std::atomic<bool> fresh_{ false };      // Front block holds data the reader hasn't taken
+};
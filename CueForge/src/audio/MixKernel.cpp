@@ -0,0 +1,258 @@
+// src/audio/MixKernel.cpp - Vectorised matrix-mix inner loops
+#include "MixKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define CUEFORGE_MIX_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define CUEFORGE_MIX_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace MixKernel {
+
+namespace {
+
+constexpr int MAX_ROUTES = 64;
+
+void accumulateScalar(float* destination, const Route* routes, int numRoutes, int numFrames, int firstFrame)
+{
+    for (int r = 0; r < numRoutes; ++r) {
+        const float* source = routes[r].source;
+        const float gain = routes[r].gain;
+        const float step = routes[r].gainStep;
+
+        for (int i = firstFrame; i < numFrames; ++i) {
+            destination[i] += source[i] * (gain + step * static_cast<float>(i));
+        }
+    }
+}
+
+void measureScalar(const float* samples, int numFrames, int firstFrame, float& peak, float& sumSquares)
+{
+    for (int i = firstFrame; i < numFrames; ++i) {
+        const float magnitude = samples[i] < 0.0f ? -samples[i] : samples[i];
+        peak = magnitude > peak ? magnitude : peak;
+        sumSquares += samples[i] * samples[i];
+    }
+}
+
+#if CUEFORGE_MIX_X86
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define CUEFORGE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+    #define CUEFORGE_TARGET_AVX2
+#endif
+
+// Each 8-frame slice of the destination is loaded once and summed over all routes in registers
+CUEFORGE_TARGET_AVX2
+void accumulateAvx2(float* destination, const Route* routes, int numRoutes, int numFrames)
+{
+    const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    __m256 gains[MAX_ROUTES];
+    __m256 steps[MAX_ROUTES];
+    for (int r = 0; r < numRoutes; ++r) {
+        steps[r] = _mm256_set1_ps(routes[r].gainStep);
+        gains[r] = _mm256_fmadd_ps(steps[r], lanes, _mm256_set1_ps(routes[r].gain));
+        steps[r] = _mm256_mul_ps(steps[r], _mm256_set1_ps(8.0f));
+    }
+
+    int i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        __m256 sum = _mm256_loadu_ps(destination + i);
+        for (int r = 0; r < numRoutes; ++r) {
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(routes[r].source + i), gains[r], sum);
+            gains[r] = _mm256_add_ps(gains[r], steps[r]);
+        }
+        _mm256_storeu_ps(destination + i, sum);
+    }
+
+    accumulateScalar(destination, routes, numRoutes, numFrames, i);
+}
+
+CUEFORGE_TARGET_AVX2
+void measureAvx2(const float* samples, int numFrames, float& peak, float& sumSquares)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 peaks = _mm256_setzero_ps();
+    __m256 squares = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+        const __m256 x = _mm256_loadu_ps(samples + i);
+        peaks = _mm256_max_ps(peaks, _mm256_andnot_ps(signMask, x));
+        squares = _mm256_fmadd_ps(x, x, squares);
+    }
+
+    alignas(32) float peakLanes[8];
+    alignas(32) float squareLanes[8];
+    _mm256_store_ps(peakLanes, peaks);
+    _mm256_store_ps(squareLanes, squares);
+    for (int lane = 0; lane < 8; ++lane) {
+        peak = peakLanes[lane] > peak ? peakLanes[lane] : peak;
+        sumSquares += squareLanes[lane];
+    }
+
+    measureScalar(samples, numFrames, i, peak, sumSquares);
+}
+
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if (!osxsave || !fma) {
+        return false;
+    }
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false; // OS doesn't save YMM state
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif // CUEFORGE_MIX_X86
+
+#if CUEFORGE_MIX_NEON
+
+void accumulateNeon(float* destination, const Route* routes, int numRoutes, int numFrames)
+{
+    const float laneValues[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    const float32x4_t lanes = vld1q_f32(laneValues);
+
+    float32x4_t gains[MAX_ROUTES];
+    float32x4_t steps[MAX_ROUTES];
+    for (int r = 0; r < numRoutes; ++r) {
+        const float32x4_t step = vdupq_n_f32(routes[r].gainStep);
+        gains[r] = vmlaq_f32(vdupq_n_f32(routes[r].gain), step, lanes);
+        steps[r] = vmulq_n_f32(step, 4.0f);
+    }
+
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        float32x4_t sum = vld1q_f32(destination + i);
+        for (int r = 0; r < numRoutes; ++r) {
+            sum = vmlaq_f32(sum, vld1q_f32(routes[r].source + i), gains[r]);
+            gains[r] = vaddq_f32(gains[r], steps[r]);
+        }
+        vst1q_f32(destination + i, sum);
+    }
+
+    accumulateScalar(destination, routes, numRoutes, numFrames, i);
+}
+
+void measureNeon(const float* samples, int numFrames, float& peak, float& sumSquares)
+{
+    float32x4_t peaks = vdupq_n_f32(0.0f);
+    float32x4_t squares = vdupq_n_f32(0.0f);
+
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+        const float32x4_t x = vld1q_f32(samples + i);
+        peaks = vmaxq_f32(peaks, vabsq_f32(x));
+        squares = vmlaq_f32(squares, x, x);
+    }
+
+    float peakLanes[4];
+    float squareLanes[4];
+    vst1q_f32(peakLanes, peaks);
+    vst1q_f32(squareLanes, squares);
+    for (int lane = 0; lane < 4; ++lane) {
+        peak = peakLanes[lane] > peak ? peakLanes[lane] : peak;
+        sumSquares += squareLanes[lane];
+    }
+
+    measureScalar(samples, numFrames, i, peak, sumSquares);
+}
+
+#endif // CUEFORGE_MIX_NEON
+
+using AccumulateFunction = void (*)(float*, const Route*, int, int);
+using MeasureFunction = void (*)(const float*, int, float&, float&);
+
+void accumulatePortable(float* destination, const Route* routes, int numRoutes, int numFrames)
+{
+    accumulateScalar(destination, routes, numRoutes, numFrames, 0);
+}
+
+void measurePortable(const float* samples, int numFrames, float& peak, float& sumSquares)
+{
+    measureScalar(samples, numFrames, 0, peak, sumSquares);
+}
+
+struct Dispatch {
+    AccumulateFunction accumulate = accumulatePortable;
+    MeasureFunction measure = measurePortable;
+    const char* name = "scalar";
+
+    explicit Dispatch(bool detect)
+    {
+        if (!detect) {
+            return;
+        }
+
+#if CUEFORGE_MIX_X86
+        if (cpuHasAvx2()) {
+            accumulate = accumulateAvx2;
+            measure = measureAvx2;
+            name = "avx2";
+        }
+#elif CUEFORGE_MIX_NEON
+        accumulate = accumulateNeon;
+        measure = measureNeon;
+        name = "neon";
+#endif
+    }
+};
+
+// Resolved during static initialisation, before any audio device starts
+Dispatch dispatch(true);
+
+} // namespace
+
+void accumulateRamped(float* destination, const Route* routes, int numRoutes, int numFrames)
+{
+    if (numRoutes <= 0 || numFrames <= 0) {
+        return;
+    }
+
+    // Larger fan-ins are split so route state stays in registers/stack
+    while (numRoutes > MAX_ROUTES) {
+        dispatch.accumulate(destination, routes, MAX_ROUTES, numFrames);
+        routes += MAX_ROUTES;
+        numRoutes -= MAX_ROUTES;
+    }
+    dispatch.accumulate(destination, routes, numRoutes, numFrames);
+}
+
+void measure(const float* samples, int numFrames, float& peak, float& sumSquares)
+{
+    peak = 0.0f;
+    sumSquares = 0.0f;
+    if (samples && numFrames > 0) {
+        dispatch.measure(samples, numFrames, peak, sumSquares);
+    }
+}
+
+void forceScalar(bool scalar)
+{
+    dispatch = Dispatch(!scalar);
+}
+
+const char* implementationName()
+{
+    return dispatch.name;
+}
+
+} // namespace MixKernel
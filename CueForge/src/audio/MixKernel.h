@@ -0,0 +1,46 @@
+// src/audio/MixKernel.h - Vectorised matrix-mix inner loops
+#pragma once
+
+/**
+ * @brief Accumulation and measurement kernels used by the voice mixer
+ *
+ * The kernel is picked once at startup: AVX2/FMA on x86 CPUs that have it,
+ * NEON on ARM, otherwise a portable scalar loop. All variants produce the
+ * same result up to float rounding; forceScalar() pins the portable loop
+ * where output must match bit for bit across machines.
+ */
+namespace MixKernel {
+
+/**
+ * @brief One input feeding the output being accumulated
+ *
+ * Gain ramps linearly from gain (frame 0) by gainStep per frame, which is how
+ * matrix snapshots and fades glide without zipper noise.
+ */
+struct Route {
+    const float* source = nullptr;
+    float gain = 0.0f;
+    float gainStep = 0.0f;
+};
+
+/**
+ * @brief destination[i] += sum over routes of source[i] * (gain + gainStep * i)
+ */
+void accumulateRamped(float* destination, const Route* routes, int numRoutes, int numFrames);
+
+/**
+ * @brief Peak magnitude and sum of squares of a buffer (for metering)
+ */
+void measure(const float* samples, int numFrames, float& peak, float& sumSquares);
+
+/**
+ * @brief Use the portable scalar loops regardless of CPU (false restores detection)
+ *
+ * Not synchronised with the audio thread: call before any device or render starts.
+ */
+void forceScalar(bool scalar);
+
+// Name of the kernel in use ("avx2", "neon" or "scalar")
+const char* implementationName();
+
+} // namespace MixKernel
@@ -0,0 +1,63 @@
+// src/audio/OutputPatch.cpp - Cue-output to device-output patch, compiled to sparse routes
+#include "OutputPatch.h"
+
+#include <algorithm>
+
+CueOutputPatch::CueOutputPatch()
+    : levels_(static_cast<std::size_t>(MAX_CUE_OUTPUTS) * MAX_DEVICE_OUTPUTS, 0.0f)
+    , muted_()
+    , soloed_()
+{
+    setIdentity();
+}
+
+void CueOutputPatch::clear()
+{
+    std::fill(levels_.begin(), levels_.end(), 0.0f);
+    muted_.fill(false);
+    soloed_.fill(false);
+}
+
+void CueOutputPatch::setIdentity()
+{
+    clear();
+    for (int output = 0; output < std::min(MAX_CUE_OUTPUTS, MAX_DEVICE_OUTPUTS); ++output) {
+        setLevel(output, output, 1.0f);
+    }
+}
+
+std::unique_ptr<CompiledPatch> CueOutputPatch::compile() const
+{
+    auto compiled = std::make_unique<CompiledPatch>();
+
+    // Solo wins over mute: with anything soloed, only soloed outputs pass
+    const bool anySolo = std::find(soloed_.begin(), soloed_.end(), true) != soloed_.end();
+    std::array<bool, MAX_CUE_OUTPUTS> audible;
+    for (int cueOutput = 0; cueOutput < MAX_CUE_OUTPUTS; ++cueOutput) {
+        audible[cueOutput] = anySolo ? soloed_[cueOutput] : !muted_[cueOutput];
+    }
+
+    compiled->firstRoute.reserve(MAX_DEVICE_OUTPUTS + 1);
+    for (int deviceOutput = 0; deviceOutput < MAX_DEVICE_OUTPUTS; ++deviceOutput) {
+        compiled->firstRoute.push_back(static_cast<int>(compiled->routes.size()));
+        for (int cueOutput = 0; cueOutput < MAX_CUE_OUTPUTS; ++cueOutput) {
+            const float gain = level(cueOutput, deviceOutput);
+            if (gain == 0.0f || !audible[cueOutput]) {
+                continue;
+            }
+
+            CompiledPatch::Route route;
+            route.cueOutput = cueOutput;
+            route.gain = gain;
+            compiled->routes.push_back(route);
+            compiled->numDeviceOutputs = deviceOutput + 1;
+            compiled->numCueOutputs = std::max(compiled->numCueOutputs, cueOutput + 1);
+        }
+    }
+
+    // Trailing device outputs with no routes need no offsets
+    compiled->firstRoute.resize(static_cast<std::size_t>(compiled->numDeviceOutputs) + 1);
+    compiled->firstRoute.back() = static_cast<int>(compiled->routes.size());
+    compiled->routes.shrink_to_fit();
+    return compiled;
+}
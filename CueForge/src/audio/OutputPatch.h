@@ -0,0 +1,70 @@
+// src/audio/OutputPatch.h - Cue-output to device-output patch, compiled to sparse routes
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "GainMatrix.h"
+
+/**
+ * @brief The patch as the audio thread applies it: only crosspoints that pass signal
+ *
+ * Routes are grouped by device output: device output d sums the routes from
+ * firstRoute[d] up to firstRoute[d + 1]. Mute and solo are already folded
+ * into the gains, so the callback never looks at them. Built on the main
+ * thread, handed to the callback by pointer and returned via the patch
+ * retire queue.
+ */
+struct CompiledPatch {
+    struct Route {
+        int cueOutput = 0;
+        float gain = 0.0f;
+    };
+
+    std::vector<Route> routes;
+    std::vector<int> firstRoute;        // numDeviceOutputs + 1 offsets into routes
+    int numDeviceOutputs = 0;           // Highest device output with a route + 1
+    int numCueOutputs = 0;              // Highest cue output routed anywhere + 1
+};
+
+/**
+ * @brief Second routing stage: cue outputs (the voice mixer's buses) to device outputs
+ *
+ * Dense, editable description kept on the main thread. Level, mute and solo
+ * belong to cue outputs; any soloed output silences every output that isn't.
+ * compile() turns it into a CompiledPatch whenever it changes.
+ */
+class CueOutputPatch
+{
+public:
+    static constexpr int MAX_CUE_OUTPUTS = GainMatrix::MAX_OUTPUTS;
+    static constexpr int MAX_DEVICE_OUTPUTS = 128;      // A full Dante/MADI rig
+
+    CueOutputPatch();
+
+    static bool isValid(int cueOutput, int deviceOutput)
+    {
+        return cueOutput >= 0 && cueOutput < MAX_CUE_OUTPUTS && deviceOutput >= 0 && deviceOutput < MAX_DEVICE_OUTPUTS;
+    }
+
+    float level(int cueOutput, int deviceOutput) const { return levels_[index(cueOutput, deviceOutput)]; }
+    void setLevel(int cueOutput, int deviceOutput, float level) { levels_[index(cueOutput, deviceOutput)] = level; }
+
+    bool isMuted(int cueOutput) const { return muted_[cueOutput]; }
+    void setMuted(int cueOutput, bool muted) { muted_[cueOutput] = muted; }
+    bool isSoloed(int cueOutput) const { return soloed_[cueOutput]; }
+    void setSoloed(int cueOutput, bool soloed) { soloed_[cueOutput] = soloed; }
+
+    void clear();           // Nothing patched, no mutes or solos
+    void setIdentity();     // Cue output n to device output n, the default
+
+    std::unique_ptr<CompiledPatch> compile() const;
+
+private:
+    static int index(int cueOutput, int deviceOutput) { return cueOutput * MAX_DEVICE_OUTPUTS + deviceOutput; }
+
+    std::vector<float> levels_;                 // MAX_CUE_OUTPUTS x MAX_DEVICE_OUTPUTS
+    std::array<bool, MAX_CUE_OUTPUTS> muted_;
+    std::array<bool, MAX_CUE_OUTPUTS> soloed_;
+};
@@ -0,0 +1,300 @@
+// src/audio/Resampler.cpp - Sample-rate conversion and varispeed with quality tiers
+#include "Resampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief Windowed-sinc coefficients for phases 0 .. phases (inclusive)
+ */
+struct Resampler::FilterBank {
+    int taps = 0;
+    int phases = 0;
+    std::vector<float> coefficients;        // (phases + 1) x taps
+
+    const float* row(int phase) const { return coefficients.data() + static_cast<std::size_t>(phase) * taps; }
+};
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double KAISER_BETA = 8.0;
+constexpr double CUTOFF_GUARD = 0.95;       // Transition band below the new Nyquist
+
+constexpr int STANDARD_TAPS = 16;
+constexpr int STANDARD_PHASES = 256;
+constexpr int HIGH_TAPS = Resampler::MAX_TAPS;
+constexpr int HIGH_PHASES = 1024;
+
+// Real-time bands: the bank for step s is the first one whose step is >= s
+constexpr int BAND_COUNT = 5;
+constexpr double BAND_STEPS[BAND_COUNT] = { 1.0, 1.5, 2.0, 3.0, Resampler::MAX_STEP };
+
+// Modified Bessel function of the first kind, order 0 (series; converges fast for the betas used)
+double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+Resampler::FilterBank designBank(int taps, int phases, double step)
+{
+    Resampler::FilterBank bank;
+    bank.taps = taps;
+    bank.phases = phases;
+    bank.coefficients.resize(static_cast<std::size_t>(phases + 1) * taps);
+
+    const double cutoff = CUTOFF_GUARD * std::min(1.0, 1.0 / step);
+    const double half = taps / 2.0;
+    const double windowNorm = besselI0(KAISER_BETA);
+
+    for (int phase = 0; phase <= phases; ++phase) {
+        const double fraction = static_cast<double>(phase) / phases;
+        float* row = bank.coefficients.data() + static_cast<std::size_t>(phase) * taps;
+
+        double sum = 0.0;
+        for (int j = 0; j < taps; ++j) {
+            const double x = j - (taps / 2 - 1) - fraction;     // Distance from the output instant
+            const double sinc = x == 0.0 ? 1.0 : std::sin(PI * cutoff * x) / (PI * cutoff * x);
+            const double ratio = x / half;
+            const double window = std::abs(ratio) >= 1.0 ? 0.0
+                : besselI0(KAISER_BETA * std::sqrt(1.0 - ratio * ratio)) / windowNorm;
+            row[j] = static_cast<float>(sinc * window);
+            sum += row[j];
+        }
+
+        // Unity gain at DC for every phase, so there is no fractional-delay ripple
+        for (int j = 0; j < taps; ++j) {
+            row[j] = static_cast<float>(row[j] / sum);
+        }
+    }
+    return bank;
+}
+
+std::array<Resampler::FilterBank, BAND_COUNT> designStandardBanks()
+{
+    std::array<Resampler::FilterBank, BAND_COUNT> banks;
+    for (int band = 0; band < BAND_COUNT; ++band) {
+        banks[band] = designBank(STANDARD_TAPS, STANDARD_PHASES, BAND_STEPS[band]);
+    }
+    return banks;
+}
+
+// Built during static initialization, before any audio device starts
+const std::array<Resampler::FilterBank, BAND_COUNT> standardBanks = designStandardBanks();
+
+int tapsFor(ResamplerQuality quality, double fixedStep)
+{
+    switch (quality) {
+    case ResamplerQuality::Linear:
+        return 2;
+    case ResamplerQuality::High:
+        return fixedStep > 0.0 ? HIGH_TAPS : STANDARD_TAPS;     // Real-time High runs as Standard
+    case ResamplerQuality::Standard:
+        break;
+    }
+    return STANDARD_TAPS;
+}
+
+} // namespace
+
+Resampler::Resampler(ResamplerQuality quality, int numChannels, int maxInputFrames, double fixedStep)
+    : quality_(quality)
+    , numChannels_(std::max(1, numChannels))
+    , taps_(tapsFor(quality, fixedStep))
+    , capacity_(0)
+    , buffer_()
+    , buffered_(0)
+    , position_(0.0)
+    , fixedBank_()
+{
+    if (fixedStep > 0.0 && quality != ResamplerQuality::Linear) {
+        const int phases = quality == ResamplerQuality::High ? HIGH_PHASES : STANDARD_PHASES;
+        fixedBank_ = std::make_unique<FilterBank>(designBank(taps_, phases, fixedStep));
+    }
+
+    prepare(maxInputFrames);
+}
+
+Resampler::~Resampler() = default;
+
+void Resampler::prepare(int maxInputFrames)
+{
+    capacity_ = std::max(1, maxInputFrames) + taps_ + 1;
+    buffer_.assign(static_cast<std::size_t>(numChannels_) * capacity_, 0.0f);
+    reset();
+}
+
+void Resampler::reset(double offset)
+{
+    // Zero history in front of the first frame: the filter starts from silence
+    // Only the leading frames are read before new input overwrites them, so this is cheap enough for Play
+    const int leading = taps_ / 2 - 1;
+    for (int channel = 0; channel < numChannels_; ++channel) {
+        float* samples = buffer_.data() + static_cast<std::size_t>(channel) * capacity_;
+        std::fill(samples, samples + leading, 0.0f);
+    }
+    buffered_ = leading;
+    position_ = leading + std::max(0.0, offset);
+}
+
+// Processing
+
+const Resampler::FilterBank* Resampler::bankFor(double step) const
+{
+    if (fixedBank_) {
+        return fixedBank_.get();
+    }
+
+    int band = 0;
+    while (band < BAND_COUNT - 1 && BAND_STEPS[band] < step) {
+        ++band;
+    }
+    return &standardBanks[band];
+}
+
+int Resampler::inputFramesFor(int outputFrames, double step) const
+{
+    if (outputFrames <= 0) {
+        return 0;
+    }
+
+    const auto last = static_cast<std::int64_t>(position_ + (outputFrames - 1) * step);
+    const std::int64_t needed = last + taps_ / 2 + 1 - buffered_;
+    return static_cast<int>(std::clamp<std::int64_t>(needed, 0, capacity_ - buffered_));
+}
+
+int Resampler::process(const float* const* input, int numChannels, int inputFrames, float* const* output,
+                       int maxOutputFrames, double step)
+{
+    const int channels = std::clamp(numChannels, 0, numChannels_);
+    const int accepted = std::clamp(inputFrames, 0, capacity_ - buffered_);
+    for (int channel = 0; channel < channels; ++channel) {
+        float* target = buffer_.data() + static_cast<std::size_t>(channel) * capacity_ + buffered_;
+        if (input && input[channel]) {
+            std::memcpy(target, input[channel], sizeof(float) * accepted);
+        }
+        else {
+            std::fill(target, target + accepted, 0.0f);
+        }
+    }
+    buffered_ += accepted;
+
+    const int half = taps_ / 2;
+    const FilterBank* bank = quality_ == ResamplerQuality::Linear ? nullptr : bankFor(step);
+
+    int produced = 0;
+    float coefficients[MAX_TAPS];
+    while (produced < maxOutputFrames) {
+        const int base = static_cast<int>(position_);
+        if (base + half >= buffered_) {
+            break;      // Needs input we haven't been given yet
+        }
+
+        const float fraction = static_cast<float>(position_ - base);
+        const int first = base - half + 1;
+
+        if (!bank) {
+            for (int channel = 0; channel < channels; ++channel) {
+                const float* samples = buffer_.data() + static_cast<std::size_t>(channel) * capacity_ + first;
+                output[channel][produced] = samples[0] + (samples[1] - samples[0]) * fraction;
+            }
+        }
+        else {
+            // Interpolate between neighbouring phases once, then apply to every channel
+            const float phasePosition = fraction * bank->phases;
+            const int phase = std::min(static_cast<int>(phasePosition), bank->phases - 1);
+            const float blend = phasePosition - static_cast<float>(phase);
+            const float* lower = bank->row(phase);
+            const float* upper = bank->row(phase + 1);
+            for (int j = 0; j < taps_; ++j) {
+                coefficients[j] = lower[j] + (upper[j] - lower[j]) * blend;
+            }
+
+            for (int channel = 0; channel < channels; ++channel) {
+                const float* samples = buffer_.data() + static_cast<std::size_t>(channel) * capacity_ + first;
+                float sum = 0.0f;
+                for (int j = 0; j < taps_; ++j) {
+                    sum += samples[j] * coefficients[j];
+                }
+                output[channel][produced] = sum;
+            }
+        }
+
+        position_ += step;
+        ++produced;
+    }
+
+    // Keep only the history the next output still needs
+    const int consumed = std::min(buffered_, std::max(0, static_cast<int>(position_) - half + 1));
+    if (consumed > 0) {
+        for (int channel = 0; channel < channels; ++channel) {
+            float* samples = buffer_.data() + static_cast<std::size_t>(channel) * capacity_;
+            std::memmove(samples, samples + consumed, sizeof(float) * (buffered_ - consumed));
+        }
+        buffered_ -= consumed;
+        position_ -= consumed;
+    }
+
+    return produced;
+}
+
+void Resampler::convert(const float* const* input, int numChannels, std::int64_t inputFrames,
+                        float* const* output, std::int64_t outputFrames, double step, double offset,
+                        ResamplerQuality quality)
+{
+    Resampler resampler(quality, numChannels, CONVERT_CHUNK_FRAMES, step);
+    resampler.reset(offset);
+
+    std::vector<const float*> sources(static_cast<std::size_t>(numChannels));
+    std::vector<float*> destinations(static_cast<std::size_t>(numChannels));
+
+    std::int64_t consumed = 0;
+    std::int64_t produced = 0;
+    while (produced < outputFrames) {
+        const int wanted = static_cast<int>(std::min<std::int64_t>(CONVERT_CHUNK_FRAMES, outputFrames - produced));
+        int count = resampler.inputFramesFor(wanted, step);
+
+        // Past the end of the input the filter is flushed with silence
+        const bool haveInput = consumed < inputFrames;
+        if (haveInput) {
+            count = static_cast<int>(std::min<std::int64_t>(count, inputFrames - consumed));
+        }
+        for (int channel = 0; channel < numChannels; ++channel) {
+            sources[channel] = haveInput ? input[channel] + consumed : nullptr;
+            destinations[channel] = output[channel] + produced;
+        }
+
+        const int made = resampler.process(haveInput ? sources.data() : nullptr, numChannels, count,
+                                           destinations.data(), wanted, step);
+        consumed += count;
+        produced += made;
+        if (made == 0 && count == 0) {
+            break;
+        }
+    }
+
+    for (int channel = 0; channel < numChannels && produced < outputFrames; ++channel) {
+        std::fill(output[channel] + produced, output[channel] + outputFrames, 0.0f);
+    }
+}
+
+const char* Resampler::qualityName(ResamplerQuality quality)
+{
+    switch (quality) {
+    case ResamplerQuality::Linear:   return "linear";
+    case ResamplerQuality::Standard: return "standard";
+    case ResamplerQuality::High:     return "high";
+    }
+    return "standard";
+}
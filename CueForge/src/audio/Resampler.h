@@ -0,0 +1,102 @@
+// src/audio/Resampler.h - Sample-rate conversion and varispeed with quality tiers
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Interpolation quality; cost grows with the tap count
+ */
+enum class ResamplerQuality : std::uint8_t {
+    Linear,     // 2-point: scrubbing and previews, near-free
+    Standard,   // 16-tap polyphase sinc: real-time varispeed
+    High        // 64-tap polyphase sinc: offline rate conversion (fixed ratio only)
+};
+
+/**
+ * @brief Streaming multichannel resampler
+ *
+ * step is input frames per output frame: speed for varispeed, or
+ * fileRate / deviceRate for rate conversion. Input is pushed a block at a
+ * time; the resampler keeps the filter's history between calls, so
+ * consecutive blocks join seamlessly.
+ *
+ * Real-time instances (fixedStep == 0) pick one of a few filter banks
+ * tabulated at startup, switching to a lower cutoff as the speed rises so
+ * that fast varispeed doesn't alias. Fixed-ratio instances design their own
+ * bank for the exact ratio. process() never allocates, so a prepared
+ * instance can run on the audio thread.
+ */
+class Resampler
+{
+public:
+    /**
+     * @param maxInputFrames Largest input block process() will be given
+     * @param fixedStep > 0 designs a dedicated bank for that ratio (offline/disk use)
+     */
+    Resampler(ResamplerQuality quality, int numChannels, int maxInputFrames, double fixedStep = 0.0);
+    ~Resampler();
+
+    Resampler(const Resampler&) = delete;
+    Resampler& operator=(const Resampler&) = delete;
+
+    ResamplerQuality quality() const { return quality_; }
+    int numChannels() const { return numChannels_; }
+    int taps() const { return taps_; }
+
+    void prepare(int maxInputFrames);       // Allocates: never from the audio thread
+
+    /**
+     * @brief Clear history; the first output lands offset input frames after the next pushed frame
+     */
+    void reset(double offset = 0.0);
+
+    /**
+     * @brief Input frames to push so the next process() can produce outputFrames
+     */
+    int inputFramesFor(int outputFrames, double step) const;
+
+    /**
+     * @brief Push inputFrames (null input = silence) and produce up to maxOutputFrames
+     *
+     * Only the first numChannels channels (at most numChannels()) are
+     * filtered, so a voice sized for MAX_VOICE_INPUTS pays for the channels
+     * its media actually has.
+     * @return Frames written to output
+     */
+    int process(const float* const* input, int numChannels, int inputFrames, float* const* output,
+                int maxOutputFrames, double step);
+
+    /**
+     * @brief Whole-buffer conversion, for decoding
+     *
+     * Output frame k is taken at input time offset + k * step; input beyond
+     * inputFrames reads as silence.
+     */
+    static void convert(const float* const* input, int numChannels, std::int64_t inputFrames,
+                        float* const* output, std::int64_t outputFrames, double step, double offset,
+                        ResamplerQuality quality = ResamplerQuality::High);
+
+    static const char* qualityName(ResamplerQuality quality);
+
+    struct FilterBank;      // Tabulated windowed-sinc phases (Resampler.cpp)
+
+    // Constants
+    static constexpr double MAX_STEP = 4.0;             // AudioCue playback speed range is 0.1 .. 4.0
+    static constexpr int MAX_TAPS = 64;
+
+private:
+    const FilterBank* bankFor(double step) const;
+
+    ResamplerQuality quality_;
+    int numChannels_;
+    int taps_;
+    int capacity_;                          // Frames per channel in buffer_
+    std::vector<float> buffer_;             // Channel-major history + pending input
+    int buffered_;
+    double position_;                       // Next output, in frames from the start of buffer_
+    std::unique_ptr<FilterBank> fixedBank_;
+
+    static constexpr int CONVERT_CHUNK_FRAMES = 65536;
+};
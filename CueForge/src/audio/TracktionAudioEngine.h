@@ -7,8 +7,11 @@
 #include <QTimer>
 #include <QMutex>
 #include <QMap>
+#include <QVector>
 #include <memory>
 
+#include "AudioBackend.h"
+
 // Conditional include for Tracktion Engine
 #if CUEFORGE_USE_TRACKTION_ENGINE
 #include <tracktion_engine/tracktion_engine.h>
@@ -21,10 +24,14 @@ namespace te = tracktion_engine;
  * This class integrates the powerful Tracktion Engine with our Qt6 application,
  * providing professional DAW-quality audio processing, matrix mixing, and
  * multi-format audio file support.
+ *
+ * Implements the same AudioBackend interface as JuceAudioBridge, so the
+ * transport path is identical whichever engine the build selects.
  */
-class TracktionAudioEngine : public QObject
+class TracktionAudioEngine : public QObject, public AudioBackend<TracktionAudioEngine>
 {
     Q_OBJECT
+    friend class AudioBackend<TracktionAudioEngine>;
 
 public:
     explicit TracktionAudioEngine(QObject* parent = nullptr);
@@ -53,6 +60,10 @@ public:
     bool loadAudioFile(const QString& cueId, const QString& filePath);
     bool removeAudioCue(const QString& cueId);
 
+    // Handle-based transport (AudioBackend)
+    using AudioBackend<TracktionAudioEngine>::setCrosspoint;
+    using AudioBackend<TracktionAudioEngine>::setInputLevel;
+
     // Playback control
     bool playCue(const QString& cueId, double startTime = 0.0, double fadeInTime = 0.0);
     bool stopCue(const QString& cueId, double fadeOutTime = 0.0);
@@ -127,6 +138,23 @@ private:
     void registerCueWithTracktion(const QString& cueId);
     void unregisterCueFromTracktion(const QString& cueId);
 
+    // AudioBackend hooks; a handle indexes handleCueIds_
+    CueHandle acquireHandle(const QString& cueId);
+    void releaseHandle(const QString& cueId);
+    CueHandle findHandle(const QString& cueId) const;
+    bool playHandle(CueHandle handle, double startTime, double fadeInTime, FadeCurve curve);
+    bool stopHandle(CueHandle handle, double fadeOutTime, FadeCurve curve);
+    bool pauseHandle(CueHandle handle);
+    bool resumeHandle(CueHandle handle);
+    bool fadeHandle(CueHandle handle, float level, double duration, FadeCurve curve);
+    void stopAllHandles(double fadeOutTime, FadeCurve curve);
+    bool playSetHandles(const QVector<CueStart>& starts);
+    bool setSpeedHandle(CueHandle handle, double speed, ResamplerQuality quality);
+    bool setMatrixHandle(CueHandle handle, const GainMatrix& matrix);
+    bool setCrosspointHandle(CueHandle handle, int input, int output, float level);
+    bool setInputLevelHandle(CueHandle handle, int input, float level);
+    bool setOutputLevelAll(int output, float level);
+
     // String conversion helpers
     QString tracktionToQt(const std::string& str) const;
     std::string qtToTracktion(const QString& str) const;
@@ -185,6 +213,10 @@ private:
     QMap<QString, DummyCue> dummyCues_;
 #endif
 
+    // Cue handles (AudioBackend): slot -> cue ID, with released slots reused
+    QVector<QString> handleCueIds_;
+    QVector<CueHandle> freeHandles_;
+
     // Status monitoring
     QTimer* statusTimer_;
     QTimer* positionTimer_;
@@ -1,209 +1,433 @@
-// src/core/Application.h - Core CueForge Application Class
-#pragma once
-
-#include <QObject>
-#include <QApplication>
-#include <QTimer>
-#include <QSettings>
-#include <memory>
-
-// Forward declarations
-class CueManager;
-class MainWindow;
-class AudioEngineManager;
-class Settings;
+// src/core/Application.cpp - Core CueForge Application Class
+#include "Application.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QMessageBox>
+#include <QThread>
+
+#include "AudioEngineManager.h"
+#include "AutosaveService.h"
+#include "CueManager.h"
+#include "MainWindow.h"
+#include "OscControlService.h"
+#include "Settings.h"
+#include "StartupSequence.h"
+#include "Workspace.h"
 
 /**
- * @brief The main CueForge application class that orchestrates all core components
- *
- * This class manages the application lifecycle, coordinates between the UI and
- * core systems, and handles global application state. It serves as the central
- * hub that connects the CueManager, AudioEngine, and UI components.
+ * @brief What the startup workers produce, picked up by the main-thread stages after them
  */
-class CueForgeApplication : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit CueForgeApplication(QObject* parent = nullptr);
-    ~CueForgeApplication();
-
-    /**
-     * @brief Initialize the application
-     * @return true if initialization succeeds, false otherwise
-     */
-    bool initialize();
-
-    /**
-     * @brief Run the application event loop
-     * @return Application exit code
-     */
-    int exec();
-
-    /**
-     * @brief Shutdown the application gracefully
-     */
-    void shutdown();
-
-    // Global access to core components
-    CueManager* cueManager() const { return cueManager_.get(); }
-    AudioEngineManager* audioEngine() const { return audioEngine_.get(); }
-    MainWindow* mainWindow() const { return mainWindow_.get(); }
-
-    // Application state
-    bool isInitialized() const { return initialized_; }
-    bool isShuttingDown() const { return shuttingDown_; }
-
-    // Global settings access
-    QVariant getSetting(const QString& key, const QVariant& defaultValue = QVariant()) const;
-    void setSetting(const QString& key, const QVariant& value);
-
-public slots:
-    /**
-     * @brief Handle application quit request (can be cancelled)
-     */
-    void requestQuit();
-
-    /**
-     * @brief Force application quit (cannot be cancelled)
-     */
-    void forceQuit();
-
-    /**
-     * @brief Show the preferences dialog
-     */
-    void showPreferences();
-
-    /**
-     * @brief Show the about dialog
-     */
-    void showAbout();
-
-    /**
-     * @brief Handle emergency panic stop
-     */
-    void emergencyStop();
-
-signals:
-    /**
-     * @brief Emitted when the application is about to quit
-     * @param canCancel Whether the quit can be cancelled
-     */
-    void aboutToQuit(bool canCancel);
-
-    /**
-     * @brief Emitted when application settings change
-     * @param key The setting key that changed
-     * @param value The new value
-     */
-    void settingChanged(const QString& key, const QVariant& value);
-
-    /**
-     * @brief Emitted when the application encounters a critical error
-     * @param message Error message
-     */
-    void criticalError(const QString& message);
-
-private slots:
-    /**
-     * @brief Handle periodic application updates
-     */
-    void onUpdateTimer();
-
-    /**
-     * @brief Handle auto-save timer
-     */
-    void onAutoSaveTimer();
-
-    /**
-     * @brief Handle window close event from main window
-     */
-    void onMainWindowCloseRequested();
-
-    /**
-     * @brief Handle audio engine errors
-     */
-    void onAudioEngineError(const QString& error);
-
-    /**
-     * @brief Handle workspace changes for auto-save
-     */
-    void onWorkspaceChanged();
-
-private:
-    /**
-     * @brief Initialize the audio engine
-     * @return true if successful
-     */
-    bool initializeAudio();
-
-    /**
-     * @brief Initialize the user interface
-     * @return true if successful
-     */
-    bool initializeUI();
-
-    /**
-     * @brief Load application settings
-     */
-    void loadSettings();
-
-    /**
-     * @brief Save application settings
-     */
-    void saveSettings();
-
-    /**
-     * @brief Setup application timers
-     */
-    void setupTimers();
-
-    /**
-     * @brief Connect signals between components
-     */
-    void connectSignals();
-
-    /**
-     * @brief Check if there are unsaved changes
-     * @return true if there are unsaved changes
-     */
-    bool hasUnsavedChanges() const;
-
-    /**
-     * @brief Prompt user to save unsaved changes
-     * @return true if user chose to continue (saved or discarded), false to cancel
-     */
-    bool promptSaveChanges();
-
-    /**
-     * @brief Perform application cleanup
-     */
-    void cleanup();
-
-    // Core components (ordered by initialization dependency)
-    std::unique_ptr<Settings> settings_;
-    std::unique_ptr<CueManager> cueManager_;
-    std::unique_ptr<AudioEngineManager> audioEngine_;
-    std::unique_ptr<MainWindow> mainWindow_;
-
-    // Application state
-    bool initialized_ = false;
-    bool shuttingDown_ = false;
-
-    // Timers
-    QTimer* updateTimer_;          // General application updates
-    QTimer* autoSaveTimer_;        // Automatic workspace saving
-
-    // Settings cache for frequently accessed values
-    mutable QSettings* qtSettings_;
-    bool autoSaveEnabled_;
-    int autoSaveInterval_;        // in minutes
-    QString lastWorkspacePath_;
-
-    // Error handling
-    QString lastError_;
-
-    // Constants
-    static constexpr int UPDATE_INTERVAL_MS = 50;     // 20 FPS for UI updates
-    static constexpr int DEFAULT_AUTOSAVE_MINUTES = 5;
-};
\ No newline at end of file
+struct CueForgeApplication::PendingStartup {
+    std::unique_ptr<Settings> settings;     // Constructed on a worker, moved to the GUI thread
+    bool loadLastWorkspace = false;
+    QString audioDevice;                    // Empty: the system default output
+    int sampleRate = 0;
+    int bufferSize = 0;
+    QString workspacePath;                  // Empty: start with an empty workspace
+    Workspace::File workspace;
+    bool recovering = false;                // workspace.contents came from the autosave, not the file
+    QString error;
+};
+
+CueForgeApplication::CueForgeApplication(QObject* parent)
+    : QObject(parent)
+    , updateTimer_(new QTimer(this))
+    , autoSaveTimer_(new QTimer(this))
+    , qtSettings_(nullptr)
+    , autoSaveEnabled_(true)
+    , autoSaveInterval_(DEFAULT_AUTOSAVE_MINUTES)
+{
+}
+
+CueForgeApplication::~CueForgeApplication()
+{
+    shutdown();
+    cleanup();
+}
+
+bool CueForgeApplication::initialize(const QElapsedTimer& launchTimer)
+{
+    if (startup_) {
+        qWarning() << "CueForge is already initialized";
+        return false;
+    }
+
+    pendingStartup_ = std::make_unique<PendingStartup>();
+    startup_ = std::make_unique<StartupSequence>();
+    startup_->setLaunchTimer(launchTimer);
+    addStartupStages();
+
+    connect(startup_.get(), &StartupSequence::goReady, this, &CueForgeApplication::goReady);
+    connect(startup_.get(), &StartupSequence::finished, this, [this](bool succeeded) {
+        initialized_ = true;
+        pendingStartup_.reset();    // Every worker is done with it
+        if (!succeeded) {
+            qWarning() << "CueForge started with failed stages:" << lastError_;
+        }
+    });
+
+    startup_->start();
+    return true;
+}
+
+int CueForgeApplication::exec()
+{
+    return QApplication::exec();
+}
+
+void CueForgeApplication::shutdown()
+{
+    if (shuttingDown_) {
+        return;
+    }
+    shuttingDown_ = true;
+
+    updateTimer_->stop();
+    autoSaveTimer_->stop();
+
+    if (settings_) {
+        saveSettings();
+    }
+    if (oscControl_) {
+        oscControl_->stop();
+    }
+    if (audioEngine_) {
+        audioEngine_->shutdown();
+    }
+
+    // By now the user has saved or chosen to discard: only a crash should leave edits to recover
+    if (cueManager_) {
+        cueManager_->autosave()->reset();
+    }
+
+    qDebug() << "CueForge shut down";
+}
+
+bool CueForgeApplication::isGoReady() const
+{
+    return startup_ && startup_->isGoReady();
+}
+
+QVariant CueForgeApplication::getSetting(const QString& key, const QVariant& defaultValue) const
+{
+    // Null until the settings stage has handed them over
+    return settings_ ? settings_->value(key, defaultValue) : defaultValue;
+}
+
+void CueForgeApplication::setSetting(const QString& key, const QVariant& value)
+{
+    if (!settings_) {
+        qWarning() << "Setting" << key << "changed before settings were loaded";
+        return;
+    }
+
+    settings_->setValue(key, value);
+    emit settingChanged(key, value);
+}
+
+// Public Slots
+
+void CueForgeApplication::requestQuit()
+{
+    if (shuttingDown_ || !promptSaveChanges()) {
+        return;
+    }
+
+    emit aboutToQuit(true);
+    shutdown();
+    QApplication::quit();
+}
+
+void CueForgeApplication::forceQuit()
+{
+    emit aboutToQuit(false);
+    shutdown();
+    QApplication::quit();
+}
+
+void CueForgeApplication::showPreferences()
+{
+    QMessageBox::information(mainWindow_.get(), "Preferences",
+        "The preferences dialog is not available in this build.\n"
+        "Settings can be imported and exported as files.");
+}
+
+void CueForgeApplication::showAbout()
+{
+    QMessageBox::about(mainWindow_.get(), "About CueForge",
+        QString("%1 %2\n\nShow control for theatre and live events.")
+            .arg(QApplication::applicationDisplayName(), QApplication::applicationVersion()));
+}
+
+void CueForgeApplication::emergencyStop()
+{
+    if (cueManager_) {
+        cueManager_->panic();
+    }
+}
+
+// Private Slots
+
+void CueForgeApplication::onUpdateTimer()
+{
+    if (mainWindow_) {
+        mainWindow_->updateStatus();
+    }
+}
+
+void CueForgeApplication::onAutoSaveTimer()
+{
+    // AutosaveService journals the workspace itself; this keeps the settings a restart after a crash reads current
+    if (settings_) {
+        saveSettings();
+    }
+}
+
+void CueForgeApplication::onMainWindowCloseRequested()
+{
+    // The window has already asked about unsaved changes
+    forceQuit();
+}
+
+void CueForgeApplication::onAudioEngineError(const QString& error)
+{
+    qWarning() << "Audio engine error:" << error;
+    lastError_ = error;
+    emit criticalError(error);
+}
+
+void CueForgeApplication::onWorkspaceChanged()
+{
+    if (!cueManager_ || cueManager_->currentWorkspacePath().isEmpty()) {
+        return;
+    }
+
+    lastWorkspacePath_ = cueManager_->currentWorkspacePath();
+    if (settings_) {
+        settings_->setString(Settings::Keys::Workspace::LastOpened, lastWorkspacePath_);
+    }
+}
+
+// Startup
+
+void CueForgeApplication::addStartupStages()
+{
+    using Thread = StartupSequence::Thread;
+    PendingStartup* pending = pendingStartup_.get();
+    QThread* mainThread = thread();
+
+    // Workers: files in, plain values out
+
+    startup_->addStage("settings", Thread::Worker, {}, [pending, mainThread]() {
+        pending->settings = std::make_unique<Settings>();
+        pending->loadLastWorkspace = pending->settings->getBool(Settings::Keys::General::LoadLastWorkspace, true);
+        pending->workspacePath = pending->settings->getString(Settings::Keys::Workspace::LastOpened);
+        pending->audioDevice = pending->settings->getString(Settings::Keys::Audio::DeviceName);
+        pending->sampleRate = pending->settings->getInt(Settings::Keys::Audio::SampleRate);
+        pending->bufferSize = pending->settings->getInt(Settings::Keys::Audio::BufferSize);
+        pending->settings->moveToThread(mainThread);
+        return true;
+    });
+
+    startup_->addStage("workspace-read", Thread::Worker, { "settings" }, [pending]() {
+        const QString path = pending->loadLastWorkspace ? pending->workspacePath : QString();
+        pending->workspacePath.clear();
+        if (path.isEmpty()) {
+            return true;
+        }
+
+        // An autosave left behind means we went down mid-show: come back with its edits
+        if (AutosaveService::hasRecoveryData(path) && AutosaveService::readRecovery(path, pending->workspace.contents)) {
+            pending->workspace.format = Workspace::Format::Binary;
+            pending->workspacePath = path;
+            pending->recovering = true;
+            return true;
+        }
+
+        if (!QFileInfo::exists(path)) {
+            qWarning() << "Last workspace" << path << "no longer exists";
+            return true;
+        }
+
+        // An unreadable workspace still leaves an empty, usable show
+        pending->workspace = Workspace::File();     // Drop a half-read recovery
+        QString error;
+        if (!Workspace::readFile(path, pending->workspace, &error)) {
+            pending->error = QString("Could not open the last workspace %1:\n%2").arg(path, error);
+            return true;
+        }
+        pending->workspacePath = path;
+        return true;
+    });
+
+    // GUI thread, one stage per event-loop pass
+
+    startup_->addStage("core", Thread::Main, {}, [this]() {
+        cueManager_ = std::make_unique<CueManager>();
+        audioEngine_ = std::make_unique<AudioEngineManager>(cueManager_.get());
+        return true;
+    });
+
+    startup_->addStage("window", Thread::Main, { "core" }, [this]() {
+        return initializeUI();
+    });
+
+    // The window has painted once before the devices open; the device choice comes from the settings
+    startup_->addStage("audio", Thread::Main, { "window", "settings" }, [this]() {
+        return initializeAudio();
+    });
+
+    startup_->addStage("configure", Thread::Main, { "settings", "window" }, [this, pending]() {
+        settings_ = std::move(pending->settings);
+        loadSettings();
+        audioEngine_->applySettings(settings_.get());
+        connectSignals();
+        setupTimers();
+        return true;
+    });
+
+    startup_->addStage("workspace", Thread::Main, { "workspace-read", "configure" }, [this]() {
+        return openStartupWorkspace();
+    });
+
+    // Remote GO has to find the engine running and the cue list loaded
+    startup_->addStage("network", Thread::Main, { "audio", "workspace" }, [this]() {
+        oscControl_ = std::make_unique<OscControlService>(cueManager_.get(), audioEngine_->getJuceBridge(),
+                                                          audioEngine_->getPrearmer());
+        oscControl_->applySettings(settings_.get());
+        return true;
+    });
+
+    startup_->setGoReadyStages({ "audio", "workspace" });
+}
+
+bool CueForgeApplication::openStartupWorkspace()
+{
+    PendingStartup& pending = *pendingStartup_;
+    if (!pending.error.isEmpty()) {
+        lastError_ = pending.error;
+        emit criticalError(pending.error);
+    }
+
+    if (pending.workspacePath.isEmpty()) {
+        return true;
+    }
+
+    bool opened = false;
+    if (pending.recovering) {
+        qWarning() << "Recovering unsaved edits to" << pending.workspacePath << "from autosave";
+        opened = cueManager_->restoreWorkspace(pending.workspace.contents, pending.workspacePath);
+    }
+    else {
+        opened = cueManager_->openWorkspace(pending.workspacePath, pending.workspace);
+    }
+
+    pending.workspace = Workspace::File();   // Summaries now live in the cues
+    if (!opened) {
+        lastError_ = QString("Failed to load workspace %1").arg(pending.workspacePath);
+        emit criticalError(lastError_);
+    }
+    return opened;
+}
+
+bool CueForgeApplication::initializeAudio()
+{
+    const PendingStartup& pending = *pendingStartup_;
+    if (!audioEngine_->initialize(pending.audioDevice, pending.sampleRate, pending.bufferSize)) {
+        lastError_ = "Failed to initialize the audio engine. Please check your audio setup.";
+        emit criticalError(lastError_);
+        return false;
+    }
+    return true;
+}
+
+bool CueForgeApplication::initializeUI()
+{
+    mainWindow_ = std::make_unique<MainWindow>(cueManager_.get());
+    mainWindow_->show();
+    return true;
+}
+
+void CueForgeApplication::loadSettings()
+{
+    autoSaveEnabled_ = settings_->getBool(Settings::Keys::General::AutoSave, true);
+    autoSaveInterval_ = settings_->getInt(Settings::Keys::General::AutoSaveInterval, DEFAULT_AUTOSAVE_MINUTES);
+    lastWorkspacePath_ = settings_->getString(Settings::Keys::Workspace::LastOpened);
+
+    cueManager_->autosave()->setEnabled(autoSaveEnabled_);
+    cueManager_->autosave()->setSnapshotIntervalMinutes(autoSaveInterval_);
+}
+
+void CueForgeApplication::saveSettings()
+{
+    settings_->setString(Settings::Keys::Workspace::LastOpened, lastWorkspacePath_);
+    settings_->sync();
+}
+
+void CueForgeApplication::setupTimers()
+{
+    updateTimer_->setInterval(UPDATE_INTERVAL_MS);
+    connect(updateTimer_, &QTimer::timeout, this, &CueForgeApplication::onUpdateTimer);
+    updateTimer_->start();
+
+    autoSaveTimer_->setInterval(qMax(1, autoSaveInterval_) * 60 * 1000);
+    connect(autoSaveTimer_, &QTimer::timeout, this, &CueForgeApplication::onAutoSaveTimer);
+    autoSaveTimer_->start();
+}
+
+void CueForgeApplication::connectSignals()
+{
+    connect(mainWindow_.get(), &MainWindow::closeRequested, this, &CueForgeApplication::onMainWindowCloseRequested);
+    connect(mainWindow_.get(), &MainWindow::preferencesRequested, this, &CueForgeApplication::showPreferences);
+    connect(cueManager_.get(), &CueManager::workspaceOpened, this, &CueForgeApplication::onWorkspaceChanged);
+    connect(cueManager_.get(), &CueManager::workspaceChanged, this, &CueForgeApplication::onWorkspaceChanged);
+    connect(audioEngine_.get(), &AudioEngineManager::criticalError, this, &CueForgeApplication::onAudioEngineError);
+
+    connect(this, &CueForgeApplication::criticalError, mainWindow_.get(), [this](const QString& message) {
+        QMessageBox::critical(mainWindow_.get(), "CueForge", message);
+    });
+}
+
+bool CueForgeApplication::hasUnsavedChanges() const
+{
+    return cueManager_ && cueManager_->hasUnsavedChanges();
+}
+
+bool CueForgeApplication::promptSaveChanges()
+{
+    if (!hasUnsavedChanges()) {
+        return true;
+    }
+
+    const QMessageBox::StandardButton result = QMessageBox::question(
+        mainWindow_.get(),
+        "Unsaved Changes",
+        "There are unsaved changes in the current workspace.\n\nDo you want to save them?",
+        QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel,
+        QMessageBox::Save);
+
+    switch (result) {
+    case QMessageBox::Save:
+        mainWindow_->saveWorkspace();
+        return !hasUnsavedChanges();     // Save As was cancelled
+    case QMessageBox::Discard:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void CueForgeApplication::cleanup()
+{
+    // Startup workers write into pendingStartup_, so they go first
+    startup_.reset();
+    pendingStartup_.reset();
+
+    // The I/O thread posts to the bridge and reads the cue list
+    oscControl_.reset();
+    mainWindow_.reset();
+    audioEngine_.reset();
+    cueManager_.reset();
+    settings_.reset();
+}
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QSettings>
 #include <memory>
@@ -11,7 +12,9 @@
 class CueManager;
 class MainWindow;
 class AudioEngineManager;
+class OscControlService;
 class Settings;
+class StartupSequence;
 
 /**
  * @brief The main CueForge application class that orchestrates all core components
@@ -29,10 +32,16 @@ public:
     ~CueForgeApplication();
 
     /**
-     * @brief Initialize the application
-     * @return true if initialization succeeds, false otherwise
+     * @brief Start the application: the window at once, everything else in stages
+     *
+     * The window is shown on the first event-loop pass. Settings and the last
+     * workspace (or its crash recovery) are read on worker threads while the
+     * audio devices open on the GUI thread; goReady() follows once both the
+     * engine and the workspace are up. Stage timings go to the log.
+     * @param launchTimer Started at the top of main(), so timings include Qt's own startup
+     * @return false if startup could not be scheduled; later failures emit criticalError()
      */
-    bool initialize();
+    bool initialize(const QElapsedTimer& launchTimer = QElapsedTimer());
 
     /**
      * @brief Run the application event loop
@@ -51,7 +60,8 @@ public:
     MainWindow* mainWindow() const { return mainWindow_.get(); }
 
     // Application state
-    bool isInitialized() const { return initialized_; }
+    bool isInitialized() const { return initialized_; }    // Every startup stage has run
+    bool isGoReady() const;
     bool isShuttingDown() const { return shuttingDown_; }
 
     // Global settings access
@@ -104,6 +114,12 @@ signals:
      */
     void criticalError(const QString& message);
 
+    /**
+     * @brief Emitted when the engine is running and the workspace is loaded
+     * @param elapsedMs Time since launch
+     */
+    void goReady(qint64 elapsedMs);
+
 private slots:
     /**
      * @brief Handle periodic application updates
@@ -131,6 +147,19 @@ private slots:
     void onWorkspaceChanged();
 
 private:
+    struct PendingStartup;      // Results handed from startup workers to main-thread stages
+
+    /**
+     * @brief Register the startup stages and their dependencies
+     */
+    void addStartupStages();
+
+    /**
+     * @brief Open the workspace read during startup
+     * @return true if there was none, or it opened
+     */
+    bool openStartupWorkspace();
+
     /**
      * @brief Initialize the audio engine
      * @return true if successful
@@ -181,10 +210,13 @@ private:
     void cleanup();
 
     // Core components (ordered by initialization dependency)
+    std::unique_ptr<StartupSequence> startup_;
+    std::unique_ptr<PendingStartup> pendingStartup_;
     std::unique_ptr<Settings> settings_;
     std::unique_ptr<CueManager> cueManager_;
     std::unique_ptr<AudioEngineManager> audioEngine_;
     std::unique_ptr<MainWindow> mainWindow_;
+    std::unique_ptr<OscControlService> oscControl_;
 
     // Application state
     bool initialized_ = false;
@@ -2,8 +2,10 @@
 #pragma once
 
 #include "Cue.h"
+#include "StringPool.h"
 #include <QUrl>
 #include <QFileInfo>
+#include <QTimer>
 #include <QVariantMap>
 
 // Forward declaration for JUCE integration
@@ -31,6 +33,8 @@ class AudioCue : public Cue
         Q_PROPERTY(double playbackSpeed READ playbackSpeed WRITE setPlaybackSpeed NOTIFY playbackSpeedChanged)
         Q_PROPERTY(QVariantMap matrixRouting READ matrixRouting WRITE setMatrixRouting NOTIFY matrixRoutingChanged)
         Q_PROPERTY(QVariantMap levels READ levels WRITE setLevels NOTIFY levelsChanged)
+        Q_PROPERTY(double mainLevel READ mainLevel WRITE setMainLevel NOTIFY mainLevelChanged)
+        Q_PROPERTY(bool muted READ isMuted WRITE setMuted NOTIFY mutedChanged)
 
 public:
     explicit AudioCue(QObject* parent = nullptr);
@@ -117,6 +121,15 @@ public:
     QJsonObject toJson() const override;
     bool fromJson(const QJsonObject& json) override;
 
+    qint64 memoryUsage() const override
+    {
+        return static_cast<qint64>(sizeof(AudioCue)) + baseHeapBytes() + POSITION_TIMER_BYTES
+            + StringPool::ownedBytes(filePath_) + StringPool::ownedBytes(audioFormat_)
+            + StringPool::ownedBytes(validationError_) + StringPool::ownedBytes(gangId_)
+            + StringPool::ownedBytes(engineCueId_)
+            + variantMapBytes(matrixRouting_) + variantMapBytes(levels_);
+    }
+
     // Validation
     bool isValid() const;
     QString getValidationError() const;
@@ -218,4 +231,5 @@ private:
     static constexpr double MIN_PLAYBACK_SPEED = 0.1;  // Minimum playback speed
     static constexpr double MAX_PLAYBACK_SPEED = 4.0;  // Maximum playback speed
     static constexpr int POSITION_UPDATE_INTERVAL = 50; // Position update interval (ms)
+    static constexpr qint64 POSITION_TIMER_BYTES = 240;  // QTimer object and private data (approximate)
 };
\ No newline at end of file
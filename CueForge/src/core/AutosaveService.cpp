@@ -0,0 +1,327 @@
+// src/core/AutosaveService.cpp - Background journaled workspace autosave
+#include "AutosaveService.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "CueManager.h"
+#include "Workspace.h"
+
+namespace {
+
+const QString GENERATION_KEY = QStringLiteral("autosaveGeneration");
+
+bool syncToDisk(QFile& file)
+{
+    if (!file.flush()) {
+        return false;
+    }
+#if defined(Q_OS_WIN)
+    return ::_commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+} // namespace
+
+AutosaveService::AutosaveService(CueManager* cueManager, QObject* parent)
+    : QObject(parent)
+    , cueManager_(cueManager)
+    , journalTimer_(new QTimer(this))
+    , enabled_(true)
+    , snapshotIntervalMs_(DEFAULT_SNAPSHOT_MINUTES * 60 * 1000)
+    , generation_(static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()))
+    , haveBase_(false)
+    , journalRecords_(0)
+    , stopping_(false)
+{
+    journalTimer_->setInterval(JOURNAL_INTERVAL_MS);
+    connect(journalTimer_, &QTimer::timeout, this, &AutosaveService::onJournalTimer);
+    journalTimer_->start();
+
+    worker_ = std::thread([this]() { workerLoop(); });
+}
+
+AutosaveService::~AutosaveService()
+{
+    journalTimer_->stop();
+
+    // Let queued writes land; losing the last journal record on a clean exit would be silly
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        stopping_ = true;
+    }
+    jobCondition_.notify_one();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+// Configuration
+
+void AutosaveService::setEnabled(bool enabled)
+{
+    if (enabled_ == enabled) {
+        return;
+    }
+
+    enabled_ = enabled;
+    if (enabled_) {
+        haveBase_ = false;      // Journal can't continue across a gap
+        journalTimer_->start();
+    }
+    else {
+        journalTimer_->stop();
+    }
+}
+
+void AutosaveService::setSnapshotIntervalMinutes(int minutes)
+{
+    snapshotIntervalMs_ = qBound(1, minutes, 60) * 60 * 1000;
+}
+
+void AutosaveService::reset(bool discardFiles)
+{
+    const QString workspaceKey = cueManager_ ? cueManager_->currentWorkspacePath() : QString();
+
+    if (discardFiles) {
+        WriteJob discard;
+        discard.kind = WriteJob::Kind::Discard;
+        discard.basePath = basePathFor(workspaceKey_);
+        discard.journalPath = journalPathFor(workspaceKey_);
+        enqueue(discard);
+
+        if (workspaceKey != workspaceKey_) {
+            discard.basePath = basePathFor(workspaceKey);
+            discard.journalPath = journalPathFor(workspaceKey);
+            enqueue(discard);
+        }
+    }
+
+    workspaceKey_ = workspaceKey;
+    haveBase_ = false;
+    journalRecords_ = 0;
+
+    if (cueManager_) {
+        cueManager_->takeDirtyCueIds(nullptr);
+    }
+}
+
+// Recovery
+
+QString AutosaveService::basePathFor(const QString& workspacePath)
+{
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/autosave";
+    const QString name = workspacePath.isEmpty() ? QStringLiteral("Untitled") : QFileInfo(workspacePath).completeBaseName();
+    const QByteArray hash = QCryptographicHash::hash(QFileInfo(workspacePath).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex().left(8);
+
+    return QString("%1/%2-%3.autosave.cfws").arg(directory, name, QString::fromLatin1(hash));
+}
+
+QString AutosaveService::journalPathFor(const QString& workspacePath)
+{
+    return basePathFor(workspacePath) + ".journal";
+}
+
+bool AutosaveService::hasRecoveryData(const QString& workspacePath)
+{
+    return QFile::exists(basePathFor(workspacePath));
+}
+
+bool AutosaveService::recover(const QString& workspacePath)
+{
+    Workspace::Contents contents;
+    return readRecovery(workspacePath, contents) && cueManager_
+        && cueManager_->restoreWorkspace(contents, workspacePath);
+}
+
+bool AutosaveService::readRecovery(const QString& workspacePath, Workspace::Contents& contents)
+{
+    QFile baseFile(basePathFor(workspacePath));
+    if (!baseFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "No autosave to recover for" << workspacePath;
+        return false;
+    }
+
+    QString error;
+    if (!Workspace::decodeBinary(baseFile.readAll(), contents, &error)) {
+        qWarning() << "Autosave base is unreadable:" << error;
+        return false;
+    }
+
+    const quint64 generation = static_cast<quint64>(contents.settings.value(GENERATION_KEY).toInteger());
+    contents.settings.remove(GENERATION_KEY);
+
+    int replayed = 0;
+    QFile journalFile(journalPathFor(workspacePath));
+    if (journalFile.open(QIODevice::ReadOnly)) {
+        replayed = Workspace::applyJournal(journalFile.readAll(), generation, contents);
+    }
+
+    qDebug() << "Recovering" << contents.cues.size() << "cues from autosave," << replayed << "journal records replayed";
+    return true;
+}
+
+// Main Thread
+
+void AutosaveService::onJournalTimer()
+{
+    if (!enabled_ || !cueManager_ || !cueManager_->hasUnsavedChanges()) {
+        return;
+    }
+
+    bool structureChanged = false;
+    QList<Workspace::ListEdit> edits;
+    const QSet<QString> dirtyIds = cueManager_->takeDirtyCueIds(&structureChanged, &edits);
+    if (dirtyIds.isEmpty() && edits.isEmpty() && !structureChanged && haveBase_) {
+        return;
+    }
+
+    const bool baseDue = !haveBase_ || structureChanged
+        || journalRecords_ >= MAX_JOURNAL_RECORDS
+        || journalBytes_.load(std::memory_order_relaxed) >= MAX_JOURNAL_BYTES
+        || baseAge_.elapsed() >= snapshotIntervalMs_;
+    if (baseDue) {
+        writeBaseSnapshot();
+        return;
+    }
+
+    bool complete = true;
+    QList<QPair<int, Workspace::CueSummary>> cues = cueManager_->snapshotCues(dirtyIds, &complete);
+    if (!complete) {
+        writeBaseSnapshot();    // Group children aren't addressable by a top-level position
+        return;
+    }
+
+    WriteJob job;
+    job.kind = WriteJob::Kind::Journal;
+    job.basePath = basePathFor(workspaceKey_);
+    job.journalPath = journalPathFor(workspaceKey_);
+    job.generation = generation_;
+    job.edits = std::move(edits);
+    job.cues = std::move(cues);
+
+    ++journalRecords_;
+    enqueue(std::move(job));
+}
+
+void AutosaveService::writeBaseSnapshot()
+{
+    ++generation_;
+
+    WriteJob job;
+    job.kind = WriteJob::Kind::Base;
+    job.basePath = basePathFor(workspaceKey_);
+    job.journalPath = journalPathFor(workspaceKey_);
+    job.generation = generation_;
+    job.contents = cueManager_->snapshotWorkspace();
+
+    haveBase_ = true;
+    journalRecords_ = 0;
+    baseAge_.restart();
+    enqueue(std::move(job));
+}
+
+void AutosaveService::enqueue(WriteJob job)
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobs_.push_back(std::move(job));
+    }
+    jobCondition_.notify_one();
+}
+
+// Worker Thread
+
+void AutosaveService::workerLoop()
+{
+    for (;;) {
+        WriteJob job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobCondition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) {
+                return;     // Stopping and drained
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        QString error;
+        if (performJob(job, error)) {
+            if (job.kind != WriteJob::Kind::Discard) {
+                emit autosaved();
+            }
+        }
+        else {
+            failedWrites_.fetch_add(1, std::memory_order_relaxed);
+            qWarning() << "Autosave failed:" << error;
+            emit autosaveFailed(error);
+        }
+    }
+}
+
+bool AutosaveService::performJob(const WriteJob& job, QString& error)
+{
+    switch (job.kind) {
+    case WriteJob::Kind::Discard:
+        QFile::remove(job.journalPath);
+        QFile::remove(job.basePath);
+        journalBytes_.store(0, std::memory_order_relaxed);
+        return true;
+
+    case WriteJob::Kind::Base: {
+        QDir().mkpath(QFileInfo(job.basePath).absolutePath());
+
+        Workspace::Contents contents = job.contents;
+        contents.settings[GENERATION_KEY] = static_cast<qint64>(job.generation);
+        const QByteArray data = Workspace::encodeBinary(contents);
+
+        // QSaveFile writes a temporary, fsyncs it and renames over the old base
+        QSaveFile base(job.basePath);
+        if (!base.open(QIODevice::WriteOnly) || base.write(data) != data.size() || !base.commit()) {
+            error = base.errorString();
+            return false;
+        }
+
+        // Records of the previous generation are now obsolete
+        journalBytes_.store(0, std::memory_order_relaxed);
+        QFile journal(job.journalPath);
+        if (!journal.open(QIODevice::WriteOnly | QIODevice::Truncate) || !syncToDisk(journal)) {
+            error = journal.errorString();
+            return false;
+        }
+        return true;
+    }
+
+    case WriteJob::Kind::Journal: {
+        const QByteArray data = Workspace::encodeJournalRecord(job.generation, job.edits, job.cues);
+        journalBytes_.fetch_add(data.size(), std::memory_order_relaxed);
+
+        QFile journal(job.journalPath);
+        if (!journal.open(QIODevice::WriteOnly | QIODevice::Append)
+            || journal.write(data) != data.size()
+            || !syncToDisk(journal)) {
+            error = journal.errorString();
+            return false;
+        }
+        return true;
+    }
+    }
+
+    return false;
+}
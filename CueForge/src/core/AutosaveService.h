@@ -0,0 +1,126 @@
+// src/core/AutosaveService.h - Background journaled workspace autosave
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QString>
+#include <QTimer>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Workspace.h"
+
+class CueManager;
+
+/**
+ * @brief Crash-safe autosave that never serializes a whole workspace on the GUI thread per edit
+ *
+ * Every JOURNAL_INTERVAL_MS the main thread takes the cues CueManager marked
+ * dirty, and the top-level inserts, removes and moves it recorded, and
+ * snapshots only those cues (O(changed)). The plain summaries go to a worker
+ * thread, which encodes the journal record, appends it and fsyncs it. Other
+ * structural edits (grouping, resequencing, a new workspace), a journal over
+ * budget or an old base trigger a full base snapshot; the worker encodes it
+ * and writes it through a temporary file plus rename, and the journal is then
+ * restarted against the new base generation.
+ *
+ * The base file is itself a binary workspace, so recovery is
+ * "open the base, replay the journal".
+ */
+class AutosaveService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AutosaveService(CueManager* cueManager, QObject* parent = nullptr);
+    ~AutosaveService();
+
+    // Configuration
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+    void setSnapshotIntervalMinutes(int minutes);   // Maximum age of the base snapshot
+
+    /**
+     * @brief Forget the current autosave and start fresh for the current workspace
+     *
+     * Called after open/new/save: the real file is now the reference, so the
+     * autosave files for it are deleted. Recovery keeps them until the next
+     * base snapshot replaces them.
+     */
+    void reset(bool discardFiles = true);
+
+    // Recovery
+    static QString basePathFor(const QString& workspacePath);
+    static QString journalPathFor(const QString& workspacePath);
+    static bool hasRecoveryData(const QString& workspacePath);
+    bool recover(const QString& workspacePath);
+    static bool readRecovery(const QString& workspacePath, Workspace::Contents& contents);   // Any thread; restore on the main one
+
+    // Status
+    quint64 journalRecordCount() const { return journalRecords_; }
+    quint64 failedWriteCount() const { return failedWrites_.load(std::memory_order_relaxed); }
+
+signals:
+    void autosaved();                       // A journal record or base snapshot reached disk
+    void autosaveFailed(const QString& error);
+
+private slots:
+    void onJournalTimer();
+
+private:
+    struct WriteJob {
+        enum class Kind {
+            Base,       // Replace base atomically, then truncate the journal
+            Journal,    // Append and fsync
+            Discard     // Delete both files
+        };
+
+        Kind kind = Kind::Journal;
+        QString basePath;
+        QString journalPath;
+        quint64 generation = 0;
+
+        // Encoded by the worker: the main thread only takes the snapshot
+        Workspace::Contents contents;                           // Base
+        QList<Workspace::ListEdit> edits;                       // Journal
+        QList<QPair<int, Workspace::CueSummary>> cues;          // Journal
+    };
+
+    // Main thread
+    void writeBaseSnapshot();
+    void enqueue(WriteJob job);
+
+    // Worker thread
+    void workerLoop();
+    bool performJob(const WriteJob& job, QString& error);
+
+    CueManager* cueManager_;
+    QTimer* journalTimer_;
+    bool enabled_;
+    int snapshotIntervalMs_;
+
+    // Main-thread bookkeeping
+    QString workspaceKey_;                  // Workspace the autosave files belong to
+    quint64 generation_;                    // Base snapshot generation journal records refer to
+    bool haveBase_;
+    quint64 journalRecords_;
+    QElapsedTimer baseAge_;
+
+    // Worker
+    std::thread worker_;
+    std::mutex jobMutex_;
+    std::condition_variable jobCondition_;
+    std::deque<WriteJob> jobs_;
+    bool stopping_;
+    std::atomic<qint64> journalBytes_{ 0 };     // Appended since the last base; counted by the worker
+    std::atomic<quint64> failedWrites_{ 0 };
+
+    // Constants
+    static constexpr int JOURNAL_INTERVAL_MS = 2000;                // Worst-case edit loss after a crash
+    static constexpr int DEFAULT_SNAPSHOT_MINUTES = 5;
+    static constexpr int MAX_JOURNAL_RECORDS = 256;
+    static constexpr qint64 MAX_JOURNAL_BYTES = 4 * 1024 * 1024;
+};
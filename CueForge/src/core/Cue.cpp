@@ -5,6 +5,23 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QUuid>
+#include <QCborValue>
+#include <QCborMap>
+#include <QSignalBlocker>
+#include <utility>
+
+#include "CueTimerService.h"
+#include "StringPool.h"
+
+namespace {
+
+qint64 fromIsoDate(const QString& text)
+{
+    const QDateTime time = QDateTime::fromString(text, Qt::ISODate);
+    return time.isValid() ? time.toMSecsSinceEpoch() : 0;
+}
+
+} // namespace
 
 // Initialize static type string mapping
 QHash<CueType, QString> Cue::typeStringMap_;
@@ -13,24 +30,22 @@ Cue::Cue(CueType type, QObject* parent)
     : QObject(parent)
     , id_(QUuid::createUuid().toString(QUuid::WithoutBraces))
     , type_(type)
-    , number_("1")
-    , name_("Untitled Cue")
+    , number_(QStringLiteral("1"))
+    , name_(QStringLiteral("Untitled Cue"))
     , status_(CueStatus::Loaded)
     , armed_(false)
     , flagged_(false)
     , continueMode_(false)
     , color_(Qt::white)
-    , notes_()
     , duration_(5.0)
     , preWait_(0.0)
     , postWait_(0.0)
     , currentPosition_(0.0)
-    , targetId_()
-    , createdTime_(QDateTime::currentDateTime())
-    , modifiedTime_(QDateTime::currentDateTime())
-    , lastExecutedTime_()
-    , preWaitTimer_(new QTimer(this))
-    , postWaitTimer_(new QTimer(this))
+    , createdMs_(QDateTime::currentMSecsSinceEpoch())
+    , modifiedMs_(createdMs_)
+    , lastExecutedMs_(0)
+    , extras_()
+    , deferredDetails_()
     , inPreWait_(false)
     , inPostWait_(false)
 {
@@ -38,13 +53,15 @@ Cue::Cue(CueType type, QObject* parent)
     if (typeStringMap_.isEmpty()) {
         initializeTypeStringMap();
     }
+}
 
-    // Setup timing
-    preWaitTimer_->setSingleShot(true);
-    postWaitTimer_->setSingleShot(true);
-
-    connect(preWaitTimer_, &QTimer::timeout, this, &Cue::onPreWaitFinished);
-    connect(postWaitTimer_, &QTimer::timeout, this, &Cue::onPostWaitFinished);
+Cue::~Cue()
+{
+    if (inPreWait_ || inPostWait_) {
+        if (CueTimerService* timers = CueTimerService::instance()) {
+            timers->cancel(this);
+        }
+    }
 }
 
 // Property Setters
@@ -62,7 +79,7 @@ void Cue::setNumber(const QString& number)
 void Cue::setName(const QString& name)
 {
     if (name_ != name) {
-        name_ = name;
+        name_ = StringPool::instance().intern(name);     // Names repeat a lot across big lists
         markModified();
         emit nameChanged();
         emit cueUpdated();
@@ -125,8 +142,9 @@ void Cue::setColor(const QColor& color)
 
 void Cue::setNotes(const QString& notes)
 {
-    if (notes_ != notes) {
-        notes_ = notes;
+    hydrate();
+    if (this->notes() != notes) {
+        extras().notes = notes;
         markModified();
         emit notesChanged();
         emit cueUpdated();
@@ -165,8 +183,8 @@ void Cue::setPostWait(double postWait)
 
 void Cue::setTargetId(const QString& targetId)
 {
-    if (targetId_ != targetId) {
-        targetId_ = targetId;
+    if (this->targetId() != targetId) {
+        extras().targetId = StringPool::instance().intern(targetId);    // Many cues can target one
         markModified();
         emit targetChanged();
         emit cueUpdated();
@@ -177,19 +195,29 @@ void Cue::setTargetId(const QString& targetId)
 
 QVariant Cue::getCustomProperty(const QString& key, const QVariant& defaultValue) const
 {
-    return customProperties_.value(key, defaultValue);
+    hydrate();
+    return extras_ ? extras_->customProperties.value(key, defaultValue) : defaultValue;
 }
 
 void Cue::setCustomProperty(const QString& key, const QVariant& value)
 {
-    if (customProperties_.value(key) != value) {
-        customProperties_[key] = value;
+    hydrate();
+    if (getCustomProperty(key) != value) {
+        extras().customProperties[StringPool::instance().intern(key)] = value;
         markModified();
         emit customPropertyChanged(key, value);
         emit cueUpdated();
     }
 }
 
+Cue::Extras& Cue::extras()
+{
+    if (!extras_) {
+        extras_ = std::make_unique<Extras>();
+    }
+    return *extras_;
+}
+
 // Display Helpers
 
 QString Cue::displayName() const
@@ -267,6 +295,8 @@ bool Cue::canExecute() const
 
 void Cue::trigger()
 {
+    hydrate();
+
     if (!canExecute()) {
         qWarning() << "Cannot execute cue" << number_ << "- status is" << statusString();
         return;
@@ -302,11 +332,10 @@ void Cue::reset()
     setStatus(CueStatus::Loaded);
     setCurrentPosition(0.0);
 
-    if (preWaitTimer_->isActive()) {
-        preWaitTimer_->stop();
-    }
-    if (postWaitTimer_->isActive()) {
-        postWaitTimer_->stop();
+    if (inPreWait_ || inPostWait_) {
+        if (CueTimerService* timers = CueTimerService::instance()) {
+            timers->cancel(this);
+        }
     }
 
     inPreWait_ = false;
@@ -324,6 +353,8 @@ void Cue::setProgress(double progress)
 
 QJsonObject Cue::toJson() const
 {
+    hydrate();
+
     QJsonObject json;
 
     // Core properties
@@ -340,7 +371,7 @@ QJsonObject Cue::toJson() const
 
     // Visual properties
     json["color"] = color_.name();
-    json["notes"] = notes_;
+    json["notes"] = notes();
 
     // Timing properties
     json["duration"] = duration_;
@@ -348,21 +379,22 @@ QJsonObject Cue::toJson() const
     json["postWait"] = postWait_;
 
     // Target system
-    if (!targetId_.isEmpty()) {
-        json["targetId"] = targetId_;
+    if (!targetId().isEmpty()) {
+        json["targetId"] = targetId();
     }
 
     // Timestamps
-    json["createdTime"] = createdTime_.toString(Qt::ISODate);
-    json["modifiedTime"] = modifiedTime_.toString(Qt::ISODate);
-    if (lastExecutedTime_.isValid()) {
-        json["lastExecutedTime"] = lastExecutedTime_.toString(Qt::ISODate);
+    json["createdTime"] = toDateTime(createdMs_).toString(Qt::ISODate);
+    json["modifiedTime"] = toDateTime(modifiedMs_).toString(Qt::ISODate);
+    if (lastExecutedMs_ > 0) {
+        json["lastExecutedTime"] = toDateTime(lastExecutedMs_).toString(Qt::ISODate);
     }
 
     // Custom properties
-    if (!customProperties_.isEmpty()) {
+    if (extras_ && !extras_->customProperties.isEmpty()) {
+        const QVariantMap& customProperties = extras_->customProperties;
         QJsonObject customProps;
-        for (auto it = customProperties_.constBegin(); it != customProperties_.constEnd(); ++it) {
+        for (auto it = customProperties.constBegin(); it != customProperties.constEnd(); ++it) {
             customProps[it.key()] = QJsonValue::fromVariant(it.value());
         }
         json["customProperties"] = customProps;
@@ -422,21 +454,24 @@ bool Cue::fromJson(const QJsonObject& json)
 
         // Timestamps
         if (json.contains("createdTime")) {
-            createdTime_ = QDateTime::fromString(json["createdTime"].toString(), Qt::ISODate);
+            createdMs_ = fromIsoDate(json["createdTime"].toString());
         }
         if (json.contains("modifiedTime")) {
-            modifiedTime_ = QDateTime::fromString(json["modifiedTime"].toString(), Qt::ISODate);
+            modifiedMs_ = fromIsoDate(json["modifiedTime"].toString());
         }
         if (json.contains("lastExecutedTime")) {
-            lastExecutedTime_ = QDateTime::fromString(json["lastExecutedTime"].toString(), Qt::ISODate);
+            lastExecutedMs_ = fromIsoDate(json["lastExecutedTime"].toString());
         }
 
         // Custom properties
         if (json.contains("customProperties")) {
-            QJsonObject customProps = json["customProperties"].toObject();
-            customProperties_.clear();
-            for (auto it = customProps.constBegin(); it != customProps.constEnd(); ++it) {
-                customProperties_[it.key()] = it.value().toVariant();
+            const QJsonObject customProps = json["customProperties"].toObject();
+            if (!customProps.isEmpty() || extras_) {
+                QVariantMap& customProperties = extras().customProperties;
+                customProperties.clear();
+                for (auto it = customProps.constBegin(); it != customProps.constEnd(); ++it) {
+                    customProperties[StringPool::instance().intern(it.key())] = it.value().toVariant();
+                }
             }
         }
 
@@ -448,11 +483,75 @@ bool Cue::fromJson(const QJsonObject& json)
     }
 }
 
+void Cue::hydrate() const
+{
+    if (deferredDetails_.isEmpty()) {
+        return;
+    }
+
+    // Logically const: the cue's observable state doesn't change, it just becomes loaded
+    Cue* self = const_cast<Cue*>(this);
+    const QByteArray details = std::exchange(self->deferredDetails_, QByteArray());
+
+    QCborParserError error;
+    const QCborValue value = QCborValue::fromCbor(details, &error);
+    if (error.error != QCborError::NoError || !value.isMap()) {
+        qWarning() << "Failed to hydrate cue" << number_ << "-" << error.errorString();
+        return;
+    }
+
+    {
+        // Loading isn't an edit: keep setters from marking the workspace modified
+        const QSignalBlocker blocker(self);
+        self->fromJson(value.toMap().toJsonObject());
+    }
+
+    emit self->detailsHydrated();
+}
+
+// Memory Accounting
+
+qint64 Cue::memoryUsage() const
+{
+    return static_cast<qint64>(sizeof(Cue)) + baseHeapBytes();
+}
+
+qint64 Cue::baseHeapBytes() const
+{
+    qint64 bytes = QOBJECT_OVERHEAD_BYTES;
+    bytes += StringPool::ownedBytes(number_) + StringPool::ownedBytes(name_);
+    bytes += deferredDetails_.isDetached() ? deferredDetails_.capacity() : 0;
+
+    if (extras_) {
+        bytes += static_cast<qint64>(sizeof(Extras));
+        bytes += StringPool::ownedBytes(extras_->notes) + StringPool::ownedBytes(extras_->targetId);
+        bytes += variantMapBytes(extras_->customProperties);
+    }
+
+    // A pending wait holds one entry in the shared timer service
+    if (inPreWait_ || inPostWait_) {
+        bytes += MAP_NODE_BYTES;
+    }
+    return bytes;
+}
+
+qint64 Cue::variantMapBytes(const QVariantMap& map)
+{
+    qint64 bytes = 0;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        bytes += MAP_NODE_BYTES + StringPool::ownedBytes(it.key());
+        if (it.value().typeId() == QMetaType::QString) {
+            bytes += it.value().toString().size() * static_cast<qint64>(sizeof(QChar));
+        }
+    }
+    return bytes;
+}
+
 // Protected Implementation
 
 void Cue::markModified()
 {
-    modifiedTime_ = QDateTime::currentDateTime();
+    modifiedMs_ = QDateTime::currentMSecsSinceEpoch();
 }
 
 void Cue::setCurrentPosition(double position)
@@ -471,9 +570,15 @@ void Cue::executePreWait()
         return;
     }
 
+    CueTimerService* timers = CueTimerService::instance();
+    if (!timers) {
+        execute();
+        return;
+    }
+
     inPreWait_ = true;
     setStatus(CueStatus::Loading);
-    preWaitTimer_->start(static_cast<int>(preWait_ * 1000));
+    timers->schedule(this, static_cast<int>(preWait_ * 1000), [this]() { onPreWaitFinished(); });
 
     qDebug() << "Cue" << number_ << "starting pre-wait of" << preWait_ << "seconds";
 }
@@ -485,15 +590,21 @@ void Cue::executePostWait()
         return;
     }
 
+    CueTimerService* timers = CueTimerService::instance();
+    if (!timers) {
+        cleanupExecution();
+        return;
+    }
+
     inPostWait_ = true;
-    postWaitTimer_->start(static_cast<int>(postWait_ * 1000));
+    timers->schedule(this, static_cast<int>(postWait_ * 1000), [this]() { onPostWaitFinished(); });
 
     qDebug() << "Cue" << number_ << "starting post-wait of" << postWait_ << "seconds";
 }
 
 void Cue::cleanupExecution()
 {
-    lastExecutedTime_ = QDateTime::currentDateTime();
+    lastExecutedMs_ = QDateTime::currentMSecsSinceEpoch();
     setCurrentPosition(1.0);
     setStatus(CueStatus::Stopped);
 
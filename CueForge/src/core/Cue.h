@@ -7,8 +7,9 @@
 #include <QDateTime>
 #include <QVariantMap>
 #include <QJsonObject>
+#include <QByteArray>
 #include <QColor>
-#include <QTimer>
+#include <memory>
 
 /**
  * @brief Enumeration of all supported cue types in CueForge
@@ -50,6 +51,13 @@ enum class CueStatus {
  *
  * This class provides the common interface and properties that all cue types share.
  * It closely mirrors the JavaScript cue structure from the original Electron version.
+ *
+ * Every cue in a workspace is one of these QObjects, idle or not. Large
+ * workspaces stay lean through what is inside it: waits run on the shared
+ * CueTimerService, names, targets and property keys are interned in
+ * StringPool, rarely set fields live in an extras block allocated on first
+ * use, and loaded details stay encoded until hydrate(). memoryUsage()
+ * estimates the result.
  */
 class Cue : public QObject
 {
@@ -72,7 +80,7 @@ class Cue : public QObject
 
 public:
     explicit Cue(CueType type, QObject* parent = nullptr);
-    virtual ~Cue() = default;
+    virtual ~Cue();
 
     // Core identification properties
     QString id() const { return id_; }
@@ -88,7 +96,7 @@ public:
 
     // Visual properties
     QColor color() const { return color_; }
-    QString notes() const { return notes_; }
+    QString notes() const { hydrate(); return extras_ ? extras_->notes : QString(); }
 
     // Timing properties
     double duration() const { return duration_; }
@@ -96,26 +104,46 @@ public:
     double postWait() const { return postWait_; }
 
     // Execution state tracking
-    QDateTime createdTime() const { return createdTime_; }
-    QDateTime modifiedTime() const { return modifiedTime_; }
-    QDateTime lastExecutedTime() const { return lastExecutedTime_; }
+    QDateTime createdTime() const { hydrate(); return toDateTime(createdMs_); }
+    QDateTime modifiedTime() const { hydrate(); return toDateTime(modifiedMs_); }
+    QDateTime lastExecutedTime() const { hydrate(); return toDateTime(lastExecutedMs_); }
     double currentPosition() const { return currentPosition_; }
     bool isExecuting() const { return status_ == CueStatus::Playing || status_ == CueStatus::Loading; }
     bool canExecute() const;
 
     // Target system (for control cues)
-    QString targetId() const { return targetId_; }
+    QString targetId() const { return extras_ ? extras_->targetId : QString(); }
     void setTargetId(const QString& targetId);
 
     // Custom properties system (extensible like JS version)
     QVariant getCustomProperty(const QString& key, const QVariant& defaultValue = QVariant()) const;
     void setCustomProperty(const QString& key, const QVariant& value);
-    QVariantMap getAllCustomProperties() const { return customProperties_; }
+    QVariantMap getAllCustomProperties() const { hydrate(); return extras_ ? extras_->customProperties : QVariantMap(); }
 
     // Serialization (matching JS workspace format)
     virtual QJsonObject toJson() const;
     virtual bool fromJson(const QJsonObject& json);
 
+    /**
+     * @brief Lazy detail hydration for binary workspaces
+     *
+     * Binary workspaces only apply the list-visible summary fields at load
+     * time; everything else stays as an encoded detail chunk that is parsed
+     * through fromJson() the first time the cue is accessed in depth.
+     */
+    bool isHydrated() const { return deferredDetails_.isEmpty(); }
+    void setDeferredDetails(const QByteArray& details) { deferredDetails_ = details; }
+    QByteArray deferredDetails() const { return deferredDetails_; }
+    void hydrate() const;
+
+    /**
+     * @brief Approximate bytes this cue occupies, object and owned heap
+     *
+     * Strings shared with other cues (interned names, paths) are charged to
+     * the string pool, not to each cue. Subclasses add their own members.
+     */
+    virtual qint64 memoryUsage() const;
+
     // Display helpers
     QString displayName() const;
     QString statusString() const;
@@ -183,6 +211,7 @@ signals:
 
     // General state signals
     void cueUpdated();      // Emitted when any property changes
+    void detailsHydrated(); // Deferred details were parsed (signals were blocked meanwhile)
 
 protected:
     /**
@@ -220,7 +249,30 @@ private slots:
     void onPreWaitFinished();
     void onPostWaitFinished();
 
+    /**
+     * @brief Bytes of the base class members beyond sizeof(Cue), for subclass memoryUsage()
+     */
+    qint64 baseHeapBytes() const;
+
+    static qint64 variantMapBytes(const QVariantMap& map);
+
 private:
+    /**
+     * @brief Rarely set fields, allocated on first use
+     *
+     * Most cues in a big list have no notes, target or custom properties;
+     * they pay one null pointer instead of three empty members.
+     */
+    struct Extras {
+        QString notes;                  // User notes
+        QString targetId;               // Target cue ID for control cues
+        QVariantMap customProperties;   // Extensible like the JS version
+    };
+
+    Extras& extras();
+
+    static QDateTime toDateTime(qint64 ms) { return ms > 0 ? QDateTime::fromMSecsSinceEpoch(ms) : QDateTime(); }
+
     // Core properties
     const QString id_;              // Unique identifier (UUID)
     const CueType type_;            // Cue type (immutable)
@@ -235,7 +287,6 @@ private:
 
     // Visual properties
     QColor color_;                  // Display color
-    QString notes_;                 // User notes
 
     // Timing properties
     double duration_;               // Expected duration in seconds
@@ -243,24 +294,26 @@ private:
     double postWait_;               // Post-execution wait in seconds
     double currentPosition_;        // Current position (0.0 to 1.0)
 
-    // Target system
-    QString targetId_;              // Target cue ID for control cues
+    // Timestamps (ms since epoch, 0 = never): far cheaper to stamp than QDateTime
+    qint64 createdMs_;
+    qint64 modifiedMs_;
+    qint64 lastExecutedMs_;
 
-    // Timestamps
-    QDateTime createdTime_;
-    QDateTime modifiedTime_;
-    QDateTime lastExecutedTime_;
+    // Notes, target and custom properties (null until one is set)
+    std::unique_ptr<Extras> extras_;
 
-    // Custom properties (extensible)
-    QVariantMap customProperties_;
+    // Encoded detail chunk awaiting hydration (empty once hydrated)
+    QByteArray deferredDetails_;
 
-    // Execution timing
-    QTimer* preWaitTimer_;
-    QTimer* postWaitTimer_;
+    // Execution timing (waits run on the shared CueTimerService)
     bool inPreWait_;
     bool inPostWait_;
 
     // Static helpers
     static QHash<CueType, QString> typeStringMap_;
     static void initializeTypeStringMap();
+
+    // Constants
+    static constexpr qint64 QOBJECT_OVERHEAD_BYTES = 200;   // QObjectPrivate plus the manager's three connections
+    static constexpr qint64 MAP_NODE_BYTES = 64;            // Per QVariantMap entry, excluding key text
 };
\ No newline at end of file
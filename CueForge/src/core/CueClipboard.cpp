@@ -0,0 +1,150 @@
+// src/core/CueClipboard.cpp - In-process cue clipboard with lazily generated JSON
+#include "CueClipboard.h"
+
+#include <QClipboard>
+#include <QDebug>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// System Clipboard Payload
+
+/**
+ * @brief Clipboard contents that serialize themselves on first read
+ *
+ * Holds its own copy of the entries (shared bytes, no deep copy), so a later
+ * copy in this process can't change what another application pastes.
+ */
+class CueClipboard::MimeData : public QMimeData
+{
+public:
+    MimeData(const QList<Workspace::CueSummary>& entries, quint64 generation)
+        : QMimeData()
+        , entries_(entries)
+        , generation_(generation)
+    {
+    }
+
+    quint64 generation() const { return generation_; }
+
+    QStringList formats() const override
+    {
+        return QStringList() << QString::fromLatin1(MIME_TYPE) << QStringLiteral("text/plain");
+    }
+
+    bool hasFormat(const QString& mimeType) const override
+    {
+        return formats().contains(mimeType);
+    }
+
+protected:
+    QVariant retrieveData(const QString& mimeType, QMetaType type) const override
+    {
+        Q_UNUSED(type);
+        if (!hasFormat(mimeType)) {
+            return QVariant();
+        }
+
+        if (json_.isEmpty()) {
+            QJsonArray array;
+            for (const Workspace::CueSummary& entry : entries_) {
+                array.append(Workspace::summaryToJson(entry));
+            }
+            json_ = QJsonDocument(array).toJson(QJsonDocument::Compact);
+        }
+
+        if (mimeType == QLatin1String("text/plain")) {
+            return QString::fromUtf8(json_);
+        }
+        return json_;
+    }
+
+private:
+    QList<Workspace::CueSummary> entries_;
+    quint64 generation_;
+    mutable QByteArray json_;
+};
+
+// Entries
+
+void CueClipboard::setEntries(const QList<Workspace::CueSummary>& entries)
+{
+    entries_ = entries;
+    json_ = QJsonArray();
+    ++generation_;
+}
+
+void CueClipboard::clear()
+{
+    // The system clipboard is left alone: other applications may still want it
+    entries_.clear();
+    json_ = QJsonArray();
+    ++generation_;
+}
+
+QJsonArray CueClipboard::toJson() const
+{
+    if (json_.isEmpty()) {
+        for (const Workspace::CueSummary& entry : entries_) {
+            json_.append(Workspace::summaryToJson(entry));
+        }
+    }
+    return json_;
+}
+
+// System Clipboard
+
+void CueClipboard::publish()
+{
+    if (!qobject_cast<QGuiApplication*>(QCoreApplication::instance())) {
+        return;
+    }
+
+    // The clipboard takes ownership of the payload
+    QGuiApplication::clipboard()->setMimeData(new MimeData(entries_, generation_));
+}
+
+bool CueClipboard::ownsSystemClipboard() const
+{
+    if (entries_.isEmpty() || !qobject_cast<QGuiApplication*>(QCoreApplication::instance())) {
+        return false;
+    }
+
+    const auto* ours = dynamic_cast<const MimeData*>(QGuiApplication::clipboard()->mimeData());
+    return ours && ours->generation() == generation_;
+}
+
+bool CueClipboard::hasSystemClipboardCues()
+{
+    if (!qobject_cast<QGuiApplication*>(QCoreApplication::instance())) {
+        return false;
+    }
+
+    const QMimeData* mimeData = QGuiApplication::clipboard()->mimeData();
+    return mimeData && mimeData->hasFormat(QString::fromLatin1(MIME_TYPE));
+}
+
+bool CueClipboard::readSystemClipboard(QList<Workspace::CueSummary>& entries)
+{
+    entries.clear();
+    if (!hasSystemClipboardCues()) {
+        return false;
+    }
+
+    const QByteArray data = QGuiApplication::clipboard()->mimeData()->data(QString::fromLatin1(MIME_TYPE));
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(data, &error);
+    if (error.error != QJsonParseError::NoError || !document.isArray()) {
+        qWarning() << "Ignoring malformed cue clipboard data:" << error.errorString();
+        return false;
+    }
+
+    const QJsonArray array = document.array();
+    entries.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        if (value.isObject()) {
+            entries.append(Workspace::summaryFromJson(value.toObject()));
+        }
+    }
+    return !entries.isEmpty();
+}
@@ -0,0 +1,64 @@
+// src/core/CueClipboard.h - In-process cue clipboard with lazily generated JSON
+#pragma once
+
+#include <QJsonArray>
+#include <QList>
+#include <QMimeData>
+#include <QString>
+#include <QStringList>
+
+#include "Workspace.h"
+
+/**
+ * @brief Cue copies held as workspace summaries
+ *
+ * A copy is a CueSummary per cue, so the strings and the encoded detail
+ * chunk are implicitly shared (copy-on-write) with the source cue and with
+ * every paste made from them; a cue that was never hydrated is copied
+ * without being parsed at all. Pasting applies the summary and leaves the
+ * details deferred, exactly like loading a binary workspace.
+ *
+ * JSON is only produced when another application asks the system clipboard
+ * for it, and is then cached until the next copy.
+ */
+class CueClipboard
+{
+public:
+    CueClipboard() = default;
+
+    void setEntries(const QList<Workspace::CueSummary>& entries);
+    QList<Workspace::CueSummary> entries() const { return entries_; }
+    bool isEmpty() const { return entries_.isEmpty(); }
+    int size() const { return entries_.size(); }
+    void clear();
+
+    QJsonArray toJson() const;      // Generated on first request, then cached
+
+    /**
+     * @brief Offer the entries on the system clipboard
+     *
+     * Ownership of the clipboard is taken immediately; the JSON payload is
+     * only built if something actually reads it. No-op without a GUI.
+     */
+    void publish();
+
+    // True while the system clipboard still holds what publish() put there
+    bool ownsSystemClipboard() const;
+
+    /**
+     * @brief Cues another process (or an earlier session) put on the system clipboard
+     * @return false if the clipboard holds no cues
+     */
+    static bool readSystemClipboard(QList<Workspace::CueSummary>& entries);
+    static bool hasSystemClipboardCues();
+
+    // Constants
+    static constexpr const char* MIME_TYPE = "application/x-cueforge-cues";
+
+private:
+    class MimeData;
+
+    QList<Workspace::CueSummary> entries_;
+    mutable QJsonArray json_;       // Cached toJson() result
+    quint64 generation_ = 0;        // Bumped per setEntries(); matches the published MimeData
+};
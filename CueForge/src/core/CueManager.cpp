@@ -8,13 +8,25 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <QSaveFile>
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QReadLocker>
 #include <QWriteLocker>
+#include <QSignalBlocker>
 #include <algorithm>
+#include <utility>
 
 #include "AudioCue.h"
 #include "GroupCue.h"
+#include "CueScheduler.h"
+#include "MediaPool.h"
+#include "Workspace.h"
+#include "AutosaveService.h"
+#include "UndoStack.h"
+#include "CueSearchIndex.h"
+#include "CueTimerService.h"
+#include "StringPool.h"
 // Additional cue types will be included as they're implemented
 
 CueManager::CueManager(QObject* parent)
@@ -25,11 +37,23 @@ CueManager::CueManager(QObject* parent)
     , hasUnsavedChanges_(false)
     , isPaused_(false)
     , executionTimer_(new QTimer(this))
+    , scheduler_(nullptr)
+    , mediaPool_(nullptr)
     , activeCues_()
     , groupExpansionState_()
-    , brokenCueCount_(0)
+    , parentGroupById_()
+    , visibleRows_()
+    , visibleRowById_()
+    , groupTreeValid_(false)
     , clipboard_()
-    , statsValid_(false)
+    , structureDirty_(false)
+    , autosave_(nullptr)
+    , undoStack_(nullptr)
+    , searchIndex_(nullptr)
+    , stats_()
+    , reportedBrokenCount_(0)
+    , statsBatchDepth_(0)
+    , mediaValidator_(nullptr)
 {
     // Setup execution timer for cue processing
     executionTimer_->setInterval(EXECUTION_TIMER_INTERVAL);
@@ -39,6 +63,36 @@ CueManager::CueManager(QObject* parent)
     // Start execution processing
     executionTimer_->start();
 
+    autosave_ = std::make_unique<AutosaveService>(this);
+    undoStack_ = std::make_unique<UndoStack>(this);
+    searchIndex_ = std::make_unique<CueSearchIndex>(this);
+    mediaValidator_ = std::make_unique<MediaValidator>();
+
+    // Media is probed in the background once a workspace is in place (queued: open returns first)
+    connect(mediaValidator_.get(), &MediaValidator::batchReady, this, &CueManager::onValidationBatch);
+    connect(mediaValidator_.get(), &MediaValidator::progress, this, &CueManager::validationProgress);
+    connect(mediaValidator_.get(), &MediaValidator::finished, this, &CueManager::validationFinished);
+    connect(this, &CueManager::workspaceOpened, this, &CueManager::validateAllCues, Qt::QueuedConnection);
+
+    // Keep the search index and statistics in step with the list; bulk edits (load,
+    // clear, grouping) don't announce every cue, so a count mismatch means rebuild
+    connect(this, &CueManager::cueAdded, this, [this](Cue* cue, int) {
+        searchIndex_->addCue(cue);
+        addToStats(cue);
+    });
+    connect(this, &CueManager::cueRemoved, this, [this](const QString& cueId, int) {
+        searchIndex_->removeCue(cueId);
+        removeFromStats(cueId);
+    });
+    connect(this, &CueManager::cueCountChanged, this, [this]() {
+        if (searchIndex_->indexedCueCount() != cues_.size()) {
+            searchIndex_->rebuild();
+        }
+        if (statsByCue_.size() != cues_.size()) {
+            rebuildStats();
+        }
+    });
+
     qDebug() << "CueManager initialized";
 }
 
@@ -85,7 +139,7 @@ QString CueManager::addCueAt(CueType type, int index, const QVariantMap& options
         cue->setNumber(options["number"].toString());
     }
     else {
-        cue->setNumber(getNextCueNumber());
+        cue->setNumber(computeNextCueNumber());
     }
 
     if (options.contains("name")) {
@@ -113,13 +167,15 @@ QString CueManager::addCueAt(CueType type, int index, const QVariantMap& options
     }
 
     // Insert at specified position
-    insertCueAt(cue, qBound(0, index, cues_.size()));
+    const int position = qBound(0, index, cues_.size());
+    insertCueAt(cue, position);
 
     // Connect signals
     connectCueSignals(cue);
 
     // Mark workspace as modified
-    markWorkspaceModified();
+    recordListEdit(Workspace::ListEdit::Kind::Insert, { position });
+    markWorkspaceModified(cue);
 
     QString cueId = cue->id();
     qDebug() << "Added cue" << cue->number() << "(" << cue->typeString() << ") at index" << index;
@@ -127,6 +183,10 @@ QString CueManager::addCueAt(CueType type, int index, const QVariantMap& options
     emit cueAdded(cue, index);
     emit cueCountChanged();
 
+    if (isRecordingUndo()) {
+        undoStack_->push(std::make_unique<CueListCommand>(CueListCommand::Kind::Insert, QStringList() << cueId));
+    }
+
     return cueId;
 }
 
@@ -136,73 +196,166 @@ bool CueManager::removeCue(const QString& cueId)
 }
 
 bool CueManager::removeCues(const QStringList& cueIds)
+{
+    const QList<QPair<int, Cue*>> removed = detachCues(cueIds);
+    if (removed.isEmpty()) {
+        return false;
+    }
+
+    if (isRecordingUndo()) {
+        // The command keeps the cues alive so undo restores the same objects
+        QStringList removedIds;
+        removedIds.reserve(removed.size());
+        for (const auto& entry : removed) {
+            removedIds.append(entry.second->id());
+        }
+        undoStack_->push(std::make_unique<CueListCommand>(CueListCommand::Kind::Remove, removedIds, removed));
+    }
+    else {
+        for (const auto& entry : removed) {
+            entry.second->deleteLater();
+        }
+    }
+
+    return true;
+}
+
+QList<QPair<int, Cue*>> CueManager::detachCues(const QStringList& cueIds)
 {
     QWriteLocker locker(&cueListLock_);
 
-    bool anyRemoved = false;
+    QList<QPair<int, Cue*>> detached;
 
-    // Remove in reverse order to maintain indices
+    QSet<QString> idsToRemove;
     for (const QString& cueId : cueIds) {
-        int index = findCueIndex(cueId);
-        if (index >= 0) {
-            Cue* cue = cues_[index];
+        if (cueById_.contains(cueId)) {
+            idsToRemove.insert(cueId);
+        }
+    }
 
-            // Stop cue if it's playing
-            if (cue->isExecuting()) {
-                cue->stop();
-            }
+    if (idsToRemove.isEmpty()) {
+        return detached;
+    }
 
-            // Remove from selection if selected
-            selectedCueIds_.removeAll(cueId);
+    // Single compaction pass so bulk deletes stay linear in the list size
+    QList<Cue*> remaining;
+    remaining.reserve(cues_.size() - idsToRemove.size());
+    detached.reserve(idsToRemove.size());
+    int firstRemovedIndex = -1;
 
-            // Clear standby if this cue is standby
-            if (standByCueId_ == cueId) {
-                standByCueId_.clear();
-            }
+    for (int i = 0; i < cues_.size(); ++i) {
+        Cue* cue = cues_[i];
+        const QString cueId = cue->id();
+
+        if (!idsToRemove.contains(cueId)) {
+            remaining.append(cue);
+            continue;
+        }
+
+        if (firstRemovedIndex < 0) {
+            firstRemovedIndex = i;
+        }
+
+        // Index as seen by listeners after the preceding removals
+        int index = remaining.size();
 
-            // Remove from active cues if present
-            activeCues_.removeAll(cue);
+        // Stop cue if it's playing
+        if (cue->isExecuting()) {
+            cue->stop();
+        }
+
+        // Clear standby if this cue is standby
+        if (standByCueId_ == cueId) {
+            standByCueId_.clear();
+        }
 
-            // Disconnect signals
-            disconnectCueSignals(cue);
+        // Remove from active cues if present
+        activeCues_.removeAll(cue);
 
-            // Remove from list
-            cues_.removeAt(index);
+        // Disconnect signals
+        disconnectCueSignals(cue);
 
-            qDebug() << "Removed cue" << cue->number() << "at index" << index;
+        // Drop from lookup index
+        cueById_.remove(cueId);
+        cueIndexById_.remove(cueId);
+        untrackCueNumber(cueId);
 
-            emit cueRemoved(cueId, index);
+        qDebug() << "Removed cue" << cue->number() << "at index" << index;
 
-            // Delete the cue
-            cue->deleteLater();
+        emit cueRemoved(cueId, index);
 
-            anyRemoved = true;
-        }
+        // Original position, for putting it back
+        detached.append(qMakePair(i, cue));
     }
 
-    if (anyRemoved) {
-        markWorkspaceModified();
-        updateStandByCue();
-        ensureValidSelection();
+    cues_.swap(remaining);
+    reindexCues(firstRemovedIndex);
+    invalidateGroupTree();
 
-        emit cueCountChanged();
-        emit selectionChanged();
-        emit playheadChanged();
+    // Standby/selection fix-ups take their own locks
+    locker.unlock();
+
+    QList<int> positions;
+    positions.reserve(detached.size());
+    for (const auto& entry : std::as_const(detached)) {
+        positions.append(entry.first);
+        dirtyCueIds_.remove(entry.second->id());     // Gone; nothing of theirs to journal
     }
+    recordListEdit(Workspace::ListEdit::Kind::Remove, positions);
+    updateStandByCue();
+    ensureValidSelection();
+
+    emit cueCountChanged();
+    emit selectionChanged();
+    emit playheadChanged();
 
-    return anyRemoved;
+    return detached;
 }
 
-Cue* CueManager::getCue(const QString& cueId) const
+void CueManager::restoreCues(const QList<QPair<int, Cue*>>& cues)
 {
-    QReadLocker locker(&cueListLock_);
+    if (cues.isEmpty()) {
+        return;
+    }
 
-    for (Cue* cue : cues_) {
-        if (cue->id() == cueId) {
-            return cue;
+    {
+        QWriteLocker locker(&cueListLock_);
+
+        // Ascending original positions: one splice puts every cue back where it was
+        insertCuesAt(cues);
+        for (const auto& entry : cues) {
+            connectCueSignals(entry.second);
         }
     }
-    return nullptr;
+
+    QList<int> positions;
+    positions.reserve(cues.size());
+    for (const auto& entry : cues) {
+        positions.append(entry.first);
+    }
+    recordListEdit(Workspace::ListEdit::Kind::Insert, positions);
+
+    for (const auto& entry : cues) {
+        markWorkspaceModified(entry.second);
+        emit cueAdded(entry.second, findCueIndex(entry.second->id()));
+    }
+    updateStandByCue();
+    emit cueCountChanged();
+}
+
+Cue* CueManager::getCue(const QString& cueId) const
+{
+    Cue* cue = nullptr;
+    {
+        QReadLocker locker(&cueListLock_);
+        cue = lookupCue(cueId);
+    }
+
+    // Callers asking by ID want the whole cue, so finish a lazy load here
+    if (cue) {
+        cue->hydrate();
+    }
+    return cue;
 }
 
 QList<Cue*> CueManager::getCuesOfType(CueType type) const
@@ -220,12 +373,61 @@ QList<Cue*> CueManager::getCuesOfType(CueType type) const
 
 int CueManager::findCueIndex(const QString& cueId) const
 {
-    for (int i = 0; i < cues_.size(); ++i) {
-        if (cues_[i]->id() == cueId) {
-            return i;
-        }
+    return cueIndexById_.value(cueId, -1);
+}
+
+bool CueManager::setCueProperty(const QString& cueId, const char* property, const QVariant& value)
+{
+    Cue* cue = getCue(cueId);
+    if (!cue) {
+        return false;
+    }
+
+    const QVariant before = cue->property(property);
+    if (!before.isValid()) {
+        qWarning() << "Cue" << cue->number() << "has no property" << property;
+        return false;
+    }
+    if (before == value) {
+        return true;
+    }
+
+    if (!cue->setProperty(property, value)) {
+        return false;
+    }
+
+    if (isRecordingUndo()) {
+        // Read back: setters clamp, and undo should restore what was really applied
+        undoStack_->push(std::make_unique<CuePropertyCommand>(cueId, QByteArray(property), before, cue->property(property)));
     }
-    return -1;
+    return true;
+}
+
+// Undo/Redo
+
+void CueManager::undo()
+{
+    undoStack_->undo();
+}
+
+void CueManager::redo()
+{
+    undoStack_->redo();
+}
+
+bool CueManager::canUndo() const
+{
+    return undoStack_->canUndo();
+}
+
+bool CueManager::canRedo() const
+{
+    return undoStack_->canRedo();
+}
+
+bool CueManager::isRecordingUndo() const
+{
+    return undoStack_ && !undoStack_->isApplying();
 }
 
 // Cue Organization
@@ -243,52 +445,78 @@ bool CueManager::moveCues(const QStringList& cueIds, int newIndex)
         return false;
     }
 
-    // Collect cues to move and their current indices
-    QList<QPair<Cue*, int>> cuesToMove;
+    // Collect cues to move via the index
+    QSet<QString> idsToMove;
+    int firstAffectedIndex = newIndex;
     for (const QString& cueId : cueIds) {
         int index = findCueIndex(cueId);
         if (index >= 0) {
-            cuesToMove.append(qMakePair(cues_[index], index));
+            idsToMove.insert(cueId);
+            firstAffectedIndex = qMin(firstAffectedIndex, index);
         }
     }
 
-    if (cuesToMove.isEmpty()) {
+    if (idsToMove.isEmpty()) {
         return false;
     }
 
-    // Sort by index (descending) to remove from back to front
-    std::sort(cuesToMove.begin(), cuesToMove.end(),
-        [](const QPair<Cue*, int>& a, const QPair<Cue*, int>& b) {
-            return a.second > b.second;
-        });
-
-    // Remove cues from their current positions
+    // Split the list in one pass, keeping the moved cues in list order
     QList<Cue*> movedCues;
-    for (const auto& pair : cuesToMove) {
-        cues_.removeAt(pair.second);
-        movedCues.prepend(pair.first); // Prepend to maintain order
-    }
+    QList<Cue*> remaining;
+    QList<QPair<int, QString>> originalPositions;
+    movedCues.reserve(idsToMove.size());
+    originalPositions.reserve(idsToMove.size());
+    remaining.reserve(cues_.size() - idsToMove.size());
 
-    // Adjust target index if cues were removed before it
+    // Adjust target index for cues removed before it
     int adjustedIndex = newIndex;
-    for (const auto& pair : cuesToMove) {
-        if (pair.second < newIndex) {
-            adjustedIndex--;
+    for (int i = 0; i < cues_.size(); ++i) {
+        Cue* cue = cues_[i];
+        if (idsToMove.contains(cue->id())) {
+            movedCues.append(cue);
+            originalPositions.append(qMakePair(i, cue->id()));
+            if (i < newIndex) {
+                adjustedIndex--;
+            }
+        }
+        else {
+            remaining.append(cue);
         }
     }
 
-    // Insert cues at new position
-    for (int i = 0; i < movedCues.size(); ++i) {
-        cues_.insert(adjustedIndex + i, movedCues[i]);
-    }
+    // Reassemble with the moved block at its new position
+    QList<Cue*> reordered;
+    reordered.reserve(cues_.size());
+    reordered.append(remaining.mid(0, adjustedIndex));
+    reordered.append(movedCues);
+    reordered.append(remaining.mid(adjustedIndex));
 
-    markWorkspaceModified();
+    cues_.swap(reordered);
+    reindexCues(firstAffectedIndex);
+    invalidateGroupTree();
+    locker.unlock();
+
+    QList<int> positions;
+    positions.reserve(originalPositions.size());
+    for (const auto& original : std::as_const(originalPositions)) {
+        positions.append(original.first);
+    }
+    recordListEdit(Workspace::ListEdit::Kind::Move, positions, adjustedIndex);
 
-    for (Cue* cue : movedCues) {
-        emit cueMoved(cue->id(), -1, adjustedIndex); // Old index not relevant for multiple moves
+    if (movedCues.size() == 1) {
+        emit cueMoved(movedCues.first()->id(), originalPositions.first().first, adjustedIndex);
     }
+    else {
+        for (Cue* cue : movedCues) {
+            emit cueMoved(cue->id(), -1, adjustedIndex); // Old index not relevant for multiple moves
+        }
+    }
+
+    qDebug() << "Moved" << movedCues.size() << "cues to index" << adjustedIndex;
 
-    qDebug() << "Moved" << cuesToMove.size() << "cues to index" << adjustedIndex;
+    if (isRecordingUndo()) {
+        undoStack_->push(std::make_unique<MoveCuesCommand>(originalPositions, newIndex));
+    }
 
     return true;
 }
@@ -302,38 +530,22 @@ bool CueManager::moveSelectedCues(int newIndex)
 QList<Cue*> CueManager::getFlattenedCues() const
 {
     QReadLocker locker(&cueListLock_);
+    QMutexLocker treeLocker(&groupTreeMutex_);
 
-    QList<Cue*> flattened;
-
-    for (Cue* cue : cues_) {
-        flattened.append(cue);
-
-        // Add group children if group is expanded
-        if (cue->type() == CueType::Group) {
-            GroupCue* group = qobject_cast<GroupCue*>(cue);
-            if (group && isGroupExpanded(group->id())) {
-                flattened.append(group->children());
-            }
-        }
-    }
-
-    return flattened;
+    ensureGroupTree();
+    return visibleRows_;
 }
 
 QString CueManager::getNextCueNumber() const
 {
     QReadLocker locker(&cueListLock_);
+    return computeNextCueNumber();
+}
 
-    // Find the highest numeric cue number
-    double highestNumber = 0.0;
-    for (Cue* cue : cues_) {
-        bool ok;
-        double number = cue->number().toDouble(&ok);
-        if (ok && number > highestNumber) {
-            highestNumber = number;
-        }
-    }
-
+QString CueManager::computeNextCueNumber() const
+{
+    // Highest numeric cue number; non-numeric and negative numbers don't count
+    const double highestNumber = cueNumberCounts_.isEmpty() ? 0.0 : qMax(0.0, cueNumberCounts_.lastKey());
     return QString::number(highestNumber + 1.0, 'f', 0);
 }
 
@@ -347,10 +559,28 @@ void CueManager::resequenceCues(const QString& startNumber, double increment)
         currentNumber = 1.0;
     }
 
+    // One compact entry for the whole renumber: IDs and the numbers they had
+    QStringList cueIds;
+    QStringList oldNumbers;
+    const bool recordUndo = isRecordingUndo();
+    if (recordUndo) {
+        cueIds.reserve(cues_.size());
+        oldNumbers.reserve(cues_.size());
+    }
+
     for (Cue* cue : cues_) {
+        if (recordUndo) {
+            cueIds.append(cue->id());
+            oldNumbers.append(cue->number());
+        }
         cue->setNumber(QString::number(currentNumber, 'f', 0));
         currentNumber += increment;
     }
+    locker.unlock();
+
+    if (recordUndo) {
+        undoStack_->push(std::make_unique<ResequenceCommand>(cueIds, oldNumbers, startNumber, increment));
+    }
 
     markWorkspaceModified();
     qDebug() << "Resequenced" << cues_.size() << "cues starting from" << startNumber;
@@ -368,14 +598,18 @@ void CueManager::selectCues(const QStringList& cueIds)
     QMutexLocker locker(&selectionMutex_);
 
     QStringList validCueIds;
-    for (const QString& cueId : cueIds) {
-        if (getCue(cueId)) {
-            validCueIds.append(cueId);
+    {
+        QReadLocker listLocker(&cueListLock_);
+        validCueIds.reserve(cueIds.size());
+        for (const QString& cueId : cueIds) {
+            if (cueById_.contains(cueId)) {
+                validCueIds.append(cueId);
+            }
         }
     }
 
     if (selectedCueIds_ != validCueIds) {
-        selectedCueIds_ = validCueIds;
+        updateSelection(validCueIds);
         emit selectionChanged();
         emit selectedCuesChanged(selectedCueIds_);
 
@@ -383,6 +617,13 @@ void CueManager::selectCues(const QStringList& cueIds)
     }
 }
 
+void CueManager::updateSelection(const QStringList& newSelection)
+{
+    // Callers hold selectionMutex_
+    selectedCueIds_ = newSelection;
+    selectedCueIdSet_ = QSet<QString>(newSelection.cbegin(), newSelection.cend());
+}
+
 void CueManager::clearSelection()
 {
     selectCues(QStringList());
@@ -393,10 +634,12 @@ void CueManager::selectAll()
     QReadLocker locker(&cueListLock_);
 
     QStringList allCueIds;
+    allCueIds.reserve(cues_.size());
     for (Cue* cue : cues_) {
         allCueIds.append(cue->id());
     }
 
+    locker.unlock();
     selectCues(allCueIds);
 }
 
@@ -405,7 +648,7 @@ void CueManager::toggleCueSelection(const QString& cueId)
     QMutexLocker locker(&selectionMutex_);
 
     QStringList newSelection = selectedCueIds_;
-    if (newSelection.contains(cueId)) {
+    if (selectedCueIdSet_.contains(cueId)) {
         newSelection.removeAll(cueId);
     }
     else {
@@ -443,10 +686,12 @@ void CueManager::selectRange(const QString& startCueId, const QString& endCueId)
 QList<Cue*> CueManager::getSelectedCues() const
 {
     QMutexLocker locker(&selectionMutex_);
+    QReadLocker listLocker(&cueListLock_);
 
     QList<Cue*> selectedCues;
+    selectedCues.reserve(selectedCueIds_.size());
     for (const QString& cueId : selectedCueIds_) {
-        Cue* cue = getCue(cueId);
+        Cue* cue = lookupCue(cueId);
         if (cue) {
             selectedCues.append(cue);
         }
@@ -457,7 +702,7 @@ QList<Cue*> CueManager::getSelectedCues() const
 bool CueManager::isCueSelected(const QString& cueId) const
 {
     QMutexLocker locker(&selectionMutex_);
-    return selectedCueIds_.contains(cueId);
+    return selectedCueIdSet_.contains(cueId);
 }
 
 // Playhead and Transport
@@ -491,6 +736,51 @@ void CueManager::advanceStandBy()
     }
 }
 
+QList<Cue*> CueManager::getUpcomingExecutableCues(int count) const
+{
+    QList<Cue*> upcoming;
+    {
+        QMutexLocker playheadLocker(&playheadMutex_);
+        QReadLocker locker(&cueListLock_);
+
+        int index = findCueIndex(standByCueId_);
+        for (; index >= 0 && index < cues_.size() && upcoming.size() < count; ++index) {
+            if (isCueExecutable(cues_[index])) {
+                upcoming.append(cues_[index]);
+            }
+        }
+    }
+
+    // These are about to be pre-armed and fired
+    for (Cue* cue : std::as_const(upcoming)) {
+        cue->hydrate();
+    }
+    return upcoming;
+}
+
+Cue* CueManager::getNextExecutableCue(const QString& afterCueId) const
+{
+    return getCue(findNextExecutableCue(afterCueId));
+}
+
+void CueManager::setScheduler(CueScheduler* scheduler)
+{
+    if (scheduler_) {
+        disconnect(scheduler_, nullptr, this, nullptr);
+    }
+
+    scheduler_ = scheduler;
+
+    if (scheduler_) {
+        connect(scheduler_, &CueScheduler::cueFired, this, &CueManager::onScheduledCueFired);
+    }
+}
+
+void CueManager::setMediaPool(const MediaPool* pool)
+{
+    mediaPool_ = pool;
+}
+
 void CueManager::go()
 {
     Cue* standbyCue = getStandByCue();
@@ -506,6 +796,16 @@ void CueManager::go()
 
     qDebug() << "Executing cue" << standbyCue->number();
 
+    // Pre-waits and auto-continue chains run on the audio clock when available
+    if (scheduler_) {
+        const QList<Cue*> scheduled = scheduler_->scheduleGo(standbyCue);
+        if (!scheduled.isEmpty()) {
+            setStandByCue(findNextExecutableCue(scheduled.last()->id()));
+            emit playbackStateChanged();
+            return;
+        }
+    }
+
     // Execute the cue
     standbyCue->trigger();
 
@@ -523,10 +823,59 @@ void CueManager::go()
     emit playbackStateChanged();
 }
 
+void CueManager::goCues(const QStringList& cueIds)
+{
+    const QList<Cue*> cues = cuesForIds(cueIds);
+    if (cues.isEmpty()) {
+        return;
+    }
+
+    // One start set on the audio clock; the fallback triggers them back to back
+    if (scheduler_ && !scheduler_->scheduleTogether(cues).isEmpty()) {
+        emit playbackStateChanged();
+        return;
+    }
+
+    for (Cue* cue : cues) {
+        if (!cue->canExecute()) {
+            continue;
+        }
+
+        cue->trigger();
+        if (cue->isExecuting()) {
+            activeCues_.append(cue);
+            emit cueExecutionStarted(cue->id());
+        }
+    }
+
+    emit playbackStateChanged();
+}
+
+void CueManager::adoptRemoteStart(AudioCue* cue, bool wasGo)
+{
+    if (!cue) {
+        return;
+    }
+
+    if (scheduler_) {
+        scheduler_->adoptStart(cue);
+    }
+
+    // A remote GO fired the standby: move on exactly as go() would have
+    if (wasGo && standByCueId_ == cue->id()) {
+        setStandByCue(findNextExecutableCue(cue->id()));
+    }
+    emit playbackStateChanged();
+}
+
 void CueManager::stop()
 {
     qDebug() << "Stopping all active cues";
 
+    if (scheduler_) {
+        scheduler_->cancelAll();
+    }
+
     QList<Cue*> cuesToStop = activeCues_;
     for (Cue* cue : cuesToStop) {
         cue->stop();
@@ -579,6 +928,10 @@ void CueManager::panic()
 {
     qWarning() << "PANIC STOP activated";
 
+    if (scheduler_) {
+        scheduler_->cancelAll();
+    }
+
     // Immediately stop all cues
     for (Cue* cue : cues_) {
         if (cue->isExecuting()) {
@@ -641,12 +994,13 @@ QString CueManager::createGroupFromCues(const QStringList& cueIds)
     // Find the first cue's position for group placement
     int firstIndex = -1;
     QList<Cue*> cuesToGroup;
+    QSet<QString> idsToGroup;
 
     for (const QString& cueId : cueIds) {
-        Cue* cue = getCue(cueId);
-        if (cue) {
-            cuesToGroup.append(cue);
-            int index = findCueIndex(cueId);
+        int index = findCueIndex(cueId);
+        if (index >= 0 && !idsToGroup.contains(cueId)) {
+            idsToGroup.insert(cueId);
+            cuesToGroup.append(cues_[index]);
             if (firstIndex < 0 || index < firstIndex) {
                 firstIndex = index;
             }
@@ -659,30 +1013,35 @@ QString CueManager::createGroupFromCues(const QStringList& cueIds)
 
     // Create group cue
     GroupCue* group = new GroupCue(this);
-    group->setNumber(getNextCueNumber());
+    group->setNumber(computeNextCueNumber());
     group->setName("Group");
 
-    // Remove cues from main list and add to group
-    for (Cue* cue : cuesToGroup) {
-        int index = findCueIndex(cue->id());
-        if (index >= 0) {
-            cues_.removeAt(index);
-            group->addChildCue(cue);
-
-            // Adjust firstIndex if necessary
-            if (index < firstIndex) {
-                firstIndex--;
-            }
+    // Remove cues from main list in one pass; nothing before firstIndex moves
+    QList<Cue*> remaining;
+    remaining.reserve(cues_.size() - cuesToGroup.size() + 1);
+    for (Cue* cue : cues_) {
+        if (!idsToGroup.contains(cue->id())) {
+            remaining.append(cue);
         }
     }
+    cues_.swap(remaining);
+
+    for (Cue* cue : cuesToGroup) {
+        cueById_.remove(cue->id());
+        cueIndexById_.remove(cue->id());
+        untrackCueNumber(cue->id());
+        group->addChildCue(cue);
+    }
 
     // Insert group at the first position
-    cues_.insert(firstIndex, group);
+    insertCueAt(group, firstIndex);
     connectCueSignals(group);
 
     // Set group as expanded by default
     groupExpansionState_[group->id()] = true;
 
+    // Grouping isn't undoable yet, and recorded positions no longer line up
+    undoStack_->clear();
     markWorkspaceModified();
 
     QString groupId = group->id();
@@ -713,18 +1072,44 @@ bool CueManager::ungroupCues(const QString& groupId)
     // Get group children
     QList<Cue*> children = group->children();
 
-    // Remove group from main list
+    // Children take the group's row at the top level, shown whatever its state was
+    {
+        QMutexLocker treeLocker(&groupTreeMutex_);
+        const int groupRow = groupTreeValid_ ? visibleRowById_.value(groupId, -1) : -1;
+        if (groupRow >= 0) {
+            QList<Cue*> rows;
+            appendVisibleChildren(group, rows);
+            const int shownRows = isGroupExpanded(groupId) ? rows.size() : 0;
+            spliceVisibleRows(groupRow, 1 + shownRows, rows);
+            for (Cue* child : std::as_const(children)) {
+                parentGroupById_.remove(child->id());
+            }
+        }
+        else {
+            groupTreeValid_ = false;
+        }
+    }
+
+    // Remove group from main list (the group tree was already updated above)
     cues_.removeAt(groupIndex);
+    cueById_.remove(groupId);
+    cueIndexById_.remove(groupId);
+    untrackCueNumber(groupId);
     disconnectCueSignals(group);
 
-    // Insert children at group position
+    // Insert children at group position in one splice
+    cues_.insert(groupIndex, children.size(), nullptr);
     for (int i = 0; i < children.size(); ++i) {
-        cues_.insert(groupIndex + i, children[i]);
+        cues_[groupIndex + i] = children[i];
+        cueById_.insert(children[i]->id(), children[i]);
+        trackCueNumber(children[i]);
     }
+    reindexCues(groupIndex);
 
     // Remove group expansion state
     groupExpansionState_.remove(groupId);
 
+    undoStack_->clear();
     markWorkspaceModified();
 
     qDebug() << "Ungrouped" << children.size() << "cues from group" << group->number();
@@ -753,7 +1138,26 @@ bool CueManager::isGroupExpanded(const QString& groupId) const
 void CueManager::toggleGroupExpansion(const QString& groupId)
 {
     bool expanded = isGroupExpanded(groupId);
-    groupExpansionState_[groupId] = !expanded;
+
+    {
+        QReadLocker locker(&cueListLock_);
+        QMutexLocker treeLocker(&groupTreeMutex_);
+        groupExpansionState_[groupId] = !expanded;
+
+        // Splice the group's visible subtree in or out; nothing to do while an ancestor hides it
+        const int groupRow = groupTreeValid_ ? visibleRowById_.value(groupId, -1) : -1;
+        const GroupCue* group = groupRow >= 0 ? qobject_cast<GroupCue*>(visibleRows_[groupRow]) : nullptr;
+        if (group) {
+            QList<Cue*> rows;
+            appendVisibleChildren(group, rows);
+            if (expanded) {
+                spliceVisibleRows(groupRow + 1, rows.size(), QList<Cue*>());
+            }
+            else {
+                spliceVisibleRows(groupRow + 1, 0, rows);
+            }
+        }
+    }
 
     emit groupExpansionChanged(groupId, !expanded);
 
@@ -770,6 +1174,7 @@ void CueManager::expandAllGroups()
             emit groupExpansionChanged(cue->id(), true);
         }
     }
+    invalidateGroupTree();
 }
 
 void CueManager::collapseAllGroups()
@@ -782,6 +1187,7 @@ void CueManager::collapseAllGroups()
             emit groupExpansionChanged(cue->id(), false);
         }
     }
+    invalidateGroupTree();
 }
 
 QList<Cue*> CueManager::getGroupChildren(const QString& groupId) const
@@ -794,51 +1200,477 @@ QList<Cue*> CueManager::getGroupChildren(const QString& groupId) const
     return QList<Cue*>();
 }
 
-// Private Implementation
-
-Cue* CueManager::createCueOfType(CueType type)
+GroupCue* CueManager::getParentGroup(const QString& cueId) const
 {
-    switch (type) {
-    case CueType::Audio:
-        return new AudioCue(this);
-    case CueType::Group:
-        return new GroupCue(this);
-        // Add other cue types as they're implemented
-    default:
-        qWarning() << "Unsupported cue type:" << static_cast<int>(type);
-        return nullptr;
-    }
+    QReadLocker locker(&cueListLock_);
+    return findParentGroup(cueId);
 }
 
-void CueManager::insertCueAt(Cue* cue, int index)
+int CueManager::visibleRowCount() const
 {
-    cues_.insert(qBound(0, index, cues_.size()), cue);
+    QReadLocker locker(&cueListLock_);
+    QMutexLocker treeLocker(&groupTreeMutex_);
+
+    ensureGroupTree();
+    return visibleRows_.size();
 }
 
-QString CueManager::generateUniqueCueId() const
+Cue* CueManager::getVisibleCue(int row) const
 {
-    return QUuid::createUuid().toString(QUuid::WithoutBraces);
+    QReadLocker locker(&cueListLock_);
+    QMutexLocker treeLocker(&groupTreeMutex_);
+
+    ensureGroupTree();
+    return row >= 0 && row < visibleRows_.size() ? visibleRows_[row] : nullptr;
 }
 
-void CueManager::connectCueSignals(Cue* cue)
+int CueManager::findVisibleRow(const QString& cueId) const
 {
-    connect(cue, &Cue::cueUpdated, this, &CueManager::onCuePropertyChanged);
-    connect(cue, &Cue::statusChanged, this, &CueManager::onCueStatusChanged);
-    connect(cue, &Cue::executionFinished, this, &CueManager::onCueExecutionFinished);
+    QReadLocker locker(&cueListLock_);
+    QMutexLocker treeLocker(&groupTreeMutex_);
+
+    ensureGroupTree();
+    return visibleRowById_.value(cueId, -1);
 }
 
-void CueManager::disconnectCueSignals(Cue* cue)
+// Group Tree
+
+GroupCue* CueManager::findParentGroup(const QString& cueId) const
 {
-    disconnect(cue, nullptr, this, nullptr);
-}
+    QMutexLocker treeLocker(&groupTreeMutex_);
 
-// Private Slots
+    ensureGroupTree();
+    return parentGroupById_.value(cueId, nullptr);
+}
 
-void CueManager::onCuePropertyChanged()
+void CueManager::ensureGroupTree() const
 {
-    Cue* cue = qobject_cast<Cue*>(sender());
+    if (groupTreeValid_) {
+        return;
+    }
+
+    parentGroupById_.clear();
+    visibleRows_.clear();
+    visibleRows_.reserve(cues_.size());
+
+    for (Cue* cue : cues_) {
+        visibleRows_.append(cue);
+
+        if (cue->type() == CueType::Group) {
+            GroupCue* group = qobject_cast<GroupCue*>(cue);
+            if (group) {
+                linkGroupChildren(group);
+                if (isGroupExpanded(group->id())) {
+                    appendVisibleChildren(group, visibleRows_);
+                }
+            }
+        }
+    }
+
+    visibleRowById_.clear();
+    visibleRowById_.reserve(visibleRows_.size());
+    reindexVisibleRows(0);
+    groupTreeValid_ = true;
+}
+
+void CueManager::invalidateGroupTree()
+{
+    // Rebuilt on next access; a structural edit usually comes in a batch
+    QMutexLocker treeLocker(&groupTreeMutex_);
+    groupTreeValid_ = false;
+}
+
+void CueManager::linkGroupChildren(GroupCue* group) const
+{
+    for (Cue* child : group->children()) {
+        parentGroupById_.insert(child->id(), group);
+
+        if (child->type() == CueType::Group) {
+            if (GroupCue* nested = qobject_cast<GroupCue*>(child)) {
+                linkGroupChildren(nested);
+            }
+        }
+    }
+}
+
+void CueManager::appendVisibleChildren(const GroupCue* group, QList<Cue*>& rows) const
+{
+    // Children are visible once their parent is; nested groups add theirs when expanded
+    for (Cue* child : group->children()) {
+        rows.append(child);
+
+        if (child->type() == CueType::Group && isGroupExpanded(child->id())) {
+            if (const GroupCue* nested = qobject_cast<const GroupCue*>(child)) {
+                appendVisibleChildren(nested, rows);
+            }
+        }
+    }
+}
+
+void CueManager::spliceVisibleRows(int row, int removeCount, const QList<Cue*>& rows) const
+{
+    for (int i = row; i < row + removeCount; ++i) {
+        visibleRowById_.remove(visibleRows_[i]->id());
+    }
+
+    QList<Cue*> spliced;
+    spliced.reserve(visibleRows_.size() - removeCount + rows.size());
+    spliced.append(visibleRows_.mid(0, row));
+    spliced.append(rows);
+    spliced.append(visibleRows_.mid(row + removeCount));
+    visibleRows_.swap(spliced);
+
+    reindexVisibleRows(row);
+}
+
+void CueManager::reindexVisibleRows(int fromRow) const
+{
+    // Rows before fromRow didn't move
+    for (int i = qMax(0, fromRow); i < visibleRows_.size(); ++i) {
+        visibleRowById_.insert(visibleRows_[i]->id(), i);
+    }
+}
+
+// Clipboard
+
+void CueManager::cutSelectedCues()
+{
+    copySelectedCues();
+    if (clipboard_.isEmpty()) {
+        return;
+    }
+
+    QStringList cueIds;
+    {
+        QMutexLocker locker(&selectionMutex_);
+        cueIds = selectedCueIds_;
+    }
+    removeCues(cueIds);     // Undoable; the clipboard keeps its own summaries
+}
+
+void CueManager::copySelectedCues()
+{
+    const QList<Workspace::CueSummary> summaries = summarizeSelection();
+    if (summaries.isEmpty()) {
+        return;
+    }
+
+    clipboard_.setEntries(summaries);
+    clipboard_.publish();
+    qDebug() << "Copied" << summaries.size() << "cues to clipboard";
+}
+
+void CueManager::pasteCues()
+{
+    int lastIndex = -1;
+    {
+        QMutexLocker locker(&selectionMutex_);
+        QReadLocker listLocker(&cueListLock_);
+        for (const QString& cueId : std::as_const(selectedCueIds_)) {
+            lastIndex = qMax(lastIndex, findCueIndex(cueId));
+        }
+        if (lastIndex < 0) {
+            lastIndex = cues_.size() - 1;
+        }
+    }
+    pasteCuesAt(lastIndex + 1);
+}
+
+void CueManager::pasteCuesAt(int index)
+{
+    // Our own copy pastes straight from the shared summaries; JSON is only
+    // parsed when the clipboard was filled by another process
+    QList<Workspace::CueSummary> summaries;
+    if (clipboard_.ownsSystemClipboard() || (!clipboard_.isEmpty() && !CueClipboard::hasSystemClipboardCues())) {
+        summaries = clipboard_.entries();
+    }
+    else if (!CueClipboard::readSystemClipboard(summaries)) {
+        return;
+    }
+
+    const QStringList cueIds = insertSummaries(summaries, index);
+    if (!cueIds.isEmpty()) {
+        selectCues(cueIds);
+        qDebug() << "Pasted" << cueIds.size() << "cues at index" << index;
+    }
+}
+
+bool CueManager::hasClipboard() const
+{
+    return !clipboard_.isEmpty() || CueClipboard::hasSystemClipboardCues();
+}
+
+void CueManager::clearClipboard()
+{
+    clipboard_.clear();
+}
+
+QStringList CueManager::duplicateSelectedCues()
+{
+    int lastIndex = -1;
+    const QList<Workspace::CueSummary> summaries = summarizeSelection(&lastIndex);
+    if (summaries.isEmpty()) {
+        return QStringList();
+    }
+
+    const QStringList cueIds = insertSummaries(summaries, lastIndex + 1);
+    if (!cueIds.isEmpty()) {
+        selectCues(cueIds);
+    }
+    return cueIds;
+}
+
+QList<Workspace::CueSummary> CueManager::summarizeSelection(int* lastIndex) const
+{
+    QMutexLocker locker(&selectionMutex_);
+    QReadLocker listLocker(&cueListLock_);
+
+    // List order, not click order; only top-level cues are in the index
+    QList<QPair<int, const Cue*>> ordered;
+    ordered.reserve(selectedCueIds_.size());
+    int last = -1;
+    for (const QString& cueId : selectedCueIds_) {
+        if (const Cue* cue = lookupCue(cueId)) {
+            const int index = findCueIndex(cueId);
+            ordered.append(qMakePair(index, cue));
+            last = qMax(last, index);
+        }
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    QList<Workspace::CueSummary> summaries;
+    summaries.reserve(ordered.size());
+    for (const auto& entry : std::as_const(ordered)) {
+        Workspace::CueSummary summary = Workspace::summarize(entry.second);
+
+        // Copies start idle; a broken media reference is still broken
+        if (summary.status != static_cast<int>(CueStatus::Broken)) {
+            summary.status = static_cast<int>(CueStatus::Loaded);
+        }
+        summaries.append(summary);
+    }
+
+    if (lastIndex) {
+        *lastIndex = last < 0 ? cues_.size() - 1 : last;
+    }
+    return summaries;
+}
+
+QStringList CueManager::insertSummaries(const QList<Workspace::CueSummary>& summaries, int index)
+{
+    QList<Cue*> inserted;
+    int position = 0;
+
+    {
+        QWriteLocker locker(&cueListLock_);
+        position = qBound(0, index, cues_.size());
+        inserted.reserve(summaries.size());
+
+        // Numbered in one pass past the current highest, instead of a scan per cue
+        double nextNumber = computeNextCueNumber().toDouble();
+
+        for (const Workspace::CueSummary& summary : summaries) {
+            Cue* cue = createCueOfType(Cue::stringToType(summary.type));
+            if (!cue) {
+                continue;
+            }
+
+            // Details stay encoded (and shared with the source) until first access
+            Workspace::applySummary(cue, summary);
+            {
+                const QSignalBlocker blocker(cue);
+                cue->setNumber(QString::number(nextNumber++, 'f', 0));
+            }
+            inserted.append(cue);
+        }
+
+        if (inserted.isEmpty()) {
+            return QStringList();
+        }
+
+        // One splice for the whole paste
+        cues_.insert(position, inserted.size(), nullptr);
+        for (int i = 0; i < inserted.size(); ++i) {
+            cues_[position + i] = inserted[i];
+            cueById_.insert(inserted[i]->id(), inserted[i]);
+            trackCueNumber(inserted[i]);
+            connectCueSignals(inserted[i]);
+        }
+        reindexCues(position);
+    }
+
+    // Group children are list structure; audio file paths feed the engine and the prearmer
+    for (Cue* cue : std::as_const(inserted)) {
+        if (cue->type() == CueType::Group || cue->type() == CueType::Audio) {
+            cue->hydrate();
+        }
+    }
+    invalidateGroupTree();
+
+    QList<int> positions;
+    positions.reserve(inserted.size());
+    for (int i = 0; i < inserted.size(); ++i) {
+        positions.append(position + i);
+    }
+    recordListEdit(Workspace::ListEdit::Kind::Insert, positions);
+
+    QStringList cueIds;
+    cueIds.reserve(inserted.size());
+    for (int i = 0; i < inserted.size(); ++i) {
+        cueIds.append(inserted[i]->id());
+        markWorkspaceModified(inserted[i]);
+        emit cueAdded(inserted[i], position + i);
+    }
+    emit cueCountChanged();
+
+    if (isRecordingUndo()) {
+        undoStack_->push(std::make_unique<CueListCommand>(CueListCommand::Kind::Insert, cueIds));
+    }
+
+    return cueIds;
+}
+
+// Private Implementation
+
+Cue* CueManager::createCueOfType(CueType type)
+{
+    switch (type) {
+    case CueType::Audio:
+        return new AudioCue(this);
+    case CueType::Group:
+        return new GroupCue(this);
+        // Add other cue types as they're implemented
+    default:
+        qWarning() << "Unsupported cue type:" << static_cast<int>(type);
+        return nullptr;
+    }
+}
+
+void CueManager::insertCueAt(Cue* cue, int index)
+{
+    int position = qBound(0, index, cues_.size());
+    cues_.insert(position, cue);
+    cueById_.insert(cue->id(), cue);
+    trackCueNumber(cue);
+    reindexCues(position);
+    invalidateGroupTree();
+}
+
+void CueManager::insertCuesAt(const QList<QPair<int, Cue*>>& cues)
+{
+    if (cues.isEmpty()) {
+        return;
+    }
+
+    // Merge in one pass: each entry's position is its index in the resulting list
+    QList<Cue*> merged;
+    merged.reserve(cues_.size() + cues.size());
+    int next = 0;
+    for (Cue* cue : std::as_const(cues_)) {
+        while (next < cues.size() && cues[next].first <= merged.size()) {
+            merged.append(cues[next++].second);
+        }
+        merged.append(cue);
+    }
+    while (next < cues.size()) {
+        merged.append(cues[next++].second);     // Positions past the end append in order
+    }
+
+    for (const auto& entry : cues) {
+        cueById_.insert(entry.second->id(), entry.second);
+        trackCueNumber(entry.second);
+    }
+
+    cues_.swap(merged);
+    reindexCues(qMin(cues.first().first, cues_.size() - cues.size()));
+    invalidateGroupTree();
+}
+
+void CueManager::removeCueAt(int index)
+{
+    if (index < 0 || index >= cues_.size()) {
+        return;
+    }
+
+    Cue* cue = cues_.takeAt(index);
+    cueById_.remove(cue->id());
+    cueIndexById_.remove(cue->id());
+    untrackCueNumber(cue->id());
+    reindexCues(index);
+    invalidateGroupTree();
+}
+
+Cue* CueManager::lookupCue(const QString& cueId) const
+{
+    return cueById_.value(cueId, nullptr);
+}
+
+void CueManager::reindexCues(int fromIndex)
+{
+    // Only positions at or after fromIndex can have shifted
+    for (int i = qMax(0, fromIndex); i < cues_.size(); ++i) {
+        cueIndexById_.insert(cues_[i]->id(), i);
+    }
+}
+
+void CueManager::trackCueNumber(const Cue* cue)
+{
+    untrackCueNumber(cue->id());
+
+    bool ok = false;
+    const double number = cue->number().toDouble(&ok);
+    if (ok) {
+        cueNumberCounts_[number]++;
+        cueNumberById_.insert(cue->id(), number);
+    }
+}
+
+void CueManager::untrackCueNumber(const QString& cueId)
+{
+    const auto it = cueNumberById_.constFind(cueId);
+    if (it == cueNumberById_.constEnd()) {
+        return;
+    }
+
+    const auto count = cueNumberCounts_.find(it.value());
+    if (count != cueNumberCounts_.end() && --count.value() <= 0) {
+        cueNumberCounts_.erase(count);
+    }
+    cueNumberById_.erase(it);
+}
+
+QString CueManager::generateUniqueCueId() const
+{
+    return QUuid::createUuid().toString(QUuid::WithoutBraces);
+}
+
+void CueManager::connectCueSignals(Cue* cue)
+{
+    connect(cue, &Cue::cueUpdated, this, &CueManager::onCuePropertyChanged);
+    connect(cue, &Cue::statusChanged, this, &CueManager::onCueStatusChanged);
+    connect(cue, &Cue::executionFinished, this, &CueManager::onCueExecutionFinished);
+}
+
+void CueManager::disconnectCueSignals(Cue* cue)
+{
+    disconnect(cue, nullptr, this, nullptr);
+}
+
+// Private Slots
+
+void CueManager::onCuePropertyChanged()
+{
+    Cue* cue = qobject_cast<Cue*>(sender());
     if (cue) {
-        markWorkspaceModified();
+        markWorkspaceModified(cue);
+        if (cueById_.contains(cue->id())) {
+            // Group children aren't indexed or counted
+            trackCueNumber(cue);            // Renumbers (edits, resequence, undo) arrive here
+            searchIndex_->updateCue(cue);
+            updateStats(cue);               // Status and duration changes arrive here too
+        }
         emit cueUpdated(cue);
     }
 }
@@ -863,6 +1695,18 @@ void CueManager::onCueExecutionFinished()
     }
 }
 
+void CueManager::onScheduledCueFired(const QString& cueId)
+{
+    Cue* cue = getCue(cueId);
+    if (!cue || activeCues_.contains(cue)) {
+        return;
+    }
+
+    activeCues_.append(cue);
+    emit cueExecutionStarted(cueId);
+    emit playbackStateChanged();
+}
+
 void CueManager::processCueExecution()
 {
     // Remove finished cues from active list
@@ -913,20 +1757,46 @@ void CueManager::ensureValidSelection()
     QMutexLocker locker(&selectionMutex_);
 
     QStringList validSelection;
+    validSelection.reserve(selectedCueIds_.size());
     for (const QString& cueId : selectedCueIds_) {
-        if (getCue(cueId)) {
+        if (cueById_.contains(cueId)) {
             validSelection.append(cueId);
         }
     }
 
     if (validSelection.size() != selectedCueIds_.size()) {
-        selectedCueIds_ = validSelection;
+        updateSelection(validSelection);
         locker.unlock();
         emit selectionChanged();
     }
 }
 
-void CueManager::markWorkspaceModified()
+void CueManager::markWorkspaceModified(const Cue* cue)
+{
+    // Autosave journals just these cues; anything else needs a full snapshot
+    if (cue) {
+        dirtyCueIds_.insert(cue->id());
+    }
+    else {
+        structureDirty_ = true;
+    }
+    noteUnsavedChanges();
+}
+
+void CueManager::recordListEdit(Workspace::ListEdit::Kind kind, const QList<int>& positions, int index)
+{
+    // Top-level inserts, removes and moves are journaled too; after any other structural change a base is due anyway
+    if (!structureDirty_) {
+        Workspace::ListEdit edit;
+        edit.kind = kind;
+        edit.positions = positions;
+        edit.index = index;
+        listEdits_.append(edit);
+    }
+    noteUnsavedChanges();
+}
+
+void CueManager::noteUnsavedChanges()
 {
     if (!hasUnsavedChanges_) {
         hasUnsavedChanges_ = true;
@@ -935,72 +1805,723 @@ void CueManager::markWorkspaceModified()
     }
 }
 
-// Workspace Management Stubs (to be fully implemented)
+// Workspace Management
 
 void CueManager::newWorkspace()
 {
     clearWorkspace();
     workspacePath_.clear();
     hasUnsavedChanges_ = false;
+    autosave_->reset();
 
     emit workspaceChanged();
     qDebug() << "New workspace created";
 }
 
-void CueManager::clearWorkspace()
+bool CueManager::openWorkspace(const QString& filePath)
 {
-    QWriteLocker locker(&cueListLock_);
+    QElapsedTimer readTimer;
+    readTimer.start();
 
-    // Stop all cues
-    stop();
+    Workspace::File file;
+    QString error;
+    if (!Workspace::readFile(filePath, file, &error)) {
+        qWarning() << "Failed to read workspace" << filePath << "-" << error;
+        return false;
+    }
 
-    // Clear selection and playhead
-    selectedCueIds_.clear();
-    standByCueId_.clear();
+    qDebug() << "Parsed workspace" << filePath << "in" << readTimer.elapsed() << "ms";
+    return openWorkspace(filePath, file);
+}
 
-    // Delete all cues
-    qDeleteAll(cues_);
-    cues_.clear();
+bool CueManager::openWorkspace(const QString& filePath, const Workspace::File& file)
+{
+    QElapsedTimer loadTimer;
+    loadTimer.start();
 
-    // Clear state
-    activeCues_.clear();
-    groupExpansionState_.clear();
-    clipboard_ = QJsonArray();
+    clearWorkspace();
+    const bool loaded = file.format == Workspace::Format::Binary ? loadWorkspaceContents(file.contents)
+                                                                 : deserializeWorkspace(file.json);
+
+    // Drop strings only the previous show used (cues still awaiting deletion let go at the next open)
+    StringPool::instance().purgeUnused();
 
+    workspacePath_ = filePath;
     hasUnsavedChanges_ = false;
-    statsValid_ = false;
+    autosave_->reset();
 
     emit cueCountChanged();
-    emit selectionChanged();
-    emit playheadChanged();
-}
-
-// Status and Monitoring
-
-bool CueManager::hasActiveCues() const
-{
-    return !activeCues_.isEmpty();
-}
+    emit workspaceChanged();
+    emit workspaceOpened(filePath);
 
-int CueManager::getBrokenCueCount() const
-{
-    return brokenCueCount_;
+    qDebug() << "Opened workspace" << filePath << "-" << cueCount() << "cues in" << loadTimer.elapsed() << "ms";
+    return loaded;
 }
 
-QList<Cue*> CueManager::getActiveCues() const
+bool CueManager::saveWorkspace(const QString& filePath)
 {
-    return activeCues_;
-}
+    const QString path = filePath.isEmpty() ? workspacePath_ : filePath;
+    if (path.isEmpty()) {
+        qWarning() << "No workspace path to save to";
+        return false;
+    }
+
+    if (!writeWorkspaceFile(path, Workspace::formatForPath(path))) {
+        return false;
+    }
+
+    workspacePath_ = path;
+    hasUnsavedChanges_ = false;
+    autosave_->reset();
+
+    emit workspaceSaved(path);
+    emit workspaceModified(false);
+    emit workspaceChanged();
+    return true;
+}
+
+bool CueManager::saveWorkspaceAs(const QString& filePath)
+{
+    return saveWorkspace(filePath);
+}
+
+bool CueManager::exportWorkspace(const QString& filePath) const
+{
+    // Export never changes the current workspace path or modified state
+    return writeWorkspaceFile(filePath, Workspace::Format::Json);
+}
+
+bool CueManager::writeWorkspaceFile(const QString& filePath, Workspace::Format format) const
+{
+    QByteArray data;
+
+    if (format == Workspace::Format::Json) {
+        // JSON carries everything, so pull in any details still deferred (outside the lock)
+        for (Cue* cue : getAllCues()) {
+            cue->hydrate();
+        }
+
+        QReadLocker locker(&cueListLock_);
+        data = QJsonDocument(serializeWorkspace()).toJson(QJsonDocument::Indented);
+    }
+    else {
+        QReadLocker locker(&cueListLock_);
+        data = Workspace::encodeBinary(collectWorkspaceContents());
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write workspace" << filePath << "-" << file.errorString();
+        return false;
+    }
+
+    file.write(data);
+    if (!file.commit()) {
+        qWarning() << "Failed to write workspace" << filePath << "-" << file.errorString();
+        return false;
+    }
+
+    qDebug() << "Saved workspace" << filePath << "(" << data.size() << "bytes)";
+    return true;
+}
+
+bool CueManager::restoreWorkspace(const Workspace::Contents& contents, const QString& filePath)
+{
+    clearWorkspace();
+    const bool loaded = loadWorkspaceContents(contents);
+
+    // The recovered edits were never saved to filePath; keep the autosave files until a new base lands
+    workspacePath_ = filePath;
+    autosave_->reset(false);
+    markWorkspaceModified();
+
+    emit cueCountChanged();
+    emit workspaceChanged();
+    emit workspaceOpened(filePath);
+    return loaded;
+}
+
+// Autosave Support
+
+QSet<QString> CueManager::takeDirtyCueIds(bool* structureChanged, QList<Workspace::ListEdit>* listEdits)
+{
+    if (structureChanged) {
+        *structureChanged = structureDirty_;
+    }
+    if (listEdits) {
+        *listEdits = std::exchange(listEdits_, QList<Workspace::ListEdit>());
+    }
+    else {
+        listEdits_.clear();
+    }
+    structureDirty_ = false;
+    return std::exchange(dirtyCueIds_, QSet<QString>());
+}
+
+Workspace::Contents CueManager::snapshotWorkspace() const
+{
+    QReadLocker locker(&cueListLock_);
+    return collectWorkspaceContents();
+}
+
+QList<QPair<int, Workspace::CueSummary>> CueManager::snapshotCues(const QSet<QString>& cueIds, bool* complete) const
+{
+    QReadLocker locker(&cueListLock_);
+
+    QList<QPair<int, Workspace::CueSummary>> snapshot;
+    snapshot.reserve(cueIds.size());
+    bool allFound = true;
+
+    for (const QString& cueId : cueIds) {
+        const int index = findCueIndex(cueId);
+        if (index < 0) {
+            allFound = false;   // Removed, or lives inside a group
+            continue;
+        }
+        snapshot.append(qMakePair(index, Workspace::summarize(cues_[index])));
+    }
+
+    if (complete) {
+        *complete = allFound;
+    }
+    return snapshot;
+}
+
+// Workspace Serialization
+
+QJsonObject CueManager::workspaceSettings() const
+{
+    QJsonObject settings;
+    settings["standByIndex"] = findCueIndex(standByCueId_);
+
+    QJsonArray expandedGroups;
+    for (int i = 0; i < cues_.size(); ++i) {
+        if (cues_[i]->type() == CueType::Group && groupExpansionState_.value(cues_[i]->id(), false)) {
+            expandedGroups.append(i);
+        }
+    }
+    settings["expandedGroups"] = expandedGroups;
+    return settings;
+}
+
+void CueManager::applyWorkspaceSettings(const QJsonObject& settings)
+{
+    // Cue IDs are regenerated on load, so workspace state is stored by position
+    for (const QJsonValue& value : settings["expandedGroups"].toArray()) {
+        const int index = value.toInt(-1);
+        if (index >= 0 && index < cues_.size()) {
+            groupExpansionState_[cues_[index]->id()] = true;
+        }
+    }
+
+    // Group children arrive with the (hydrated) groups, after the list itself
+    invalidateGroupTree();
+
+    const int standByIndex = settings["standByIndex"].toInt(-1);
+    if (standByIndex >= 0 && standByIndex < cues_.size()) {
+        setStandByCue(cues_[standByIndex]->id());
+    }
+    else {
+        updateStandByCue();
+    }
+}
+
+QJsonObject CueManager::serializeWorkspace() const
+{
+    QJsonArray cueArray;
+    for (const Cue* cue : cues_) {
+        cueArray.append(cue->toJson());
+    }
+
+    QJsonObject json;
+    json["format"] = "cueforge-workspace";
+    json["version"] = WORKSPACE_JSON_VERSION;
+    json["settings"] = workspaceSettings();
+    json["cues"] = cueArray;
+    return json;
+}
+
+bool CueManager::deserializeWorkspace(const QJsonObject& json)
+{
+    const QJsonArray cueArray = json["cues"].toArray();
+    bool allLoaded = true;
+
+    {
+        QWriteLocker locker(&cueListLock_);
+        cues_.reserve(cueArray.size());
+
+        for (const QJsonValue& value : cueArray) {
+            const QJsonObject cueJson = value.toObject();
+            Cue* cue = createCueOfType(Cue::stringToType(cueJson["type"].toString()));
+            if (!cue || !cue->fromJson(cueJson)) {
+                delete cue;
+                allLoaded = false;
+                continue;
+            }
+
+            cues_.append(cue);
+            cueById_.insert(cue->id(), cue);
+            trackCueNumber(cue);
+            connectCueSignals(cue);
+        }
+        reindexCues();
+    }
+
+    applyWorkspaceSettings(json["settings"].toObject());
+    return allLoaded;
+}
+
+Workspace::Contents CueManager::collectWorkspaceContents() const
+{
+    Workspace::Contents contents;
+    contents.settings = workspaceSettings();
+    contents.cues.reserve(cues_.size());
+
+    for (const Cue* cue : cues_) {
+        contents.cues.append(Workspace::summarize(cue));
+    }
+    return contents;
+}
+
+bool CueManager::loadWorkspaceContents(const Workspace::Contents& contents)
+{
+    QList<Cue*> groups;
+    bool allLoaded = true;
+
+    {
+        QWriteLocker locker(&cueListLock_);
+        cues_.reserve(contents.cues.size());
+
+        for (const Workspace::CueSummary& summary : contents.cues) {
+            Cue* cue = createCueOfType(Cue::stringToType(summary.type));
+            if (!cue) {
+                allLoaded = false;
+                continue;
+            }
+
+            // Only the summary is applied now; details hydrate on first access
+            Workspace::applySummary(cue, summary);
+
+            cues_.append(cue);
+            cueById_.insert(cue->id(), cue);
+            trackCueNumber(cue);
+            connectCueSignals(cue);
+
+            if (cue->type() == CueType::Group) {
+                groups.append(cue);
+            }
+        }
+        reindexCues();
+    }
+
+    // Group children are part of the list structure, so groups can't stay lazy
+    for (Cue* group : std::as_const(groups)) {
+        group->hydrate();
+    }
+
+    applyWorkspaceSettings(contents.settings);
+    return allLoaded;
+}
+
+void CueManager::clearWorkspace()
+{
+    QWriteLocker locker(&cueListLock_);
+
+    // Stop all cues
+    stop();
+    cancelValidation();
+
+    // Clear selection and playhead
+    selectedCueIds_.clear();
+    selectedCueIdSet_.clear();
+    standByCueId_.clear();
+
+    // Delete all cues
+    qDeleteAll(cues_);
+    cues_.clear();
+    cueById_.clear();
+    cueIndexById_.clear();
+    cueNumberCounts_.clear();
+    cueNumberById_.clear();
+
+    // Clear state
+    activeCues_.clear();
+    groupExpansionState_.clear();
+    invalidateGroupTree();
+    clipboard_.clear();
+    undoStack_->clear();
+
+    hasUnsavedChanges_ = false;
+
+    emit cueCountChanged();
+    emit selectionChanged();
+    emit playheadChanged();
+}
+
+// Status and Monitoring
+
+bool CueManager::hasActiveCues() const
+{
+    return !activeCues_.isEmpty();
+}
+
+int CueManager::getBrokenCueCount() const
+{
+    return stats_.brokenCues;
+}
+
+QList<Cue*> CueManager::getActiveCues() const
+{
+    return activeCues_;
+}
 
 QList<Cue*> CueManager::getBrokenCues() const
 {
     QReadLocker locker(&cueListLock_);
 
+    // O(broken): order the tracked set by list position
+    QList<QPair<int, Cue*>> ordered;
+    ordered.reserve(brokenCueIds_.size());
+    for (const QString& cueId : brokenCueIds_) {
+        if (Cue* cue = lookupCue(cueId)) {
+            ordered.append(qMakePair(findCueIndex(cueId), cue));
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(),
+        [](const QPair<int, Cue*>& a, const QPair<int, Cue*>& b) { return a.first < b.first; });
+
     QList<Cue*> brokenCues;
+    brokenCues.reserve(ordered.size());
+    for (const auto& entry : std::as_const(ordered)) {
+        brokenCues.append(entry.second);
+    }
+    return brokenCues;
+}
+
+CueManager::CueStats CueManager::getCueStatistics() const
+{
+    CueStats stats = stats_;
+    if (mediaPool_) {
+        const MediaPool::Stats pool = mediaPool_->stats();
+        stats.mediaPoolHits = pool.hits;
+        stats.mediaPoolMisses = pool.misses;
+        stats.mediaPoolEvictions = pool.evictions;
+        stats.mediaPoolEntries = pool.entries;
+        stats.mediaPoolBytes = pool.residentBytes;
+        stats.mediaPoolBudgetBytes = pool.budgetBytes;
+    }
+
+    // Walked on request rather than tracked: every setter would have to report its delta
+    {
+        QReadLocker locker(&cueListLock_);
+        for (const Cue* cue : cues_) {
+            addMemoryOf(cue, stats);
+        }
+    }
+
+    const StringPool& strings = StringPool::instance();
+    stats.internedStrings = strings.count();
+    stats.internedBytes = strings.bytes();
+    if (stats.allocatedCues > 0) {
+        stats.bytesPerCue = (stats.cueMemoryBytes + stats.internedBytes) / stats.allocatedCues;
+    }
+    if (const CueTimerService* timers = CueTimerService::instance()) {
+        stats.pendingWaits = timers->pendingCount();
+    }
+    return stats;
+}
+
+void CueManager::addMemoryOf(const Cue* cue, CueStats& stats)
+{
+    ++stats.allocatedCues;
+    stats.cueMemoryBytes += cue->memoryUsage();
+
+    if (cue->type() == CueType::Group) {
+        if (const GroupCue* group = qobject_cast<const GroupCue*>(cue)) {
+            for (const Cue* child : group->children()) {
+                addMemoryOf(child, stats);
+            }
+        }
+    }
+}
+
+void CueManager::updateBrokenCueCount()
+{
+    if (stats_.brokenCues != brokenCueIds_.size()) {
+        qWarning() << "Broken cue count drifted, rebuilding statistics";
+        rebuildStats();
+    }
+}
+
+// Statistics
+
+CueManager::StatsContribution CueManager::contributionOf(const Cue* cue)
+{
+    StatsContribution contribution;
+    contribution.type = cue->type();
+    contribution.broken = cue->status() == CueStatus::Broken;
+    contribution.duration = cue->duration();
+    return contribution;
+}
+
+void CueManager::applyContribution(const StatsContribution& contribution, int sign)
+{
+    stats_.totalCues += sign;
+    stats_.brokenCues += contribution.broken ? sign : 0;
+    stats_.totalDuration += sign * contribution.duration;
+
+    switch (contribution.type) {
+    case CueType::Audio:
+        stats_.audioCues += sign;
+        break;
+    case CueType::Video:
+        stats_.videoCues += sign;
+        break;
+    case CueType::MIDI:
+        stats_.midiCues += sign;
+        break;
+    case CueType::Fade:
+        stats_.fadeCues += sign;
+        break;
+    case CueType::Group:
+        stats_.groupCues += sign;
+        break;
+    default:
+        stats_.controlCues += sign;     // Wait, Start, Stop, Goto, Target, Load, Script
+        break;
+    }
+}
+
+void CueManager::addToStats(const Cue* cue)
+{
+    if (!cue || statsByCue_.contains(cue->id())) {
+        return;
+    }
+
+    const StatsContribution contribution = contributionOf(cue);
+    applyContribution(contribution, +1);
+    statsByCue_.insert(cue->id(), contribution);
+
+    if (contribution.broken) {
+        brokenCueIds_.insert(cue->id());
+        notifyBrokenCueCount();
+    }
+}
+
+void CueManager::removeFromStats(const QString& cueId)
+{
+    auto it = statsByCue_.find(cueId);
+    if (it == statsByCue_.end()) {
+        return;
+    }
+
+    const bool wasBroken = it->broken;
+    applyContribution(*it, -1);
+    statsByCue_.erase(it);
+
+    if (stats_.totalCues == 0) {
+        stats_.totalDuration = 0.0;     // Don't carry rounding drift into an empty list
+    }
+
+    if (wasBroken) {
+        brokenCueIds_.remove(cueId);
+        notifyBrokenCueCount();
+    }
+}
+
+void CueManager::updateStats(const Cue* cue)
+{
+    auto it = statsByCue_.find(cue->id());
+    if (it == statsByCue_.end()) {
+        addToStats(cue);
+        return;
+    }
+
+    const StatsContribution contribution = contributionOf(cue);
+    if (contribution.broken == it->broken && contribution.duration == it->duration) {
+        return;     // Type is immutable; nothing counted changed
+    }
+
+    const bool brokenChanged = contribution.broken != it->broken;
+    applyContribution(*it, -1);
+    applyContribution(contribution, +1);
+    *it = contribution;
+
+    if (brokenChanged) {
+        if (contribution.broken) {
+            brokenCueIds_.insert(cue->id());
+        }
+        else {
+            brokenCueIds_.remove(cue->id());
+        }
+        notifyBrokenCueCount();
+    }
+}
+
+void CueManager::rebuildStats()
+{
+    stats_ = CueStats();
+    statsByCue_.clear();
+    brokenCueIds_.clear();
+    statsByCue_.reserve(cues_.size());
+
+    for (const Cue* cue : std::as_const(cues_)) {
+        const StatsContribution contribution = contributionOf(cue);
+        applyContribution(contribution, +1);
+        statsByCue_.insert(cue->id(), contribution);
+        if (contribution.broken) {
+            brokenCueIds_.insert(cue->id());
+        }
+    }
+
+    notifyBrokenCueCount();
+}
+
+void CueManager::notifyBrokenCueCount()
+{
+    // Inside a batch the count is reported once, by endStatsBatch()
+    if (statsBatchDepth_ == 0 && stats_.brokenCues != reportedBrokenCount_) {
+        reportedBrokenCount_ = stats_.brokenCues;
+        emit brokenCueCountChanged(stats_.brokenCues);
+    }
+}
+
+void CueManager::beginStatsBatch()
+{
+    ++statsBatchDepth_;
+}
+
+void CueManager::endStatsBatch()
+{
+    if (statsBatchDepth_ > 0 && --statsBatchDepth_ == 0) {
+        notifyBrokenCueCount();
+    }
+}
+
+// Media Validation
+
+bool CueManager::validateCue(Cue* cue)
+{
+    if (!cue) {
+        return false;
+    }
+
+    // Only media references are probed; other cue types have nothing on disk to check
+    auto* audioCue = qobject_cast<AudioCue*>(cue);
+    if (!audioCue) {
+        return cue->status() != CueStatus::Broken;
+    }
+
+    const MediaProbe probe = mediaValidator_->probe(mediaPathOf(audioCue));
+    applyValidationResult(audioCue, probe);
+    return probe.valid;
+}
+
+void CueManager::validateAllCues()
+{
+    QList<QPair<QString, QString>> jobs;
+    {
+        QReadLocker locker(&cueListLock_);
+        for (Cue* cue : std::as_const(cues_)) {
+            if (auto* audioCue = qobject_cast<AudioCue*>(cue)) {
+                jobs.append(qMakePair(audioCue->id(), mediaPathOf(audioCue)));
+            }
+        }
+    }
+
+    qDebug() << "Validating" << jobs.size() << "media files";
+    mediaValidator_->validate(jobs);
+}
+
+QString CueManager::mediaPathOf(AudioCue* cue)
+{
+    // Loaded from the summary; only workspaces written before it carried the path need the details
+    if (cue->filePath().isEmpty() && !cue->isHydrated()) {
+        cue->hydrate();
+    }
+    return cue->filePath();
+}
+
+void CueManager::cancelValidation()
+{
+    mediaValidator_->cancel();
+}
+
+void CueManager::onValidationBatch(const QList<QPair<QString, MediaProbe>>& results)
+{
+    beginStatsBatch();
+    for (const auto& result : results) {
+        if (Cue* cue = lookupCue(result.first)) {
+            applyValidationResult(cue, result.second);
+        }
+    }
+    endStatsBatch();
+}
+
+void CueManager::applyValidationResult(Cue* cue, const MediaProbe& probe)
+{
+    const bool wasBroken = cue->status() == CueStatus::Broken;
+    if (probe.valid == !wasBroken) {
+        return;
+    }
+
+    if (!probe.valid) {
+        qWarning() << "Cue" << cue->number() << "media invalid:" << probe.path << probe.error;
+    }
+
+    cue->setStatus(probe.valid ? CueStatus::Loaded : CueStatus::Broken);
+    emit cueValidationChanged(cue->id(), probe.valid);
+}
+// Search and Filtering
+
+CueSearchIndex* CueManager::searchIndex() const
+{
+    return searchIndex_.get();
+}
+
+QList<Cue*> CueManager::findCues(const QString& searchText) const
+{
+    return cuesForIds(searchIndex_->search(searchText));
+}
+
+QList<Cue*> CueManager::findCuesByNumber(const QString& number) const
+{
+    return cuesForIds(searchIndex_->searchNumber(number));
+}
+
+QList<Cue*> CueManager::findCuesByName(const QString& name) const
+{
+    return cuesForIds(searchIndex_->searchName(name));
+}
+
+QList<Cue*> CueManager::filterCuesByType(CueType type) const
+{
+    return getCuesOfType(type);
+}
+
+QList<Cue*> CueManager::filterCuesByStatus(CueStatus status) const
+{
+    QReadLocker locker(&cueListLock_);
+
+    QList<Cue*> result;
     for (Cue* cue : cues_) {
-        if (cue->status() == CueStatus::Broken) {
-            brokenCues.append(cue);
+        if (cue->status() == status) {
+            result.append(cue);
         }
     }
-    return brokenCues;
-}
\ No newline at end of file
+    return result;
+}
+
+QList<Cue*> CueManager::cuesForIds(const QStringList& cueIds) const
+{
+    QReadLocker locker(&cueListLock_);
+
+    QList<Cue*> result;
+    result.reserve(cueIds.size());
+    for (const QString& cueId : cueIds) {
+        if (Cue* cue = lookupCue(cueId)) {
+            result.append(cue);
+        }
+    }
+    return result;
+}
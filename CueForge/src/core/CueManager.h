@@ -10,9 +10,15 @@
 #include <QMutex>
 #include <QReadWriteLock>
 #include <QStringList>
+#include <QHash>
+#include <QMap>
+#include <QSet>
 #include <memory>
 
 #include "Cue.h"
+#include "Workspace.h"
+#include "CueClipboard.h"
+#include "MediaValidator.h"
 
 // Forward declarations
 class GroupCue;
@@ -21,6 +27,11 @@ class VideoCue;
 class MIDICue;
 class FadeCue;
 class ControlCue;
+class CueScheduler;
+class MediaPool;
+class AutosaveService;
+class UndoStack;
+class CueSearchIndex;
 
 /**
  * @brief Central management system for all cues in CueForge
@@ -55,6 +66,7 @@ public:
     QString addCueAt(CueType type, int index, const QVariantMap& options = {});
     bool removeCue(const QString& cueId);
     bool removeCues(const QStringList& cueIds);
+    bool setCueProperty(const QString& cueId, const char* property, const QVariant& value);  // Undoable edit
 
     // Cue access
     Cue* getCue(const QString& cueId) const;
@@ -67,7 +79,7 @@ public:
     bool moveCue(const QString& cueId, int newIndex);
     bool moveCues(const QStringList& cueIds, int newIndex);
     bool moveSelectedCues(int newIndex);
-    QList<Cue*> getFlattenedCues() const; // Include group children when expanded
+    QList<Cue*> getFlattenedCues() const; // Include group children when expanded (cached)
     QString getNextCueNumber() const;
     void resequenceCues(const QString& startNumber = "1", double increment = 1.0);
 
@@ -88,7 +100,13 @@ public:
     QString standByCueId() const { return standByCueId_; }
     void setStandByCue(const QString& cueId);
     void advanceStandBy();                    // Move to next executable cue
+    QList<Cue*> getUpcomingExecutableCues(int count) const; // Standby cue and the ones GO reaches next
+    Cue* getNextExecutableCue(const QString& afterCueId) const;
+    void setScheduler(CueScheduler* scheduler);  // Audio-clock GO; null falls back to QTimer waits
+    void setMediaPool(const MediaPool* pool);    // Reported by getCueStatistics(); not owned
     void go();                               // Execute standby cue
+    void goCues(const QStringList& cueIds);  // Fire cues together (same sample via the scheduler)
+    void adoptRemoteStart(AudioCue* cue, bool wasGo);  // Network control already posted its Play
     void stop();                             // Stop all cues
     void pause();                            // Pause active cues
     void resume();                           // Resume paused cues  
@@ -105,25 +123,52 @@ public:
     void expandAllGroups();
     void collapseAllGroups();
     QList<Cue*> getGroupChildren(const QString& groupId) const;
+    GroupCue* getParentGroup(const QString& cueId) const;     // Null for top-level cues
+
+    // Expanded view as rows (same order as getFlattenedCues); O(1) per row
+    int visibleRowCount() const;
+    Cue* getVisibleCue(int row) const;
+    int findVisibleRow(const QString& cueId) const;         // -1 if hidden in a collapsed group
 
     // Clipboard operations (matching JS clipboard functions)
     void cutSelectedCues();
     void copySelectedCues();
     void pasteCues();
     void pasteCuesAt(int index);
-    bool hasClipboard() const { return !clipboard_.isEmpty(); }
+    bool hasClipboard() const;          // In-process copy, or cues on the system clipboard
     void clearClipboard();
+    QStringList duplicateSelectedCues();    // Inserted after the selection; clipboard untouched
 
     // Workspace management
     void newWorkspace();
     bool openWorkspace(const QString& filePath);
+    bool openWorkspace(const QString& filePath, const Workspace::File& file);  // Already read, e.g. by a startup worker
     bool saveWorkspace(const QString& filePath = QString());
     bool saveWorkspaceAs(const QString& filePath);
+    bool exportWorkspace(const QString& filePath) const;   // Always JSON, path/modified state untouched
     QString currentWorkspacePath() const { return workspacePath_; }
     bool hasUnsavedChanges() const { return hasUnsavedChanges_; }
-    void markWorkspaceModified();
+    void markWorkspaceModified(const Cue* cue = nullptr);   // Null = structural change
     QString getWorkspaceTitle() const;
 
+    // Undo/redo (edits made through CueManager are recorded as deltas)
+    UndoStack* undoStack() const { return undoStack_.get(); }
+    void undo();
+    void redo();
+    bool canUndo() const;
+    bool canRedo() const;
+
+    // Undo support: detached cues stay alive, owned by the caller, until restored
+    QList<QPair<int, Cue*>> detachCues(const QStringList& cueIds);
+    void restoreCues(const QList<QPair<int, Cue*>>& cues);   // Ascending original positions
+
+    // Autosave support (main thread)
+    AutosaveService* autosave() const { return autosave_.get(); }
+    QSet<QString> takeDirtyCueIds(bool* structureChanged, QList<Workspace::ListEdit>* listEdits = nullptr);
+    Workspace::Contents snapshotWorkspace() const;
+    QList<QPair<int, Workspace::CueSummary>> snapshotCues(const QSet<QString>& cueIds, bool* complete) const;
+    bool restoreWorkspace(const Workspace::Contents& contents, const QString& filePath);
+
     // Status and monitoring
     bool hasActiveCues() const;
     bool isPaused() const { return isPaused_; }
@@ -132,12 +177,14 @@ public:
     QList<Cue*> getBrokenCues() const;
 
     // Cue validation and fixing
-    bool validateCue(Cue* cue);
-    void validateAllCues();
+    bool validateCue(Cue* cue);             // Synchronous, cached probe
+    void validateAllCues();                 // Background; results arrive in batches
+    void cancelValidation();
     QString getTargetDisplayText(Cue* cue) const;
     QStringList getTargetCueIds(Cue* cue) const;
 
-    // Search and filtering
+    // Search and filtering (indexed; see CueSearchIndex for chunked searches)
+    CueSearchIndex* searchIndex() const;
     QList<Cue*> findCues(const QString& searchText) const;
     QList<Cue*> findCuesByNumber(const QString& number) const;
     QList<Cue*> findCuesByName(const QString& name) const;
@@ -155,6 +202,22 @@ public:
         int controlCues = 0;
         int brokenCues = 0;
         double totalDuration = 0.0;
+
+        // Shared decoded-media pool (all zero without an audio engine)
+        quint64 mediaPoolHits = 0;
+        quint64 mediaPoolMisses = 0;
+        quint64 mediaPoolEvictions = 0;
+        int mediaPoolEntries = 0;
+        qint64 mediaPoolBytes = 0;
+        qint64 mediaPoolBudgetBytes = 0;
+
+        // Cue memory, group children included (approximate, see Cue::memoryUsage())
+        int allocatedCues = 0;
+        qint64 cueMemoryBytes = 0;
+        qint64 bytesPerCue = 0;         // Including a share of the interned strings
+        int internedStrings = 0;
+        qint64 internedBytes = 0;
+        int pendingWaits = 0;           // Pre/post waits queued on the shared timer
     };
     CueStats getCueStatistics() const;
 
@@ -163,6 +226,7 @@ public slots:
     void onCuePropertyChanged();
     void onCueStatusChanged();
     void onCueExecutionFinished();
+    void onScheduledCueFired(const QString& cueId);
 
     // Group expansion slots
     void onGroupExpansionChanged(const QString& groupId, bool expanded);
@@ -203,10 +267,13 @@ signals:
 
     // Status signals
     void cueValidationChanged(const QString& cueId, bool isValid);
+    void validationProgress(int completed, int total);
+    void validationFinished();
     void brokenCueCountChanged(int count);
 
 private slots:
     void processCueExecution();
+    void onValidationBatch(const QList<QPair<QString, MediaProbe>>& results);
     void updateActiveCues();
     void onExecutionTimer();
 
@@ -214,11 +281,20 @@ private:
     // Core cue management
     Cue* createCueOfType(CueType type);
     void insertCueAt(Cue* cue, int index);
+    void insertCuesAt(const QList<QPair<int, Cue*>>& cues);   // Ascending final positions; one splice and reindex
     void removeCueAt(int index);
+    Cue* lookupCue(const QString& cueId) const;     // Unlocked O(1) lookup
+    void reindexCues(int fromIndex = 0);           // Refresh cueIndexById_ from fromIndex on
+    QString computeNextCueNumber() const;          // Unlocked getNextCueNumber()
+    void trackCueNumber(const Cue* cue);           // (Re)count a top-level cue's number
+    void untrackCueNumber(const QString& cueId);
     QString generateUniqueCueId() const;
     void connectCueSignals(Cue* cue);
     void disconnectCueSignals(Cue* cue);
 
+    bool isRecordingUndo() const;
+    QList<Cue*> cuesForIds(const QStringList& cueIds) const;   // Skips IDs no longer in the list
+
     // Selection helpers
     void updateSelection(const QStringList& newSelection);
     void ensureValidSelection();
@@ -229,21 +305,70 @@ private:
     bool isCueExecutable(Cue* cue) const;
 
     // Group management helpers
-    GroupCue* findParentGroup(const QString& cueId) const;
+    GroupCue* findParentGroup(const QString& cueId) const;  // Caller holds cueListLock_
     void updateGroupChildren(GroupCue* group);
 
+    // Group tree cache (caller holds cueListLock_ and groupTreeMutex_ unless noted)
+    void ensureGroupTree() const;                   // Rebuilds parents and rows if invalidated
+    void invalidateGroupTree();                     // Locks groupTreeMutex_ itself
+    void linkGroupChildren(GroupCue* group) const;  // Parent pointers for the whole subtree
+    void appendVisibleChildren(const GroupCue* group, QList<Cue*>& rows) const;
+    void spliceVisibleRows(int row, int removeCount, const QList<Cue*>& rows) const;
+    void reindexVisibleRows(int fromRow) const;
+
+    // Autosave helpers
+    void recordListEdit(Workspace::ListEdit::Kind kind, const QList<int>& positions, int index = 0);
+    void noteUnsavedChanges();
+
+    // Clipboard helpers
+    QList<Workspace::CueSummary> summarizeSelection(int* lastIndex = nullptr) const;
+    QStringList insertSummaries(const QList<Workspace::CueSummary>& summaries, int index);
+
     // Workspace serialization
+    bool writeWorkspaceFile(const QString& filePath, Workspace::Format format) const;
+    QJsonObject workspaceSettings() const;
+    void applyWorkspaceSettings(const QJsonObject& settings);
     QJsonObject serializeWorkspace() const;
     bool deserializeWorkspace(const QJsonObject& json);
+    Workspace::Contents collectWorkspaceContents() const;
+    bool loadWorkspaceContents(const Workspace::Contents& contents);   // Summaries only, details stay deferred
     void clearWorkspace();
 
     // Validation helpers
     void validateCueTargets();
     void updateBrokenCueCount();
+    void applyValidationResult(Cue* cue, const MediaProbe& probe);
+    static QString mediaPathOf(AudioCue* cue);     // Without hydrating when the summary had it
+
+    // Statistics helpers
+    struct StatsContribution {
+        CueType type = CueType::Audio;
+        bool broken = false;
+        double duration = 0.0;
+    };
+    void addToStats(const Cue* cue);
+    void removeFromStats(const QString& cueId);
+    void updateStats(const Cue* cue);
+    void rebuildStats();
+    void applyContribution(const StatsContribution& contribution, int sign);
+    void notifyBrokenCueCount();
+    void beginStatsBatch();                 // Defers brokenCueCountChanged to endStatsBatch()
+    void endStatsBatch();
+    static StatsContribution contributionOf(const Cue* cue);
+    static void addMemoryOf(const Cue* cue, CueStats& stats);     // Recurses into groups
 
     // Core data (matching JS structure)
     QList<Cue*> cues_;                          // Main cue list
     QStringList selectedCueIds_;                // Selected cue IDs
+
+    // Lookup index (kept in sync by insertCueAt/removeCueAt/moveCues)
+    QHash<QString, Cue*> cueById_;              // Cue ID -> top-level cue
+    QHash<QString, int> cueIndexById_;          // Cue ID -> position in cues_
+    QSet<QString> selectedCueIdSet_;            // Mirror of selectedCueIds_ for membership tests
+
+    // Next cue number: highest numeric top-level number, kept by the same sites as the index
+    QMap<double, int> cueNumberCounts_;         // Numeric cue number -> top-level cues using it
+    QHash<QString, double> cueNumberById_;      // Cue ID -> number it is counted under
     QString standByCueId_;                      // Current standby cue
     QString workspacePath_;                     // Current workspace file
     bool hasUnsavedChanges_;                    // Modification flag
@@ -251,23 +376,51 @@ private:
 
     // Execution management
     QTimer* executionTimer_;                    // Cue execution processing timer
+    CueScheduler* scheduler_;                   // Not owned
+    const MediaPool* mediaPool_;                // Not owned
     QList<Cue*> activeCues_;                   // Currently executing cues
-    QMap<QString, bool> groupExpansionState_;  // Group expansion states
-    int brokenCueCount_;                       // Cached broken cue count
+    QHash<QString, bool> groupExpansionState_; // Group expansion states
+
+    // Group tree: parent pointers and the flattened visible rows, rebuilt lazily after
+    // structural edits and spliced in place when a group expands, collapses or ungroups
+    mutable QHash<QString, GroupCue*> parentGroupById_;     // Nested cue -> containing group
+    mutable QList<Cue*> visibleRows_;
+    mutable QHash<QString, int> visibleRowById_;
+    mutable bool groupTreeValid_;
+    mutable QMutex groupTreeMutex_;             // Cache only; taken after cueListLock_
 
     // Clipboard system
-    QJsonArray clipboard_;                      // Clipboard data (JSON format)
+    CueClipboard clipboard_;                    // Summaries sharing the source cues' detail chunks
+
+    // Autosave (edits since the last autosave tick)
+    QSet<QString> dirtyCueIds_;
+    QList<Workspace::ListEdit> listEdits_;      // Top-level inserts, removes and moves, in order
+    bool structureDirty_;
+    std::unique_ptr<AutosaveService> autosave_;
+
+    // Undo history
+    std::unique_ptr<UndoStack> undoStack_;
+
+    // Search index (updated per cue from onCuePropertyChanged)
+    std::unique_ptr<CueSearchIndex> searchIndex_;
 
     // Thread safety
     mutable QReadWriteLock cueListLock_;       // Protects cue list access
     mutable QMutex selectionMutex_;            // Protects selection changes
     mutable QMutex playheadMutex_;             // Protects playhead changes
 
-    // Statistics cache
-    mutable CueStats cachedStats_;
-    mutable bool statsValid_;
+    // Statistics (running aggregates, adjusted by each cue's last contribution)
+    CueStats stats_;
+    QHash<QString, StatsContribution> statsByCue_;
+    QSet<QString> brokenCueIds_;
+    int reportedBrokenCount_;                  // Last value sent with brokenCueCountChanged
+    int statsBatchDepth_;
+
+    // Background media probing
+    std::unique_ptr<MediaValidator> mediaValidator_;
 
     // Constants
     static constexpr int EXECUTION_TIMER_INTERVAL = 50;  // 20 FPS execution updates
     static constexpr double DEFAULT_CUE_DURATION = 5.0;   // Default cue duration
+    static constexpr int WORKSPACE_JSON_VERSION = 1;
 };
\ No newline at end of file
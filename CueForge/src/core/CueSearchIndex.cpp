@@ -0,0 +1,515 @@
+// src/core/CueSearchIndex.cpp - Incremental token and number index for cue search
+#include "CueSearchIndex.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Cue.h"
+#include "CueManager.h"
+
+CueSearchIndex::CueSearchIndex(CueManager* cueManager, QObject* parent)
+    : QObject(parent)
+    , cueManager_(cueManager)
+    , revision_(0)
+    , searchTimer_(new QTimer(this))
+    , nextSearchId_(0)
+{
+    // Zero interval: one slice per event-loop pass, input and repaints run in between
+    searchTimer_->setInterval(0);
+    connect(searchTimer_, &QTimer::timeout, this, &CueSearchIndex::processSearchChunk);
+}
+
+CueSearchIndex::~CueSearchIndex() = default;
+
+// Maintenance
+
+void CueSearchIndex::addCue(const Cue* cue)
+{
+    updateCue(cue);
+}
+
+void CueSearchIndex::updateCue(const Cue* cue)
+{
+    if (!cue) {
+        return;
+    }
+
+    IndexedCue entry = indexEntryFor(cue);
+
+    auto existing = tokensByCue_.find(cue->id());
+    if (existing != tokensByCue_.end()) {
+        // Most property edits (levels, colors, timing) don't touch searchable text
+        if (existing->tokens == entry.tokens && existing->number == entry.number) {
+            return;
+        }
+        eraseTokens(cue->id(), *existing);
+    }
+
+    insertTokens(cue->id(), entry);
+    tokensByCue_.insert(cue->id(), std::move(entry));
+    ++revision_;
+}
+
+void CueSearchIndex::removeCue(const QString& cueId)
+{
+    auto existing = tokensByCue_.find(cueId);
+    if (existing == tokensByCue_.end()) {
+        return;
+    }
+
+    eraseTokens(cueId, *existing);
+    tokensByCue_.erase(existing);
+    ++revision_;
+}
+
+void CueSearchIndex::rebuild()
+{
+    tokenIndex_.clear();
+    nameIndex_.clear();
+    numberIndex_.clear();
+    numberPrefixIndex_.clear();
+    tokensByCue_.clear();
+
+    if (cueManager_) {
+        const QList<Cue*> cues = cueManager_->getAllCues();
+        tokensByCue_.reserve(cues.size());
+        for (const Cue* cue : cues) {
+            IndexedCue entry = indexEntryFor(cue);
+            insertTokens(cue->id(), entry);
+            tokensByCue_.insert(cue->id(), std::move(entry));
+        }
+    }
+
+    ++revision_;
+}
+
+CueSearchIndex::IndexedCue CueSearchIndex::indexEntryFor(const Cue* cue)
+{
+    IndexedCue entry;
+    entry.nameTokens = tokenize(cue->name());
+    entry.nameTokens.removeDuplicates();
+    entry.number = normalize(cue->number()).trimmed();
+
+    entry.tokens = entry.nameTokens;
+    entry.tokens.append(tokenize(cue->number()));
+    entry.tokens.append(normalize(cue->typeString()));
+    entry.tokens.removeDuplicates();
+    return entry;
+}
+
+void CueSearchIndex::insertTokens(const QString& cueId, const IndexedCue& entry)
+{
+    for (const QString& token : entry.tokens) {
+        tokenIndex_[token].insert(cueId);
+    }
+    for (const QString& token : entry.nameTokens) {
+        nameIndex_[token].insert(cueId);
+    }
+    if (!entry.number.isEmpty()) {
+        numberIndex_[NumberKey{ entry.number }].insert(cueId);
+        numberPrefixIndex_[entry.number].insert(cueId);
+    }
+}
+
+void CueSearchIndex::eraseTokens(const QString& cueId, const IndexedCue& entry)
+{
+    auto erase = [&cueId](auto& index, const auto& key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return;
+        }
+        it->remove(cueId);
+        if (it->isEmpty()) {
+            index.erase(it);
+        }
+    };
+
+    for (const QString& token : entry.tokens) {
+        erase(tokenIndex_, token);
+    }
+    for (const QString& token : entry.nameTokens) {
+        erase(nameIndex_, token);
+    }
+    if (!entry.number.isEmpty()) {
+        erase(numberIndex_, NumberKey{ entry.number });
+        erase(numberPrefixIndex_, entry.number);
+    }
+}
+
+// Normalization
+
+QString CueSearchIndex::normalize(const QString& text)
+{
+    // Compatibility decomposition splits accents off their base letters; drop the marks
+    const QString decomposed = text.normalized(QString::NormalizationForm_KD);
+
+    QString normalized;
+    normalized.reserve(decomposed.size());
+    for (const QChar ch : decomposed) {
+        if (ch.category() == QChar::Mark_NonSpacing) {
+            continue;
+        }
+        normalized.append(ch.toCaseFolded());
+    }
+    return normalized;
+}
+
+bool CueSearchIndex::naturalLess(QStringView a, QStringView b)
+{
+    qsizetype i = 0;
+    qsizetype j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i].isDigit() && b[j].isDigit()) {
+            // Compare digit runs by value: skip leading zeros, then longer run is larger
+            while (i < a.size() && a[i] == u'0') {
+                ++i;
+            }
+            while (j < b.size() && b[j] == u'0') {
+                ++j;
+            }
+            qsizetype endA = i;
+            qsizetype endB = j;
+            while (endA < a.size() && a[endA].isDigit()) {
+                ++endA;
+            }
+            while (endB < b.size() && b[endB].isDigit()) {
+                ++endB;
+            }
+            if (endA - i != endB - j) {
+                return endA - i < endB - j;
+            }
+            const int order = a.mid(i, endA - i).compare(b.mid(j, endB - j));
+            if (order != 0) {
+                return order < 0;
+            }
+            i = endA;
+            j = endB;
+            continue;
+        }
+
+        if (a[i] != b[j]) {
+            return a[i] < b[j];
+        }
+        ++i;
+        ++j;
+    }
+
+    if (i < a.size() || j < b.size()) {
+        return j < b.size();
+    }
+    // Equal by value ("01" and "1"): fall back to text so distinct keys stay distinct
+    return a < b;
+}
+
+QStringList CueSearchIndex::tokenize(const QString& text)
+{
+    const QString normalized = normalize(text);
+
+    QStringList tokens;
+    QString current;
+    for (int i = 0; i < normalized.size(); ++i) {
+        const QChar ch = normalized.at(i);
+
+        // Keep decimal points inside numbers so "2.5" stays one token
+        const bool decimalPoint = ch == QLatin1Char('.') && !current.isEmpty() && current.back().isDigit()
+            && i + 1 < normalized.size() && normalized.at(i + 1).isDigit();
+
+        if (ch.isLetterOrNumber() || decimalPoint) {
+            current.append(ch);
+        }
+        else if (!current.isEmpty()) {
+            tokens.append(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty()) {
+        tokens.append(current);
+    }
+    return tokens;
+}
+
+// Synchronous Queries
+
+QStringList CueSearchIndex::search(const QString& query, MatchMode mode) const
+{
+    return inListOrder(matchQuery(tokenize(query), mode, tokenIndex_));
+}
+
+QStringList CueSearchIndex::searchNumber(const QString& number, bool prefix) const
+{
+    const QString key = normalize(number).trimmed();
+    if (key.isEmpty()) {
+        return QStringList();
+    }
+
+    QSet<QString> matches;
+    if (prefix) {
+        collectPrefix(key, numberPrefixIndex_, matches);
+    }
+    else {
+        matches = numberIndex_.value(NumberKey{ key });
+    }
+    return inListOrder(matches);
+}
+
+QStringList CueSearchIndex::searchNumberRange(const QString& first, const QString& last) const
+{
+    const NumberKey from{ normalize(first).trimmed() };
+    const NumberKey to{ normalize(last).trimmed() };
+    if (from.text.isEmpty() || to.text.isEmpty() || to < from) {
+        return QStringList();
+    }
+
+    // Walk the natural order; cues sharing a number keep their list order
+    QStringList cueIds;
+    for (auto it = numberIndex_.lowerBound(from); it != numberIndex_.constEnd() && !(to < it.key()); ++it) {
+        cueIds.append(inListOrder(it.value()));
+    }
+    return cueIds;
+}
+
+QStringList CueSearchIndex::searchName(const QString& name, MatchMode mode) const
+{
+    return inListOrder(matchQuery(tokenize(name), mode, nameIndex_));
+}
+
+QSet<QString> CueSearchIndex::matchQuery(const QStringList& queryTokens, MatchMode mode, const TokenIndex& index) const
+{
+    QSet<QString> candidates;
+    for (int i = 0; i < queryTokens.size(); ++i) {
+        QSet<QString> matches = matchToken(queryTokens[i], mode, index);
+        if (i == 0) {
+            candidates = std::move(matches);
+        }
+        else {
+            candidates.intersect(matches);
+        }
+
+        if (candidates.isEmpty()) {
+            break;
+        }
+    }
+    return candidates;
+}
+
+QSet<QString> CueSearchIndex::matchToken(const QString& token, MatchMode mode, const TokenIndex& index) const
+{
+    QSet<QString> matches;
+    collectPrefix(token, index, matches);
+
+    const int budget = fuzzyBudget(token.size());
+    if (mode == MatchMode::Fuzzy && budget > 0) {
+        // Vocabulary is far smaller than the cue list, so a scan stays cheap
+        for (auto it = index.constBegin(); it != index.constEnd(); ++it) {
+            if (fuzzyMatches(token, it.key(), budget)) {
+                matches.unite(it.value());
+            }
+        }
+    }
+    return matches;
+}
+
+void CueSearchIndex::collectPrefix(const QString& token, const TokenIndex& index, QSet<QString>& matches)
+{
+    // Keys sharing a prefix are contiguous in the sorted map
+    for (auto it = index.lowerBound(token); it != index.constEnd() && it.key().startsWith(token); ++it) {
+        matches.unite(it.value());
+    }
+}
+
+QStringList CueSearchIndex::inListOrder(const QSet<QString>& cueIds) const
+{
+    std::vector<std::pair<int, QString>> ordered;
+    ordered.reserve(cueIds.size());
+    for (const QString& cueId : cueIds) {
+        const int index = cueManager_ ? cueManager_->findCueIndex(cueId) : -1;
+        if (index >= 0) {
+            ordered.emplace_back(index, cueId);
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    QStringList result;
+    result.reserve(static_cast<qsizetype>(ordered.size()));
+    for (const auto& entry : ordered) {
+        result.append(entry.second);
+    }
+    return result;
+}
+
+// Fuzzy Matching
+
+int CueSearchIndex::fuzzyBudget(int tokenLength)
+{
+    if (tokenLength < 3) {
+        return 0;       // Short tokens would match nearly everything
+    }
+    return tokenLength < 6 ? 1 : 2;
+}
+
+bool CueSearchIndex::fuzzyMatches(QStringView token, QStringView candidate, int maxDistance)
+{
+    if (withinEditDistance(token, candidate, maxDistance)) {
+        return true;
+    }
+
+    // Typo within what has been typed so far of a longer word
+    return candidate.size() > token.size()
+        && withinEditDistance(token, candidate.left(token.size()), maxDistance);
+}
+
+bool CueSearchIndex::withinEditDistance(QStringView a, QStringView b, int maxDistance)
+{
+    if (qAbs(a.size() - b.size()) > maxDistance) {
+        return false;
+    }
+
+    QVarLengthArray<int, 64> previous(b.size() + 1);
+    QVarLengthArray<int, 64> current(b.size() + 1);
+    for (qsizetype j = 0; j <= b.size(); ++j) {
+        previous[j] = static_cast<int>(j);
+    }
+
+    for (qsizetype i = 1; i <= a.size(); ++i) {
+        current[0] = static_cast<int>(i);
+        int rowMinimum = current[0];
+
+        for (qsizetype j = 1; j <= b.size(); ++j) {
+            const int substitution = previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+            current[j] = std::min({ previous[j] + 1, current[j - 1] + 1, substitution });
+            rowMinimum = std::min(rowMinimum, current[j]);
+        }
+
+        // Every later row is at least this row's minimum
+        if (rowMinimum > maxDistance) {
+            return false;
+        }
+        std::swap(previous, current);
+    }
+
+    return previous[b.size()] <= maxDistance;
+}
+
+// Chunked Search
+
+quint64 CueSearchIndex::startSearch(const QString& query, MatchMode mode)
+{
+    cancelSearch();
+
+    activeSearch_.id = ++nextSearchId_;
+    activeSearch_.mode = mode;
+    activeSearch_.queryTokens = tokenize(query);
+    restartMatching();
+
+    searchTimer_->start();
+    return activeSearch_.id;
+}
+
+void CueSearchIndex::cancelSearch()
+{
+    searchTimer_->stop();
+    activeSearch_ = ActiveSearch();
+}
+
+void CueSearchIndex::restartMatching()
+{
+    activeSearch_.revision = revision_;
+    activeSearch_.tokenPosition = 0;
+    activeSearch_.scanningVocabulary = false;
+    activeSearch_.tokenMatches.clear();
+    activeSearch_.candidates.clear();
+    activeSearch_.haveCandidates = false;
+    activeSearch_.ordered.clear();
+    activeSearch_.emitted = 0;
+}
+
+void CueSearchIndex::processSearchChunk()
+{
+    ActiveSearch& search = activeSearch_;
+    if (search.id == 0) {
+        searchTimer_->stop();
+        return;
+    }
+
+    const bool matching = search.tokenPosition < search.queryTokens.size();
+    if (matching && search.revision != revision_) {
+        // The index changed between slices; vocabulary iterators are no longer valid
+        restartMatching();
+    }
+
+    const quint64 searchId = search.id;
+    QElapsedTimer slice;
+    slice.start();
+
+    while (slice.elapsed() < CHUNK_BUDGET_MS) {
+        // Matching phase: one query token at a time, fuzzy vocabulary scans in slices
+        if (search.tokenPosition < search.queryTokens.size()) {
+            const QString& token = search.queryTokens[search.tokenPosition];
+            const int budget = fuzzyBudget(token.size());
+
+            if (!search.scanningVocabulary) {
+                search.tokenMatches.clear();
+                collectPrefix(token, tokenIndex_, search.tokenMatches);
+
+                if (search.mode == MatchMode::Fuzzy && budget > 0) {
+                    search.scanningVocabulary = true;
+                    search.vocabularyPosition = tokenIndex_.constBegin();
+                    continue;
+                }
+            }
+            else {
+                for (int checked = 0; checked < VOCABULARY_CHECK_INTERVAL
+                     && search.vocabularyPosition != tokenIndex_.constEnd(); ++checked, ++search.vocabularyPosition) {
+                    if (fuzzyMatches(token, search.vocabularyPosition.key(), budget)) {
+                        search.tokenMatches.unite(search.vocabularyPosition.value());
+                    }
+                }
+                if (search.vocabularyPosition != tokenIndex_.constEnd()) {
+                    continue;
+                }
+                search.scanningVocabulary = false;
+            }
+
+            if (search.haveCandidates) {
+                search.candidates.intersect(search.tokenMatches);
+            }
+            else {
+                search.candidates = std::move(search.tokenMatches);
+                search.haveCandidates = true;
+            }
+            search.tokenMatches.clear();
+
+            ++search.tokenPosition;
+            if (search.candidates.isEmpty()) {
+                search.tokenPosition = search.queryTokens.size();   // Nothing left to narrow
+            }
+            if (search.tokenPosition == search.queryTokens.size()) {
+                search.ordered = inListOrder(search.candidates);
+                search.candidates.clear();
+            }
+            continue;
+        }
+
+        // Emit phase: results in list order, a batch at a time
+        if (search.emitted < search.ordered.size()) {
+            const QStringList batch = search.ordered.mid(search.emitted, RESULT_BATCH_SIZE);
+            search.emitted += batch.size();
+            emit searchResults(searchId, batch);
+
+            if (activeSearch_.id != searchId) {
+                return;     // A receiver started or cancelled a search
+            }
+            continue;
+        }
+
+        const int total = search.ordered.size();
+        cancelSearch();
+        emit searchFinished(searchId, total);
+        return;
+    }
+}
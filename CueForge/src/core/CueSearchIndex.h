@@ -0,0 +1,139 @@
+// src/core/CueSearchIndex.h - Incremental token and number index for cue search
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QTimer>
+
+class Cue;
+class CueManager;
+
+/**
+ * @brief Search index over the top-level cue list
+ *
+ * Keeps a normalized-token inverted index (name, number and type words,
+ * case-folded with diacritics stripped) and a number index in natural order
+ * ("2" before "10", "1.5" before "1.10"). Queries
+ * are AND-ed across their tokens and each token matches by prefix; Fuzzy
+ * mode also accepts tokens within a small edit distance. Results come back
+ * as cue IDs in list order.
+ *
+ * The index is updated per cue (CueManager calls updateCue() from
+ * onCuePropertyChanged); bulk list changes trigger a rebuild. Long queries
+ * can run chunked on the event loop via startSearch(), streaming results
+ * through searchResults() in time-sliced batches.
+ */
+class CueSearchIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class MatchMode {
+        Prefix,     // Every query token is a prefix of some cue token
+        Fuzzy       // Prefix, or within the edit-distance budget for the token length
+    };
+
+    explicit CueSearchIndex(CueManager* cueManager, QObject* parent = nullptr);
+    ~CueSearchIndex();
+
+    // Maintenance
+    void addCue(const Cue* cue);
+    void updateCue(const Cue* cue);
+    void removeCue(const QString& cueId);
+    void rebuild();
+    int indexedCueCount() const { return tokensByCue_.size(); }
+
+    // Synchronous queries (IDs in list order)
+    QStringList search(const QString& query, MatchMode mode = MatchMode::Prefix) const;
+    QStringList searchNumber(const QString& number, bool prefix = false) const;
+    QStringList searchNumberRange(const QString& first, const QString& last) const;  // Inclusive, in number order
+    QStringList searchName(const QString& name, MatchMode mode = MatchMode::Prefix) const;
+
+    /**
+     * @brief Start a chunked search; any running search is cancelled
+     * @return Search ID carried by searchResults()/searchFinished()
+     */
+    quint64 startSearch(const QString& query, MatchMode mode = MatchMode::Prefix);
+    void cancelSearch();
+    bool isSearching() const { return activeSearch_.id != 0; }
+
+    // Normalization (exposed so callers can match the index's view of text)
+    static QString normalize(const QString& text);
+    static QStringList tokenize(const QString& text);
+    static bool naturalLess(QStringView a, QStringView b);     // Digit runs compare by value
+
+signals:
+    void searchResults(quint64 searchId, const QStringList& cueIds);
+    void searchFinished(quint64 searchId, int totalResults);
+
+private slots:
+    void processSearchChunk();
+
+private:
+    using TokenIndex = QMap<QString, QSet<QString>>;
+
+    struct NumberKey {
+        QString text;
+        bool operator<(const NumberKey& other) const { return naturalLess(text, other.text); }
+    };
+    using NumberIndex = QMap<NumberKey, QSet<QString>>;
+
+    struct IndexedCue {
+        QStringList tokens;     // All tokens, as inserted into tokenIndex_
+        QStringList nameTokens;
+        QString number;         // Normalized number key
+    };
+
+    struct ActiveSearch {
+        quint64 id = 0;
+        quint64 revision = 0;           // Index revision the search started against
+        MatchMode mode = MatchMode::Prefix;
+        QStringList queryTokens;
+        int tokenPosition = 0;          // Query token being matched
+        TokenIndex::const_iterator vocabularyPosition;
+        bool scanningVocabulary = false;
+        QSet<QString> tokenMatches;     // Cues matching the current query token
+        QSet<QString> candidates;       // Intersection so far
+        bool haveCandidates = false;
+        QStringList ordered;            // Final results in list order
+        int emitted = 0;
+    };
+
+    void restartMatching();
+    void insertTokens(const QString& cueId, const IndexedCue& entry);
+    void eraseTokens(const QString& cueId, const IndexedCue& entry);
+    static IndexedCue indexEntryFor(const Cue* cue);
+
+    QSet<QString> matchQuery(const QStringList& queryTokens, MatchMode mode, const TokenIndex& index) const;
+    QSet<QString> matchToken(const QString& token, MatchMode mode, const TokenIndex& index) const;
+    static void collectPrefix(const QString& token, const TokenIndex& index, QSet<QString>& matches);
+    QStringList inListOrder(const QSet<QString>& cueIds) const;
+
+    static int fuzzyBudget(int tokenLength);
+    static bool fuzzyMatches(QStringView token, QStringView candidate, int maxDistance);
+    static bool withinEditDistance(QStringView a, QStringView b, int maxDistance);
+
+    CueManager* cueManager_;
+
+    TokenIndex tokenIndex_;                 // Token -> cue IDs (sorted for prefix ranges)
+    TokenIndex nameIndex_;                  // Name tokens only
+    NumberIndex numberIndex_;               // Normalized number -> cue IDs, natural order for ranges
+    TokenIndex numberPrefixIndex_;          // Same keys in text order, where prefixes are contiguous
+    QHash<QString, IndexedCue> tokensByCue_;
+    quint64 revision_;
+
+    // Chunked search state
+    QTimer* searchTimer_;
+    ActiveSearch activeSearch_;
+    quint64 nextSearchId_;
+
+    // Constants
+    static constexpr int CHUNK_BUDGET_MS = 4;           // Event-loop time per search slice
+    static constexpr int RESULT_BATCH_SIZE = 256;
+    static constexpr int VOCABULARY_CHECK_INTERVAL = 512;
+};
@@ -0,0 +1,79 @@
+// src/core/CueTimerService.cpp - One shared timer for every cue's pre/post wait
+#include "CueTimerService.h"
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+
+CueTimerService* CueTimerService::instance()
+{
+    static QPointer<CueTimerService> service;
+    if (!service && QCoreApplication::instance()) {
+        service = new CueTimerService(QCoreApplication::instance());
+    }
+    return service;
+}
+
+CueTimerService::CueTimerService(QObject* parent)
+    : QObject(parent)
+    , timer_(new QTimer(this))
+    , clock_()
+    , deadlines_()
+    , pending_()
+{
+    clock_.start();
+
+    // Waits are show timing: the default coarse timer may be 5% late
+    timer_->setSingleShot(true);
+    timer_->setTimerType(Qt::PreciseTimer);
+    connect(timer_, &QTimer::timeout, this, &CueTimerService::onTimeout);
+}
+
+void CueTimerService::schedule(const void* owner, int delayMs, std::function<void()> callback)
+{
+    cancel(owner);
+
+    Wait wait;
+    wait.owner = owner;
+    wait.callback = std::move(callback);
+    pending_.insert(owner, deadlines_.emplace(clock_.elapsed() + std::max(0, delayMs), std::move(wait)));
+    rearm();
+}
+
+void CueTimerService::cancel(const void* owner)
+{
+    const auto it = pending_.constFind(owner);
+    if (it == pending_.constEnd()) {
+        return;
+    }
+
+    deadlines_.erase(it.value());
+    pending_.erase(it);
+    rearm();
+}
+
+void CueTimerService::onTimeout()
+{
+    // Fire everything due; a callback may schedule or cancel other waits
+    const qint64 now = clock_.elapsed();
+    while (!deadlines_.empty() && deadlines_.begin()->first <= now) {
+        Wait wait = std::move(deadlines_.begin()->second);
+        pending_.remove(wait.owner);
+        deadlines_.erase(deadlines_.begin());
+        wait.callback();
+    }
+    rearm();
+}
+
+void CueTimerService::rearm()
+{
+    if (deadlines_.empty()) {
+        timer_->stop();
+        return;
+    }
+
+    const qint64 delay = std::max<qint64>(0, deadlines_.begin()->first - clock_.elapsed());
+    timer_->start(static_cast<int>(delay));
+}
@@ -0,0 +1,57 @@
+// src/core/CueTimerService.h - One shared timer for every cue's pre/post wait
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <functional>
+#include <map>
+
+class QTimer;
+
+/**
+ * @brief Deadline queue behind all cue pre-waits and post-waits
+ *
+ * Cue lists run to tens of thousands of cues, but only a handful wait at
+ * any moment. Instead of two QTimers per cue, waits are kept in a deadline
+ * queue served by a single precise timer that is always armed for the
+ * earliest one. Each owner has at most one pending wait; scheduling again
+ * replaces it.
+ *
+ * Main thread only.
+ */
+class CueTimerService : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief The application-wide service, created on first use and owned by the application object
+     * @return Null once the application object is gone
+     */
+    static CueTimerService* instance();
+
+    void schedule(const void* owner, int delayMs, std::function<void()> callback);
+    void cancel(const void* owner);
+    bool isPending(const void* owner) const { return pending_.contains(owner); }
+    int pendingCount() const { return pending_.size(); }
+
+private slots:
+    void onTimeout();
+
+private:
+    explicit CueTimerService(QObject* parent);
+
+    struct Wait {
+        const void* owner = nullptr;
+        std::function<void()> callback;
+    };
+    using Deadlines = std::multimap<qint64, Wait>;
+
+    void rearm();
+
+    QTimer* timer_;
+    QElapsedTimer clock_;
+    Deadlines deadlines_;                               // Clock milliseconds -> wait, earliest first
+    QHash<const void*, Deadlines::iterator> pending_;   // Owner -> its entry in deadlines_
+};
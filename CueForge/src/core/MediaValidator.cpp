@@ -0,0 +1,346 @@
+// src/core/MediaValidator.cpp - Concurrent media file probing for cue validation
+#include "MediaValidator.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtEndian>
+#include <cmath>
+
+#include "AudioCue.h"
+
+namespace {
+
+quint32 readLE32(const char* p) { return qFromLittleEndian<quint32>(p); }
+quint16 readLE16(const char* p) { return qFromLittleEndian<quint16>(p); }
+quint32 readBE32(const char* p) { return qFromBigEndian<quint32>(p); }
+quint16 readBE16(const char* p) { return qFromBigEndian<quint16>(p); }
+
+// RIFF/WAVE: walk chunks for "fmt " and "data"
+bool parseWav(const QByteArray& header, MediaProbe& probe)
+{
+    quint16 blockAlign = 0;
+    qint64 dataBytes = -1;
+
+    qsizetype offset = 12;
+    while (offset + 8 <= header.size()) {
+        const char* chunk = header.constData() + offset;
+        const quint32 chunkSize = readLE32(chunk + 4);
+
+        if (qstrncmp(chunk, "fmt ", 4) == 0 && offset + 8 + 16 <= header.size()) {
+            probe.channels = readLE16(chunk + 10);
+            probe.sampleRate = readLE32(chunk + 12);
+            blockAlign = readLE16(chunk + 20);
+        }
+        else if (qstrncmp(chunk, "data", 4) == 0) {
+            dataBytes = chunkSize;
+            break;      // Sample data follows; nothing more to find in the header
+        }
+
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (probe.channels <= 0 || probe.sampleRate <= 0.0 || blockAlign == 0) {
+        probe.error = QStringLiteral("WAV header has no usable fmt chunk");
+        return false;
+    }
+    if (dataBytes >= 0) {
+        probe.duration = static_cast<double>(dataBytes / blockAlign) / probe.sampleRate;
+    }
+    return true;
+}
+
+// IEEE 754 80-bit extended, as AIFF stores its sample rate
+double readExtended(const char* p)
+{
+    const int exponent = (readBE16(p) & 0x7fff) - 16383 - 63;
+    const quint64 mantissa = qFromBigEndian<quint64>(p + 2);
+    return std::ldexp(static_cast<double>(mantissa), exponent);
+}
+
+// FORM/AIFF(-C): COMM chunk has channels, frame count and rate
+bool parseAiff(const QByteArray& header, MediaProbe& probe)
+{
+    qsizetype offset = 12;
+    while (offset + 8 <= header.size()) {
+        const char* chunk = header.constData() + offset;
+        const quint32 chunkSize = readBE32(chunk + 4);
+
+        if (qstrncmp(chunk, "COMM", 4) == 0 && offset + 8 + 18 <= header.size()) {
+            probe.channels = readBE16(chunk + 8);
+            const quint32 frames = readBE32(chunk + 10);
+            probe.sampleRate = readExtended(chunk + 16);
+            if (probe.sampleRate > 0.0) {
+                probe.duration = frames / probe.sampleRate;
+            }
+            break;
+        }
+
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (probe.channels <= 0 || probe.sampleRate <= 0.0) {
+        probe.error = QStringLiteral("AIFF header has no usable COMM chunk");
+        return false;
+    }
+    return true;
+}
+
+// fLaC: the first metadata block is always STREAMINFO
+bool parseFlac(const QByteArray& header, MediaProbe& probe)
+{
+    if (header.size() < 4 + 4 + 18) {
+        probe.error = QStringLiteral("FLAC header is truncated");
+        return false;
+    }
+
+    const auto* info = reinterpret_cast<const uchar*>(header.constData() + 8);
+    const quint32 packed = (quint32(info[10]) << 24) | (quint32(info[11]) << 16) | (quint32(info[12]) << 8) | info[13];
+    probe.sampleRate = packed >> 12;
+    probe.channels = static_cast<int>(((packed >> 9) & 0x7) + 1);
+
+    const quint64 totalSamples = (quint64(info[13] & 0x0f) << 32)
+        | (quint64(info[14]) << 24) | (quint64(info[15]) << 16) | (quint64(info[16]) << 8) | info[17];
+    if (probe.sampleRate > 0.0) {
+        probe.duration = totalSamples / probe.sampleRate;
+    }
+    return probe.sampleRate > 0.0;
+}
+
+} // namespace
+
+MediaValidator::MediaValidator(QObject* parent)
+    : QObject(parent)
+    , batchTimer_(new QTimer(this))
+    , completed_(0)
+    , total_(0)
+{
+    pool_.setMaxThreadCount(MAX_IO_PARALLELISM);
+
+    batchTimer_->setInterval(BATCH_INTERVAL_MS);
+    connect(batchTimer_, &QTimer::timeout, this, &MediaValidator::drainResults);
+}
+
+MediaValidator::~MediaValidator()
+{
+    cancel();
+    pool_.waitForDone();
+}
+
+// Validation Passes
+
+void MediaValidator::validate(const QList<QPair<QString, QString>>& jobs)
+{
+    cancel();
+
+    const quint64 generation = generation_.load();
+    total_ = jobs.size();
+    completed_ = 0;
+
+    if (jobs.isEmpty()) {
+        emit finished();
+        return;
+    }
+
+    for (const auto& job : jobs) {
+        const QString cueId = job.first;
+        const QString path = job.second;
+
+        pool_.start([this, generation, cueId, path]() {
+            if (generation_.load(std::memory_order_relaxed) != generation) {
+                return;     // Superseded before this file's turn came
+            }
+
+            MediaProbe result = probeCached(path);
+
+            QMutexLocker locker(&resultMutex_);
+            if (generation_.load(std::memory_order_relaxed) == generation) {
+                pendingResults_.append(qMakePair(cueId, std::move(result)));
+            }
+        });
+    }
+
+    batchTimer_->start();
+    emit progress(0, total_);
+}
+
+void MediaValidator::cancel()
+{
+    generation_.fetch_add(1);
+    pool_.clear();      // Drop queued probes; running ones see the new generation
+    batchTimer_->stop();
+
+    {
+        QMutexLocker locker(&resultMutex_);
+        pendingResults_.clear();
+    }
+    completed_ = 0;
+    total_ = 0;
+}
+
+void MediaValidator::drainResults()
+{
+    QList<QPair<QString, MediaProbe>> batch;
+    {
+        QMutexLocker locker(&resultMutex_);
+        batch.swap(pendingResults_);
+    }
+
+    if (!batch.isEmpty()) {
+        completed_ += batch.size();
+        emit batchReady(batch);
+        emit progress(completed_, total_);
+    }
+
+    if (total_ > 0 && completed_ >= total_) {
+        batchTimer_->stop();
+        total_ = 0;
+        completed_ = 0;
+        emit finished();
+    }
+}
+
+// Probing
+
+MediaProbe MediaValidator::probe(const QString& path)
+{
+    return probeCached(path);
+}
+
+bool MediaValidator::cachedProbe(const QString& path, MediaProbe& result) const
+{
+    const QString normalized = normalizedPath(path);
+    QMutexLocker locker(&cacheMutex_);
+
+    const auto key = latestKeyByPath_.constFind(normalized);
+    if (key == latestKeyByPath_.constEnd()) {
+        return false;
+    }
+    result = cache_.value(*key);
+    return true;
+}
+
+void MediaValidator::clearCache()
+{
+    QMutexLocker locker(&cacheMutex_);
+    cache_.clear();
+    latestKeyByPath_.clear();
+}
+
+QString MediaValidator::normalizedPath(const QString& path)
+{
+    // String-only: no stat, so cachedProbe() stays cheap
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+QString MediaValidator::cacheKey(const QString& path, const QDateTime& modified, qint64 size)
+{
+    return QString("%1|%2|%3").arg(path).arg(modified.toMSecsSinceEpoch()).arg(size);
+}
+
+MediaProbe MediaValidator::probeCached(const QString& path)
+{
+    // The stat is unavoidable; it's what tells us whether the cached header is still current
+    const QFileInfo info(path);
+    if (!info.exists()) {
+        MediaProbe missing;
+        missing.path = path;
+        missing.error = QStringLiteral("File not found");
+        return missing;
+    }
+
+    // One spelling per file for both maps, however the cue refers to it
+    const QString normalized = normalizedPath(path);
+    const QString key = cacheKey(normalized, info.lastModified(), info.size());
+    {
+        QMutexLocker locker(&cacheMutex_);
+        const auto cached = cache_.constFind(key);
+        if (cached != cache_.constEnd()) {
+            return *cached;
+        }
+    }
+
+    MediaProbe result = probeFile(path);
+
+    QMutexLocker locker(&cacheMutex_);
+    const QString previousKey = latestKeyByPath_.value(normalized);
+    if (!previousKey.isEmpty() && previousKey != key) {
+        cache_.remove(previousKey);     // Older version of the same file
+    }
+    cache_.insert(key, result);
+    latestKeyByPath_.insert(normalized, key);
+    return result;
+}
+
+MediaProbe MediaValidator::probeFile(const QString& path)
+{
+    MediaProbe probe;
+    probe.path = path;
+
+    if (path.isEmpty()) {
+        probe.error = QStringLiteral("No file assigned");
+        return probe;
+    }
+
+    const QFileInfo info(path);
+    probe.size = info.size();
+    probe.modified = info.lastModified();
+
+    if (!AudioCue::isFormatSupported(path)) {
+        probe.error = QString("Unsupported format: %1").arg(info.suffix());
+        return probe;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        probe.error = file.errorString();
+        return probe;
+    }
+
+    const QByteArray header = file.read(HEADER_PROBE_BYTES);
+    if (header.size() < 12) {
+        probe.error = QStringLiteral("File is too short to be audio");
+        return probe;
+    }
+
+    const char* magic = header.constData();
+    if (qstrncmp(magic, "RIFF", 4) == 0 && qstrncmp(magic + 8, "WAVE", 4) == 0) {
+        probe.format = QStringLiteral("WAV");
+        probe.valid = parseWav(header, probe);
+    }
+    else if (qstrncmp(magic, "FORM", 4) == 0 && (qstrncmp(magic + 8, "AIFF", 4) == 0 || qstrncmp(magic + 8, "AIFC", 4) == 0)) {
+        probe.format = QStringLiteral("AIFF");
+        probe.valid = parseAiff(header, probe);
+    }
+    else if (qstrncmp(magic, "fLaC", 4) == 0) {
+        probe.format = QStringLiteral("FLAC");
+        probe.valid = parseFlac(header, probe);
+    }
+    else if (qstrncmp(magic, "OggS", 4) == 0) {
+        probe.format = QStringLiteral("OGG");
+        probe.valid = true;
+    }
+    else if (qstrncmp(magic, "caff", 4) == 0) {
+        probe.format = QStringLiteral("CAF");
+        probe.valid = true;
+    }
+    else if (qstrncmp(magic + 4, "ftyp", 4) == 0) {
+        probe.format = QStringLiteral("MP4");
+        probe.valid = true;
+    }
+    else if (qstrncmp(magic, "ID3", 3) == 0
+             || (static_cast<uchar>(magic[0]) == 0xff && (static_cast<uchar>(magic[1]) & 0xe0) == 0xe0)) {
+        probe.format = QStringLiteral("MP3");
+        probe.valid = true;
+    }
+    else {
+        probe.error = QStringLiteral("Unrecognized audio header");
+    }
+
+    if (!probe.valid && probe.error.isEmpty()) {
+        probe.error = QString("Malformed %1 header").arg(probe.format);
+    }
+    return probe;
+}
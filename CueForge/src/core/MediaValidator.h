@@ -0,0 +1,98 @@
+// src/core/MediaValidator.h - Concurrent media file probing for cue validation
+#pragma once
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <atomic>
+
+/**
+ * @brief Result of probing one media file's header
+ */
+struct MediaProbe {
+    QString path;
+    bool valid = false;
+    QString error;              // Why the file can't be played (empty when valid)
+    QString format;             // "WAV", "AIFF", "FLAC", "MP3", "OGG", "MP4", "CAF"
+    int channels = 0;           // 0 when the header doesn't say cheaply
+    double sampleRate = 0.0;
+    double duration = 0.0;      // Seconds, 0 when unknown
+    qint64 size = 0;
+    QDateTime modified;
+};
+
+/**
+ * @brief Probes media files on a bounded thread pool
+ *
+ * Relocated show folders on network storage make every stat and header read
+ * a round trip, so probes run MAX_IO_PARALLELISM at a time off the GUI
+ * thread. Results are cached by path + mtime + size (a stat is still needed
+ * per file, the header read is not) and handed back to the main thread in
+ * batches every BATCH_INTERVAL_MS so the cue list and status bar update once
+ * per batch rather than once per file.
+ */
+class MediaValidator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MediaValidator(QObject* parent = nullptr);
+    ~MediaValidator();
+
+    /**
+     * @brief Probe files for the given cues; a running pass is superseded
+     * @param jobs (cue ID, file path) pairs
+     */
+    void validate(const QList<QPair<QString, QString>>& jobs);
+    void cancel();
+    bool isRunning() const { return total_ > 0; }
+
+    /**
+     * @brief Synchronous probe through the same cache (single-cue validation)
+     */
+    MediaProbe probe(const QString& path);
+    bool cachedProbe(const QString& path, MediaProbe& result) const;
+    void clearCache();
+
+    static MediaProbe probeFile(const QString& path);  // Uncached header read
+
+signals:
+    void batchReady(const QList<QPair<QString, MediaProbe>>& results);  // (cue ID, probe)
+    void progress(int completed, int total);
+    void finished();
+
+private slots:
+    void drainResults();
+
+private:
+    static QString normalizedPath(const QString& path);   // Absolute and cleaned, the key for both maps
+    static QString cacheKey(const QString& path, const QDateTime& modified, qint64 size);
+    MediaProbe probeCached(const QString& path);
+
+    QThreadPool pool_;
+    QTimer* batchTimer_;
+    std::atomic<quint64> generation_{ 0 };     // Bumped per pass; stale workers drop their results
+
+    // Shared with workers
+    mutable QMutex cacheMutex_;
+    QHash<QString, MediaProbe> cache_;          // cacheKey -> probe
+    QHash<QString, QString> latestKeyByPath_;   // normalizedPath -> last cacheKey, for cachedProbe()
+
+    QMutex resultMutex_;
+    QList<QPair<QString, MediaProbe>> pendingResults_;
+
+    // Main-thread progress
+    int completed_;
+    int total_;
+
+    // Constants
+    static constexpr int MAX_IO_PARALLELISM = 4;    // Enough to hide latency without flooding a NAS
+    static constexpr int BATCH_INTERVAL_MS = 100;
+    static constexpr int HEADER_PROBE_BYTES = 64 * 1024;
+};
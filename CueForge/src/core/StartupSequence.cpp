@@ -0,0 +1,236 @@
+// src/core/StartupSequence.cpp - Staged, partly parallel application startup with timings
+#include "StartupSequence.h"
+
+#include <QDebug>
+#include <QMetaObject>
+#include <QThread>
+
+StartupSequence::StartupSequence(QObject* parent)
+    : QObject(parent)
+    , stages_()
+    , goReadyStages_()
+    , workerPool_()
+    , launchTimer_()
+    , pending_(0)
+    , goReadyMs_(-1)
+    , started_(false)
+    , finished_(false)
+{
+    workerPool_.setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+}
+
+StartupSequence::~StartupSequence()
+{
+    // Workers post back to this object and fill their owner's members
+    workerPool_.waitForDone();
+}
+
+void StartupSequence::setLaunchTimer(const QElapsedTimer& launchTimer)
+{
+    launchTimer_ = launchTimer;
+}
+
+void StartupSequence::addStage(const QString& name, Thread thread, const QStringList& after, std::function<bool()> function)
+{
+    Q_ASSERT(!started_);
+
+    Stage stage;
+    stage.timing.name = name;
+    stage.timing.thread = thread;
+    stage.after = after;
+    stage.function = std::move(function);
+    stages_.append(stage);
+}
+
+void StartupSequence::setGoReadyStages(const QStringList& names)
+{
+    goReadyStages_ = names;
+}
+
+void StartupSequence::start()
+{
+    if (started_) {
+        return;
+    }
+    started_ = true;
+
+    if (!launchTimer_.isValid()) {
+        launchTimer_.start();
+    }
+
+    for (const Stage& stage : std::as_const(stages_)) {
+        for (const QString& name : stage.after) {
+            if (indexOf(name) < 0) {
+                qWarning() << "Startup stage" << stage.timing.name << "depends on unknown stage" << name;
+            }
+        }
+    }
+
+    pending_ = stages_.size();
+    qDebug() << "Startup:" << pending_ << "stages, launched" << nowMs() << "ms ago";
+    schedule();
+}
+
+QList<StartupSequence::StageTiming> StartupSequence::timings() const
+{
+    QList<StageTiming> result;
+    result.reserve(stages_.size());
+    for (const Stage& stage : stages_) {
+        result.append(stage.timing);
+    }
+    return result;
+}
+
+// Scheduling
+
+void StartupSequence::schedule()
+{
+    for (int i = 0; i < stages_.size(); ++i) {
+        Stage& stage = stages_[i];
+        if (stage.state != State::Waiting) {
+            continue;
+        }
+
+        bool ready = true;
+        bool blocked = false;
+        for (const QString& name : std::as_const(stage.after)) {
+            const int dependency = indexOf(name);
+            const State state = dependency >= 0 ? stages_[dependency].state : State::Failed;
+            if (state == State::Failed || state == State::Skipped) {
+                blocked = true;
+            }
+            else if (state != State::Succeeded) {
+                ready = false;
+            }
+        }
+
+        if (blocked) {
+            stage.state = State::Skipped;
+            qWarning() << "Startup stage" << stage.timing.name << "skipped: a stage it needs failed";
+            onStageDone(i, false, -1, -1);
+            return; // onStageDone() schedules again
+        }
+
+        if (ready) {
+            runStage(i);
+        }
+    }
+}
+
+void StartupSequence::runStage(int index)
+{
+    Stage& stage = stages_[index];
+    stage.state = State::Running;
+    const std::function<bool()> function = stage.function;
+
+    if (stage.timing.thread == Thread::Worker) {
+        // QElapsedTimer is a plain value, so workers can read the launch clock too
+        const QElapsedTimer clock = launchTimer_;
+        workerPool_.start([this, index, function, clock]() {
+            const qint64 startMs = clock.elapsed();
+            const bool succeeded = function();
+            const qint64 endMs = clock.elapsed();
+            QMetaObject::invokeMethod(this, [this, index, succeeded, startMs, endMs]() {
+                onStageDone(index, succeeded, startMs, endMs);
+            }, Qt::QueuedConnection);
+        });
+        return;
+    }
+
+    // Main stages get their own event-loop pass: the window paints in between
+    QMetaObject::invokeMethod(this, [this, index, function]() {
+        const qint64 startMs = nowMs();
+        const bool succeeded = function();
+        onStageDone(index, succeeded, startMs, nowMs());
+    }, Qt::QueuedConnection);
+}
+
+void StartupSequence::onStageDone(int index, bool succeeded, qint64 startMs, qint64 endMs)
+{
+    Stage& stage = stages_[index];
+    if (stage.state == State::Running) {
+        stage.state = succeeded ? State::Succeeded : State::Failed;
+    }
+    stage.timing.startMs = startMs;
+    stage.timing.endMs = endMs;
+    stage.timing.succeeded = succeeded;
+    --pending_;
+
+    if (stage.state != State::Skipped) {
+        if (!succeeded) {
+            qWarning() << "Startup stage" << stage.timing.name << "failed after" << endMs - startMs << "ms";
+        }
+        emit stageFinished(stage.timing.name, succeeded, endMs - startMs);
+    }
+
+    checkGoReady();
+
+    if (pending_ > 0) {
+        schedule();
+        return;
+    }
+
+    finished_ = true;
+    logTimings();
+
+    bool allSucceeded = true;
+    for (const Stage& done : std::as_const(stages_)) {
+        allSucceeded = allSucceeded && done.state == State::Succeeded;
+    }
+    emit finished(allSucceeded);
+}
+
+void StartupSequence::checkGoReady()
+{
+    if (goReadyMs_ >= 0) {
+        return;
+    }
+
+    for (const QString& name : std::as_const(goReadyStages_)) {
+        const int index = indexOf(name);
+        if (index < 0 || stages_[index].state != State::Succeeded) {
+            return;
+        }
+    }
+
+    goReadyMs_ = nowMs();
+    if (goReadyMs_ > GO_READY_TARGET_MS) {
+        qWarning() << "Startup: GO-ready after" << goReadyMs_ << "ms, over the" << GO_READY_TARGET_MS << "ms target";
+    }
+    else {
+        qDebug() << "Startup: GO-ready after" << goReadyMs_ << "ms";
+    }
+    emit goReady(goReadyMs_);
+}
+
+// Private Implementation
+
+void StartupSequence::logTimings() const
+{
+    qDebug() << "Startup stages (ms since launch):";
+    for (const Stage& stage : stages_) {
+        const QString thread = stage.timing.thread == Thread::Main ? "main" : "worker";
+        if (stage.state == State::Skipped) {
+            qDebug().noquote() << QString("  %1 %2 skipped").arg(stage.timing.name, -16).arg(thread, -6);
+            continue;
+        }
+
+        qDebug().noquote() << QString("  %1 %2 %3 - %4 (%5 ms)%6")
+            .arg(stage.timing.name, -16)
+            .arg(thread, -6)
+            .arg(stage.timing.startMs, 5)
+            .arg(stage.timing.endMs, 5)
+            .arg(stage.timing.endMs - stage.timing.startMs)
+            .arg(stage.timing.succeeded ? QString() : QString(" FAILED"));
+    }
+}
+
+int StartupSequence::indexOf(const QString& name) const
+{
+    for (int i = 0; i < stages_.size(); ++i) {
+        if (stages_[i].timing.name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
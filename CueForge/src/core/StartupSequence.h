@@ -0,0 +1,104 @@
+// src/core/StartupSequence.h - Staged, partly parallel application startup with timings
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <functional>
+
+/**
+ * @brief Runs startup as named stages, each as soon as the stages it needs are done
+ *
+ * Worker stages run on a private pool, concurrently with each other and with
+ * the GUI thread; main stages run one per event-loop pass, so the window
+ * keeps painting between them. A stage that fails (returns false) skips every
+ * stage that depends on it; the others still run.
+ *
+ * Once all "GO-ready" stages have succeeded the show can be run: goReady() is
+ * emitted with the time since launch. When the last stage is done, the
+ * per-stage timings are written to the log.
+ */
+class StartupSequence : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Thread {
+        Main,       // GUI thread: anything that creates or touches QObjects living there
+        Worker      // Pool thread: file reads and parsing into plain values
+    };
+
+    struct StageTiming {
+        QString name;
+        Thread thread = Thread::Main;
+        qint64 startMs = -1;    // Since launch; -1 if the stage never ran
+        qint64 endMs = -1;
+        bool succeeded = false;
+    };
+
+    explicit StartupSequence(QObject* parent = nullptr);
+    ~StartupSequence();
+
+    /**
+     * @brief Measure from here instead of from start() (normally the top of main())
+     */
+    void setLaunchTimer(const QElapsedTimer& launchTimer);
+
+    /**
+     * @brief Add a stage; must be called before start()
+     * @param after Stages that must have succeeded first
+     * @param function Work of the stage; false marks it (and its dependents) failed
+     */
+    void addStage(const QString& name, Thread thread, const QStringList& after, std::function<bool()> function);
+    void setGoReadyStages(const QStringList& names);
+
+    void start();
+    bool isFinished() const { return finished_; }
+    bool isGoReady() const { return goReadyMs_ >= 0; }
+    qint64 goReadyMs() const { return goReadyMs_; }
+    QList<StageTiming> timings() const;
+
+signals:
+    void stageFinished(const QString& name, bool succeeded, qint64 durationMs);
+    void goReady(qint64 elapsedMs);
+    void finished(bool succeeded);
+
+private:
+    enum class State {
+        Waiting,
+        Running,
+        Succeeded,
+        Failed,
+        Skipped
+    };
+
+    struct Stage {
+        StageTiming timing;
+        QStringList after;
+        std::function<bool()> function;
+        State state = State::Waiting;
+    };
+
+    void schedule();                        // Starts every stage whose dependencies are done
+    void runStage(int index);
+    void onStageDone(int index, bool succeeded, qint64 startMs, qint64 endMs);
+    void checkGoReady();
+    void logTimings() const;
+    int indexOf(const QString& name) const;
+    qint64 nowMs() const { return launchTimer_.elapsed(); }
+
+    QList<Stage> stages_;
+    QStringList goReadyStages_;
+    QThreadPool workerPool_;
+    QElapsedTimer launchTimer_;
+    int pending_;                           // Stages not yet done
+    qint64 goReadyMs_;
+    bool started_;
+    bool finished_;
+
+    // Constants
+    static constexpr qint64 GO_READY_TARGET_MS = 2000;  // Back in the show within 2 s of a crash
+};
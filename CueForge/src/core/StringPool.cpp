@@ -0,0 +1,58 @@
+// src/core/StringPool.cpp - Interned strings shared between cues
+#include "StringPool.h"
+
+#include <QMutexLocker>
+
+StringPool& StringPool::instance()
+{
+    static StringPool pool;
+    return pool;
+}
+
+QString StringPool::intern(const QString& text)
+{
+    if (text.isEmpty() || text.size() > MAX_INTERNED_LENGTH) {
+        return text;
+    }
+
+    QMutexLocker locker(&mutex_);
+    const auto it = strings_.constFind(text);
+    if (it != strings_.constEnd()) {
+        return *it;
+    }
+
+    // Store a tight copy: the caller's buffer may have spare capacity
+    QString pooled = text;
+    pooled.squeeze();
+    strings_.insert(pooled);
+    return pooled;
+}
+
+void StringPool::purgeUnused()
+{
+    QMutexLocker locker(&mutex_);
+    for (auto it = strings_.begin(); it != strings_.end();) {
+        if (it->isDetached()) {
+            it = strings_.erase(it);       // Only the pool still holds it
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+int StringPool::count() const
+{
+    QMutexLocker locker(&mutex_);
+    return strings_.size();
+}
+
+qint64 StringPool::bytes() const
+{
+    QMutexLocker locker(&mutex_);
+    qint64 total = 0;
+    for (const QString& text : strings_) {
+        total += text.capacity() * static_cast<qint64>(sizeof(QChar));
+    }
+    return total;
+}
@@ -0,0 +1,45 @@
+// src/core/StringPool.h - Interned strings shared between cues
+#pragma once
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+/**
+ * @brief Deduplicates strings that repeat across a cue list
+ *
+ * Large workspaces repeat the same few names ("Fade out", "Wait"), file
+ * paths and custom property keys thousands of times. intern() hands back
+ * the pooled copy, so equal strings share one implicitly shared buffer
+ * instead of each cue holding its own.
+ *
+ * Strings nobody else references any more are dropped by purgeUnused().
+ */
+class StringPool
+{
+public:
+    static StringPool& instance();
+
+    QString intern(const QString& text);
+    void purgeUnused();
+
+    int count() const;
+    qint64 bytes() const;       // Character storage held by the pool
+
+    /**
+     * @brief Heap bytes a string costs its holder: nothing when the buffer is shared
+     */
+    static qint64 ownedBytes(const QString& text)
+    {
+        return text.isDetached() ? text.capacity() * static_cast<qint64>(sizeof(QChar)) : 0;
+    }
+
+private:
+    StringPool() = default;
+
+    mutable QMutex mutex_;
+    QSet<QString> strings_;
+
+    // Constants
+    static constexpr int MAX_INTERNED_LENGTH = 256;     // Longer text (notes, scripts) is rarely shared
+};
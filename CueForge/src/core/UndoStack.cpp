@@ -0,0 +1,378 @@
+// src/core/UndoStack.cpp - Delta-based undo/redo implementation
+#include "UndoStack.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QVariantMap>
+#include <utility>
+
+#include "Cue.h"
+#include "CueManager.h"
+#include "Workspace.h"
+
+namespace {
+
+qint64 estimateVariantBytes(const QVariant& value)
+{
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        return static_cast<qint64>(sizeof(QVariant)) + value.toString().size() * 2;
+    case QMetaType::QByteArray:
+        return static_cast<qint64>(sizeof(QVariant)) + value.toByteArray().size();
+    case QMetaType::QVariantMap: {
+        qint64 bytes = sizeof(QVariant);
+        const QVariantMap map = value.toMap();
+        for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+            bytes += it.key().size() * 2 + estimateVariantBytes(it.value()) + 16;
+        }
+        return bytes;
+    }
+    default:
+        return sizeof(QVariant);
+    }
+}
+
+} // namespace
+
+// CuePropertyCommand
+
+CuePropertyCommand::CuePropertyCommand(const QString& cueId, const QByteArray& property, const QVariant& before, const QVariant& after)
+    : cueId_(cueId)
+    , property_(property)
+    , before_(before)
+    , after_(after)
+{
+}
+
+void CuePropertyCommand::undo(CueManager* manager)
+{
+    if (Cue* cue = manager->getCue(cueId_)) {
+        cue->setProperty(property_.constData(), before_);
+    }
+}
+
+void CuePropertyCommand::redo(CueManager* manager)
+{
+    if (Cue* cue = manager->getCue(cueId_)) {
+        cue->setProperty(property_.constData(), after_);
+    }
+}
+
+bool CuePropertyCommand::mergeWith(const UndoCommand* other)
+{
+    const auto* newer = dynamic_cast<const CuePropertyCommand*>(other);
+    if (!newer || newer->cueId_ != cueId_ || newer->property_ != property_) {
+        return false;
+    }
+
+    // Keep the value from before the gesture, take the latest after
+    after_ = newer->after_;
+    return true;
+}
+
+qint64 CuePropertyCommand::byteSize() const
+{
+    return static_cast<qint64>(sizeof(*this)) + cueId_.size() * 2 + property_.size()
+        + estimateVariantBytes(before_) + estimateVariantBytes(after_);
+}
+
+QString CuePropertyCommand::text() const
+{
+    return QString("Change %1").arg(QString::fromLatin1(property_));
+}
+
+// ResequenceCommand
+
+ResequenceCommand::ResequenceCommand(const QStringList& cueIds, const QStringList& oldNumbers, const QString& startNumber, double increment)
+    : cueIds_(cueIds)
+    , oldNumbers_(oldNumbers)
+    , startNumber_(startNumber)
+    , increment_(increment)
+{
+}
+
+void ResequenceCommand::undo(CueManager* manager)
+{
+    for (int i = 0; i < cueIds_.size(); ++i) {
+        if (Cue* cue = manager->getCue(cueIds_[i])) {
+            cue->setNumber(oldNumbers_[i]);
+        }
+    }
+}
+
+void ResequenceCommand::redo(CueManager* manager)
+{
+    manager->resequenceCues(startNumber_, increment_);
+}
+
+qint64 ResequenceCommand::byteSize() const
+{
+    qint64 bytes = sizeof(*this);
+    for (int i = 0; i < cueIds_.size(); ++i) {
+        bytes += (cueIds_[i].size() + oldNumbers_[i].size()) * 2 + 2 * static_cast<qint64>(sizeof(QString));
+    }
+    return bytes;
+}
+
+QString ResequenceCommand::text() const
+{
+    return QStringLiteral("Renumber Cues");
+}
+
+// MoveCuesCommand
+
+MoveCuesCommand::MoveCuesCommand(const QList<QPair<int, QString>>& originalPositions, int newIndex)
+    : originalPositions_(originalPositions)
+    , newIndex_(newIndex)
+{
+}
+
+void MoveCuesCommand::undo(CueManager* manager)
+{
+    // Put each cue back in ascending order of its old slot; earlier slots are already final
+    for (const auto& position : std::as_const(originalPositions_)) {
+        const int currentIndex = manager->findCueIndex(position.second);
+        if (currentIndex < 0 || currentIndex == position.first) {
+            continue;
+        }
+
+        // moveCues() targets are in pre-removal coordinates
+        const int target = position.first > currentIndex ? position.first + 1 : position.first;
+        manager->moveCues(QStringList() << position.second, target);
+    }
+}
+
+void MoveCuesCommand::redo(CueManager* manager)
+{
+    QStringList cueIds;
+    cueIds.reserve(originalPositions_.size());
+    for (const auto& position : std::as_const(originalPositions_)) {
+        cueIds.append(position.second);
+    }
+    manager->moveCues(cueIds, newIndex_);
+}
+
+qint64 MoveCuesCommand::byteSize() const
+{
+    qint64 bytes = sizeof(*this);
+    for (const auto& position : originalPositions_) {
+        bytes += position.second.size() * 2 + static_cast<qint64>(sizeof(position));
+    }
+    return bytes;
+}
+
+QString MoveCuesCommand::text() const
+{
+    return originalPositions_.size() == 1 ? QStringLiteral("Move Cue") : QStringLiteral("Move Cues");
+}
+
+// CueListCommand
+
+CueListCommand::CueListCommand(Kind kind, const QStringList& cueIds, const QList<QPair<int, Cue*>>& detachedCues)
+    : kind_(kind)
+    , cueIds_(cueIds)
+    , detached_(detachedCues)
+    , detachedBytes_(0)
+{
+    for (const auto& entry : std::as_const(detached_)) {
+        detachedBytes_ += estimateCueBytes(entry.second);
+    }
+}
+
+CueListCommand::~CueListCommand()
+{
+    for (const auto& entry : std::as_const(detached_)) {
+        entry.second->deleteLater();
+    }
+}
+
+void CueListCommand::undo(CueManager* manager)
+{
+    if (kind_ == Kind::Insert) {
+        detach(manager);
+    }
+    else {
+        restore(manager);
+    }
+}
+
+void CueListCommand::redo(CueManager* manager)
+{
+    if (kind_ == Kind::Insert) {
+        restore(manager);
+    }
+    else {
+        detach(manager);
+    }
+}
+
+void CueListCommand::detach(CueManager* manager)
+{
+    detached_ = manager->detachCues(cueIds_);
+
+    detachedBytes_ = 0;
+    for (const auto& entry : std::as_const(detached_)) {
+        detachedBytes_ += estimateCueBytes(entry.second);
+    }
+}
+
+void CueListCommand::restore(CueManager* manager)
+{
+    manager->restoreCues(detached_);
+    detached_.clear();
+    detachedBytes_ = 0;
+}
+
+qint64 CueListCommand::byteSize() const
+{
+    qint64 bytes = static_cast<qint64>(sizeof(*this)) + detachedBytes_;
+    for (const QString& cueId : cueIds_) {
+        bytes += cueId.size() * 2 + static_cast<qint64>(sizeof(QString));
+    }
+    return bytes;
+}
+
+QString CueListCommand::text() const
+{
+    const QString noun = cueIds_.size() == 1 ? QStringLiteral("Cue") : QStringLiteral("Cues");
+    return kind_ == Kind::Insert ? QString("Add %1").arg(noun) : QString("Delete %1").arg(noun);
+}
+
+qint64 CueListCommand::estimateCueBytes(const Cue* cue)
+{
+    // Encoded details track the cue's own payload; the constant covers QObject overhead
+    constexpr qint64 OBJECT_OVERHEAD = 1024;
+    return OBJECT_OVERHEAD + Workspace::summarize(cue).details.size();
+}
+
+// UndoStack
+
+UndoStack::UndoStack(CueManager* manager, QObject* parent)
+    : QObject(parent)
+    , manager_(manager)
+    , undoBytes_(0)
+    , redoBytes_(0)
+    , byteBudget_(DEFAULT_BYTE_BUDGET)
+    , lastPushMs_(0)
+    , coalescing_(false)
+    , applying_(false)
+{
+}
+
+UndoStack::~UndoStack() = default;
+
+void UndoStack::push(std::unique_ptr<UndoCommand> command)
+{
+    if (!command || applying_) {
+        return;
+    }
+
+    // Anything pushed invalidates the redo branch
+    redoCommands_.clear();
+    redoBytes_ = 0;
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const bool withinGesture = coalescing_ && (nowMs - lastPushMs_) <= COALESCE_WINDOW_MS;
+    lastPushMs_ = nowMs;
+    coalescing_ = true;
+
+    if (withinGesture && !undoCommands_.empty()) {
+        UndoCommand* top = undoCommands_.back().get();
+        const qint64 before = top->byteSize();
+        if (top->mergeWith(command.get())) {
+            undoBytes_ += top->byteSize() - before;
+            emit stackChanged();
+            return;
+        }
+    }
+
+    undoBytes_ += command->byteSize();
+    undoCommands_.push_back(std::move(command));
+    enforceBudget();
+    emit stackChanged();
+}
+
+void UndoStack::undo()
+{
+    if (undoCommands_.empty()) {
+        return;
+    }
+
+    std::unique_ptr<UndoCommand> command = std::move(undoCommands_.back());
+    undoCommands_.pop_back();
+    undoBytes_ -= command->byteSize();
+
+    applying_ = true;
+    command->undo(manager_);
+    applying_ = false;
+    coalescing_ = false;
+
+    redoBytes_ += command->byteSize();     // Size can change (cues detached/restored)
+    redoCommands_.push_back(std::move(command));
+    enforceBudget();
+    emit stackChanged();
+}
+
+void UndoStack::redo()
+{
+    if (redoCommands_.empty()) {
+        return;
+    }
+
+    std::unique_ptr<UndoCommand> command = std::move(redoCommands_.back());
+    redoCommands_.pop_back();
+    redoBytes_ -= command->byteSize();
+
+    applying_ = true;
+    command->redo(manager_);
+    applying_ = false;
+    coalescing_ = false;
+
+    undoBytes_ += command->byteSize();
+    undoCommands_.push_back(std::move(command));
+    enforceBudget();
+    emit stackChanged();
+}
+
+void UndoStack::clear()
+{
+    if (undoCommands_.empty() && redoCommands_.empty()) {
+        return;
+    }
+
+    undoCommands_.clear();
+    redoCommands_.clear();
+    undoBytes_ = 0;
+    redoBytes_ = 0;
+    coalescing_ = false;
+    emit stackChanged();
+}
+
+QString UndoStack::undoText() const
+{
+    return undoCommands_.empty() ? QString() : undoCommands_.back()->text();
+}
+
+QString UndoStack::redoText() const
+{
+    return redoCommands_.empty() ? QString() : redoCommands_.back()->text();
+}
+
+void UndoStack::setByteBudget(qint64 bytes)
+{
+    byteBudget_ = qMax<qint64>(0, bytes);
+    enforceBudget();
+}
+
+void UndoStack::enforceBudget()
+{
+    // Oldest undo history goes first, then the far end of the redo branch
+    while (undoBytes_ + redoBytes_ > byteBudget_ && !undoCommands_.empty()) {
+        undoBytes_ -= undoCommands_.front()->byteSize();
+        undoCommands_.pop_front();
+    }
+    while (undoBytes_ + redoBytes_ > byteBudget_ && !redoCommands_.empty()) {
+        redoBytes_ -= redoCommands_.front()->byteSize();
+        redoCommands_.pop_front();
+    }
+}
@@ -0,0 +1,188 @@
+// src/core/UndoStack.h - Delta-based undo/redo for cue edits
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <deque>
+#include <memory>
+
+class Cue;
+class CueManager;
+
+/**
+ * @brief One reversible edit
+ *
+ * Commands store deltas (old/new values, positions), never workspace
+ * snapshots. They are pushed after the edit has been applied.
+ */
+class UndoCommand
+{
+public:
+    virtual ~UndoCommand() = default;
+
+    virtual void undo(CueManager* manager) = 0;
+    virtual void redo(CueManager* manager) = 0;
+
+    /**
+     * @brief Absorb a newer command of the same kind (slider drags, typing)
+     * @return true if other was merged and can be dropped
+     */
+    virtual bool mergeWith(const UndoCommand* other) { Q_UNUSED(other) return false; }
+
+    virtual qint64 byteSize() const = 0;    // Approximate heap footprint, for the budget
+    virtual QString text() const = 0;
+};
+
+/**
+ * @brief Single property delta on one cue, addressed by Q_PROPERTY name
+ */
+class CuePropertyCommand : public UndoCommand
+{
+public:
+    CuePropertyCommand(const QString& cueId, const QByteArray& property, const QVariant& before, const QVariant& after);
+
+    void undo(CueManager* manager) override;
+    void redo(CueManager* manager) override;
+    bool mergeWith(const UndoCommand* other) override;
+    qint64 byteSize() const override;
+    QString text() const override;
+
+private:
+    QString cueId_;
+    QByteArray property_;
+    QVariant before_;
+    QVariant after_;
+};
+
+/**
+ * @brief Whole-list renumbering as one entry (old numbers + the parameters to redo it)
+ */
+class ResequenceCommand : public UndoCommand
+{
+public:
+    ResequenceCommand(const QStringList& cueIds, const QStringList& oldNumbers, const QString& startNumber, double increment);
+
+    void undo(CueManager* manager) override;
+    void redo(CueManager* manager) override;
+    qint64 byteSize() const override;
+    QString text() const override;
+
+private:
+    QStringList cueIds_;
+    QStringList oldNumbers_;
+    QString startNumber_;
+    double increment_;
+};
+
+/**
+ * @brief Multi-cue move: original positions of the moved cues plus the target index
+ */
+class MoveCuesCommand : public UndoCommand
+{
+public:
+    MoveCuesCommand(const QList<QPair<int, QString>>& originalPositions, int newIndex);
+
+    void undo(CueManager* manager) override;
+    void redo(CueManager* manager) override;
+    qint64 byteSize() const override;
+    QString text() const override;
+
+private:
+    QList<QPair<int, QString>> originalPositions_;   // Ascending by index
+    int newIndex_;
+};
+
+/**
+ * @brief Cue insertion or removal
+ *
+ * Removed cues are kept alive (detached from the list) rather than
+ * re-created, so their IDs stay valid for every other command on the stack.
+ */
+class CueListCommand : public UndoCommand
+{
+public:
+    enum class Kind {
+        Insert,
+        Remove
+    };
+
+    // detachedCues: for Remove, the cues just taken out of the list (ownership passes in)
+    CueListCommand(Kind kind, const QStringList& cueIds, const QList<QPair<int, Cue*>>& detachedCues = {});
+    ~CueListCommand() override;
+
+    void undo(CueManager* manager) override;
+    void redo(CueManager* manager) override;
+    qint64 byteSize() const override;
+    QString text() const override;
+
+private:
+    void detach(CueManager* manager);
+    void restore(CueManager* manager);
+    static qint64 estimateCueBytes(const Cue* cue);
+
+    Kind kind_;
+    QStringList cueIds_;
+    QList<QPair<int, Cue*>> detached_;      // Owned while out of the list
+    qint64 detachedBytes_;
+};
+
+/**
+ * @brief Bounded undo/redo stack
+ *
+ * Memory is capped by an approximate byte budget: the oldest entries are
+ * dropped first. Consecutive commands arriving within COALESCE_WINDOW_MS
+ * are offered to mergeWith() so a slider drag becomes one entry;
+ * breakCoalescing() ends a gesture early (e.g. on mouse release).
+ */
+class UndoStack : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UndoStack(CueManager* manager, QObject* parent = nullptr);
+    ~UndoStack();
+
+    void push(std::unique_ptr<UndoCommand> command);
+    void undo();
+    void redo();
+    void clear();
+    void breakCoalescing() { coalescing_ = false; }
+
+    bool canUndo() const { return !undoCommands_.empty(); }
+    bool canRedo() const { return !redoCommands_.empty(); }
+    QString undoText() const;
+    QString redoText() const;
+
+    // True while a command is being applied; edits made then aren't recorded
+    bool isApplying() const { return applying_; }
+
+    void setByteBudget(qint64 bytes);
+    qint64 byteBudget() const { return byteBudget_; }
+    qint64 byteSize() const { return undoBytes_ + redoBytes_; }
+    int count() const { return static_cast<int>(undoCommands_.size() + redoCommands_.size()); }
+
+signals:
+    void stackChanged();
+
+private:
+    void enforceBudget();
+
+    CueManager* manager_;
+    std::deque<std::unique_ptr<UndoCommand>> undoCommands_;     // Newest at the back
+    std::deque<std::unique_ptr<UndoCommand>> redoCommands_;     // Next redo at the back
+    qint64 undoBytes_;
+    qint64 redoBytes_;
+    qint64 byteBudget_;
+    qint64 lastPushMs_;
+    bool coalescing_;
+    bool applying_;
+
+    // Constants
+    static constexpr qint64 DEFAULT_BYTE_BUDGET = 8 * 1024 * 1024;
+    static constexpr qint64 COALESCE_WINDOW_MS = 750;
+};
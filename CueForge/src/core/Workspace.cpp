@@ -0,0 +1,520 @@
+// src/core/Workspace.cpp - Workspace file format implementation
+#include "Workspace.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QColor>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QSignalBlocker>
+#include <QtEndian>
+#include <cstring>
+
+#include "AudioCue.h"
+#include "Cue.h"
+
+namespace {
+
+// Positions within a TOC entry array
+enum TocField {
+    TocType = 0,
+    TocNumber,
+    TocName,
+    TocStatus,
+    TocColor,
+    TocFlags,
+    TocDuration,
+    TocPreWait,
+    TocPostWait,
+    TocTargetId,
+    TocDetailOffset,
+    TocDetailLength,
+    TocFieldCount,                  // Fields every version 1 entry has
+    TocMediaPath = TocFieldCount    // Optional trailing field; older files lack it
+};
+
+enum TocFlag : int {
+    FlagArmed = 1 << 0,
+    FlagFlagged = 1 << 1,
+    FlagContinue = 1 << 2
+};
+
+// Keys carried by the TOC summary and therefore left out of detail chunks
+const char* const SUMMARY_KEYS[] = {
+    "id", "type", "number", "name", "status", "armed", "flagged",
+    "continueMode", "color", "duration", "preWait", "postWait", "targetId"
+};
+
+void setError(QString* error, const QString& message)
+{
+    if (error) {
+        *error = message;
+    }
+}
+
+// Replays one journaled list edit; false if it doesn't fit the list (the journal has diverged)
+bool applyListEdit(const Workspace::ListEdit& edit, QList<Workspace::CueSummary>& cues)
+{
+    using Kind = Workspace::ListEdit::Kind;
+
+    int previous = -1;
+    for (int position : edit.positions) {
+        if (position <= previous) {
+            return false;
+        }
+        previous = position;
+    }
+
+    switch (edit.kind) {
+    case Kind::Insert:
+        // Ascending final positions: inserting in order puts each one where it ends up
+        if (!edit.positions.isEmpty() && edit.positions.last() >= cues.size() + edit.positions.size()) {
+            return false;
+        }
+        for (int position : edit.positions) {
+            cues.insert(position, Workspace::CueSummary());
+        }
+        return true;
+
+    case Kind::Remove:
+        if (!edit.positions.isEmpty() && edit.positions.last() >= cues.size()) {
+            return false;
+        }
+        for (auto it = edit.positions.crbegin(); it != edit.positions.crend(); ++it) {
+            cues.removeAt(*it);
+        }
+        return true;
+
+    case Kind::Move: {
+        if (edit.positions.isEmpty() || edit.positions.last() >= cues.size()
+            || edit.index < 0 || edit.index > cues.size() - edit.positions.size()) {
+            return false;
+        }
+        QList<Workspace::CueSummary> moved;
+        moved.reserve(edit.positions.size());
+        for (auto it = edit.positions.crbegin(); it != edit.positions.crend(); ++it) {
+            moved.prepend(cues.takeAt(*it));
+        }
+        for (int i = 0; i < moved.size(); ++i) {
+            cues.insert(edit.index + i, moved[i]);
+        }
+        return true;
+    }
+    }
+
+    return false;
+}
+
+// Summary fields shared by TOC entries and journal records
+QCborArray encodeSummaryFields(const Workspace::CueSummary& summary)
+{
+    QCborArray entry;
+    entry.append(summary.type);
+    entry.append(summary.number);
+    entry.append(summary.name);
+    entry.append(summary.status);
+    entry.append(static_cast<qint64>(summary.color));
+    entry.append((summary.armed ? FlagArmed : 0)
+        | (summary.flagged ? FlagFlagged : 0)
+        | (summary.continueMode ? FlagContinue : 0));
+    entry.append(summary.duration);
+    entry.append(summary.preWait);
+    entry.append(summary.postWait);
+    entry.append(summary.targetId);
+    return entry;
+}
+
+Workspace::CueSummary decodeSummaryFields(const QCborArray& entry)
+{
+    const int flags = static_cast<int>(entry.at(TocFlags).toInteger());
+
+    Workspace::CueSummary summary;
+    summary.type = entry.at(TocType).toString();
+    summary.number = entry.at(TocNumber).toString();
+    summary.name = entry.at(TocName).toString();
+    summary.status = static_cast<int>(entry.at(TocStatus).toInteger());
+    summary.color = static_cast<QRgb>(entry.at(TocColor).toInteger(0xffffffff));
+    summary.armed = (flags & FlagArmed) != 0;
+    summary.flagged = (flags & FlagFlagged) != 0;
+    summary.continueMode = (flags & FlagContinue) != 0;
+    summary.duration = entry.at(TocDuration).toDouble();
+    summary.preWait = entry.at(TocPreWait).toDouble();
+    summary.postWait = entry.at(TocPostWait).toDouble();
+    summary.targetId = entry.at(TocTargetId).toString();
+    return summary;
+}
+
+} // namespace
+
+// Format Selection
+
+Workspace::Format Workspace::detectFormat(const QByteArray& data)
+{
+    if (data.size() >= HEADER_SIZE && std::memcmp(data.constData(), MAGIC, sizeof(MAGIC)) == 0) {
+        return Format::Binary;
+    }
+    return Format::Json;
+}
+
+Workspace::Format Workspace::formatForPath(const QString& filePath)
+{
+    return filePath.endsWith(".json", Qt::CaseInsensitive) ? Format::Json : Format::Binary;
+}
+
+// Files
+
+bool Workspace::readFile(const QString& filePath, File& file, QString* error)
+{
+    QFile input(filePath);
+    if (!input.open(QIODevice::ReadOnly)) {
+        setError(error, input.errorString());
+        return false;
+    }
+    const QByteArray data = input.readAll();
+    input.close();
+
+    file.format = detectFormat(data);
+    if (file.format == Format::Binary) {
+        return decodeBinary(data, file.contents, error);
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        setError(error, parseError.error != QJsonParseError::NoError ? parseError.errorString()
+                                                                     : QStringLiteral("Not a workspace document"));
+        return false;
+    }
+
+    file.json = document.object();
+    return true;
+}
+
+// Binary Format
+
+QByteArray Workspace::encodeBinary(const Contents& contents)
+{
+    QByteArray data(HEADER_SIZE, '\0');
+
+    // Detail chunks first, so the TOC can record where each one landed
+    QCborArray toc;
+    for (const CueSummary& summary : contents.cues) {
+        const qint64 offset = data.size();
+        data.append(summary.details);
+
+        QCborArray entry = encodeSummaryFields(summary);
+        entry.append(offset);
+        entry.append(static_cast<qint64>(summary.details.size()));
+        entry.append(summary.mediaPath);
+        toc.append(entry);
+    }
+
+    QCborMap root;
+    root.insert(QStringLiteral("settings"), QCborMap::fromJsonObject(contents.settings));
+    root.insert(QStringLiteral("cues"), toc);
+
+    const QByteArray tocBytes = root.toCborValue().toCbor();
+    const quint64 tocOffset = static_cast<quint64>(data.size());
+    data.append(tocBytes);
+
+    // Header
+    char* header = data.data();
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint16>(FORMAT_VERSION, header + 4);
+    qToLittleEndian<quint32>(static_cast<quint32>(contents.cues.size()), header + 8);
+    qToLittleEndian<quint64>(tocOffset, header + 16);
+    qToLittleEndian<quint64>(static_cast<quint64>(tocBytes.size()), header + 24);
+
+    return data;
+}
+
+bool Workspace::decodeBinary(const QByteArray& data, Contents& contents, QString* error)
+{
+    if (detectFormat(data) != Format::Binary) {
+        setError(error, QStringLiteral("Not a binary workspace"));
+        return false;
+    }
+
+    const char* header = data.constData();
+    const quint16 version = qFromLittleEndian<quint16>(header + 4);
+    const quint32 cueCount = qFromLittleEndian<quint32>(header + 8);
+    const quint64 tocOffset = qFromLittleEndian<quint64>(header + 16);
+    const quint64 tocLength = qFromLittleEndian<quint64>(header + 24);
+    const quint64 fileSize = static_cast<quint64>(data.size());
+
+    if (version > FORMAT_VERSION) {
+        setError(error, QStringLiteral("Workspace format version %1 is newer than supported").arg(version));
+        return false;
+    }
+    if (tocOffset < HEADER_SIZE || tocOffset > fileSize || tocLength > fileSize - tocOffset) {
+        setError(error, QStringLiteral("Workspace table of contents is out of range"));
+        return false;
+    }
+
+    QCborParserError parseError;
+    const QCborValue root = QCborValue::fromCbor(
+        data.mid(static_cast<qsizetype>(tocOffset), static_cast<qsizetype>(tocLength)), &parseError);
+    if (parseError.error != QCborError::NoError || !root.isMap()) {
+        setError(error, QStringLiteral("Corrupt table of contents: %1").arg(parseError.errorString()));
+        return false;
+    }
+
+    const QCborMap rootMap = root.toMap();
+    const QCborArray toc = rootMap.value(QStringLiteral("cues")).toArray();
+    if (static_cast<quint32>(toc.size()) != cueCount) {
+        setError(error, QStringLiteral("Cue count mismatch (%1 in header, %2 in table)").arg(cueCount).arg(toc.size()));
+        return false;
+    }
+
+    contents.settings = rootMap.value(QStringLiteral("settings")).toMap().toJsonObject();
+    contents.cues.clear();
+    contents.cues.reserve(toc.size());
+
+    for (const QCborValue& value : toc) {
+        const QCborArray entry = value.toArray();
+        if (entry.size() < TocFieldCount) {
+            setError(error, QStringLiteral("Truncated cue entry in table of contents"));
+            return false;
+        }
+
+        const qint64 detailOffset = entry.at(TocDetailOffset).toInteger(-1);
+        const qint64 detailLength = entry.at(TocDetailLength).toInteger(-1);
+        if (detailOffset < HEADER_SIZE || detailLength < 0
+            || static_cast<quint64>(detailOffset) > tocOffset
+            || static_cast<quint64>(detailLength) > tocOffset - static_cast<quint64>(detailOffset)) {
+            setError(error, QStringLiteral("Cue detail chunk is out of range"));
+            return false;
+        }
+
+        CueSummary summary = decodeSummaryFields(entry);
+        summary.mediaPath = entry.at(TocMediaPath).toString();
+        summary.details = data.mid(static_cast<qsizetype>(detailOffset), static_cast<qsizetype>(detailLength));
+        contents.cues.append(summary);
+    }
+
+    return true;
+}
+
+// Autosave Journal
+
+QByteArray Workspace::encodeJournalRecord(quint64 generation, const QList<ListEdit>& edits,
+                                          const QList<QPair<int, CueSummary>>& cues)
+{
+    QCborArray editEntries;
+    for (const ListEdit& edit : edits) {
+        QCborArray positions;
+        for (int position : edit.positions) {
+            positions.append(position);
+        }
+        QCborArray entry;
+        entry.append(static_cast<int>(edit.kind));
+        entry.append(positions);
+        entry.append(edit.index);
+        editEntries.append(entry);
+    }
+
+    QCborArray entries;
+    for (const auto& change : cues) {
+        QCborArray entry;
+        entry.append(change.first);
+        entry.append(encodeSummaryFields(change.second));
+        entry.append(change.second.details);
+        entry.append(change.second.mediaPath);
+        entries.append(entry);
+    }
+
+    QCborArray payloadArray;
+    payloadArray.append(static_cast<qint64>(generation));
+    payloadArray.append(entries);
+    payloadArray.append(editEntries);     // Replayed before the entries; older records lack it
+    const QByteArray payload = payloadArray.toCborValue().toCbor();
+
+    // Frame: payload length, checksum, reserved; a torn tail fails either check
+    QByteArray record(JOURNAL_FRAME_SIZE, '\0');
+    qToLittleEndian<quint32>(static_cast<quint32>(payload.size()), record.data());
+    qToLittleEndian<quint16>(qChecksum(payload), record.data() + 4);
+    record.append(payload);
+    return record;
+}
+
+int Workspace::applyJournal(const QByteArray& journal, quint64 generation, Contents& contents)
+{
+    int applied = 0;
+    qsizetype position = 0;
+
+    while (journal.size() - position >= JOURNAL_FRAME_SIZE) {
+        const char* frame = journal.constData() + position;
+        const quint32 length = qFromLittleEndian<quint32>(frame);
+        const quint16 checksum = qFromLittleEndian<quint16>(frame + 4);
+
+        if (length > static_cast<quint64>(journal.size() - position - JOURNAL_FRAME_SIZE)) {
+            break; // Crash mid-append: everything before this record is intact
+        }
+
+        const QByteArray payload = journal.mid(position + JOURNAL_FRAME_SIZE, length);
+        position += JOURNAL_FRAME_SIZE + length;
+        if (qChecksum(payload) != checksum) {
+            break;
+        }
+
+        const QCborArray record = QCborValue::fromCbor(payload).toArray();
+        if (static_cast<quint64>(record.at(0).toInteger(-1)) != generation) {
+            continue; // Left over from an older base snapshot
+        }
+
+        // On a copy, so a record that doesn't fit leaves the list as the previous one did
+        QList<CueSummary> cues = contents.cues;
+        bool fits = true;
+        for (const QCborValue& value : record.at(2).toArray()) {
+            const QCborArray entry = value.toArray();
+            const qint64 kind = entry.at(0).toInteger(-1);
+            if (kind < static_cast<int>(ListEdit::Kind::Insert) || kind > static_cast<int>(ListEdit::Kind::Move)) {
+                fits = false;
+                break;
+            }
+
+            ListEdit edit;
+            edit.kind = static_cast<ListEdit::Kind>(kind);
+            for (const QCborValue& cuePosition : entry.at(1).toArray()) {
+                edit.positions.append(static_cast<int>(cuePosition.toInteger(-1)));
+            }
+            edit.index = static_cast<int>(entry.at(2).toInteger(-1));
+            if (!applyListEdit(edit, cues)) {
+                fits = false;
+                break;
+            }
+        }
+        if (!fits) {
+            qWarning() << "Autosave journal record" << applied + 1 << "doesn't fit its base; replay stops there";
+            break;
+        }
+        contents.cues.swap(cues);
+
+        for (const QCborValue& value : record.at(1).toArray()) {
+            const QCborArray entry = value.toArray();
+            const qint64 index = entry.at(0).toInteger(-1);
+            if (index < 0 || index >= contents.cues.size()) {
+                continue;
+            }
+
+            CueSummary summary = decodeSummaryFields(entry.at(1).toArray());
+            summary.details = entry.at(2).toByteArray();
+            summary.mediaPath = entry.at(3).toString();
+            contents.cues[index] = summary;
+        }
+        ++applied;
+    }
+
+    return applied;
+}
+
+// Cue <-> Summary Conversion
+
+Workspace::CueSummary Workspace::summarize(const Cue* cue)
+{
+    CueSummary summary;
+    summary.type = cue->typeString();
+    summary.number = cue->number();
+    summary.name = cue->name();
+    summary.status = static_cast<int>(cue->status());
+    summary.color = cue->color().rgba();
+    summary.armed = cue->isArmed();
+    summary.flagged = cue->isFlagged();
+    summary.continueMode = cue->continueMode();
+    summary.duration = cue->duration();
+    summary.preWait = cue->preWait();
+    summary.postWait = cue->postWait();
+    summary.targetId = cue->targetId();
+    if (const auto* audioCue = qobject_cast<const AudioCue*>(cue)) {
+        summary.mediaPath = audioCue->filePath();     // Set from the summary even before hydration
+    }
+
+    if (!cue->isHydrated()) {
+        // Never touched since load: write the original chunk back untouched
+        summary.details = cue->deferredDetails();
+        return summary;
+    }
+
+    QJsonObject details = cue->toJson();
+    for (const char* key : SUMMARY_KEYS) {
+        details.remove(QLatin1String(key));
+    }
+    summary.details = QCborMap::fromJsonObject(details).toCborValue().toCbor();
+    return summary;
+}
+
+void Workspace::applySummary(Cue* cue, const CueSummary& summary)
+{
+    const QSignalBlocker blocker(cue);
+
+    cue->setNumber(summary.number);
+    cue->setName(summary.name);
+    cue->setStatus(static_cast<CueStatus>(summary.status));
+    cue->setColor(QColor::fromRgba(summary.color));
+    cue->setArmed(summary.armed);
+    cue->setFlagged(summary.flagged);
+    cue->setContinueMode(summary.continueMode);
+    cue->setDuration(summary.duration);
+    cue->setPreWait(summary.preWait);
+    cue->setPostWait(summary.postWait);
+    cue->setTargetId(summary.targetId);
+    if (auto* audioCue = qobject_cast<AudioCue*>(cue); audioCue && !summary.mediaPath.isEmpty()) {
+        audioCue->setFilePath(summary.mediaPath);
+    }
+
+    if (!summary.details.isEmpty()) {
+        cue->setDeferredDetails(summary.details);
+    }
+}
+
+QJsonObject Workspace::summaryToJson(const CueSummary& summary)
+{
+    QJsonObject json;
+    if (!summary.details.isEmpty()) {
+        json = QCborValue::fromCbor(summary.details).toMap().toJsonObject();
+    }
+
+    json["type"] = summary.type;
+    json["number"] = summary.number;
+    json["name"] = summary.name;
+    json["status"] = summary.status;
+    json["armed"] = summary.armed;
+    json["flagged"] = summary.flagged;
+    json["continueMode"] = summary.continueMode;
+    json["color"] = QColor::fromRgba(summary.color).name();
+    json["duration"] = summary.duration;
+    json["preWait"] = summary.preWait;
+    json["postWait"] = summary.postWait;
+    if (!summary.targetId.isEmpty()) {
+        json["targetId"] = summary.targetId;
+    }
+    return json;
+}
+
+Workspace::CueSummary Workspace::summaryFromJson(const QJsonObject& json)
+{
+    CueSummary summary;
+    summary.type = json["type"].toString();
+    summary.number = json["number"].toString();
+    summary.name = json["name"].toString();
+    summary.status = json["status"].toInt();
+    summary.color = json.contains("color") ? QColor(json["color"].toString()).rgba() : summary.color;
+    summary.armed = json["armed"].toBool();
+    summary.flagged = json["flagged"].toBool();
+    summary.continueMode = json["continueMode"].toBool();
+    summary.duration = json["duration"].toDouble();
+    summary.preWait = json["preWait"].toDouble();
+    summary.postWait = json["postWait"].toDouble();
+    summary.targetId = json["targetId"].toString();
+    summary.mediaPath = json["filePath"].toString();    // Stays in the details too, for hydration
+
+    QJsonObject details = json;
+    for (const char* key : SUMMARY_KEYS) {
+        details.remove(QLatin1String(key));
+    }
+    summary.details = QCborMap::fromJsonObject(details).toCborValue().toCbor();
+    return summary;
+}
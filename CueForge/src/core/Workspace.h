@@ -0,0 +1,133 @@
+// src/core/Workspace.h - Workspace file formats (JSON and indexed binary)
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QRgb>
+#include <QString>
+#include <cstdint>
+
+class Cue;
+
+/**
+ * @brief Encoding and decoding of CueForge workspace files
+ *
+ * Two formats are supported:
+ * - JSON: the original interchange format, one QJsonDocument of every cue's
+ *   toJson(). Kept for import/export.
+ * - Binary: a fixed header pointing at a CBOR table of contents. The table
+ *   holds a compact summary of every cue (everything the cue list shows)
+ *   plus the offset/length of that cue's detail chunk. Loading only parses
+ *   the table; each cue hydrates its own chunk on first access.
+ *
+ * Binary layout (little-endian):
+ *   0   char[4]  magic "CFWB"
+ *   4   uint16   format version
+ *   6   uint16   reserved
+ *   8   uint32   cue count
+ *   12  uint32   reserved
+ *   16  uint64   TOC offset
+ *   24  uint64   TOC length
+ *   32  ...      detail chunks (CBOR maps), then the TOC (CBOR map)
+ */
+class Workspace
+{
+public:
+    enum class Format {
+        Json,
+        Binary
+    };
+
+    /**
+     * @brief List-visible cue fields stored in the table of contents
+     */
+    struct CueSummary {
+        QString type;
+        QString number;
+        QString name;
+        int status = 0;
+        QRgb color = 0xffffffff;
+        bool armed = false;
+        bool flagged = false;
+        bool continueMode = false;
+        double duration = 0.0;
+        double preWait = 0.0;
+        double postWait = 0.0;
+        QString targetId;
+        QString mediaPath;      // Audio file, readable without hydrating (empty for other types)
+        QByteArray details;     // Encoded detail chunk (CBOR map)
+    };
+
+    /**
+     * @brief Insert, remove or move of top-level cues, journaled instead of a new base
+     *
+     * Positions are ascending. Insert: where each new cue ends up (its summary
+     * follows as an update in the same record). Remove and Move: where each cue
+     * was. A moved block lands at index among the cues that stayed.
+     */
+    struct ListEdit {
+        enum class Kind {
+            Insert,
+            Remove,
+            Move
+        };
+
+        Kind kind = Kind::Insert;
+        QList<int> positions;
+        int index = 0;
+    };
+
+    struct Contents {
+        QJsonObject settings;   // Workspace-level state (playhead, group expansion)
+        QList<CueSummary> cues;
+    };
+
+    /**
+     * @brief A workspace file read and parsed, before any cue exists
+     */
+    struct File {
+        Format format = Format::Json;
+        Contents contents;      // Binary format
+        QJsonObject json;       // JSON format: the document CueManager deserializes
+    };
+
+    // Format selection
+    static Format detectFormat(const QByteArray& data);
+    static Format formatForPath(const QString& filePath);
+
+    // Whole files; thread-safe since no Cue objects are created (startup parses off the GUI thread)
+    static bool readFile(const QString& filePath, File& file, QString* error = nullptr);
+
+    // Binary format
+    static QByteArray encodeBinary(const Contents& contents);
+    static bool decodeBinary(const QByteArray& data, Contents& contents, QString* error = nullptr);
+
+    /**
+     * @brief Autosave journal records
+     *
+     * Each record first applies its list edits, in order, to the cue list
+     * rebuilt from the base snapshot tagged with the same generation, then
+     * replaces the summaries of the cues at the given positions. Records are
+     * framed with a length and checksum so replay stops cleanly at a torn tail.
+     */
+    static QByteArray encodeJournalRecord(quint64 generation, const QList<ListEdit>& edits,
+                                          const QList<QPair<int, CueSummary>>& cues);
+    static int applyJournal(const QByteArray& journal, quint64 generation, Contents& contents);
+
+    // Cue <-> summary conversion
+    static CueSummary summarize(const Cue* cue);            // Reuses the deferred chunk of unhydrated cues
+    static void applySummary(Cue* cue, const CueSummary& summary);
+
+    // Summary <-> Cue::toJson() layout, without instantiating a cue (clipboard interchange)
+    static QJsonObject summaryToJson(const CueSummary& summary);
+    static CueSummary summaryFromJson(const QJsonObject& json);
+
+private:
+    // Constants
+    static constexpr char MAGIC[4] = { 'C', 'F', 'W', 'B' };
+    static constexpr std::uint16_t FORMAT_VERSION = 1;
+    static constexpr int HEADER_SIZE = 32;
+    static constexpr int JOURNAL_FRAME_SIZE = 8;
+};
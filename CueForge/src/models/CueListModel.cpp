@@ -0,0 +1,455 @@
+// src/models/CueListModel.cpp - Incremental list model over CueManager
+#include "CueListModel.h"
+
+#include <QDebug>
+#include <algorithm>
+
+#include "CueManager.h"
+#include "AudioCue.h"
+
+CueListModel::CueListModel(CueManager* cueManager, QObject* parent)
+    : QAbstractListModel(parent)
+    , cueManager_(cueManager)
+    , frameTimer_(new QTimer(this))
+    , firstVisibleRow_(-1)
+    , lastVisibleRow_(-1)
+{
+    frameTimer_->setInterval(FRAME_INTERVAL);
+    frameTimer_->setSingleShot(true);
+    connect(frameTimer_, &QTimer::timeout, this, &CueListModel::flushFrame);
+
+    if (cueManager_) {
+        connect(cueManager_, &CueManager::cueAdded, this, &CueListModel::onCueAdded);
+        connect(cueManager_, &CueManager::cueRemoved, this, &CueListModel::onCueRemoved);
+        connect(cueManager_, &CueManager::cueMoved, this, &CueListModel::onCueMoved);
+        connect(cueManager_, &CueManager::cueCountChanged, this, &CueListModel::onCueCountChanged);
+        connect(cueManager_, &CueManager::selectionChanged, this, &CueListModel::onSelectionChanged);
+        connect(cueManager_, &CueManager::standByCueChanged, this, &CueListModel::onStandByCueChanged);
+    }
+
+    resync();
+}
+
+CueListModel::~CueListModel() = default;
+
+// QAbstractListModel Interface
+
+int CueListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : rows_.size();
+}
+
+QVariant CueListModel::data(const QModelIndex& index, int role) const
+{
+    Cue* cue = cueAt(index.row());
+    if (!cue) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:       return cue->displayName();
+    case Qt::ToolTipRole:       return cue->notes().isEmpty() ? cue->displayName() : cue->notes();
+    case IdRole:                return cue->id();
+    case NumberRole:            return cue->number();
+    case NameRole:              return cue->name();
+    case TypeRole:              return cue->typeString();
+    case StatusRole:            return cue->statusString();
+    case ColorRole:             return cue->color();
+    case NotesRole:             return cue->notes();
+    case ArmedRole:             return cue->isArmed();
+    case FlaggedRole:           return cue->isFlagged();
+    case ContinueModeRole:      return cue->continueMode();
+    case DurationRole:          return cue->duration();
+    case PreWaitRole:           return cue->preWait();
+    case PostWaitRole:          return cue->postWait();
+    case ProgressRole:          return cue->getProgress();
+    case PositionRole: {
+        const AudioCue* audioCue = qobject_cast<const AudioCue*>(cue);
+        return audioCue ? QVariant(audioCue->getCurrentPlaybackTime()) : QVariant();
+    }
+    case SelectedRole:          return selectedIds_.contains(cue->id());
+    case StandByRole:           return cue->id() == standById_;
+    case CuePointerRole:        return QVariant::fromValue(static_cast<QObject*>(cue));
+    default:                    return QVariant();
+    }
+}
+
+QHash<int, QByteArray> CueListModel::roleNames() const
+{
+    QHash<int, QByteArray> roles = QAbstractListModel::roleNames();
+    roles[IdRole] = "cueId";
+    roles[NumberRole] = "number";
+    roles[NameRole] = "name";
+    roles[TypeRole] = "type";
+    roles[StatusRole] = "status";
+    roles[ColorRole] = "color";
+    roles[NotesRole] = "notes";
+    roles[ArmedRole] = "armed";
+    roles[FlaggedRole] = "flagged";
+    roles[ContinueModeRole] = "continueMode";
+    roles[DurationRole] = "duration";
+    roles[PreWaitRole] = "preWait";
+    roles[PostWaitRole] = "postWait";
+    roles[ProgressRole] = "progress";
+    roles[PositionRole] = "position";
+    roles[SelectedRole] = "selected";
+    roles[StandByRole] = "standBy";
+    roles[CuePointerRole] = "cue";
+    return roles;
+}
+
+// Row Helpers
+
+Cue* CueListModel::cueAt(int row) const
+{
+    return row >= 0 && row < rows_.size() ? rows_[row] : nullptr;
+}
+
+int CueListModel::rowForCue(const Cue* cue) const
+{
+    if (!cue) {
+        return -1;
+    }
+
+    // The manager's index is O(1) and matches our rows outside of a structural change
+    const int row = cueManager_ ? cueManager_->findCueIndex(cue->id()) : -1;
+    if (row >= 0 && row < rows_.size() && rows_[row] == cue) {
+        return row;
+    }
+    return rows_.indexOf(const_cast<Cue*>(cue));
+}
+
+QModelIndex CueListModel::indexForCueId(const QString& cueId) const
+{
+    if (!cueManager_) {
+        return QModelIndex();
+    }
+
+    const int row = rowForCue(cueManager_->getCue(cueId));
+    return row >= 0 ? index(row) : QModelIndex();
+}
+
+void CueListModel::setVisibleRows(int firstRow, int lastRow)
+{
+    // Rows scrolled into view repaint from live values, so nothing needs flushing here
+    firstVisibleRow_ = firstRow;
+    lastVisibleRow_ = lastRow;
+}
+
+// Structural Changes
+
+void CueListModel::resync()
+{
+    beginResetModel();
+
+    for (auto it = connections_.constBegin(); it != connections_.constEnd(); ++it) {
+        for (const QMetaObject::Connection& connection : it.value()) {
+            disconnect(connection);
+        }
+    }
+    connections_.clear();
+    snapshots_.clear();
+    propertyDirty_.clear();
+    progressDirty_.clear();
+
+    rows_ = cueManager_ ? cueManager_->getAllCues() : QList<Cue*>();
+    for (Cue* cue : std::as_const(rows_)) {
+        snapshots_.insert(cue, snapshotOf(cue));
+        watchCue(cue);
+    }
+
+    selectedIds_.clear();
+    standById_.clear();
+    if (cueManager_) {
+        const QStringList selected = cueManager_->getSelectedCueIds();
+        selectedIds_ = QSet<QString>(selected.begin(), selected.end());
+        standById_ = cueManager_->standByCueId();
+    }
+
+    endResetModel();
+}
+
+void CueListModel::onCueAdded(Cue* cue, int index)
+{
+    if (!cue || index < 0 || index > rows_.size()) {
+        resync();
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), index, index);
+    rows_.insert(index, cue);
+    snapshots_.insert(cue, snapshotOf(cue));
+    watchCue(cue);
+    endInsertRows();
+}
+
+void CueListModel::onCueRemoved(const QString& cueId, int index)
+{
+    // Removed cues are deleted later, so the pointer is still valid here
+    if (index < 0 || index >= rows_.size() || rows_[index]->id() != cueId) {
+        resync();
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), index, index);
+    Cue* cue = rows_.takeAt(index);
+    unwatchCue(cue);
+    forgetPending(cue);
+    snapshots_.remove(cue);
+    endRemoveRows();
+}
+
+void CueListModel::onCueMoved(const QString& cueId, int oldIndex, int newIndex)
+{
+    // Multi-cue moves don't report the old index
+    if (oldIndex < 0 || oldIndex >= rows_.size() || newIndex < 0 || newIndex >= rows_.size()
+        || rows_[oldIndex]->id() != cueId) {
+        resync();
+        return;
+    }
+
+    if (oldIndex == newIndex) {
+        return;
+    }
+
+    const int destination = newIndex > oldIndex ? newIndex + 1 : newIndex;
+    if (beginMoveRows(QModelIndex(), oldIndex, oldIndex, QModelIndex(), destination)) {
+        rows_.move(oldIndex, newIndex);
+        endMoveRows();
+    }
+}
+
+void CueListModel::onCueCountChanged()
+{
+    // Bulk operations (clear, load) change the list without per-row signals
+    if (!cueManager_ || rows_.size() != cueManager_->cueCount()) {
+        resync();
+    }
+}
+
+void CueListModel::onSelectionChanged()
+{
+    if (!cueManager_) {
+        return;
+    }
+
+    const QStringList selected = cueManager_->getSelectedCueIds();
+    const QSet<QString> newSelection(selected.begin(), selected.end());
+
+    // Only rows whose selected state flipped
+    QSet<QString> flipped = newSelection;
+    flipped.unite(selectedIds_);
+    flipped.subtract(QSet<QString>(newSelection).intersect(selectedIds_));
+    selectedIds_ = newSelection;
+
+    QList<int> rows;
+    rows.reserve(flipped.size());
+    for (const QString& cueId : std::as_const(flipped)) {
+        const int row = rowForCue(cueManager_->getCue(cueId));
+        if (row >= 0) {
+            rows.append(row);
+        }
+    }
+    emitRowRanges(rows, { SelectedRole });
+}
+
+void CueListModel::onStandByCueChanged(const QString& cueId)
+{
+    if (cueId == standById_ || !cueManager_) {
+        return;
+    }
+
+    QList<int> rows;
+    for (const QString& id : { standById_, cueId }) {
+        const int row = rowForCue(cueManager_->getCue(id));
+        if (row >= 0) {
+            rows.append(row);
+        }
+    }
+    standById_ = cueId;
+    emitRowRanges(rows, { StandByRole });
+}
+
+// Per-Frame Batching
+
+void CueListModel::watchCue(Cue* cue)
+{
+    QList<QMetaObject::Connection>& connections = connections_[cue];
+    connections.append(connect(cue, &Cue::cueUpdated, this, [this, cue]() { markPropertiesDirty(cue); }));
+    connections.append(connect(cue, &Cue::detailsHydrated, this, [this, cue]() { markPropertiesDirty(cue); }));
+    connections.append(connect(cue, &Cue::progressChanged, this, [this, cue]() { markProgressDirty(cue, ProgressRole); }));
+
+    if (AudioCue* audioCue = qobject_cast<AudioCue*>(cue)) {
+        connections.append(connect(audioCue, &AudioCue::playbackPositionChanged, this,
+            [this, cue]() { markProgressDirty(cue, PositionRole); }));
+    }
+}
+
+void CueListModel::unwatchCue(const Cue* cue)
+{
+    const QList<QMetaObject::Connection> connections = connections_.take(cue);
+    for (const QMetaObject::Connection& connection : connections) {
+        disconnect(connection);
+    }
+}
+
+void CueListModel::markPropertiesDirty(Cue* cue)
+{
+    propertyDirty_.insert(cue);
+    scheduleFrame();
+}
+
+void CueListModel::markProgressDirty(Cue* cue, int role)
+{
+    progressDirty_[cue].insert(role);
+    scheduleFrame();
+}
+
+void CueListModel::scheduleFrame()
+{
+    if (!frameTimer_->isActive()) {
+        frameTimer_->start();
+    }
+}
+
+void CueListModel::forgetPending(const Cue* cue)
+{
+    propertyDirty_.remove(const_cast<Cue*>(cue));
+    progressDirty_.remove(const_cast<Cue*>(cue));
+}
+
+void CueListModel::flushFrame()
+{
+    // Group rows by the exact role set that changed, one dataChanged per contiguous run
+    QHash<QList<int>, QList<int>> rowsByRoles;
+
+    for (Cue* cue : std::as_const(propertyDirty_)) {
+        const int row = rowForCue(cue);
+        if (row < 0) {
+            continue;
+        }
+
+        const RowSnapshot after = snapshotOf(cue);
+        const QList<int> roles = changedRoles(snapshots_.value(cue), after);
+        snapshots_.insert(cue, after);
+
+        if (!roles.isEmpty()) {
+            rowsByRoles[roles].append(row);
+        }
+    }
+    propertyDirty_.clear();
+
+    // Position/progress: visible rows only, the rest read fresh values on scroll
+    for (auto it = progressDirty_.constBegin(); it != progressDirty_.constEnd(); ++it) {
+        const int row = rowForCue(it.key());
+        if (row < 0 || !isRowVisible(row)) {
+            continue;
+        }
+
+        QList<int> roles = it.value().values();
+        std::sort(roles.begin(), roles.end());
+        rowsByRoles[roles].append(row);
+    }
+    progressDirty_.clear();
+
+    for (auto it = rowsByRoles.begin(); it != rowsByRoles.end(); ++it) {
+        emitRowRanges(it.value(), it.key());
+    }
+}
+
+bool CueListModel::isRowVisible(int row) const
+{
+    if (firstVisibleRow_ < 0 && lastVisibleRow_ < 0) {
+        return true; // View hasn't reported a range yet
+    }
+    return row >= firstVisibleRow_ && row <= lastVisibleRow_;
+}
+
+void CueListModel::emitRowRanges(QList<int> rows, const QList<int>& roles)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    std::sort(rows.begin(), rows.end());
+
+    int first = rows.first();
+    int last = first;
+    for (int i = 1; i <= rows.size(); ++i) {
+        if (i < rows.size() && rows[i] <= last + 1) {
+            last = qMax(last, rows[i]);
+            continue;
+        }
+
+        emit dataChanged(index(first), index(last), roles);
+
+        if (i < rows.size()) {
+            first = rows[i];
+            last = first;
+        }
+    }
+}
+
+// Snapshots
+
+CueListModel::RowSnapshot CueListModel::snapshotOf(const Cue* cue)
+{
+    RowSnapshot snapshot;
+    snapshot.number = cue->number();
+    snapshot.name = cue->name();
+    snapshot.status = static_cast<int>(cue->status());
+    snapshot.color = cue->color();
+    snapshot.notes = cue->isHydrated() ? cue->notes() : QString();   // Don't hydrate every row on resync
+    snapshot.armed = cue->isArmed();
+    snapshot.flagged = cue->isFlagged();
+    snapshot.continueMode = cue->continueMode();
+    snapshot.duration = cue->duration();
+    snapshot.preWait = cue->preWait();
+    snapshot.postWait = cue->postWait();
+    return snapshot;
+}
+
+QList<int> CueListModel::changedRoles(const RowSnapshot& before, const RowSnapshot& after)
+{
+    QList<int> roles;
+
+    if (before.number != after.number) {
+        roles << NumberRole;
+    }
+    if (before.name != after.name) {
+        roles << NameRole;
+    }
+    if (before.number != after.number || before.name != after.name) {
+        roles << Qt::DisplayRole;
+    }
+    if (before.status != after.status) {
+        roles << StatusRole;
+    }
+    if (before.color != after.color) {
+        roles << ColorRole;
+    }
+    if (before.notes != after.notes) {
+        roles << NotesRole << Qt::ToolTipRole;
+    }
+    if (before.armed != after.armed) {
+        roles << ArmedRole;
+    }
+    if (before.flagged != after.flagged) {
+        roles << FlaggedRole;
+    }
+    if (before.continueMode != after.continueMode) {
+        roles << ContinueModeRole;
+    }
+    if (before.duration != after.duration) {
+        roles << DurationRole;
+    }
+    if (before.preWait != after.preWait) {
+        roles << PreWaitRole;
+    }
+    if (before.postWait != after.postWait) {
+        roles << PostWaitRole;
+    }
+
+    std::sort(roles.begin(), roles.end());
+    return roles;
+}
@@ -0,0 +1,130 @@
+// src/models/CueListModel.h - Incremental list model over CueManager
+#pragma once
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+// Forward declarations
+class Cue;
+class CueManager;
+
+/**
+ * @brief Row-per-cue model that mirrors CueManager without full refreshes
+ *
+ * Structural changes map one-to-one onto begin/endInsert/Remove/MoveRows.
+ * Property edits are diffed per role against a cached snapshot, so a rename
+ * only repaints the name column of one row. Playback position and progress
+ * are collected per cue and flushed once per frame, and only for rows the
+ * view reports as visible; off-screen rows read fresh values when they
+ * scroll into view.
+ */
+class CueListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum CueRoles {
+        IdRole = Qt::UserRole + 1,
+        NumberRole,
+        NameRole,
+        TypeRole,
+        StatusRole,
+        ColorRole,
+        NotesRole,
+        ArmedRole,
+        FlaggedRole,
+        ContinueModeRole,
+        DurationRole,
+        PreWaitRole,
+        PostWaitRole,
+        ProgressRole,
+        PositionRole,       // Playback position in seconds (audio cues)
+        SelectedRole,
+        StandByRole,
+        CuePointerRole      // Cue* as QVariant, for delegates
+    };
+    Q_ENUM(CueRoles)
+
+    explicit CueListModel(CueManager* cueManager, QObject* parent = nullptr);
+    ~CueListModel() override;
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Row helpers
+    Cue* cueAt(int row) const;
+    int rowForCue(const Cue* cue) const;
+    QModelIndex indexForCueId(const QString& cueId) const;
+
+    /**
+     * @brief Rows currently on screen; per-frame updates are limited to these
+     * @param lastRow Inclusive; pass -1 for both to mark everything visible
+     */
+    void setVisibleRows(int firstRow, int lastRow);
+
+public slots:
+    void resync();
+
+private slots:
+    void onCueAdded(Cue* cue, int index);
+    void onCueRemoved(const QString& cueId, int index);
+    void onCueMoved(const QString& cueId, int oldIndex, int newIndex);
+    void onCueCountChanged();
+    void onSelectionChanged();
+    void onStandByCueChanged(const QString& cueId);
+    void flushFrame();
+
+private:
+    // Values the roles are diffed against
+    struct RowSnapshot {
+        QString number;
+        QString name;
+        int status = 0;
+        QColor color;
+        QString notes;
+        bool armed = false;
+        bool flagged = false;
+        bool continueMode = false;
+        double duration = 0.0;
+        double preWait = 0.0;
+        double postWait = 0.0;
+    };
+
+    static RowSnapshot snapshotOf(const Cue* cue);
+    static QList<int> changedRoles(const RowSnapshot& before, const RowSnapshot& after);
+
+    void watchCue(Cue* cue);
+    void unwatchCue(const Cue* cue);
+    void markPropertiesDirty(Cue* cue);
+    void markProgressDirty(Cue* cue, int role);
+    void scheduleFrame();
+    void forgetPending(const Cue* cue);
+    bool isRowVisible(int row) const;
+    void emitRowRanges(QList<int> rows, const QList<int>& roles);
+
+    CueManager* cueManager_;
+    QList<Cue*> rows_;
+    QHash<const Cue*, RowSnapshot> snapshots_;
+    QHash<const Cue*, QList<QMetaObject::Connection>> connections_;   // Safe to drop after the cue is gone
+
+    // Pending per-frame work
+    QSet<Cue*> propertyDirty_;
+    QHash<Cue*, QSet<int>> progressDirty_;      // Cue -> ProgressRole/PositionRole
+    QTimer* frameTimer_;
+
+    // Cached view state for diffing
+    QSet<QString> selectedIds_;
+    QString standById_;
+    int firstVisibleRow_;
+    int lastVisibleRow_;
+
+    // Constants
+    static constexpr int FRAME_INTERVAL = 16;   // ~60 Hz batched repaint
+};
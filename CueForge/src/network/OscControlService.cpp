@@ -0,0 +1,718 @@
+// src/network/OscControlService.cpp - OSC over UDP show control on a dedicated I/O thread
+#include "OscControlService.h"
+
+#include <QDebug>
+#include <QMetaObject>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(Q_OS_WIN)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#include "AudioCue.h"
+#include "CueManager.h"
+#include "CuePrearmer.h"
+#include "GroupCue.h"
+#include "JuceAudioBridge.h"
+#include "OscPacket.h"
+#include "Settings.h"
+
+namespace {
+
+constexpr std::intptr_t NO_SOCKET = -1;
+
+void closeNativeSocket(std::intptr_t socket)
+{
+#if defined(Q_OS_WIN)
+    ::closesocket(static_cast<SOCKET>(socket));
+#else
+    ::close(static_cast<int>(socket));
+#endif
+}
+
+QString lastSocketError()
+{
+#if defined(Q_OS_WIN)
+    return QString("Winsock error %1").arg(::WSAGetLastError());
+#else
+    return QString::fromLocal8Bit(std::strerror(errno));
+#endif
+}
+
+} // namespace
+
+OscControlService::OscControlService(CueManager* cueManager, JuceAudioBridge* bridge, CuePrearmer* prearmer, QObject* parent)
+    : QObject(parent)
+    , cueManager_(cueManager)
+    , bridge_(bridge)
+    , prearmer_(prearmer)
+    , rebuildTimer_(new QTimer(this))
+    , tableMutex_()
+    , table_()
+    , goPlan_()
+    , cuesByNumber_()
+    , thread_()
+    , stopRequested_(false)
+    , socket_(NO_SOCKET)
+    , port_(0)
+    , running_(false)
+    , requests_()
+    , dispatchPending_(false)
+    , packets_(0)
+    , messages_(0)
+    , malformed_(0)
+    , unknown_(0)
+    , direct_(0)
+    , marshalled_(0)
+    , dispatchLatency_()
+    , uiLatency_()
+{
+    // Edits come in bursts (paste, resequence): one rebuild per event-loop pass
+    rebuildTimer_->setSingleShot(true);
+    rebuildTimer_->setInterval(0);
+    connect(rebuildTimer_, &QTimer::timeout, this, &OscControlService::rebuildTable);
+
+    if (cueManager_) {
+        // Removed cues and replaced workspaces take their handles with them: drop the table at once
+        connect(cueManager_, &CueManager::cueRemoved, this, [this]() { invalidateTable(); scheduleRebuild(); });
+        connect(cueManager_, &CueManager::workspaceOpened, this, [this]() { invalidateTable(); scheduleRebuild(); });
+        connect(cueManager_, &CueManager::cueAdded, this, &OscControlService::scheduleRebuild);
+        connect(cueManager_, &CueManager::cueUpdated, this, &OscControlService::scheduleRebuild);
+        connect(cueManager_, &CueManager::cueMoved, this, &OscControlService::scheduleRebuild);
+        connect(cueManager_, &CueManager::groupCreated, this, &OscControlService::scheduleRebuild);
+        connect(cueManager_, &CueManager::groupRemoved, this, &OscControlService::scheduleRebuild);
+
+        // A GO from the GUI must not leave the old standby claimable by /go
+        connect(cueManager_, &CueManager::standByCueChanged, this, [this]() {
+            {
+                std::lock_guard<std::mutex> lock(tableMutex_);
+                goPlan_ = GoPlan();
+            }
+            scheduleRebuild();
+        });
+    }
+
+    if (prearmer_) {
+        connect(prearmer_, &CuePrearmer::cueArmed, this, &OscControlService::scheduleRebuild);
+        connect(prearmer_, &CuePrearmer::cueArmFailed, this, &OscControlService::scheduleRebuild);
+        connect(prearmer_, &CuePrearmer::cueDisarmed, this, [this]() { invalidateTable(); scheduleRebuild(); });
+    }
+
+#if defined(Q_OS_WIN)
+    WSADATA wsaData;
+    ::WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+
+    rebuildTable();
+}
+
+OscControlService::~OscControlService()
+{
+    stop();
+#if defined(Q_OS_WIN)
+    ::WSACleanup();
+#endif
+}
+
+// Lifecycle
+
+bool OscControlService::start(quint16 port)
+{
+    stop();
+
+    const auto fail = [this, port](const QString& what) {
+        const QString message = QString("OSC: %1 on UDP port %2: %3").arg(what).arg(port).arg(lastSocketError());
+        qWarning().noquote() << message;
+        closeSocket();
+        emit error(message);
+        return false;
+    };
+
+    const auto native = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#if defined(Q_OS_WIN)
+    if (native == INVALID_SOCKET) {
+#else
+    if (native < 0) {
+#endif
+        return fail("cannot create socket");
+    }
+    socket_ = static_cast<std::intptr_t>(native);
+
+    // Blocking reads with a timeout: no busy polling, and stop() is seen within RECEIVE_TIMEOUT_MS
+#if defined(Q_OS_WIN)
+    const DWORD timeout = RECEIVE_TIMEOUT_MS;
+#else
+    timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = RECEIVE_TIMEOUT_MS * 1000;
+#endif
+    if (::setsockopt(native, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout)) != 0) {
+        return fail("cannot set receive timeout");
+    }
+
+    const int reuse = 1;
+    ::setsockopt(native, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (::bind(native, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        return fail("cannot bind");
+    }
+
+    port_ = port;
+    running_ = true;
+    stopRequested_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this]() { run(); });
+
+    qDebug() << "OSC control listening on UDP port" << port;
+    emit started(port);
+    return true;
+}
+
+void OscControlService::stop()
+{
+    if (!running_) {
+        return;
+    }
+
+    stopRequested_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    closeSocket();
+    running_ = false;
+
+    // Whatever the I/O thread queued last still runs
+    dispatchRequests();
+
+    qDebug() << "OSC control stopped";
+    emit stopped();
+}
+
+void OscControlService::closeSocket()
+{
+    if (socket_ == NO_SOCKET) {
+        return;
+    }
+    closeNativeSocket(socket_);
+    socket_ = NO_SOCKET;
+}
+
+void OscControlService::applySettings(Settings* settings)
+{
+    if (!settings) {
+        return;
+    }
+
+    const auto apply = [this, settings]() {
+        const bool enabled = settings->value(Settings::Keys::Network::OSCEnabled).toBool();
+        const uint configured = settings->value(Settings::Keys::Network::OSCPort).toUInt();
+        const quint16 port = configured > 0 && configured <= 65535 ? static_cast<quint16>(configured) : DEFAULT_PORT;
+
+        if (!enabled) {
+            stop();
+        }
+        else if (!running_ || port != port_) {
+            start(port);
+        }
+    };
+
+    apply();
+    connect(settings, &Settings::settingChanged, this,
+            [apply](const QString& key, const QVariant& oldValue, const QVariant& newValue) {
+        Q_UNUSED(oldValue)
+        Q_UNUSED(newValue)
+        if (key == Settings::Keys::Network::OSCEnabled || key == Settings::Keys::Network::OSCPort) {
+            apply();
+        }
+    });
+}
+
+// Statistics
+
+OscControlService::Stats OscControlService::stats() const
+{
+    Stats result;
+    result.packets = packets_.load(std::memory_order_relaxed);
+    result.messages = messages_.load(std::memory_order_relaxed);
+    result.malformed = malformed_.load(std::memory_order_relaxed);
+    result.unknown = unknown_.load(std::memory_order_relaxed);
+    result.direct = direct_.load(std::memory_order_relaxed);
+    result.marshalled = marshalled_.load(std::memory_order_relaxed);
+    result.dropped = requests_.droppedCount();
+    result.dispatchLatency = dispatchLatency_.snapshot();
+    result.uiLatency = uiLatency_.snapshot();
+    return result;
+}
+
+QJsonObject OscControlService::statsJson() const
+{
+    const Stats current = stats();
+
+    QJsonObject json;
+    json["running"] = running_;
+    json["port"] = port_;
+    json["packets"] = static_cast<qint64>(current.packets);
+    json["messages"] = static_cast<qint64>(current.messages);
+    json["malformed"] = static_cast<qint64>(current.malformed);
+    json["unknown"] = static_cast<qint64>(current.unknown);
+    json["direct"] = static_cast<qint64>(current.direct);
+    json["marshalled"] = static_cast<qint64>(current.marshalled);
+    json["dropped"] = static_cast<qint64>(current.dropped);
+    json["dispatchLatency"] = LatencyHistogram::toJson(current.dispatchLatency);
+    json["uiLatency"] = LatencyHistogram::toJson(current.uiLatency);
+    if (bridge_) {
+        json["triggerLatency"] = LatencyHistogram::toJson(bridge_->getTriggerLatencyHistogram().snapshot());
+    }
+    return json;
+}
+
+void OscControlService::resetStats()
+{
+    packets_.store(0, std::memory_order_relaxed);
+    messages_.store(0, std::memory_order_relaxed);
+    malformed_.store(0, std::memory_order_relaxed);
+    unknown_.store(0, std::memory_order_relaxed);
+    direct_.store(0, std::memory_order_relaxed);
+    marshalled_.store(0, std::memory_order_relaxed);
+    dispatchLatency_.reset();
+    uiLatency_.reset();
+}
+
+// I/O Thread
+
+void OscControlService::run()
+{
+    // The only allocation on this thread; parsing works in place
+    std::vector<char> buffer(RECEIVE_BUFFER_SIZE);
+
+    while (!stopRequested_.load(std::memory_order_relaxed)) {
+#if defined(Q_OS_WIN)
+        const int received = ::recv(static_cast<SOCKET>(socket_), buffer.data(), RECEIVE_BUFFER_SIZE, 0);
+#else
+        const int received = static_cast<int>(::recv(static_cast<int>(socket_), buffer.data(), RECEIVE_BUFFER_SIZE, 0));
+#endif
+        if (received <= 0) {
+            continue;   // Timeout (or a transient error): check the stop flag and wait again
+        }
+
+        const std::int64_t arrivalNs = JuceAudioBridge::steadyClockNs();
+        packets_.fetch_add(1, std::memory_order_relaxed);
+
+        const bool parsed = OscPacket::parse(buffer.data(), received, [this, arrivalNs](const OscMessage& message) {
+            messages_.fetch_add(1, std::memory_order_relaxed);
+            handleMessage(message, arrivalNs);
+        });
+        if (!parsed) {
+            malformed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void OscControlService::handleMessage(const OscMessage& message, std::int64_t arrivalNs)
+{
+    OscAddress address(message.address, message.addressLength);
+    const char* segment = nullptr;
+    int length = 0;
+    if (!address.next(segment, length)) {
+        unknown_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const char* extra = nullptr;
+    int extraLength = 0;
+
+    if (OscAddress::equals(segment, length, "go")) {
+        GoPlan plan;
+        if (claimGoPlan(plan)) {
+            AudioCommand command;
+            command.type = AudioCommandType::Play;
+            command.cueHandle = plan.handle;
+            command.time = plan.startTime;
+            command.duration = plan.fadeIn;
+            command.timestampNs = arrivalNs;
+
+            // Adopt before Play: the GUI thread takes the cue on before the engine's Started event reaches it
+            marshal(RequestType::Adopt, arrivalNs, plan.number, plan.numberLength, 0.0f, -1.0f, true);
+            if (!postDirect(command, arrivalNs)) {
+                // Already adopted (and standby moved on): start that same cue the slow way
+                marshal(RequestType::StartCue, arrivalNs, plan.number, plan.numberLength);
+            }
+            return;
+        }
+        marshal(RequestType::Go, arrivalNs);
+        return;
+    }
+
+    if (OscAddress::equals(segment, length, "panic")) {
+        AudioCommand cancel;
+        cancel.type = AudioCommandType::CancelScheduled;
+        cancel.token = 0;
+        AudioCommand stopAll;
+        stopAll.type = AudioCommandType::StopAll;
+        stopAll.duration = 0.0;
+        if (bridge_) {
+            bridge_->postCommand(cancel);
+            postDirect(stopAll, arrivalNs);
+        }
+        marshal(RequestType::Panic, arrivalNs);
+        return;
+    }
+
+    if (OscAddress::equals(segment, length, "stop")) {
+        marshal(RequestType::Stop, arrivalNs);   // Each cue's own fade-out, as from the GUI
+        return;
+    }
+    if (OscAddress::equals(segment, length, "pause")) {
+        marshal(RequestType::Pause, arrivalNs);
+        return;
+    }
+    if (OscAddress::equals(segment, length, "resume")) {
+        marshal(RequestType::Resume, arrivalNs);
+        return;
+    }
+
+    if (OscAddress::equals(segment, length, "select") && address.next(extra, extraLength)) {
+        marshal(RequestType::Select, arrivalNs, extra, extraLength);
+        return;
+    }
+
+    if (OscAddress::equals(segment, length, "cue") && address.next(extra, extraLength)) {
+        const char* action = nullptr;
+        int actionLength = 0;
+        if (address.next(action, actionLength)
+            && handleCueMessage(extra, extraLength, action, actionLength, message, arrivalNs)) {
+            return;
+        }
+    }
+
+    unknown_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool OscControlService::handleCueMessage(const char* number, int numberLength, const char* action, int actionLength,
+                                         const OscMessage& message, std::int64_t arrivalNs)
+{
+    if (numberLength > MAX_NUMBER_LENGTH) {
+        return false;
+    }
+
+    const std::shared_ptr<const CueTable> table = currentTable();
+    const CueEntry* entry = table ? table->find(number, numberLength) : nullptr;
+
+    double fade = -1.0;
+    const bool hasFade = message.number(OscAddress::equals(action, actionLength, "level") ? 1 : 0, fade) && fade >= 0.0;
+
+    if (OscAddress::equals(action, actionLength, "start")) {
+        if (entry && entry->direct) {
+            AudioCommand command;
+            command.type = AudioCommandType::Play;
+            command.cueHandle = entry->handle;
+            command.time = entry->startTime;
+            command.duration = entry->fadeIn;
+            command.timestampNs = arrivalNs;
+
+            marshal(RequestType::Adopt, arrivalNs, number, numberLength);
+            if (postDirect(command, arrivalNs)) {
+                return true;
+            }
+        }
+        marshal(RequestType::StartCue, arrivalNs, number, numberLength);
+        return true;
+    }
+
+    if (OscAddress::equals(action, actionLength, "stop")) {
+        if (entry && entry->handle >= 0) {
+            AudioCommand command;
+            command.type = AudioCommandType::Stop;
+            command.cueHandle = entry->handle;
+            command.duration = hasFade ? fade : entry->fadeOut;
+            if (postDirect(command, arrivalNs)) {
+                return true;
+            }
+        }
+        marshal(RequestType::StopCue, arrivalNs, number, numberLength, 0.0f, hasFade ? static_cast<float>(fade) : -1.0f);
+        return true;
+    }
+
+    if (OscAddress::equals(action, actionLength, "pause") || OscAddress::equals(action, actionLength, "resume")) {
+        const bool pause = OscAddress::equals(action, actionLength, "pause");
+        if (entry && entry->handle >= 0) {
+            AudioCommand command;
+            command.type = pause ? AudioCommandType::Pause : AudioCommandType::Resume;
+            command.cueHandle = entry->handle;
+            if (postDirect(command, arrivalNs)) {
+                return true;
+            }
+        }
+        marshal(pause ? RequestType::PauseCue : RequestType::ResumeCue, arrivalNs, number, numberLength);
+        return true;
+    }
+
+    if (OscAddress::equals(action, actionLength, "level")) {
+        double decibels = 0.0;
+        if (!entry || entry->handle < 0 || !message.number(0, decibels)) {
+            return false;
+        }
+        AudioCommand command;
+        command.type = AudioCommandType::Fade;
+        command.cueHandle = entry->handle;
+        command.level = static_cast<float>(std::pow(10.0, decibels / 20.0));
+        command.duration = hasFade ? fade : 0.0;
+        postDirect(command, arrivalNs);
+        return true;
+    }
+
+    return false;
+}
+
+bool OscControlService::postDirect(const AudioCommand& command, std::int64_t arrivalNs)
+{
+    if (!bridge_ || !bridge_->postCommand(command)) {
+        return false;
+    }
+    direct_.fetch_add(1, std::memory_order_relaxed);
+    dispatchLatency_.record(JuceAudioBridge::steadyClockNs() - arrivalNs);
+    return true;
+}
+
+void OscControlService::marshal(RequestType type, std::int64_t arrivalNs, const char* number, int numberLength,
+                                float value, float duration, bool wasGo)
+{
+    Request request;
+    request.type = type;
+    request.numberLength = std::min(numberLength, MAX_NUMBER_LENGTH);
+    if (number && request.numberLength > 0) {
+        std::memcpy(request.number, number, static_cast<std::size_t>(request.numberLength));
+    }
+    request.value = value;
+    request.duration = duration;
+    request.arrivalNs = arrivalNs;
+    request.wasGo = wasGo;
+
+    if (!requests_.push(request)) {
+        return;     // Counted by droppedCount()
+    }
+    marshalled_.fetch_add(1, std::memory_order_relaxed);
+
+    // Edge-triggered like the bridge's event dispatch: one queued drain in flight at most
+    if (!dispatchPending_.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, [this]() { dispatchRequests(); }, Qt::QueuedConnection);
+    }
+}
+
+std::shared_ptr<const OscControlService::CueTable> OscControlService::currentTable() const
+{
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    return table_;
+}
+
+bool OscControlService::claimGoPlan(GoPlan& plan)
+{
+    // One GO per standby: a second /go before the GUI thread has moved on takes the slow path
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    if (goPlan_.handle < 0) {
+        return false;
+    }
+    plan = goPlan_;
+    goPlan_ = GoPlan();
+    return true;
+}
+
+// GUI Thread
+
+void OscControlService::dispatchRequests()
+{
+    // Clear first so requests pushed during the drain trigger a fresh dispatch
+    dispatchPending_.store(false, std::memory_order_release);
+
+    requests_.drain([this](const Request& request) {
+        handleRequest(request);
+        uiLatency_.record(JuceAudioBridge::steadyClockNs() - request.arrivalNs);
+    }, MAX_REQUESTS_PER_DISPATCH);
+
+    if (!requests_.isEmpty() && !dispatchPending_.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, [this]() { dispatchRequests(); }, Qt::QueuedConnection);
+    }
+}
+
+void OscControlService::handleRequest(const Request& request)
+{
+    if (!cueManager_) {
+        return;
+    }
+
+    switch (request.type) {
+    case RequestType::Go:
+        cueManager_->go();
+        return;
+    case RequestType::Stop:
+        cueManager_->stop();
+        return;
+    case RequestType::Pause:
+        cueManager_->pause();
+        return;
+    case RequestType::Resume:
+        cueManager_->resume();
+        return;
+    case RequestType::Panic:
+        cueManager_->panic();
+        return;
+    default:
+        break;
+    }
+
+    Cue* cue = cueForNumber(request.number, request.numberLength);
+    if (!cue) {
+        qWarning() << "OSC: no cue numbered" << QByteArray(request.number, request.numberLength);
+        return;
+    }
+
+    switch (request.type) {
+    case RequestType::Select:
+        cueManager_->setStandByCue(cue->id());
+        break;
+    case RequestType::StartCue:
+        cueManager_->goCues({ cue->id() });
+        break;
+    case RequestType::StopCue:
+        if (cue->isExecuting()) {
+            const AudioCue* audioCue = qobject_cast<AudioCue*>(cue);
+            const double defaultFade = audioCue ? audioCue->fadeOutTime() : 0.0;
+            cue->stop(request.duration >= 0.0f ? request.duration : defaultFade);
+            emit cueManager_->playbackStateChanged();
+        }
+        break;
+    case RequestType::PauseCue:
+        cue->pause();
+        break;
+    case RequestType::ResumeCue:
+        cue->resume();
+        break;
+    case RequestType::Adopt:
+        cueManager_->adoptRemoteStart(qobject_cast<AudioCue*>(cue), request.wasGo);
+        break;
+    default:
+        break;
+    }
+}
+
+Cue* OscControlService::cueForNumber(const char* number, int length) const
+{
+    return cuesByNumber_.value(QByteArray::fromRawData(number, length)).data();
+}
+
+void OscControlService::scheduleRebuild()
+{
+    if (!rebuildTimer_->isActive()) {
+        rebuildTimer_->start();
+    }
+}
+
+void OscControlService::invalidateTable()
+{
+    // Everything takes the slow path until the rebuild
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    table_.reset();
+    goPlan_ = GoPlan();
+}
+
+void OscControlService::rebuildTable()
+{
+    if (!cueManager_) {
+        return;
+    }
+
+    auto table = std::make_shared<CueTable>();
+    cuesByNumber_.clear();
+    collectCues(cueManager_->getAllCues(), *table);
+    std::sort(table->entries.begin(), table->entries.end(), [](const CueEntry& a, const CueEntry& b) {
+        return a.hash < b.hash;
+    });
+
+    // /go may start the standby itself only when GO is nothing more than one Play
+    GoPlan plan;
+    Cue* standby = cueManager_->getStandByCue();
+    const QByteArray standbyNumber = standby ? standby->number().toUtf8() : QByteArray();
+    const CueEntry* entry = standby ? table->find(standbyNumber.constData(), standbyNumber.size()) : nullptr;
+    if (entry && entry->direct && entry->cueId == standby->id()
+        && standby->preWait() <= 0.0 && !standby->continueMode() && standby->canExecute()) {
+        plan.handle = entry->handle;
+        plan.startTime = entry->startTime;
+        plan.fadeIn = entry->fadeIn;
+        plan.numberLength = standbyNumber.size();
+        std::memcpy(plan.number, standbyNumber.constData(), static_cast<std::size_t>(plan.numberLength));
+    }
+
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    table_ = std::move(table);
+    goPlan_ = plan;
+}
+
+void OscControlService::collectCues(const QList<Cue*>& cues, CueTable& table)
+{
+    for (Cue* cue : cues) {
+        if (GroupCue* group = qobject_cast<GroupCue*>(cue)) {
+            collectCues(group->children(), table);
+        }
+
+        const QByteArray number = cue->number().toUtf8();
+        if (number.isEmpty() || number.size() > MAX_NUMBER_LENGTH || cuesByNumber_.contains(number)) {
+            continue;   // Duplicate numbers: the first in list order wins
+        }
+        cuesByNumber_.insert(number, cue);
+
+        CueEntry entry;
+        entry.hash = hashNumber(number.constData(), number.size());
+        entry.number = number;
+        entry.cueId = cue->id();
+
+        if (AudioCue* audioCue = qobject_cast<AudioCue*>(cue)) {
+            entry.handle = bridge_ ? bridge_->cueHandle(cue->id()) : -1;
+            entry.direct = entry.handle >= 0 && prearmer_
+                && prearmer_->isArmed(cue->id(), audioCue->filePath(), audioCue->startTime());
+            entry.startTime = audioCue->startTime();
+            entry.fadeIn = audioCue->fadeInTime();
+            entry.fadeOut = audioCue->fadeOutTime();
+        }
+        table.entries.push_back(entry);
+    }
+}
+
+const OscControlService::CueEntry* OscControlService::CueTable::find(const char* number, int length) const
+{
+    const std::uint32_t hash = hashNumber(number, length);
+    auto it = std::lower_bound(entries.begin(), entries.end(), hash, [](const CueEntry& entry, std::uint32_t value) {
+        return entry.hash < value;
+    });
+    for (; it != entries.end() && it->hash == hash; ++it) {
+        if (it->number.size() == length && std::memcmp(it->number.constData(), number, static_cast<std::size_t>(length)) == 0) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+std::uint32_t OscControlService::hashNumber(const char* number, int length)
+{
+    // FNV-1a
+    std::uint32_t hash = 2166136261u;
+    for (int i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(number[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,215 @@
+// src/network/OscControlService.h - OSC over UDP show control on a dedicated I/O thread
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QPointer>
+#include <QString>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AudioCommandQueue.h"
+#include "LatencyHistogram.h"
+
+class Cue;
+class CueManager;
+class CuePrearmer;
+class JuceAudioBridge;
+class QTimer;
+class Settings;
+struct OscMessage;
+
+/**
+ * @brief Receives OSC show control and acts on it without waiting for the GUI thread
+ *
+ * A blocking UDP socket is read on a thread of its own, so a GO from a
+ * console is parsed and acted on as soon as it arrives rather than when the
+ * event loop gets round to it. Messages that only need the audio engine go
+ * straight onto its lock-free command ring:
+ *
+ *   /go                     standby cue, when it is an armed audio cue without pre-wait or continue
+ *   /cue/{number}/start     armed audio cue
+ *   /cue/{number}/stop      [fade seconds]
+ *   /cue/{number}/pause, /cue/{number}/resume
+ *   /cue/{number}/level     dB [fade seconds]
+ *   /panic
+ *
+ * Everything else (GO on a group or a chain, cues that aren't armed, /stop,
+ * /pause, /resume, /select/{number}) is marshalled to the GUI thread through
+ * a lock-free queue and runs through CueManager like a key press. Directly
+ * started cues are handed to CueManager before their Play is posted, so the
+ * cue list catches up without the start itself waiting for it.
+ *
+ * Cue numbers resolve through an immutable table the GUI thread rebuilds
+ * whenever the cue list, standby or arm state changes; the I/O thread only
+ * ever swaps a shared pointer under a short lock.
+ */
+class OscControlService : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        std::uint64_t packets = 0;
+        std::uint64_t messages = 0;
+        std::uint64_t malformed = 0;        // Packets rejected by the parser
+        std::uint64_t unknown = 0;          // Unknown address or cue number
+        std::uint64_t direct = 0;           // Acted on from the I/O thread
+        std::uint64_t marshalled = 0;       // Handed to the GUI thread
+        std::uint64_t dropped = 0;          // Request queue full
+        LatencyHistogram::Snapshot dispatchLatency;     // Arrival -> audio command posted
+        LatencyHistogram::Snapshot uiLatency;           // Arrival -> handled on the GUI thread
+    };
+
+    OscControlService(CueManager* cueManager, JuceAudioBridge* bridge, CuePrearmer* prearmer, QObject* parent = nullptr);
+    ~OscControlService();
+
+    /**
+     * @brief Bind the UDP port and start the I/O thread (restarts if already running)
+     * @return false if the socket couldn't be set up (error() is emitted)
+     */
+    bool start(quint16 port);
+    void stop();
+    bool isRunning() const { return running_; }
+    quint16 port() const { return port_; }
+
+    /**
+     * @brief Follow Settings::Keys::Network (enabled, port), now and on change
+     */
+    void applySettings(Settings* settings);
+
+    Stats stats() const;
+    QJsonObject statsJson() const;      // Includes the engine's GO -> first sample histogram
+    void resetStats();
+
+signals:
+    void started(quint16 port);
+    void stopped();
+    void error(const QString& message);
+
+private:
+    /**
+     * @brief Resolved cue, built on the GUI thread
+     */
+    struct CueEntry {
+        std::uint32_t hash = 0;             // Of number, sort key
+        QByteArray number;
+        QString cueId;
+        int handle = -1;                    // Voice handle of an audio cue, -1 otherwise
+        bool direct = false;                // Armed audio cue: may be started from the I/O thread
+        double startTime = 0.0;
+        double fadeIn = 0.0;
+        double fadeOut = 0.0;
+    };
+
+    struct CueTable {
+        std::vector<CueEntry> entries;      // Sorted by hash
+
+        const CueEntry* find(const char* number, int length) const;
+    };
+
+    /**
+     * @brief What /go does without the GUI thread; claimed by the first GO that uses it
+     */
+    struct GoPlan {
+        int handle = -1;
+        double startTime = 0.0;
+        double fadeIn = 0.0;
+        char number[32] = {};
+        int numberLength = 0;
+    };
+
+    enum class RequestType : std::uint8_t {
+        Go,
+        Stop,
+        Pause,
+        Resume,
+        Panic,
+        Select,
+        StartCue,
+        StopCue,
+        PauseCue,
+        ResumeCue,
+        Adopt               // Already started from the I/O thread: bring the cue list up to date
+    };
+
+    struct Request {
+        RequestType type = RequestType::Go;
+        char number[32] = {};
+        int numberLength = 0;
+        float value = 0.0f;
+        float duration = -1.0f;             // Fade seconds, -1 = the cue's own
+        std::int64_t arrivalNs = 0;
+        bool wasGo = false;                 // Adopt: started by /go, so standby advances
+    };
+
+    using RequestQueue = LockFreeQueue<Request, 256>;
+
+    // I/O thread
+    void run();
+    void handleMessage(const OscMessage& message, std::int64_t arrivalNs);
+    bool handleCueMessage(const char* number, int numberLength, const char* action, int actionLength,
+                          const OscMessage& message, std::int64_t arrivalNs);
+    bool postDirect(const AudioCommand& command, std::int64_t arrivalNs);
+    void marshal(RequestType type, std::int64_t arrivalNs, const char* number = nullptr, int numberLength = 0,
+                 float value = 0.0f, float duration = -1.0f, bool wasGo = false);
+    std::shared_ptr<const CueTable> currentTable() const;
+    bool claimGoPlan(GoPlan& plan);
+
+    // GUI thread
+    void dispatchRequests();
+    void handleRequest(const Request& request);
+    Cue* cueForNumber(const char* number, int length) const;
+    void scheduleRebuild();
+    void invalidateTable();
+    void rebuildTable();
+    void collectCues(const QList<Cue*>& cues, CueTable& table);
+    void closeSocket();
+
+    static std::uint32_t hashNumber(const char* number, int length);
+
+    CueManager* cueManager_;
+    JuceAudioBridge* bridge_;
+    CuePrearmer* prearmer_;
+    QTimer* rebuildTimer_;
+
+    // Published to the I/O thread
+    mutable std::mutex tableMutex_;
+    std::shared_ptr<const CueTable> table_;
+    GoPlan goPlan_;
+    QHash<QByteArray, QPointer<Cue>> cuesByNumber_;     // GUI thread only
+
+    // Socket and thread
+    std::thread thread_;
+    std::atomic<bool> stopRequested_;
+    std::intptr_t socket_;
+    quint16 port_;
+    bool running_;
+
+    // GUI-thread marshalling
+    RequestQueue requests_;
+    std::atomic<bool> dispatchPending_;
+
+    // Statistics (written by the I/O thread, read anywhere)
+    std::atomic<std::uint64_t> packets_;
+    std::atomic<std::uint64_t> messages_;
+    std::atomic<std::uint64_t> malformed_;
+    std::atomic<std::uint64_t> unknown_;
+    std::atomic<std::uint64_t> direct_;
+    std::atomic<std::uint64_t> marshalled_;
+    LatencyHistogram dispatchLatency_;
+    LatencyHistogram uiLatency_;
+
+    // Constants
+    static constexpr int MAX_NUMBER_LENGTH = 31;            // Longer cue numbers are only reachable from the GUI
+    static constexpr int RECEIVE_BUFFER_SIZE = 65536;       // Largest UDP datagram
+    static constexpr int RECEIVE_TIMEOUT_MS = 100;          // How often the I/O thread checks for stop()
+    static constexpr int MAX_REQUESTS_PER_DISPATCH = 256;
+    static constexpr quint16 DEFAULT_PORT = 53000;
+};
@@ -0,0 +1,273 @@
+// src/network/OscPacket.h - Allocation-free OSC 1.0 packet parsing
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief One OSC message, as views into the datagram it was parsed from
+ *
+ * Nothing is copied: address and string arguments point into the receive
+ * buffer and are only valid until the next packet is read into it.
+ */
+struct OscMessage {
+    static constexpr int MAX_ARGUMENTS = 8;
+
+    const char* address = nullptr;      // Starts with '/', not necessarily terminated at addressLength
+    int addressLength = 0;
+    int argumentCount = 0;              // Arguments past MAX_ARGUMENTS are parsed over but not kept
+    std::array<char, MAX_ARGUMENTS> types{};
+    std::array<double, MAX_ARGUMENTS> numbers{};    // i, h, f, d, T/F as numbers
+
+    /**
+     * @brief Numeric argument at index, if there is one
+     */
+    bool number(int index, double& value) const
+    {
+        if (index < 0 || index >= argumentCount || index >= MAX_ARGUMENTS) {
+            return false;
+        }
+        switch (types[index]) {
+        case 'i': case 'h': case 'f': case 'd': case 'T': case 'F':
+            value = numbers[index];
+            return true;
+        default:
+            return false;
+        }
+    }
+};
+
+/**
+ * @brief Walks the path segments of an OSC address without copying them
+ */
+class OscAddress
+{
+public:
+    OscAddress(const char* address, int length) : cursor_(address), end_(address + length) {}
+
+    // Next segment between slashes; false at the end of the address
+    bool next(const char*& segment, int& length)
+    {
+        while (cursor_ < end_ && *cursor_ == '/') {
+            ++cursor_;
+        }
+        if (cursor_ >= end_) {
+            return false;
+        }
+
+        segment = cursor_;
+        while (cursor_ < end_ && *cursor_ != '/') {
+            ++cursor_;
+        }
+        length = static_cast<int>(cursor_ - segment);
+        return true;
+    }
+
+    static bool equals(const char* segment, int length, const char* literal)
+    {
+        return static_cast<int>(std::strlen(literal)) == length && std::memcmp(segment, literal, length) == 0;
+    }
+
+private:
+    const char* cursor_;
+    const char* end_;
+};
+
+/**
+ * @brief OSC 1.0 packet parser: messages and (nested) bundles
+ *
+ * Bundle time tags are ignored: everything is dispatched on arrival, which is
+ * what consoles sending GO expect. Malformed packets are rejected as a whole
+ * before any of their messages are dispatched.
+ */
+class OscPacket
+{
+public:
+    static constexpr int MAX_BUNDLE_DEPTH = 4;
+
+    /**
+     * @brief Parse a datagram and call handler(const OscMessage&) for each message
+     * @return false if the packet is malformed (nothing was dispatched)
+     */
+    template <typename Handler>
+    static bool parse(const char* data, int size, Handler&& handler)
+    {
+        if (!walk(data, size, 0, [](const OscMessage&) {})) {
+            return false;
+        }
+        return walk(data, size, 0, handler);
+    }
+
+private:
+    template <typename Handler>
+    static bool walk(const char* data, int size, int depth, Handler&& handler)
+    {
+        if (size < 4 || (size & 3) != 0) {
+            return false;
+        }
+
+        if (data[0] == '/') {
+            OscMessage message;
+            if (!parseMessage(data, size, message)) {
+                return false;
+            }
+            handler(message);
+            return true;
+        }
+
+        // "#bundle\0", 8-byte time tag, then size-prefixed elements
+        if (size < 16 || std::memcmp(data, "#bundle", 8) != 0 || depth >= MAX_BUNDLE_DEPTH) {
+            return false;
+        }
+
+        int offset = 16;
+        while (offset < size) {
+            if (size - offset < 4) {
+                return false;
+            }
+            const std::int32_t elementSize = readInt32(data + offset);
+            offset += 4;
+            if (elementSize < 0 || elementSize > size - offset) {
+                return false;
+            }
+            if (!walk(data + offset, elementSize, depth + 1, handler)) {
+                return false;
+            }
+            offset += elementSize;
+        }
+        return true;
+    }
+
+    static bool parseMessage(const char* data, int size, OscMessage& message)
+    {
+        int offset = 0;
+        int length = 0;
+        if (!readString(data, size, offset, length)) {
+            return false;
+        }
+        message.address = data;
+        message.addressLength = length;
+
+        // A missing type tag string (OSC 1.0 leniency) means no arguments
+        if (offset >= size) {
+            return true;
+        }
+        if (data[offset] != ',') {
+            return false;
+        }
+
+        const char* tags = data + offset + 1;
+        int tagsLength = 0;
+        if (!readString(data, size, offset, tagsLength)) {
+            return false;
+        }
+        --tagsLength;   // Leading comma
+
+        for (int i = 0; i < tagsLength; ++i) {
+            const char tag = tags[i];
+            double value = 0.0;
+            switch (tag) {
+            case 'i':
+            case 'f':
+            case 'c':
+            case 'r':
+            case 'm':
+                if (size - offset < 4) {
+                    return false;
+                }
+                if (tag == 'i') {
+                    value = readInt32(data + offset);
+                }
+                else if (tag == 'f') {
+                    const std::uint32_t bits = static_cast<std::uint32_t>(readInt32(data + offset));
+                    float number = 0.0f;
+                    std::memcpy(&number, &bits, sizeof(number));
+                    value = number;
+                }
+                offset += 4;
+                break;
+            case 'h':
+            case 'd':
+            case 't':
+                if (size - offset < 8) {
+                    return false;
+                }
+                if (tag == 'h') {
+                    value = static_cast<double>(readInt64(data + offset));
+                }
+                else if (tag == 'd') {
+                    const std::uint64_t bits = static_cast<std::uint64_t>(readInt64(data + offset));
+                    std::memcpy(&value, &bits, sizeof(value));
+                }
+                offset += 8;
+                break;
+            case 's':
+            case 'S': {
+                int stringLength = 0;
+                if (!readString(data, size, offset, stringLength)) {
+                    return false;
+                }
+                break;
+            }
+            case 'b': {
+                if (size - offset < 4) {
+                    return false;
+                }
+                // Bound the size before padding it: near INT32_MAX the rounding would overflow
+                const std::int32_t blobSize = readInt32(data + offset);
+                if (blobSize < 0 || blobSize > size - offset - 4) {
+                    return false;
+                }
+                const std::int64_t padded = (static_cast<std::int64_t>(blobSize) + 3) & ~std::int64_t(3);
+                if (padded > size - offset - 4) {
+                    return false;
+                }
+                offset += 4 + static_cast<int>(padded);
+                break;
+            }
+            case 'T':
+                value = 1.0;
+                break;
+            case 'F':
+            case 'N':
+            case 'I':
+                break;
+            default:
+                return false;   // Arrays and unknown tags: reject rather than misread what follows
+            }
+
+            if (message.argumentCount < OscMessage::MAX_ARGUMENTS) {
+                message.types[message.argumentCount] = tag;
+                message.numbers[message.argumentCount] = value;
+            }
+            ++message.argumentCount;
+        }
+        return true;
+    }
+
+    // Null-terminated, padded to 4 bytes; advances offset past the padding
+    static bool readString(const char* data, int size, int& offset, int& length)
+    {
+        const void* terminator = std::memchr(data + offset, '\0', static_cast<std::size_t>(size - offset));
+        if (!terminator) {
+            return false;
+        }
+        length = static_cast<int>(static_cast<const char*>(terminator) - (data + offset));
+        offset += (length + 4) & ~3;
+        return offset <= size;
+    }
+
+    static std::int32_t readInt32(const char* p)
+    {
+        const auto* b = reinterpret_cast<const unsigned char*>(p);
+        return static_cast<std::int32_t>((std::uint32_t(b[0]) << 24) | (std::uint32_t(b[1]) << 16)
+                                         | (std::uint32_t(b[2]) << 8) | std::uint32_t(b[3]));
+    }
+
+    static std::int64_t readInt64(const char* p)
+    {
+        return static_cast<std::int64_t>((static_cast<std::uint64_t>(static_cast<std::uint32_t>(readInt32(p))) << 32)
+                                         | static_cast<std::uint32_t>(readInt32(p + 4)));
+    }
+};
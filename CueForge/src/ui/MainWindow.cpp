@@ -23,6 +23,8 @@
 #include <QStyleFactory>
 
 #include "core/CueManager.h"
+#include "UndoStack.h"
+#include "CueListModel.h"
 #include "CueListWidget.h"
 #include "InspectorWidget.h"
 #include "TransportWidget.h"
@@ -34,6 +36,7 @@ MainWindow::MainWindow(CueManager* cueManager, QWidget* parent)
     , cueManager_(cueManager)
     , mainSplitter_(nullptr)
     , rightSplitter_(nullptr)
+    , cueListModel_(cueManager ? new CueListModel(cueManager, this) : nullptr)
     , cueListWidget_(nullptr)
     , inspectorWidget_(nullptr)
     , transportWidget_(nullptr)
@@ -339,7 +342,7 @@ void MainWindow::openWorkspace()
         this,
         "Open Workspace",
         QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation),
-        "CueForge Workspace (*.cfws);;All Files (*)"
+        "CueForge Workspace (*.cfws *.json);;All Files (*)"
     );
 
     if (!filePath.isEmpty()) {
@@ -416,12 +419,29 @@ void MainWindow::saveWorkspaceAs()
 
 void MainWindow::exportWorkspace()
 {
-    // TODO: Implement workspace export functionality
-    QMessageBox::information(
+    QString filePath = QFileDialog::getSaveFileName(
         this,
         "Export Workspace",
-        "Export functionality will be implemented in a future version."
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation),
+        "CueForge Workspace JSON (*.json);;All Files (*)"
     );
+
+    if (!filePath.isEmpty()) {
+        if (!filePath.endsWith(".json", Qt::CaseInsensitive)) {
+            filePath += ".json";
+        }
+
+        if (cueManager_ && cueManager_->exportWorkspace(filePath)) {
+            qDebug() << "Exported workspace:" << filePath;
+        }
+        else {
+            QMessageBox::critical(
+                this,
+                "Export Workspace",
+                "Failed to export workspace file:\n" + filePath
+            );
+        }
+    }
 }
 
 void MainWindow::recentWorkspace()
@@ -472,14 +492,16 @@ void MainWindow::quitApplication()
 
 void MainWindow::undoAction()
 {
-    // TODO: Implement undo functionality
-    qDebug() << "Undo requested";
+    if (cueManager_) {
+        cueManager_->undo();
+    }
 }
 
 void MainWindow::redoAction()
 {
-    // TODO: Implement redo functionality
-    qDebug() << "Redo requested";
+    if (cueManager_) {
+        cueManager_->redo();
+    }
 }
 
 void MainWindow::cutCues()
@@ -661,8 +683,10 @@ void MainWindow::addScriptCue()
 
 void MainWindow::duplicateSelectedCues()
 {
-    // TODO: Implement cue duplication
-    qDebug() << "Duplicate selected cues requested";
+    if (cueManager_) {
+        const QStringList cueIds = cueManager_->duplicateSelectedCues();
+        qDebug() << "Duplicated" << cueIds.size() << "cues";
+    }
 }
 
 void MainWindow::groupSelectedCues()
@@ -1225,6 +1249,15 @@ void MainWindow::connectSignals()
             this, &MainWindow::onCueExecutionStarted);
         connect(cueManager_, &CueManager::cueExecutionFinished,
             this, &MainWindow::onCueExecutionFinished);
+
+        // Undo/redo actions track the stack
+        UndoStack* undoStack = cueManager_->undoStack();
+        connect(undoStack, &UndoStack::stackChanged, this, [this, undoStack]() {
+            undoAction_->setEnabled(undoStack->canUndo());
+            undoAction_->setText(undoStack->canUndo() ? "&Undo " + undoStack->undoText() : "&Undo");
+            redoAction_->setEnabled(undoStack->canRedo());
+            redoAction_->setText(undoStack->canRedo() ? "&Redo " + undoStack->redoText() : "&Redo");
+        });
     }
 
     qDebug() << "Signals connected";
@@ -1515,12 +1548,12 @@ QMenu* MainWindow::createEditMenu()
     undoAction_ = menu->addAction("&Undo", this, &MainWindow::undoAction);
     undoAction_->setShortcut(QKeySequence::Undo);
     undoAction_->setIcon(style()->standardIcon(QStyle::SP_ArrowLeft));
-    undoAction_->setEnabled(false); // TODO: Enable when undo is implemented
+    undoAction_->setEnabled(false); // Follows the undo stack
 
     redoAction_ = menu->addAction("&Redo", this, &MainWindow::redoAction);
     redoAction_->setShortcut(QKeySequence::Redo);
     redoAction_->setIcon(style()->standardIcon(QStyle::SP_ArrowRight));
-    redoAction_->setEnabled(false); // TODO: Enable when redo is implemented
+    redoAction_->setEnabled(false); // Follows the undo stack
 
     menu->addSeparator();
 
@@ -24,6 +24,7 @@ QT_END_NAMESPACE
 
 class CueManager;
 class CueListWidget;
+class CueListModel;
 class InspectorWidget;
 class TransportWidget;
 class MatrixMixerWidget;
@@ -46,6 +47,7 @@ public:
     // Public interface for application integration
     void updateStatus();
     void updateWindowTitle();
+    CueListModel* cueListModel() const { return cueListModel_; }
 
     // UI state management  
     bool isInspectorVisible() const;
@@ -199,6 +201,7 @@ private:
     QSplitter* rightSplitter_;          // Right vertical splitter
 
     // Primary UI widgets
+    CueListModel* cueListModel_;        // Incremental model behind the cue list view
     CueListWidget* cueListWidget_;
     InspectorWidget* inspectorWidget_;
     TransportWidget* transportWidget_;
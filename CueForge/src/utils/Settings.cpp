@@ -369,6 +369,7 @@ void Settings::initializeDefaults()
     defaults_[Keys::Audio::OutputChannels] = 2;
     defaults_[Keys::Audio::MasterVolume] = 0.8;
     defaults_[Keys::Audio::EnableExclusive] = false;
+    defaults_[Keys::Audio::MediaPoolBudget] = 1024; // MB
 
     // MIDI settings
     defaults_[Keys::MIDI::EnableMTC] = false;
@@ -429,6 +430,13 @@ void Settings::validateSettings()
         qWarning() << "Invalid master volume, reset to default";
     }
 
+    // Media pool budget (MB, 0 = cache only what is playing)
+    int mediaPoolBudget = settings_->value(Keys::Audio::MediaPoolBudget, defaults_[Keys::Audio::MediaPoolBudget]).toInt();
+    if (mediaPoolBudget < 0) {
+        settings_->setValue(Keys::Audio::MediaPoolBudget, defaults_[Keys::Audio::MediaPoolBudget]);
+        qWarning() << "Invalid media pool budget, reset to default";
+    }
+
     // Validate theme setting
     QStringList validThemes = { "dark", "light", "auto" };
     QString theme = settings_->value(Keys::General::Theme, defaults_[Keys::General::Theme]).toString();
@@ -533,6 +541,7 @@ namespace Settings::Keys {
         const QString OutputChannels = "audio/outputChannels";
         const QString MasterVolume = "audio/masterVolume";
         const QString EnableExclusive = "audio/enableExclusive";
+        const QString MediaPoolBudget = "audio/mediaPoolBudget";
     }
 
     namespace MIDI {
@@ -111,6 +111,7 @@ public:
             static const QString OutputChannels = "audio/outputChannels";
             static const QString MasterVolume = "audio/masterVolume";
             static const QString EnableExclusive = "audio/enableExclusive";
+            static const QString MediaPoolBudget = "audio/mediaPoolBudget";     // MB of decoded audio kept cached
         }
 
         // MIDI settings
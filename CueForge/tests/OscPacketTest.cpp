@@ -0,0 +1,151 @@
+// tests/OscPacketTest.cpp - Malformed and valid datagrams through the OSC packet parser
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "OscPacket.h"
+
+namespace {
+
+/**
+ * @brief Builds datagrams byte by byte, big-endian as OSC sends them
+ */
+class PacketBuilder
+{
+public:
+    PacketBuilder& string(const char* text)
+    {
+        const std::string value(text);
+        bytes_.insert(bytes_.end(), value.begin(), value.end());
+        bytes_.push_back('\0');
+        pad();
+        return *this;
+    }
+
+    PacketBuilder& int32(std::int32_t value)
+    {
+        const auto bits = static_cast<std::uint32_t>(value);
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            bytes_.push_back(static_cast<char>((bits >> shift) & 0xff));
+        }
+        return *this;
+    }
+
+    PacketBuilder& element(const PacketBuilder& packet)
+    {
+        int32(packet.size());
+        bytes_.insert(bytes_.end(), packet.bytes_.begin(), packet.bytes_.end());
+        return *this;
+    }
+
+    PacketBuilder& raw(int count, char value = 'x')
+    {
+        bytes_.insert(bytes_.end(), static_cast<std::size_t>(count), value);
+        pad();
+        return *this;
+    }
+
+    const char* data() const { return bytes_.data(); }
+    int size() const { return static_cast<int>(bytes_.size()); }
+
+private:
+    void pad()
+    {
+        while (bytes_.size() % 4 != 0) {
+            bytes_.push_back('\0');
+        }
+    }
+
+    std::vector<char> bytes_;
+};
+
+int failures = 0;
+
+void expect(bool condition, const char* name)
+{
+    if (!condition) {
+        std::printf("FAIL %s\n", name);
+        ++failures;
+    }
+}
+
+int parsedMessages(const PacketBuilder& packet, bool& accepted)
+{
+    int count = 0;
+    accepted = OscPacket::parse(packet.data(), packet.size(), [&count](const OscMessage&) { ++count; });
+    return count;
+}
+
+} // namespace
+
+int main()
+{
+    bool accepted = false;
+
+    {
+        // /go 5: the common case still parses
+        PacketBuilder packet;
+        packet.string("/go").string(",i").int32(5);
+        double value = 0.0;
+        accepted = OscPacket::parse(packet.data(), packet.size(), [&value](const OscMessage& message) {
+            message.number(0, value);
+        });
+        expect(accepted && value == 5.0, "int argument");
+    }
+
+    {
+        PacketBuilder packet;
+        packet.string("/cue/data").string(",bi").int32(3).raw(3).int32(7);
+        const int count = parsedMessages(packet, accepted);
+        expect(accepted && count == 1, "padded blob followed by an argument");
+    }
+
+    {
+        // Rounding INT32_MAX up to a multiple of 4 overflowed before the bounds check
+        PacketBuilder packet;
+        packet.string("/cue/data").string(",b").int32(0x7fffffff).raw(4);
+        const int count = parsedMessages(packet, accepted);
+        expect(!accepted && count == 0, "blob size near INT32_MAX");
+    }
+
+    {
+        PacketBuilder packet;
+        packet.string("/cue/data").string(",b").int32(0x7ffffffd).raw(4);
+        parsedMessages(packet, accepted);
+        expect(!accepted, "blob size just under INT32_MAX");
+    }
+
+    {
+        PacketBuilder packet;
+        packet.string("/cue/data").string(",b").int32(-4).raw(4);
+        parsedMessages(packet, accepted);
+        expect(!accepted, "negative blob size");
+    }
+
+    {
+        PacketBuilder packet;
+        packet.string("/cue/data").string(",b").int32(9).raw(8);
+        parsedMessages(packet, accepted);
+        expect(!accepted, "blob larger than the packet");
+    }
+
+    {
+        // A bad message inside a bundle rejects the whole bundle, good messages included
+        PacketBuilder good;
+        good.string("/go").string(",");
+        PacketBuilder bad;
+        bad.string("/cue/data").string(",b").int32(0x7fffffff);
+
+        PacketBuilder bundle;
+        bundle.string("#bundle").int32(0).int32(1).element(good).element(bad);
+
+        const int count = parsedMessages(bundle, accepted);
+        expect(!accepted && count == 0, "oversized blob inside a bundle");
+    }
+
+    if (failures == 0) {
+        std::printf("All OSC packet checks passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
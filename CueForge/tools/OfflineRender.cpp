@@ -0,0 +1,540 @@
+// tools/OfflineRender.cpp - Headless, faster-than-real-time render of a scripted show
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "audio/AudioEngineManager.h"
+#include "audio/CallbackProfiler.h"
+#include "audio/CuePrearmer.h"
+#include "audio/CueScheduler.h"
+#include "audio/JuceAudioBridge.h"
+#include "audio/MediaPool.h"
+#include "audio/MixKernel.h"
+#include "audio/OutputPatch.h"
+#include "core/CueManager.h"
+
+namespace {
+
+/**
+ * @brief One line of the GO script: "<seconds> <command> [cue numbers...]"
+ *
+ * Commands: go (standby cue, or the listed cues fired together), standby
+ * <number>, stop, pause, resume, panic. '#' starts a comment.
+ */
+struct ScriptEvent {
+    std::int64_t atFrame = 0;
+    QString command;
+    QStringList arguments;
+    int line = 0;
+};
+
+bool parseScript(const QString& path, double sampleRate, std::vector<ScriptEvent>& events, QString& error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = QString("Cannot open script %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    static const QStringList commands = { "go", "standby", "stop", "pause", "resume", "panic" };
+
+    int lineNumber = 0;
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        ++lineNumber;
+        QString line = in.readLine();
+        line = line.left(line.indexOf('#')).trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        QStringList fields = line.split(QChar(' '), Qt::SkipEmptyParts);
+        bool ok = false;
+        const double seconds = fields.takeFirst().toDouble(&ok);
+        if (!ok || seconds < 0.0 || fields.isEmpty() || !commands.contains(fields.first())) {
+            error = QString("%1:%2: expected \"<seconds> <command> [cues]\"").arg(path).arg(lineNumber);
+            return false;
+        }
+
+        ScriptEvent event;
+        event.atFrame = std::llround(seconds * sampleRate);
+        event.command = fields.takeFirst();
+        event.arguments = fields;
+        event.line = lineNumber;
+        events.push_back(event);
+    }
+
+    // Same-time events keep their file order
+    std::stable_sort(events.begin(), events.end(), [](const ScriptEvent& a, const ScriptEvent& b) {
+        return a.atFrame < b.atFrame;
+    });
+    return true;
+}
+
+Cue* findCueByNumber(CueManager& manager, const QList<Cue*>& cues, const QString& number)
+{
+    for (Cue* cue : cues) {
+        if (cue->number() == number) {
+            return cue;
+        }
+        if (cue->type() == CueType::Group) {
+            if (Cue* child = findCueByNumber(manager, manager.getGroupChildren(cue->id()), number)) {
+                return child;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool runEvent(CueManager& manager, const ScriptEvent& event, QString& error)
+{
+    QStringList cueIds;
+    for (const QString& number : event.arguments) {
+        Cue* cue = findCueByNumber(manager, manager.getAllCues(), number);
+        if (!cue) {
+            error = QString("line %1: no cue numbered %2").arg(event.line).arg(number);
+            return false;
+        }
+        cueIds.append(cue->id());
+    }
+
+    if (event.command == "go") {
+        if (cueIds.isEmpty()) {
+            manager.go();
+        }
+        else {
+            manager.goCues(cueIds);
+        }
+    }
+    else if (event.command == "standby") {
+        if (cueIds.size() != 1) {
+            error = QString("line %1: standby takes one cue number").arg(event.line);
+            return false;
+        }
+        manager.setStandByCue(cueIds.first());
+    }
+    else if (event.command == "stop") {
+        manager.stop();
+    }
+    else if (event.command == "pause") {
+        manager.pause();
+    }
+    else if (event.command == "resume") {
+        manager.resume();
+    }
+    else if (event.command == "panic") {
+        manager.panic();
+    }
+    return true;
+}
+
+/**
+ * @brief Interleaved 32-bit float WAV (IEEE float, WAVE_FORMAT_IEEE_FLOAT)
+ */
+class WavWriter
+{
+public:
+    bool open(const QString& path, int channels, double sampleRate)
+    {
+        file_.setFileName(path);
+        if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return false;
+        }
+        channels_ = channels;
+        sampleRate_ = static_cast<std::uint32_t>(std::lround(sampleRate));
+        writeHeader(0);     // Sizes are patched in close()
+        return true;
+    }
+
+    void write(const float* interleaved, std::int64_t frames)
+    {
+        const qint64 bytes = frames * channels_ * static_cast<qint64>(sizeof(float));
+        file_.write(reinterpret_cast<const char*>(interleaved), bytes);
+        dataBytes_ += bytes;
+    }
+
+    bool close()
+    {
+        file_.seek(0);
+        writeHeader(dataBytes_);
+        file_.close();
+        return file_.error() == QFileDevice::NoError;
+    }
+
+private:
+    template <typename T>
+    void put(T value)
+    {
+        // WAV is little-endian, as is every platform the engine runs on
+        file_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeHeader(qint64 dataBytes)
+    {
+        const std::uint16_t blockAlign = static_cast<std::uint16_t>(channels_ * sizeof(float));
+        file_.write("RIFF", 4);
+        put<std::uint32_t>(static_cast<std::uint32_t>(36 + dataBytes));
+        file_.write("WAVEfmt ", 8);
+        put<std::uint32_t>(16);
+        put<std::uint16_t>(3);      // IEEE float
+        put<std::uint16_t>(static_cast<std::uint16_t>(channels_));
+        put<std::uint32_t>(sampleRate_);
+        put<std::uint32_t>(sampleRate_ * blockAlign);
+        put<std::uint16_t>(blockAlign);
+        put<std::uint16_t>(32);
+        file_.write("data", 4);
+        put<std::uint32_t>(static_cast<std::uint32_t>(dataBytes));
+    }
+
+    QFile file_;
+    int channels_ = 0;
+    std::uint32_t sampleRate_ = 0;
+    qint64 dataBytes_ = 0;
+};
+
+/**
+ * @brief Sample data of a float WAV written by WavWriter (or any IEEE float WAV)
+ */
+bool readFloatWav(const QString& path, int& channels, std::vector<float>& samples)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    if (data.size() < 12 || !data.startsWith("RIFF") || data.mid(8, 4) != "WAVE") {
+        return false;
+    }
+
+    const auto read16 = [&data](int offset) {
+        std::uint16_t value = 0;
+        std::memcpy(&value, data.constData() + offset, sizeof(value));
+        return value;
+    };
+    const auto read32 = [&data](int offset) {
+        std::uint32_t value = 0;
+        std::memcpy(&value, data.constData() + offset, sizeof(value));
+        return value;
+    };
+
+    bool isFloat = false;
+    int offset = 12;
+    while (offset + 8 <= data.size()) {
+        const QByteArray id = data.mid(offset, 4);
+        const int size = static_cast<int>(read32(offset + 4));
+        const int body = offset + 8;
+        if (id == "fmt " && size >= 16) {
+            isFloat = read16(body) == 3 && read16(body + 14) == 32;
+            channels = read16(body + 2);
+        }
+        else if (id == "data" && isFloat && channels > 0) {
+            const int bytes = std::min(size, static_cast<int>(data.size()) - body);
+            samples.resize(static_cast<std::size_t>(bytes) / sizeof(float));
+            std::memcpy(samples.data(), data.constData() + body, samples.size() * sizeof(float));
+            return true;
+        }
+        offset = body + size + (size & 1);
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("CueForgeOfflineRender");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render a workspace through the cue engine without an audio device, "
+                                     "as fast as the CPU allows.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("workspace", "Workspace to load (.cfw or JSON)");
+    const QCommandLineOption scriptOption("script", "GO script; without one the standby cue is fired at 0 s.", "file");
+    const QCommandLineOption outputOption({ "o", "output" }, "Rendered audio (32-bit float WAV).", "file");
+    const QCommandLineOption referenceOption("reference", "Compare with a previous render; exit 1 unless bit-exact.", "file");
+    const QCommandLineOption statsOption("stats", "Write timing statistics as JSON.", "file");
+    const QCommandLineOption rateOption("rate", "Sample rate (default 48000).", "hz", "48000");
+    const QCommandLineOption blockOption("block", "Block size in frames (default 256).", "frames", "256");
+    const QCommandLineOption channelsOption("channels", "Output channels (default 2).", "count", "2");
+    const QCommandLineOption tailOption("tail", "Seconds rendered after the last voice stops (default 1).", "seconds", "1");
+    const QCommandLineOption limitOption("max-duration", "Upper bound on rendered seconds (default 3600).", "seconds", "3600");
+    const QCommandLineOption kernelOption("kernel", "Mix kernel: scalar (default, identical on every CPU) or native "
+                                                    "(AVX2/NEON, for throughput; not comparable across machines).",
+                                          "name", "scalar");
+    parser.addOptions({ scriptOption, outputOption, referenceOption, statsOption, rateOption, blockOption,
+                        channelsOption, tailOption, limitOption, kernelOption });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(2);
+    }
+
+    const double sampleRate = parser.value(rateOption).toDouble();
+    const int blockSize = parser.value(blockOption).toInt();
+    const int channels = parser.value(channelsOption).toInt();
+    const std::int64_t tailFrames = std::llround(parser.value(tailOption).toDouble() * sampleRate);
+    const std::int64_t limitFrames = std::llround(parser.value(limitOption).toDouble() * sampleRate);
+    if (sampleRate <= 0.0 || blockSize <= 0 || channels <= 0 || channels > CueOutputPatch::MAX_DEVICE_OUTPUTS) {
+        err << "Invalid rate, block size or channel count\n";
+        return 2;
+    }
+
+    // Vector kernels round differently from the scalar loop, so a reference
+    // rendered on one CPU would not be bit-exact on another
+    const QString kernel = parser.value(kernelOption);
+    if (kernel != "scalar" && kernel != "native") {
+        err << "Unknown kernel " << kernel << " (expected scalar or native)\n";
+        return 2;
+    }
+    MixKernel::forceScalar(kernel == "scalar");
+
+    // Engine without a device: nothing is opened until initialize(), which is never called
+    CueManager manager;
+    AudioEngineManager engine(&manager);
+    JuceAudioBridge* bridge = engine.getJuceBridge();
+    bridge->setFreewheel(true);
+    bridge->prepareAudio(sampleRate, blockSize);
+    bridge->getProfiler()->setStageTiming(true);
+
+    // Repeatable output: everything RAM-resident (no read-ahead racing the render),
+    // and every cue armed synchronously at its GO rather than whenever a worker finishes
+    bridge->setResidentThresholdBytes(std::numeric_limits<std::int64_t>::max());
+    engine.getPrearmer()->setPrearmDepth(0);
+
+    const QString workspacePath = parser.positionalArguments().first();
+    if (!manager.openWorkspace(workspacePath)) {
+        err << "Failed to load workspace " << workspacePath << "\n";
+        return 2;
+    }
+
+    std::vector<ScriptEvent> events;
+    QString error;
+    if (parser.isSet(scriptOption)) {
+        if (!parseScript(parser.value(scriptOption), sampleRate, events, error)) {
+            err << error << "\n";
+            return 2;
+        }
+    }
+    else {
+        ScriptEvent go;
+        go.command = "go";
+        events.push_back(go);
+    }
+
+    WavWriter writer;
+    if (parser.isSet(outputOption) && !writer.open(parser.value(outputOption), channels, sampleRate)) {
+        err << "Cannot write " << parser.value(outputOption) << "\n";
+        return 2;
+    }
+
+    // Render
+    std::vector<std::vector<float>> buffers(static_cast<std::size_t>(channels), std::vector<float>(blockSize));
+    std::vector<float*> outputs(static_cast<std::size_t>(channels));
+    for (int channel = 0; channel < channels; ++channel) {
+        outputs[channel] = buffers[channel].data();
+    }
+    std::vector<float> interleaved(static_cast<std::size_t>(channels) * blockSize);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    std::int64_t frame = 0;
+    std::int64_t silentSince = -1;
+    std::size_t nextEvent = 0;
+    qint64 renderNs = 0;
+    qint64 eventNs = 0;
+    double voiceFrames = 0.0;
+    int peakVoices = 0;
+    std::int64_t blocks = 0;
+
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+    QElapsedTimer timer;
+
+    while (frame < limitFrames) {
+        // Script events land on their exact frame: GO between blocks starts on the next block's first sample
+        timer.start();
+        while (nextEvent < events.size() && events[nextEvent].atFrame <= frame) {
+            if (!runEvent(manager, events[nextEvent], error)) {
+                err << error << "\n";
+                return 2;
+            }
+            ++nextEvent;
+        }
+        bridge->dispatchAudioEvents();
+        QCoreApplication::processEvents();
+        eventNs += timer.nsecsElapsed();
+
+        int frames = blockSize;
+        if (nextEvent < events.size()) {
+            frames = static_cast<int>(std::min<std::int64_t>(frames, events[nextEvent].atFrame - frame));
+        }
+        frames = static_cast<int>(std::min<std::int64_t>(frames, limitFrames - frame));
+
+        timer.start();
+        bridge->processAudioBlock(outputs.data(), channels, frames);
+        renderNs += timer.nsecsElapsed();
+
+        const int voices = bridge->getProfiler()->lastRecord().activeVoices;
+        voiceFrames += static_cast<double>(voices) * frames;
+        peakVoices = std::max(peakVoices, voices);
+        ++blocks;
+
+        for (int i = 0; i < frames; ++i) {
+            for (int channel = 0; channel < channels; ++channel) {
+                interleaved[static_cast<std::size_t>(i) * channels + channel] = buffers[channel][i];
+            }
+        }
+        const auto bytes = reinterpret_cast<const char*>(interleaved.data());
+        hash.addData(QByteArrayView(bytes, static_cast<qsizetype>(frames) * channels * sizeof(float)));
+        if (parser.isSet(outputOption)) {
+            writer.write(interleaved.data(), frames);
+        }
+        frame += frames;
+
+        // Done once the script has run out, nothing is pending and the tail has passed in silence
+        const bool idle = voices == 0 && engine.getScheduler()->pendingCount() == 0;
+        if (nextEvent < events.size() || !idle) {
+            silentSince = -1;
+        }
+        else if (silentSince < 0) {
+            silentSince = frame;
+        }
+        else if (frame - silentSince >= tailFrames) {
+            break;
+        }
+    }
+
+    manager.stop();
+    bridge->dispatchAudioEvents();
+    QCoreApplication::processEvents();
+    const qint64 wallNs = wallTimer.nsecsElapsed();
+
+    if (parser.isSet(outputOption) && !writer.close()) {
+        err << "Failed to finish " << parser.value(outputOption) << "\n";
+        return 2;
+    }
+
+    // Statistics
+    const double renderedSeconds = frame / sampleRate;
+    const double realtimeFactor = renderNs > 0 ? renderedSeconds / (renderNs / 1.0e9) : 0.0;
+    const double averageVoices = frame > 0 ? voiceFrames / frame : 0.0;
+    const CallbackProfiler::Snapshot profile = bridge->getProfiler()->snapshot(false);
+    const MediaPool::Stats pool = bridge->getMediaPool()->stats();
+    const QString digest = QString::fromLatin1(hash.result().toHex());
+
+    out << QString("rendered        %1 s (%2 frames, %3 blocks)\n").arg(renderedSeconds, 0, 'f', 3).arg(frame).arg(blocks);
+    out << QString("render time     %1 ms (%2x real time)\n").arg(renderNs / 1.0e6, 0, 'f', 3).arg(realtimeFactor, 0, 'f', 1);
+    out << QString("control time    %1 ms (GO, arming, event dispatch)\n").arg(eventNs / 1.0e6, 0, 'f', 3);
+    out << QString("mix kernel      %1\n").arg(MixKernel::implementationName());
+    out << QString("wall time       %1 ms\n").arg(wallNs / 1.0e6, 0, 'f', 3);
+    out << QString("block avg/worst %1 / %2 us\n").arg(profile.averageNs / 1.0e3, 0, 'f', 2).arg(profile.worstNs / 1.0e3, 0, 'f', 2);
+    for (int stage = 0; stage < CallbackProfiler::STAGE_COUNT; ++stage) {
+        const QString name = CallbackProfiler::stageName(static_cast<CallbackProfiler::Stage>(stage));
+        out << QString("  %1 %2 us avg\n").arg(name, -12).arg(profile.stageAverageNs[stage] / 1.0e3, 0, 'f', 2);
+    }
+    // One core would sustain this many of the show's average voice at real time
+    out << QString("voices          avg %1, peak %2, %3 per core\n")
+        .arg(averageVoices, 0, 'f', 2).arg(peakVoices).arg(averageVoices * realtimeFactor, 0, 'f', 0);
+    out << QString("media pool      %1 hits, %2 misses, %3 MB\n")
+        .arg(pool.hits).arg(pool.misses).arg(pool.residentBytes / (1024.0 * 1024.0), 0, 'f', 1);
+    out << QString("sha1            %1\n").arg(digest);
+
+    if (parser.isSet(statsOption)) {
+        QJsonObject stages;
+        for (int stage = 0; stage < CallbackProfiler::STAGE_COUNT; ++stage) {
+            stages[CallbackProfiler::stageName(static_cast<CallbackProfiler::Stage>(stage))] = profile.stageAverageNs[stage];
+        }
+
+        QJsonObject stats;
+        stats["workspace"] = QFileInfo(workspacePath).fileName();
+        stats["sampleRate"] = sampleRate;
+        stats["blockSize"] = blockSize;
+        stats["channels"] = channels;
+        stats["kernel"] = MixKernel::implementationName();
+        stats["frames"] = static_cast<qint64>(frame);
+        stats["renderNs"] = renderNs;
+        stats["controlNs"] = eventNs;
+        stats["wallNs"] = wallNs;
+        stats["realtimeFactor"] = realtimeFactor;
+        stats["averageBlockNs"] = profile.averageNs;
+        stats["worstBlockNs"] = static_cast<qint64>(profile.worstNs);
+        stats["stageAverageNs"] = stages;
+        stats["averageVoices"] = averageVoices;
+        stats["peakVoices"] = peakVoices;
+        stats["voicesPerCore"] = averageVoices * realtimeFactor;
+        stats["mediaPoolHits"] = static_cast<qint64>(pool.hits);
+        stats["mediaPoolMisses"] = static_cast<qint64>(pool.misses);
+        stats["sha1"] = digest;
+
+        QFile file(parser.value(statsOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            err << "Cannot write " << parser.value(statsOption) << "\n";
+            return 2;
+        }
+        file.write(QJsonDocument(stats).toJson());
+    }
+
+    // Bit-exactness against a previous render
+    if (parser.isSet(referenceOption)) {
+        if (!parser.isSet(outputOption)) {
+            err << "--reference needs --output to compare against\n";
+            return 2;
+        }
+
+        int referenceChannels = 0;
+        int renderedChannels = 0;
+        std::vector<float> reference;
+        std::vector<float> rendered;
+        if (!readFloatWav(parser.value(referenceOption), referenceChannels, reference)
+            || !readFloatWav(parser.value(outputOption), renderedChannels, rendered)) {
+            err << "Cannot read " << parser.value(referenceOption) << " as a float WAV\n";
+            return 2;
+        }
+
+        if (referenceChannels != renderedChannels || reference.size() != rendered.size()) {
+            out << QString("MISMATCH        layout differs (%1 ch x %2 vs %3 ch x %4 frames)\n")
+                .arg(referenceChannels).arg(reference.size() / std::max(1, referenceChannels))
+                .arg(renderedChannels).arg(rendered.size() / std::max(1, renderedChannels));
+            return 1;
+        }
+
+        // Compared as bit patterns, so -0.0 vs 0.0 or a changed NaN counts as a difference
+        std::size_t differing = 0;
+        std::size_t first = 0;
+        float maxError = 0.0f;
+        for (std::size_t i = 0; i < rendered.size(); ++i) {
+            if (std::memcmp(&rendered[i], &reference[i], sizeof(float)) != 0) {
+                if (differing++ == 0) {
+                    first = i;
+                }
+                maxError = std::max(maxError, std::abs(rendered[i] - reference[i]));
+            }
+        }
+
+        if (differing > 0) {
+            out << QString("MISMATCH        %1 samples differ, first at frame %2, max error %3\n")
+                .arg(differing).arg(first / renderedChannels).arg(maxError, 0, 'g', 6);
+            return 1;
+        }
+        out << "bit-exact       yes\n";
+    }
+
+    return 0;
+}